@@ -137,133 +137,76 @@ CFilter::CFilter(void)
 bool CFilter::On_Execute(void)
 {
 	int			Mode, Radius, Method;
-	double		Mean;
-	CSG_Grid	*pResult;
+	CSG_Grid	*pInput, *pResult, Mean;
 
 	//-----------------------------------------------------
-	m_pInput	= Parameters("INPUT")	->asGrid();
+	pInput		= Parameters("INPUT")	->asGrid();
 	pResult		= Parameters("RESULT")	->asGrid();
 	Radius		= Parameters("RADIUS")	->asInt();
 	Mode		= Parameters("MODE")	->asInt();
 	Method		= Parameters("METHOD")	->asInt();
 
-	switch( Mode )
-	{
-	case 0:								break;
-	case 1:	m_Radius.Create(Radius);	break;
-	}
-
 	//-----------------------------------------------------
-	if( !pResult || pResult == m_pInput )
+	if( !pResult || pResult == pInput )
 	{
-		pResult	= SG_Create_Grid(m_pInput);
+		pResult	= SG_Create_Grid(pInput);
 	}
 	else
 	{
-		pResult->Set_Name(CSG_String::Format(SG_T("%s [%s]"), m_pInput->Get_Name(), _TL("Filter")));
+		pResult->Set_Name(CSG_String::Format(SG_T("%s [%s]"), pInput->Get_Name(), _TL("Filter")));
 
-		pResult->Set_NoData_Value(m_pInput->Get_NoData_Value());
+		pResult->Set_NoData_Value(pInput->Get_NoData_Value());
 	}
 
 	//-----------------------------------------------------
-	for(int y=0; y<Get_NY() && Set_Progress(y); y++)
+	switch( Method )
 	{
-		for(int x=0; x<Get_NX(); x++)
+	case 0:	default:	// Smooth...
+		SG_Grid_Filter_Mean(pInput, pResult, Radius, Mode == 0);
+		break;
+
+	case 1:				// Sharpen...
+	case 2:				// Edge...
+		Mean.Create(*Get_System(), SG_DATATYPE_Double);
+
+		SG_Grid_Filter_Mean(pInput, &Mean, Radius, Mode == 0);
+
+		for(int y=0; y<Get_NY() && Set_Progress(y); y++)
 		{
-			if( m_pInput->is_InGrid(x, y) )
+			#pragma omp parallel for
+			for(int x=0; x<Get_NX(); x++)
 			{
-				switch( Mode )
+				if( Mean.is_NoData(x, y) )
 				{
-				case 0:		Mean	= Get_Mean_Square(x, y, Radius);	break;
-				case 1:		Mean	= Get_Mean_Circle(x, y);			break;
+					pResult->Set_NoData(x, y);
 				}
-
-				switch( Method )
+				else if( Method == 1 )
 				{
-				case 0:	default:	// Smooth...
-					pResult->Set_Value(x, y, Mean);
-					break;
-
-				case 1:				// Sharpen...
-					pResult->Set_Value(x, y, m_pInput->asDouble(x, y) + (m_pInput->asDouble(x, y) - Mean));
-					break;
-
-				case 2:				// Edge...
-					pResult->Set_Value(x, y, m_pInput->asDouble(x, y) - Mean);
-					break;
+					pResult->Set_Value(x, y, pInput->asDouble(x, y) + (pInput->asDouble(x, y) - Mean.asDouble(x, y)));
+				}
+				else
+				{
+					pResult->Set_Value(x, y, pInput->asDouble(x, y) - Mean.asDouble(x, y));
 				}
-			}
-			else
-			{
-				pResult->Set_NoData(x, y);
 			}
 		}
+		break;
 	}
 
 	//-----------------------------------------------------
-	if( !Parameters("RESULT")->asGrid() || Parameters("RESULT")->asGrid() == m_pInput )
+	if( !Parameters("RESULT")->asGrid() || Parameters("RESULT")->asGrid() == pInput )
 	{
-		m_pInput->Assign(pResult);
+		pInput->Assign(pResult);
 
 		delete(pResult);
 
-		DataObject_Update(m_pInput);
+		DataObject_Update(pInput);
 	}
 
-	m_Radius.Destroy();
-
 	return( true );
 }
 
 
-///////////////////////////////////////////////////////////
-//														 //
-//														 //
-//														 //
-///////////////////////////////////////////////////////////
-
-//---------------------------------------------------------
-double CFilter::Get_Mean_Square(int x, int y, int Radius)
-{
-	int		ix, iy, n;
-	double	s;
-
-	for(n=0, s=0.0, iy=y-Radius; iy<=y+Radius; iy++)
-	{
-		for(ix=x-Radius; ix<=x+Radius; ix++)
-		{
-			if( m_pInput->is_InGrid(ix, iy) )
-			{
-				s	+= m_pInput->asDouble(ix, iy);
-				n	++;
-			}
-		}
-	}
-
-	return( n > 0 ? s / n : m_pInput->Get_NoData_Value() );
-}
-
-//---------------------------------------------------------
-double CFilter::Get_Mean_Circle(int x, int y)
-{
-	int		i, ix, iy, n;
-	double	s;
-
-	for(n=0, s=0.0, i=0; i<m_Radius.Get_nPoints(); i++)
-	{
-		m_Radius.Get_Point(i, x, y, ix, iy);
-
-		if( m_pInput->is_InGrid(ix, iy) )
-		{
-			s	+= m_pInput->asDouble(ix, iy);
-			n	++;
-		}
-	}
-
-	return( n > 0 ? s / n : m_pInput->Get_NoData_Value() );
-}
-
-
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -92,17 +92,6 @@ protected:
 
 	virtual bool			On_Execute		(void);
 
-
-private:
-
-	CSG_Grid_Radius			m_Radius;
-
-	CSG_Grid				*m_pInput;
-
-
-	double					Get_Mean_Square	(int x, int y, int Radius);
-	double					Get_Mean_Circle	(int x, int y);
-
 };
 
 
@@ -165,21 +165,7 @@ bool CFilter_Gauss::On_Execute(void)
 		}
 
 		//-------------------------------------------------
-		for(int y=0; y<Get_NY() && Set_Progress(y); y++)
-		{
-			#pragma omp parallel for
-			for(int x=0; x<Get_NX(); x++)
-			{
-				if( m_pInput->is_InGrid(x, y) )
-				{
-					pResult->Set_Value(x, y, Get_Mean(x, y));
-				}
-				else
-				{
-					pResult->Set_NoData(x, y);
-				}
-			}
-		}
+		SG_Grid_Filter_Gaussian(m_pInput, pResult, Sigma, Radius, Mode == 0);
 
 		//-------------------------------------------------
 		if( !Parameters("RESULT")->asGrid() || Parameters("RESULT")->asGrid() == m_pInput )
@@ -262,27 +248,6 @@ bool CFilter_Gauss::Initialise(int Radius, double Sigma, int Mode)
 	return( false );
 }
 
-//---------------------------------------------------------
-double CFilter_Gauss::Get_Mean(int x, int y)
-{
-	int		ix, iy, jx, jy;
-	double	s, n, w;
-
-	for(n=0.0, s=0.0, jy=0, iy=y-(m_Weights.Get_NY()-1)/2; jy<m_Weights.Get_NY(); jy++, iy++)
-	{
-		for(jx=0, ix=x-(m_Weights.Get_NX()-1)/2; jx<m_Weights.Get_NX(); jx++, ix++)
-		{
-			if( (w = m_Weights.asDouble(jx, jy)) > 0.0 && m_pInput->is_InGrid(ix, iy) )
-			{
-				s	+= w * m_pInput->asDouble(ix, iy);
-				n	+= w;
-			}
-		}
-	}
-
-	return( n > 0.0 ? s / n : m_pInput->Get_NoData_Value() );
-}
-
 
 ///////////////////////////////////////////////////////////
 //														 //
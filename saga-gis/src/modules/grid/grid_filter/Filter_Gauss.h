@@ -88,8 +88,6 @@ private:
 
 	bool				Initialise			(int Radius, double Sigma, int Mode);
 
-	double				Get_Mean			(int x, int y);
-
 };
 
 //---------------------------------------------------------
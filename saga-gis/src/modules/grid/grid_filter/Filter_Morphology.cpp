@@ -135,144 +135,61 @@ CFilter_Morphology::CFilter_Morphology(void)
 //---------------------------------------------------------
 bool CFilter_Morphology::On_Execute(void)
 {
-	int			x, y, ix, iy, Method;
-	double		Minimum, Maximum;
-	CSG_Grid	*pResult, Result;
+	int			Radius, Method;
+	bool		bSquare;
+	CSG_Grid	*pInput, *pResult, Result;
 
 	//-----------------------------------------------------
-	m_pInput	= Parameters("INPUT")	->asGrid();
+	pInput		= Parameters("INPUT")	->asGrid();
 	pResult		= Parameters("RESULT")	->asGrid();
-	m_Radius	= Parameters("RADIUS")	->asInt();
+	Radius		= Parameters("RADIUS")	->asInt();
 	Method		= Parameters("METHOD")	->asInt();
+	bSquare		= Parameters("MODE")	->asInt() == 0;
 
 	//-----------------------------------------------------
-	m_Kernel.Create(SG_DATATYPE_Byte, 1 + 2 * m_Radius, 1 + 2 * m_Radius);
-	m_Kernel.Set_NoData_Value(0.0);
-	m_Kernel.Assign(1.0);
-	m_Kernel.Set_Value(m_Radius, m_Radius, 0.0);
-
-	if( Parameters("MODE")->asInt() == 1 )
-	{
-		for(y=-m_Radius, iy=0; y<=m_Radius; y++, iy++)
-		{
-			for(x=-m_Radius, ix=0; x<=m_Radius; x++, ix++)
-			{
-				if( x*x + y*y > m_Radius*m_Radius )
-				{
-					m_Kernel.Set_Value(ix, iy, 0.0);
-				}
-			}
-		}
-	}
-
-	//-----------------------------------------------------
-	if( !pResult || pResult == m_pInput )
+	if( !pResult || pResult == pInput )
 	{
-		pResult	= SG_Create_Grid(m_pInput);
+		pResult	= SG_Create_Grid(pInput);
 	}
 	else
 	{
-		pResult->Set_Name(CSG_String::Format(SG_T("%s [%s]"), m_pInput->Get_Name(), Parameters("METHOD")->asString()));
+		pResult->Set_Name(CSG_String::Format(SG_T("%s [%s]"), pInput->Get_Name(), Parameters("METHOD")->asString()));
 
-		pResult->Set_NoData_Value(m_pInput->Get_NoData_Value());
+		pResult->Set_NoData_Value(pInput->Get_NoData_Value());
 	}
 
 	//-----------------------------------------------------
-	if( Method == 2 || Method == 3 )
+	switch( Method )
 	{
-		Result.Create(*Get_System());
+	case 0:	// Dilation
+		SG_Grid_Filter_Maximum(pInput, pResult, Radius, bSquare);
+		break;
 
-		for(y=0; y<Get_NY() && Set_Progress(y); y++)
-		{
-			for(x=0; x<Get_NX(); x++)
-			{
-				if( Get_Range(x, y, Minimum, Maximum) )
-				{
-					switch( Method )
-					{
-					case 2:	Result.Set_Value(x, y, Minimum);	break;	// Opening = Erosion + Dilation
-					case 3:	Result.Set_Value(x, y, Maximum);	break;	// Closing = Dilation + Erosion
-					}
-				}
-				else
-				{
-					Result.Set_NoData(x, y);
-				}
-			}
-		}
-
-		m_pInput	= &Result;
-	}
+	case 1:	// Erosion
+		SG_Grid_Filter_Minimum(pInput, pResult, Radius, bSquare);
+		break;
 
-	for(y=0; y<Get_NY() && Set_Progress(y); y++)
-	{
-		for(x=0; x<Get_NX(); x++)
-		{
-			if( Get_Range(x, y, Minimum, Maximum) )
-			{
-				switch( Method )
-				{
-				case 0: case 2:	pResult->Set_Value(x, y, Maximum);	break;	// Dilation
-				case 1: case 3:	pResult->Set_Value(x, y, Minimum);	break;	// Erosion
-				}
-			}
-			else
-			{
-				pResult->Set_NoData(x, y);
-			}
-		}
+	case 2:	// Opening = Erosion + Dilation
+		Result.Create(*Get_System());
+		SG_Grid_Filter_Minimum(pInput , &Result, Radius, bSquare);
+		SG_Grid_Filter_Maximum(&Result, pResult, Radius, bSquare);
+		break;
+
+	case 3:	// Closing = Dilation + Erosion
+		Result.Create(*Get_System());
+		SG_Grid_Filter_Maximum(pInput , &Result, Radius, bSquare);
+		SG_Grid_Filter_Minimum(&Result, pResult, Radius, bSquare);
+		break;
 	}
 
 	//-----------------------------------------------------
-	if( !Parameters("RESULT")->asGrid() || Parameters("RESULT")->asGrid() == m_pInput )
+	if( !Parameters("RESULT")->asGrid() || Parameters("RESULT")->asGrid() == pInput )
 	{
-		m_pInput->Assign(pResult);
+		pInput->Assign(pResult);
 
 		delete(pResult);
 
-		DataObject_Update(m_pInput);
-	}
-
-	m_Kernel.Destroy();
-
-	return( true );
-}
-
-
-///////////////////////////////////////////////////////////
-//														 //
-//														 //
-//														 //
-///////////////////////////////////////////////////////////
-
-//---------------------------------------------------------
-bool CFilter_Morphology::Get_Range(int x, int y, double &Minimum, double &Maximum)
-{
-	if( !m_pInput->is_InGrid(x, y) )
-	{
-		return( false );
-	}
-
-	Minimum	= Maximum	= m_pInput->asDouble(x, y);
-
-	for(int iy=0, jy=y-m_Radius; iy<m_Kernel.Get_NY(); iy++, jy++)
-	{
-		for(int ix=0, jx=x-m_Radius; ix<m_Kernel.Get_NX(); ix++, jx++)
-		{
-			if( m_Kernel.asByte(ix, iy) && m_pInput->is_InGrid(jx, jy) )
-			{
-				double	z	= m_pInput->asDouble(jx, jy);
-
-				if( Minimum > z )
-				{
-					Minimum	= z;
-				}
-				else if( Maximum < z )
-				{
-					Maximum	= z;
-				}
-			}
-		}
+		DataObject_Update(pInput);
 	}
 
 	return( true );
@@ -90,16 +90,6 @@ protected:
 
 	virtual bool			On_Execute		(void);
 
-
-private:
-
-	int						m_Radius, m_Threshold;
-
-	CSG_Grid				m_Kernel, *m_pInput;
-
-
-	bool					Get_Range		(int x, int y, double &Minimum, double &Maximum);
-
 };
 
 
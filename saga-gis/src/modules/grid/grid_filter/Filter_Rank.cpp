@@ -131,117 +131,75 @@ CFilter_Rank::CFilter_Rank(void)
 bool CFilter_Rank::On_Execute(void)
 {
 	//-----------------------------------------------------
-	m_Kernel.Set_Radius(Parameters("RADIUS")->asInt(), Parameters("MODE")->asInt() == 0);
+	int		Radius	= Parameters("RADIUS")->asInt();
+
+	bool	bSquare	= Parameters("MODE")->asInt() == 0;
 
 	double	Rank	= Parameters("RANK")->asDouble() / 100.0;
 
 	//-----------------------------------------------------
-	m_pInput	= Parameters("INPUT")->asGrid();
+	CSG_Grid	*pInput	= Parameters("INPUT")->asGrid();
 
 	CSG_Grid	Input, *pResult	= Parameters("RESULT")->asGrid();
 
-	if( !pResult || pResult == m_pInput )
+	if( !pResult || pResult == pInput )
 	{
-		Input.Create(*m_pInput); pResult = m_pInput; m_pInput = &Input;
+		Input.Create(*pInput); pResult = pInput; pInput = &Input;
 	}
 	else
 	{
-		pResult->Set_Name(CSG_String::Format(SG_T("%s [%s: %.1f]"), m_pInput->Get_Name(), _TL("Rank"), 100.0 * Rank));
+		pResult->Set_Name(CSG_String::Format(SG_T("%s [%s: %.1f]"), pInput->Get_Name(), _TL("Rank"), 100.0 * Rank));
 
-		pResult->Set_NoData_Value(m_pInput->Get_NoData_Value());
+		pResult->Set_NoData_Value(pInput->Get_NoData_Value());
 	}
 
 	//-----------------------------------------------------
-	for(int y=0; y<Get_NY() && Set_Progress(y); y++)
-	{
-		#pragma omp parallel for
-		for(int x=0; x<Get_NX(); x++)
-		{
-			double	Value;
+	// each thread moves its own window along a block of columns,
+	// so that only entering and leaving kernel cells are updated
 
-			if( Get_Value(x, y, Rank, Value) )
-			{
-				pResult->Set_Value(x, y, Value);
-			}
-			else
-			{
-				pResult->Set_NoData(x, y);
-			}
-		}
-	}
+	int	nBlocks	= M_GET_MIN(SG_Get_Max_Num_Threads_Omp(), Get_NX());
 
-	//-----------------------------------------------------
-	if( m_pInput == &Input )
+	CSG_Grid_Rank_Window	*Windows	= new CSG_Grid_Rank_Window[nBlocks];
+
+	for(int iBlock=0; iBlock<nBlocks; iBlock++)
 	{
-		DataObject_Update(pResult);
+		Windows[iBlock].Create(pInput, Radius, bSquare);
 	}
 
-	m_Kernel.Destroy();
-
-	return( true );
-}
-
-
-///////////////////////////////////////////////////////////
-//														 //
-//														 //
-//														 //
-///////////////////////////////////////////////////////////
-
-//---------------------------------------------------------
-bool CFilter_Rank::Get_Value(int x, int y, double Rank, double &Value)
-{
-	if( m_pInput->is_InGrid(x, y) )
+	//-----------------------------------------------------
+	for(int y=0; y<Get_NY() && Set_Progress(y); y++)
 	{
-		CSG_Table	Values;
-
-		Values.Add_Field(SG_T("Z"), SG_DATATYPE_Double);
-
-		for(int i=0; i<m_Kernel.Get_Count(); i++)
-		{
-			int	ix	= m_Kernel.Get_X(i, x);
-			int	iy	= m_Kernel.Get_Y(i, y);
-
-			if( m_pInput->is_InGrid(ix, iy) )
-			{
-				Values.Add_Record()->Set_Value(0, m_pInput->asDouble(ix, iy));
-			}
-		}
-
-		switch( Values.Get_Count() )
+		#pragma omp parallel for
+		for(int iBlock=0; iBlock<nBlocks; iBlock++)
 		{
-		case 0:
-			return( false );
-
-		case 1:
-			Value	= Values[0].asDouble(0);
-			return( true );
-
-		case 2:
-			Value	= (Values[0].asDouble(0) + Values[1].asDouble(0)) / 2.0;
-			return( true );
+			int	ax	= (int)(((sLong)Get_NX() *  iBlock     ) / nBlocks);
+			int	bx	= (int)(((sLong)Get_NX() * (iBlock + 1)) / nBlocks);
 
-		default:
+			for(int x=ax; x<bx; x++)
 			{
-				Values.Set_Index(0, TABLE_INDEX_Ascending);
+				double	Value;
 
-				Rank	= Rank * (Values.Get_Count() - 1.0);
-
-				int	i	= (int)Rank;
-
-				Value	= Values.Get_Record_byIndex(i)->asDouble(0);
-
-				if( Rank - i > 0.0 && i < Values.Get_Count() - 1 )
+				if( Windows[iBlock].Set_Cell(x, y) && !pInput->is_NoData(x, y) && Windows[iBlock].Get_Rank(Rank, Value) )
 				{
-					Value	= (Value + Values.Get_Record_byIndex(i + 1)->asDouble(0)) / 2.0;
+					pResult->Set_Value(x, y, Value);
+				}
+				else
+				{
+					pResult->Set_NoData(x, y);
 				}
 			}
-
-			return( true );
 		}
 	}
 
-	return( false );
+	delete[](Windows);
+
+	//-----------------------------------------------------
+	if( pInput == &Input )
+	{
+		DataObject_Update(pResult);
+	}
+
+	return( true );
 }
 
 
@@ -90,16 +90,6 @@ protected:
 
 	virtual bool			On_Execute		(void);
 
-
-private:
-
-	CSG_Grid_Cell_Addressor	m_Kernel;
-
-	CSG_Grid				*m_pInput;
-
-
-	bool					Get_Value		(int x, int y, double Rank, double &Value);
-
 };
 
 
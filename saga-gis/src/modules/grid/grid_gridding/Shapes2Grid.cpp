@@ -295,6 +295,33 @@ bool CShapes2Grid::On_Execute(void)
 	m_pCount->Assign(0.0);
 
 	//-----------------------------------------------------
+	// the target rows are split into bands, each band is
+	// rasterized by one thread only, handling the shapes it
+	// is touched by in input order, so that each cell sees
+	// the same sequence of values as with a serial run
+
+	int	NY		= m_pGrid->Get_NY();
+	int	nBlocks	= M_GET_MAX(1, M_GET_MIN(NY, SG_Get_Max_Num_Threads_Omp()));
+	int	nBands	= M_GET_MAX(1, M_GET_MIN(NY, 4 * nBlocks));
+
+	double		*Values	= (double *)SG_Malloc(m_pShapes->Get_Count() * sizeof(double));
+
+	if( !Values && m_pShapes->Get_Count() > 0 )
+	{
+		m_Count.Destroy();
+
+		Error_Set(_TL("failed to allocate memory"));
+
+		return( false );
+	}
+
+	CSG_Array	*Bands	= new CSG_Array[nBands];
+
+	for(int iBand=0; iBand<nBands; iBand++)
+	{
+		Bands[iBand].Create(sizeof(int), 0, SG_ARRAY_GROWTH_2);
+	}
+
 	for(int iShape=0; iShape<m_pShapes->Get_Count() && Set_Progress(iShape, m_pShapes->Get_Count()); iShape++)
 	{
 		CSG_Shape	*pShape	= m_pShapes->Get_Shape(iShape);
@@ -303,39 +330,48 @@ bool CShapes2Grid::On_Execute(void)
 		{
 			if( iField < 0 || !pShape->is_NoData(iField) )
 			{
-				m_Value	= iField >= 0 ? pShape->asDouble(iField) : iField == -2 ? iShape + 1 : 1;
+				Values[iShape]	= iField >= 0 ? pShape->asDouble(iField) : iField == -2 ? iShape + 1 : 1;
 
 				if( pShape->Intersects(m_pGrid->Get_Extent()) )
 				{
-					switch( m_pShapes->Get_Type() )
-					{
-					case SHAPE_TYPE_Point:	case SHAPE_TYPE_Points:
-						Set_Points	(pShape);
-						break;
-
-					case SHAPE_TYPE_Line:
-						Set_Line	(pShape);
-						break;
+					// rows touched by the shape, one row added to each side for rounding
+					int	yA	= (int)floor(Y_WORLD_TO_GRID(pShape->Get_Extent().Get_YMin())) - 1;	if( yA <  0  )	yA	= 0;
+					int	yB	= (int)ceil (Y_WORLD_TO_GRID(pShape->Get_Extent().Get_YMax())) + 1;	if( yB >= NY )	yB	= NY - 1;
 
-					case SHAPE_TYPE_Polygon:
-						Set_Polygon	(pShape);
-
-						if( m_Method_Polygon == 1 )	// all cells intersected have to be marked
+					for(int iBand=(int)(((sLong)yA * nBands) / NY); iBand<nBands && NY*(sLong)iBand/nBands<=yB; iBand++)
+					{
+						if( Bands[iBand].Inc_Array() )
 						{
-							Set_Line(pShape);	// thick, each cell crossed by polygon boundary will be marked additionally
+							*((int *)Bands[iBand].Get_Entry(Bands[iBand].Get_Size() - 1))	= iShape;
 						}
-						break;
 					}
 				}
 			}
 		}
 	}
 
+	//-----------------------------------------------------
+	// bands differ in their number of shapes, so that each
+	// thread takes the next band as soon as it is done
+
+	#pragma omp parallel for schedule(dynamic)
+	for(int iBand=0; iBand<nBands; iBand++)
+	{
+		Set_Band((int)(NY * (sLong)iBand / nBands), (int)(NY * (sLong)(iBand + 1) / nBands),
+			(int)Bands[iBand].Get_Size(), (const int *)Bands[iBand].Get_Array(), Values
+		);
+	}
+
+	delete[](Bands);
+
+	SG_Free(Values);
+
 	//-----------------------------------------------------
 	if( m_Method_Multi == 4 )	// mean
 	{
 		for(int y=0; y<m_pGrid->Get_NY() && Set_Progress(y, m_pGrid->Get_NY()); y++)
 		{
+			#pragma omp parallel for
 			for(int x=0; x<m_pGrid->Get_NX(); x++)
 			{
 				if( m_pCount->asInt(x, y) > 1 )
@@ -360,13 +396,49 @@ bool CShapes2Grid::On_Execute(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-inline void CShapes2Grid::Set_Value(int x, int y)
+void CShapes2Grid::Set_Band(int yMin, int yMax, int nShapes, const int *Shapes, const double *Values)
+{
+	TBand	Band;
+
+	Band.yMin	= yMin;
+	Band.yMax	= yMax;
+
+	for(int i=0; i<nShapes; i++)
+	{
+		CSG_Shape	*pShape	= m_pShapes->Get_Shape(Shapes[i]);
+
+		Band.Value	= Values[Shapes[i]];
+
+		switch( m_pShapes->Get_Type() )
+		{
+		case SHAPE_TYPE_Point:	case SHAPE_TYPE_Points:
+			Set_Points	(Band, pShape);
+			break;
+
+		case SHAPE_TYPE_Line:
+			Set_Line	(Band, pShape);
+			break;
+
+		case SHAPE_TYPE_Polygon:
+			Set_Polygon	(Band, pShape);
+
+			if( m_Method_Polygon == 1 )	// all cells intersected have to be marked
+			{
+				Set_Line(Band, pShape);	// thick, each cell crossed by polygon boundary will be marked additionally
+			}
+			break;
+		}
+	}
+}
+
+//---------------------------------------------------------
+inline void CShapes2Grid::Set_Value(const TBand &Band, int x, int y)
 {
-	if( m_pGrid->is_InGrid(x, y, false) )
+	if( y >= Band.yMin && y < Band.yMax && x >= 0 && x < m_pGrid->Get_NX() )
 	{
 		if( m_pCount->asInt(x, y) == 0 )
 		{
-			m_pGrid->Set_Value(x, y, m_Value);
+			m_pGrid->Set_Value(x, y, Band.Value);
 		}
 		else switch( m_Method_Multi )
 		{
@@ -374,25 +446,25 @@ inline void CShapes2Grid::Set_Value(int x, int y)
 			break;
 
 		case 1:	// last
-			m_pGrid->Set_Value(x, y, m_Value);
+			m_pGrid->Set_Value(x, y, Band.Value);
 			break;
 
 		case 2:	// minimum
-			if( m_pGrid->asDouble(x, y) > m_Value )
+			if( m_pGrid->asDouble(x, y) > Band.Value )
 			{
-				m_pGrid->Set_Value(x, y, m_Value);
+				m_pGrid->Set_Value(x, y, Band.Value);
 			}
 			break;
 
 		case 3:	// maximum
-			if( m_pGrid->asDouble(x, y) < m_Value )
+			if( m_pGrid->asDouble(x, y) < Band.Value )
 			{
-				m_pGrid->Set_Value(x, y, m_Value);
+				m_pGrid->Set_Value(x, y, Band.Value);
 			}
 			break;
 
 		case 4:	// mean
-			m_pGrid->Add_Value(x, y, m_Value);
+			m_pGrid->Add_Value(x, y, Band.Value);
 			break;
 		}
 
@@ -408,7 +480,7 @@ inline void CShapes2Grid::Set_Value(int x, int y)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-void CShapes2Grid::Set_Points(CSG_Shape *pShape)
+void CShapes2Grid::Set_Points(const TBand &Band, CSG_Shape *pShape)
 {
 	for(int iPart=0; iPart<pShape->Get_Part_Count(); iPart++)
 	{
@@ -416,7 +488,7 @@ void CShapes2Grid::Set_Points(CSG_Shape *pShape)
 		{
 			TSG_Point	p	= pShape->Get_Point(iPoint, iPart);
 
-			Set_Value(
+			Set_Value(Band,
 				(int)(0.5 + X_WORLD_TO_GRID(p.x)),
 				(int)(0.5 + Y_WORLD_TO_GRID(p.y))
 			);
@@ -432,7 +504,7 @@ void CShapes2Grid::Set_Points(CSG_Shape *pShape)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-void CShapes2Grid::Set_Line(CSG_Shape *pShape)
+void CShapes2Grid::Set_Line(const TBand &Band, CSG_Shape *pShape)
 {
 	TSG_Point	a, b;
 
@@ -449,17 +521,22 @@ void CShapes2Grid::Set_Line(CSG_Shape *pShape)
 			b.x	= X_WORLD_TO_GRID(b.x);
 			b.y	= Y_WORLD_TO_GRID(b.y);
 
+			if( M_GET_MAX(a.y, b.y) + 2.0 < Band.yMin || M_GET_MIN(a.y, b.y) - 1.0 >= Band.yMax )
+			{
+				continue;	// segment does not touch the band's rows
+			}
+
 			switch( m_Method_Lines )
 			{
-			case 0:	Set_Line_A(a, b);	break;
-			case 1:	Set_Line_B(a, b);	break;
+			case 0:	Set_Line_A(Band, a, b);	break;
+			case 1:	Set_Line_B(Band, a, b);	break;
 			}
 		}
 	}
 }
 
 //---------------------------------------------------------
-void CShapes2Grid::Set_Line_A(TSG_Point a, TSG_Point b)
+void CShapes2Grid::Set_Line_A(const TBand &Band, TSG_Point a, TSG_Point b)
 {
 	double			ix, iy, sig;
 	double			dx, dy;
@@ -484,7 +561,7 @@ void CShapes2Grid::Set_Line_A(TSG_Point a, TSG_Point b)
 
 			for(ix=0; ix<=dx; ix++, a.x+=sig, a.y+=dy)
 			{
-				Set_Value((int)a.x, (int)a.y);
+				Set_Value(Band, (int)a.x, (int)a.y);
 			}
 		}
 		else if( fabs(dy) >= fabs(dx) && dy != 0 )
@@ -495,18 +572,18 @@ void CShapes2Grid::Set_Line_A(TSG_Point a, TSG_Point b)
 
 			for(iy=0; iy<=dy; iy++, a.x+=dx, a.y+=sig)
 			{
-				Set_Value((int)a.x, (int)a.y);
+				Set_Value(Band, (int)a.x, (int)a.y);
 			}
 		}
 	}
 	else
 	{
-		Set_Value(A.x, A.y);
+		Set_Value(Band, A.x, A.y);
 	}
 }
 
 /*/---------------------------------------------------------
-void CShapes2Grid::Set_Line_A(TSG_Point a, TSG_Point b)
+void CShapes2Grid::Set_Line_A(const TBand &Band, TSG_Point a, TSG_Point b)
 {
 	TSG_Point_Int	A, B;
 
@@ -531,7 +608,7 @@ void CShapes2Grid::Set_Line_A(TSG_Point a, TSG_Point b)
 
 			for(t=A.y; A.x!=B.x; A.x+=d, t+=m)
 			{
-				Set_Value(A.x, (int)t);
+				Set_Value(Band, A.x, (int)t);
 			}
 		}
 		else // if( fabs(dy) >= fabs(dx) )
@@ -541,18 +618,18 @@ void CShapes2Grid::Set_Line_A(TSG_Point a, TSG_Point b)
 
 			for(t=A.x; A.y!=B.y; A.y+=d, t+=m)
 			{
-				Set_Value((int)t, A.y);
+				Set_Value(Band, (int)t, A.y);
 			}
 		}
 	}
 	else
 	{
-		Set_Value(A.x, A.y);
+		Set_Value(Band, A.x, A.y);
 	}
 }/**/
 
 //---------------------------------------------------------
-void CShapes2Grid::Set_Line_B(TSG_Point a, TSG_Point b)
+void CShapes2Grid::Set_Line_B(const TBand &Band, TSG_Point a, TSG_Point b)
 {
 	int				ix, iy;
 	double			e, d, dx, dy;
@@ -563,7 +640,7 @@ void CShapes2Grid::Set_Line_B(TSG_Point a, TSG_Point b)
 	B.x	= (int)(b.x	+= 0.5);
 	B.y	= (int)(b.y	+= 0.5);
 
-	Set_Value(A.x, A.y);
+	Set_Value(Band, A.x, A.y);
 
 	//-----------------------------------------------------
 	if( A.x != B.x || A.y != B.y )
@@ -588,14 +665,14 @@ void CShapes2Grid::Set_Line_B(TSG_Point a, TSG_Point b)
 			{
 				e	-= 1.0;
 				A.y	+= iy;
-				Set_Value(A.x, A.y);
+				Set_Value(Band, A.x, A.y);
 			}
 
 			while( A.x != B.x )
 			{
 				A.x	+= ix;
 				e	+= d;
-				Set_Value(A.x, A.y);
+				Set_Value(Band, A.x, A.y);
 
 				if( A.x != B.x )
 				{
@@ -603,7 +680,7 @@ void CShapes2Grid::Set_Line_B(TSG_Point a, TSG_Point b)
 					{
 						e	-= 1.0;
 						A.y	+= iy;
-						Set_Value(A.x, A.y);
+						Set_Value(Band, A.x, A.y);
 					}
 				}
 			}
@@ -615,7 +692,7 @@ void CShapes2Grid::Set_Line_B(TSG_Point a, TSG_Point b)
 				while( A.y != B.y )
 				{
 					A.y	+= iy;
-					Set_Value(A.x, A.y);
+					Set_Value(Band, A.x, A.y);
 				}
 			}
 		}
@@ -634,14 +711,14 @@ void CShapes2Grid::Set_Line_B(TSG_Point a, TSG_Point b)
 			{
 				e	-= 1.0;
 				A.x	+= ix;
-				Set_Value(A.x, A.y);
+				Set_Value(Band, A.x, A.y);
 			}
 
 			while( A.y != B.y )
 			{
 				A.y	+= iy;
 				e	+= d;
-				Set_Value(A.x, A.y);
+				Set_Value(Band, A.x, A.y);
 
 				if( A.y != B.y )
 				{
@@ -649,7 +726,7 @@ void CShapes2Grid::Set_Line_B(TSG_Point a, TSG_Point b)
 					{
 						e	-= 1.0;
 						A.x	+= ix;
-						Set_Value(A.x, A.y);
+						Set_Value(Band, A.x, A.y);
 					}
 				}
 			}
@@ -661,7 +738,7 @@ void CShapes2Grid::Set_Line_B(TSG_Point a, TSG_Point b)
 				while( A.x != B.x )
 				{
 					A.x	+= ix;
-					Set_Value(A.x, A.y);
+					Set_Value(Band, A.x, A.y);
 				}
 			}
 		}
@@ -676,22 +753,20 @@ void CShapes2Grid::Set_Line_B(TSG_Point a, TSG_Point b)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-void CShapes2Grid::Set_Polygon(CSG_Shape *pShape)
+void CShapes2Grid::Set_Polygon(const TBand &Band, CSG_Shape *pShape)
 {
-	Set_Polygon_Node((CSG_Shape_Polygon *)pShape);
+	Set_Polygon_Node(Band, (CSG_Shape_Polygon *)pShape);
 }
 
 //---------------------------------------------------------
-void CShapes2Grid::Set_Polygon_Node(CSG_Shape_Polygon *pPolygon)
+void CShapes2Grid::Set_Polygon_Node(const TBand &Band, CSG_Shape_Polygon *pPolygon)
 {
 	bool		bFill, *bCrossing;
-	int			x, y, xStart, xStop;
+	int			x, y, xStart, xStop, yStart, yStop;
 	TSG_Point	A, B, a, b, c;
 	CSG_Rect	Extent;
 
 	//-----------------------------------------------------
-	bCrossing	= (bool *)SG_Malloc(m_pGrid->Get_NX() * sizeof(bool));
-
 	Extent		= pPolygon->Get_Extent();
 
 	xStart		= (int)((Extent.m_rect.xMin - m_pGrid->Get_XMin()) / m_pGrid->Get_Cellsize()) - 1;
@@ -702,17 +777,39 @@ void CShapes2Grid::Set_Polygon_Node(CSG_Shape_Polygon *pPolygon)
 	if( xStop >= m_pGrid->Get_NX() )
 		xStop	= m_pGrid->Get_NX() - 1;
 
+	// rows covered by the polygon within the band
+	yStart		= (int)floor((Extent.m_rect.yMin - m_pGrid->Get_YMin()) / m_pGrid->Get_Cellsize());
+	if( yStart < Band.yMin )
+		yStart	= Band.yMin;
+
+	yStop		= (int)ceil ((Extent.m_rect.yMax - m_pGrid->Get_YMin()) / m_pGrid->Get_Cellsize());
+	if( yStop >= Band.yMax )
+		yStop	= Band.yMax - 1;
+
+	if( xStart > xStop || yStart > yStop )
+	{
+		return;
+	}
+
 	A.x			= m_pGrid->Get_XMin() - 1.0;
 	B.x			= m_pGrid->Get_XMax() + 1.0;
 
+	// crossings are only needed for the columns covered by the polygon
+	if( (bCrossing = (bool *)SG_Malloc((xStop - xStart + 1) * sizeof(bool))) == NULL )
+	{
+		return;
+	}
+
 	//-----------------------------------------------------
-	for(y=0, A.y=m_pGrid->Get_YMin(); y<m_pGrid->Get_NY(); y++, A.y+=m_pGrid->Get_Cellsize())
+	for(y=yStart; y<=yStop; y++)
 	{
+		A.y	= m_pGrid->Get_System().Get_yGrid_to_World(y);
+
 		if( A.y >= Extent.m_rect.yMin && A.y <= Extent.m_rect.yMax )
 		{
 			B.y	= A.y;
 
-			memset(bCrossing, 0, m_pGrid->Get_NX() * sizeof(bool));
+			memset(bCrossing, 0, (xStop - xStart + 1) * sizeof(bool));
 
 			for(int iPart=0; iPart<pPolygon->Get_Part_Count(); iPart++)
 			{
@@ -736,12 +833,13 @@ void CShapes2Grid::Set_Polygon_Node(CSG_Shape_Polygon *pPolygon)
 							{
 								x	= 0;
 							}
-							else if( x >= m_pGrid->Get_NX() )
+
+							if( x < xStart || x > xStop )	// never reached by the fill below
 							{
 								continue;
 							}
 
-							bCrossing[x]	= !bCrossing[x];
+							bCrossing[x - xStart]	= !bCrossing[x - xStart];
 						}
 					}
 				}
@@ -750,14 +848,14 @@ void CShapes2Grid::Set_Polygon_Node(CSG_Shape_Polygon *pPolygon)
 			//---------------------------------------------
 			for(x=xStart, bFill=false; x<=xStop; x++)
 			{
-				if( bCrossing[x] )
+				if( bCrossing[x - xStart] )
 				{
 					bFill	= !bFill;
 				}
 
 				if( bFill )
 				{
-					Set_Value(x, y);
+					Set_Value(Band, x, y);
 				}
 			}
 		}
@@ -768,15 +866,15 @@ void CShapes2Grid::Set_Polygon_Node(CSG_Shape_Polygon *pPolygon)
 }
 
 //---------------------------------------------------------
-void CShapes2Grid::Set_Polygon_Cell(CSG_Shape_Polygon *pPolygon)
+void CShapes2Grid::Set_Polygon_Cell(const TBand &Band, CSG_Shape_Polygon *pPolygon)
 {
 	//-----------------------------------------------------
 	CSG_Grid_System	s(m_pGrid->Get_System());
 
 	int	xA	= s.Get_xWorld_to_Grid(pPolygon->Get_Extent().Get_XMin());	if( xA <  0          )	xA	= 0;
 	int	xB	= s.Get_xWorld_to_Grid(pPolygon->Get_Extent().Get_XMax());	if( xB >= s.Get_NX() )	xB	= s.Get_NX() - 1;
-	int	yA	= s.Get_yWorld_to_Grid(pPolygon->Get_Extent().Get_YMin());	if( yA <  0          )	yA	= 0;
-	int	yB	= s.Get_yWorld_to_Grid(pPolygon->Get_Extent().Get_YMax());	if( yB >= s.Get_NY() )	yB	= s.Get_NY() - 1;
+	int	yA	= s.Get_yWorld_to_Grid(pPolygon->Get_Extent().Get_YMin());	if( yA <  Band.yMin )	yA	= Band.yMin;
+	int	yB	= s.Get_yWorld_to_Grid(pPolygon->Get_Extent().Get_YMax());	if( yB >= Band.yMax )	yB	= Band.yMax - 1;
 
 	//-----------------------------------------------------
 	TSG_Rect	r;
@@ -795,7 +893,7 @@ void CShapes2Grid::Set_Polygon_Cell(CSG_Shape_Polygon *pPolygon)
 
 			if( pPolygon->Intersects(r) )
 			{
-				Set_Value(x, y);
+				Set_Value(Band, x, y);
 			}
 		}
 	}
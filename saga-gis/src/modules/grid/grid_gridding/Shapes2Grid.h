@@ -98,9 +98,16 @@ protected:
 
 private:
 
-	int							m_Method_Multi, m_Method_Lines, m_Method_Polygon;
+	typedef struct
+	{
+		int						yMin, yMax;	// the band's rows, yMin <= y < yMax
+
+		double					Value;
+	}
+	TBand;
 
-	double						m_Value;
+
+	int							m_Method_Multi, m_Method_Lines, m_Method_Polygon;
 
 	CSG_Parameters_Grid_Target	m_Grid_Target;
 
@@ -111,17 +118,19 @@ private:
 
 	TSG_Data_Type				Get_Grid_Type			(int iType);
 
-	void						Set_Value				(int x, int y);
+	void						Set_Band				(int yMin, int yMax, int nShapes, const int *Shapes, const double *Values);
+
+	void						Set_Value				(const TBand &Band, int x, int y);
 
-	void						Set_Points				(CSG_Shape *pShape);
+	void						Set_Points				(const TBand &Band, CSG_Shape *pShape);
 
-	void						Set_Line				(CSG_Shape *pShape);
-	void						Set_Line_A				(TSG_Point a, TSG_Point b);
-	void						Set_Line_B				(TSG_Point a, TSG_Point b);
+	void						Set_Line				(const TBand &Band, CSG_Shape *pShape);
+	void						Set_Line_A				(const TBand &Band, TSG_Point a, TSG_Point b);
+	void						Set_Line_B				(const TBand &Band, TSG_Point a, TSG_Point b);
 
-	void						Set_Polygon				(CSG_Shape *pShape);
-	void						Set_Polygon_Node		(CSG_Shape_Polygon *pPolygon);
-	void						Set_Polygon_Cell		(CSG_Shape_Polygon *pPolygon);
+	void						Set_Polygon				(const TBand &Band, CSG_Shape *pShape);
+	void						Set_Polygon_Node		(const TBand &Band, CSG_Shape_Polygon *pPolygon);
+	void						Set_Polygon_Cell		(const TBand &Band, CSG_Shape_Polygon *pPolygon);
 
 };
 
@@ -91,6 +91,11 @@ CKernel_Density::CKernel_Density(void)
 
 	Set_Description	(_TW(
 		"Kernel density estimation. If any point is currently in selection only selected points are taken into account.\n"
+		"The exact method adds each point's kernel to the grid cells, its costs grow with the number of points times "
+		"the kernel area. The binned method first sums up the points in grid cells, using either simple or linear "
+		"binning, and then convolves the binned grid with the kernel using fast Fourier transformation on tiles "
+		"(overlap-add), which makes its costs independent of the number of points. Automatic selection chooses "
+		"the method with the lower estimated costs, i.e. the exact one for small inputs.\n"
 		"\n"
 		"References:\n"
 		"- Fotheringham, A.S., Brunsdon, C., Charlton, M. (2000): Quantitative Geography. Sage. 270p.\n"
@@ -126,6 +131,25 @@ CKernel_Density::CKernel_Density(void)
 		), 0
 	);
 
+	Parameters.Add_Choice(
+		NULL	, "METHOD"		, _TL("Method"),
+		_TL(""),
+		CSG_String::Format(SG_T("%s|%s|%s|"),
+			_TL("automatic"),
+			_TL("exact"),
+			_TL("binned")
+		), 0
+	);
+
+	Parameters.Add_Choice(
+		NULL	, "BINNING"		, _TL("Binning"),
+		_TL("Simple binning assigns a point to the nearest cell, linear binning splits it among the four surrounding cells."),
+		CSG_String::Format(SG_T("%s|%s|"),
+			_TL("simple"),
+			_TL("linear")
+		), 1
+	);
+
 	//-----------------------------------------------------
 	m_Grid_Target.Create(&Parameters, true, NULL, "TARGET_");
 }
@@ -156,6 +180,11 @@ int CKernel_Density::On_Parameter_Changed(CSG_Parameters *pParameters, CSG_Param
 //---------------------------------------------------------
 int CKernel_Density::On_Parameters_Enable(CSG_Parameters *pParameters, CSG_Parameter *pParameter)
 {
+	if( !SG_STR_CMP(pParameter->Get_Identifier(), "METHOD") )
+	{
+		pParameters->Get_Parameter("BINNING")->Set_Enabled(pParameter->asInt() != 1);
+	}
+
 	return( m_Grid_Target.On_Parameters_Enable(pParameters, pParameter) ? 1 : 0 );
 }
 
@@ -202,29 +231,89 @@ bool CKernel_Density::On_Execute(void)
 	m_iRadius	= 1 + (int)m_dRadius;
 
 	//-----------------------------------------------------
-	if( pPoints->Get_Selection_Count() > 0 )
+	// collect the points, z holds the population
+
+	bool		bSelection	= pPoints->Get_Selection_Count() > 0;
+	int			nPoints		= bSelection ? pPoints->Get_Selection_Count() : pPoints->Get_Count();
+	CSG_Array	Points(sizeof(TSG_Point_Z), nPoints);
+
+	TSG_Point_Z	*pPoint	= (TSG_Point_Z *)Points.Get_Array();
+
+	for(int iPoint=0; iPoint<nPoints; iPoint++, pPoint++)
+	{
+		CSG_Shape	*pShape	= bSelection ? pPoints->Get_Selection(iPoint) : pPoints->Get_Shape(iPoint);
+
+		TSG_Point	p	= pShape->Get_Point(0);
+
+		pPoint->x	= p.x;
+		pPoint->y	= p.y;
+		pPoint->z	= Population < 0 ? 1.0 : pShape->asDouble(Population);
+	}
+
+	//-----------------------------------------------------
+	int		Method	= Parameters("METHOD")->asInt();
+
+	if( Method == 0 )	// automatic, compare the estimated operation counts
 	{
-		for(int iPoint=0; iPoint<pPoints->Get_Selection_Count() && Set_Progress(iPoint, pPoints->Get_Selection_Count()); iPoint++)
-		{
-			CSG_Shape	*pPoint	= pPoints->Get_Selection(iPoint);
+		int		N		= Get_FFT_Size(), T	= N - 2 * m_iRadius;
+		double	nTiles	= (1.0 + (m_pGrid->Get_NX() + 2 * m_iRadius - 1) / T) * (1.0 + (m_pGrid->Get_NY() + 2 * m_iRadius - 1) / T);
 
-			Set_Kernel(pPoint->Get_Point(0), Population < 0 ? 1.0 : pPoint->asDouble(Population));
-		}
+		double	Exact	= (double)nPoints * SG_Get_Square(2.0 * m_iRadius + 1.0);
+		double	Binned	= nTiles * N * N * 4.0 * log((double)N) / log(2.0);
+
+		Method	= Exact <= Binned ? 1 : 2;
 	}
-	else
+
+	if( Method == 1 )
 	{
-		for(int iPoint=0; iPoint<pPoints->Get_Count() && Set_Progress(iPoint, pPoints->Get_Count()); iPoint++)
+		Message_Add(_TL("exact kernel density estimation"));
+
+		return( Set_Exact((TSG_Point_Z *)Points.Get_Array(), nPoints) );
+	}
+
+	Message_Add(_TL("binned kernel density estimation"));
+
+	return( Set_Binned((TSG_Point_Z *)Points.Get_Array(), nPoints, Parameters("BINNING")->asInt() == 1) );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Adds the kernels of batches of points to the grid. Each
+// thread owns a strip of rows and adds those parts of all
+// kernels that fall into its strip.
+//---------------------------------------------------------
+bool CKernel_Density::Set_Exact(const TSG_Point_Z *Points, int nPoints)
+{
+	int	NY		= m_pGrid->Get_NY();
+	int	nBlocks	= M_GET_MAX(1, M_GET_MIN(NY, SG_Get_Max_Num_Threads_Omp()));
+	int	nBatch	= 0x4000;
+
+	for(int iPoint=0; iPoint<nPoints && Set_Progress(iPoint, nPoints); iPoint+=nBatch)
+	{
+		int	n	= M_GET_MIN(nBatch, nPoints - iPoint);
+
+		#pragma omp parallel for
+		for(int iBlock=0; iBlock<nBlocks; iBlock++)
 		{
-			CSG_Shape	*pPoint	= pPoints->Get_Shape(iPoint);
+			int	yMin	= NY *  iBlock      / nBlocks;
+			int	yMax	= NY * (iBlock + 1) / nBlocks;
 
-			Set_Kernel(pPoint->Get_Point(0), Population < 0 ? 1.0 : pPoint->asDouble(Population));
+			for(int i=iPoint; i<iPoint+n; i++)
+			{
+				Set_Kernel(Points[i], yMin, yMax);
+			}
 		}
 	}
 
 	return( true );
 }
 
-
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -232,14 +321,21 @@ bool CKernel_Density::On_Execute(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-void CKernel_Density::Set_Kernel(const TSG_Point &Point, double Population)
+void CKernel_Density::Set_Kernel(const TSG_Point_Z &Point, int yMin, int yMax)
 {
-	double	x	= (Point.x - m_pGrid->Get_XMin()) / m_pGrid->Get_Cellsize();
-	double	y	= (Point.y - m_pGrid->Get_YMin()) / m_pGrid->Get_Cellsize();
+	double	x	= X_WORLD_TO_GRID(Point.x);
+	double	y	= Y_WORLD_TO_GRID(Point.y);
+
+	if( y + m_iRadius < yMin || y - m_iRadius >= yMax )
+	{
+		return;
+	}
+
+	double	Population	= Point.z;
 
 	for(int iy=(int)y-m_iRadius; iy<=y+m_iRadius; iy++)
 	{
-		if( iy >= 0 && iy < m_pGrid->Get_NY() )
+		if( iy >= yMin && iy < yMax )
 		{
 			for(int ix=(int)x-m_iRadius; ix<=x+m_iRadius; ix++)
 			{
@@ -284,6 +380,348 @@ inline double CKernel_Density::Get_Kernel(double dx, double dy)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// In-place radix-2 transformation of n complex values
+// (real and imaginary parts interleaved), the i-th value
+// being found at Data[2 * i * Step].
+//---------------------------------------------------------
+static void	FFT(double *Data, int n, int Step, bool bInverse)
+{
+	int		i, j, k, m;
+
+	for(i=1, j=0; i<n; i++)	// bit reversal
+	{
+		for(m=n>>1; j&m; m>>=1)
+		{
+			j	^= m;
+		}
+
+		j	^= m;
+
+		if( i < j )
+		{
+			double	*a	= Data + 2 * i * Step, *b	= Data + 2 * j * Step, t;
+
+			t	= a[0];	a[0]	= b[0];	b[0]	= t;
+			t	= a[1];	a[1]	= b[1];	b[1]	= t;
+		}
+	}
+
+	for(m=2; m<=n; m<<=1)	// butterflies
+	{
+		double	Angle	= (bInverse ? 2.0 : -2.0) * M_PI / m;
+
+		for(k=0; k<m/2; k++)
+		{
+			double	wr	= cos(k * Angle), wi	= sin(k * Angle);
+
+			for(i=k; i<n; i+=m)
+			{
+				double	*a	= Data + 2 * i * Step, *b	= Data + 2 * (i + m / 2) * Step;
+
+				double	tr	= b[0] * wr - b[1] * wi;
+				double	ti	= b[0] * wi + b[1] * wr;
+
+				b[0]	= a[0] - tr;	a[0]	+= tr;
+				b[1]	= a[1] - ti;	a[1]	+= ti;
+			}
+		}
+	}
+}
+
+//---------------------------------------------------------
+// Two-dimensional transformation of a N x N array. Only the
+// first nRows rows of the forward transformation's input
+// are expected to contain non-zero values.
+//---------------------------------------------------------
+static void	FFT_2D(double *Data, int N, bool bInverse, int nRows)
+{
+	int	i;
+
+	if( !bInverse )
+	{
+		for(i=0; i<nRows; i++)	FFT(Data + 2 * i * N, N, 1, false);	// rows
+		for(i=0; i<N    ; i++)	FFT(Data + 2 * i    , N, N, false);	// columns
+	}
+	else
+	{
+		for(i=0; i<N    ; i++)	FFT(Data + 2 * i    , N, N, true );	// columns
+		for(i=0; i<N    ; i++)	FFT(Data + 2 * i * N, N, 1, true );	// rows
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Size of the transformation tiles. Tiles must be at least
+// four kernel radii wide, so that the kernel's reach does
+// not alias and tiles two steps apart never overlap.
+//---------------------------------------------------------
+int CKernel_Density::Get_FFT_Size(void)
+{
+	int	N	= 64;
+
+	while( N < 4 * m_iRadius || (N < 8 * m_iRadius && N < 1024) )
+	{
+		N	*= 2;
+	}
+
+	return( N );
+}
+
+//---------------------------------------------------------
+bool CKernel_Density::Set_Binned(const TSG_Point_Z *Points, int nPoints, bool bLinear)
+{
+	//-----------------------------------------------------
+	// the binning grid is enlarged by the kernel radius, so
+	// that points outside the target contribute to its edges
+
+	int		R	= m_iRadius;
+	int		MX	= m_pGrid->Get_NX() + 2 * R;
+	int		MY	= m_pGrid->Get_NY() + 2 * R;
+
+	double	*Bins	= (double *)SG_Calloc((size_t)MX * MY, sizeof(double));
+
+	if( !Bins )
+	{
+		Error_Set(_TL("failed to allocate memory"));
+
+		return( false );
+	}
+
+	Process_Set_Text(_TL("binning"));
+
+	for(int iPoint=0; iPoint<nPoints && Set_Progress(iPoint, nPoints); iPoint++)
+	{
+		double	x	= X_WORLD_TO_GRID(Points[iPoint].x) + R;
+		double	y	= Y_WORLD_TO_GRID(Points[iPoint].y) + R;
+		double	w	= Points[iPoint].z;
+
+		if( bLinear )
+		{
+			int		ix	= (int)floor(x), iy	= (int)floor(y);
+			double	dx	= x - ix       , dy	= y - iy;
+
+			for(int jy=0; jy<=1; jy++)
+			{
+				if( iy + jy >= 0 && iy + jy < MY )
+				{
+					for(int jx=0; jx<=1; jx++)
+					{
+						if( ix + jx >= 0 && ix + jx < MX )
+						{
+							Bins[(iy + jy) * (size_t)MX + ix + jx]	+= w * (jx ? dx : 1.0 - dx) * (jy ? dy : 1.0 - dy);
+						}
+					}
+				}
+			}
+		}
+		else
+		{
+			int		ix	= (int)floor(x + 0.5), iy	= (int)floor(y + 0.5);
+
+			if( ix >= 0 && ix < MX && iy >= 0 && iy < MY )
+			{
+				Bins[iy * (size_t)MX + ix]	+= w;
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	bool	bResult	= Process_Get_Okay() && Set_Convolution(Bins);
+
+	SG_Free(Bins);
+
+	return( bResult );
+}
+
+//---------------------------------------------------------
+// Convolves the binned grid with the kernel by overlap-add
+// on tiles of T x T bins, transformed with N = T + 2R. The
+// results of tiles two steps apart never overlap, so tiles
+// are processed in four passes (even/odd columns and rows),
+// the tiles of each pass in parallel. Empty tiles are skipped.
+//---------------------------------------------------------
+bool CKernel_Density::Set_Convolution(const double *Bins)
+{
+	int		R	= m_iRadius;
+	int		N	= Get_FFT_Size(), T	= N - 2 * R;
+	int		NX	= m_pGrid->Get_NX(), MX	= NX + 2 * R;
+	int		NY	= m_pGrid->Get_NY(), MY	= NY + 2 * R;
+	int		nTX	= 1 + (MX - 1) / T;
+	int		nTY	= 1 + (MY - 1) / T;
+
+	//-----------------------------------------------------
+	// each thread needs a tile buffer of 2 N^2 doubles, the
+	// buffers are limited to the tiles of one pass and to the
+	// size of the binned grid, and are reduced further, if the
+	// allocation fails
+
+	int		nBlocks	= M_GET_MIN(SG_Get_Max_Num_Threads_Omp(), ((nTX + 1) / 2) * ((nTY + 1) / 2));
+
+	nBlocks	= M_GET_MAX(1, M_GET_MIN(nBlocks, (int)(((double)MX * MY) / (2.0 * N * N))));
+
+	double	*Tiles;
+
+	while( (Tiles = (double *)SG_Malloc(2 * (size_t)N * N * nBlocks * sizeof(double))) == NULL && nBlocks > 1 )
+	{
+		nBlocks	/= 2;
+	}
+
+	//-----------------------------------------------------
+	// the kernel's spectrum, scaled for the inverse transformation
+
+	double	*Kernel	= (double *)SG_Calloc(2 * (size_t)N * N           , sizeof(double));
+
+	if( !Kernel || !Tiles )
+	{
+		SG_FREE_SAFE(Kernel);
+		SG_FREE_SAFE(Tiles );
+
+		Error_Set(_TL("failed to allocate memory"));
+
+		return( false );
+	}
+
+	double	Peak	= 0.0;
+
+	for(int dy=-R; dy<=R; dy++)
+	{
+		for(int dx=-R; dx<=R; dx++)
+		{
+			double	k	= Get_Kernel(dx, dy);
+
+			Kernel[2 * (((dy + N) % N) * (size_t)N + (dx + N) % N)]	= k;
+
+			if( Peak < k )
+			{
+				Peak	= k;
+			}
+		}
+	}
+
+	FFT_2D(Kernel, N, false, N);
+
+	for(size_t i=0; i<2*(size_t)N*N; i++)
+	{
+		Kernel[i]	/= (double)N * N;
+	}
+
+	//-----------------------------------------------------
+	Process_Set_Text(_TL("convolution"));
+
+	int	nTiles	= nTX * nTY, nDone	= 0;
+
+	for(int iPass=0; iPass<4 && Process_Get_Okay(); iPass++)
+	{
+		int	nPass	= ((nTX - (iPass % 2) + 1) / 2) * ((nTY - (iPass / 2) + 1) / 2);	// tiles of this pass
+
+		for(int iTile=0; iTile<nPass && Set_Progress(nDone, nTiles); iTile+=nBlocks, nDone+=nBlocks)
+		{
+			#pragma omp parallel for
+			for(int iBlock=0; iBlock<nBlocks; iBlock++)
+			{
+				if( iTile + iBlock >= nPass )
+				{
+					continue;
+				}
+
+				int	nPassX	= (nTX - (iPass % 2) + 1) / 2;
+				int	tx		= T * (2 * ((iTile + iBlock) % nPassX) + iPass % 2);
+				int	ty		= T * (2 * ((iTile + iBlock) / nPassX) + iPass / 2);
+
+				double	*Tile	= Tiles + 2 * (size_t)N * N * iBlock;
+
+				//-----------------------------------------
+				double	Max	= 0.0;
+
+				memset(Tile, 0, 2 * (size_t)N * N * sizeof(double));
+
+				for(int y=0; y<T && ty+y<MY; y++)
+				{
+					const double	*b	= Bins + (ty + y) * (size_t)MX + tx;
+
+					for(int x=0; x<T && tx+x<MX; x++)
+					{
+						if( b[x] != 0.0 )
+						{
+							Tile[2 * (y * (size_t)N + x)]	= b[x];
+
+							if( Max < fabs(b[x]) )
+							{
+								Max	= fabs(b[x]);
+							}
+						}
+					}
+				}
+
+				if( Max <= 0.0 )	// empty tile
+				{
+					continue;
+				}
+
+				// the inverse transformation spreads round-off over the whole tile,
+				// which must not turn cells out of the kernels' reach into data (no-data
+				// value is zero), results of negative populations are kept
+				double	Epsilon	= 1.0e-9 * Peak * Max;
+
+				//-----------------------------------------
+				FFT_2D(Tile, N, false, T);
+
+				for(size_t i=0; i<(size_t)N*N; i++)
+				{
+					double	*t	= Tile + 2 * i, *k	= Kernel + 2 * i;
+
+					double	r	= t[0] * k[0] - t[1] * k[1];
+					t[1]		= t[0] * k[1] + t[1] * k[0];
+					t[0]		= r;
+				}
+
+				FFT_2D(Tile, N, true, N);
+
+				//-----------------------------------------
+				// local offsets -R..T+R-1 wrap around N
+
+				for(int v=0; v<N; v++)
+				{
+					int	y	= ty + (v < T + R ? v : v - N) - R;
+
+					if( y >= 0 && y < NY )
+					{
+						for(int u=0; u<N; u++)
+						{
+							int	x	= tx + (u < T + R ? u : u - N) - R;
+
+							double	z	= Tile[2 * (v * (size_t)N + u)];
+
+							if( x >= 0 && x < NX && fabs(z) > Epsilon )
+							{
+								m_pGrid->Add_Value(x, y, z);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	SG_Free(Kernel);
+	SG_Free(Tiles );
+
+	return( true );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
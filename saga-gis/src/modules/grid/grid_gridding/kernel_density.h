@@ -105,7 +105,12 @@ private:
 	CSG_Grid					*m_pGrid;
 
 
-	void						Set_Kernel				(const TSG_Point &Point, double Population);
+	bool						Set_Exact				(const TSG_Point_Z *Points, int nPoints);
+	void						Set_Kernel				(const TSG_Point_Z &Point, int yMin, int yMax);
+
+	bool						Set_Binned				(const TSG_Point_Z *Points, int nPoints, bool bLinear);
+	bool						Set_Convolution			(const double *Bins);
+	int							Get_FFT_Size			(void);
 
 	double						Get_Kernel				(double dx, double dy);
 
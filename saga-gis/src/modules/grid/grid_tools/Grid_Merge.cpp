@@ -79,7 +79,12 @@ CGrid_Merge::CGrid_Merge(void)
 	Set_Author		(SG_T("O.Conrad (c) 2003-12"));
 
 	Set_Description	(_TW(
-		"Mosaicking several grids to a single new one. Formerly known as 'Merge Grids'."
+		"Mosaicking several grids to a single new one. Formerly known as 'Merge Grids'.\n"
+		"The target is processed in tiles, each tile only pulling the input grids overlapping it, "
+		"so that the run time depends on the input cells rather than on the number of inputs times "
+		"the target size. Blending and feathering weights are kept only for the inputs of the "
+		"current strip of tiles. Histogram matching needs the mosaic built from the preceding "
+		"grids and therefore processes the input grids one after the other."
 	));
 
 	//-----------------------------------------------------
@@ -147,6 +152,12 @@ CGrid_Merge::CGrid_Merge(void)
 		), 0
 	);
 
+	Parameters.Add_Value(
+		NULL	, "CACHE"		, _TL("File Cache"),
+		_TL("Write the mosaic to a temporary file cache instead of keeping it in memory."),
+		PARAMETER_TYPE_Bool, false
+	);
+
 	//-----------------------------------------------------
 	m_Grid_Target.Create(&Parameters, true, NULL, "TARGET_");
 }
@@ -196,16 +207,47 @@ bool CGrid_Merge::On_Execute(void)
 		return( false );
 	}
 
+	//-----------------------------------------------------
+	bool	bResult	= Parameters("MATCH")->asInt() ? Set_Mosaic() : Set_Mosaic_Tiled();
+
+	//-----------------------------------------------------
+	m_Weight .Destroy();
+	m_Weights.Destroy();
+
+	return( bResult );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CGrid_Merge::Set_Mosaic(void)
+{
+	m_pMosaic->Assign_NoData();
+
+	switch( m_Overlap )
+	{
+	case 4:	// mean
+	case 6:	// feathering
+		if( !m_Weights.Create(m_pMosaic->Get_System(), m_Overlap == 4 && m_pGrids->Get_Count() < 256 ? SG_DATATYPE_Byte : SG_DATATYPE_Word) )
+		{
+			Error_Set(_TL("could not create weights grid"));
+
+			return( false );
+		}
+		break;
+	}
+
 	//-----------------------------------------------------
 	for(int i=0; i<m_pGrids->Get_Count(); i++)
 	{
 		CSG_Grid	*pGrid	= m_pGrids->asGrid(i);
 
-		Set_Weight(pGrid);
+		Set_Weight(pGrid, m_Weight);
 
-		if( i > 0 && m_Overlap == 6 )
-		{
-		}
+		CSG_Grid	*pWeight	= m_Weight.is_Valid() ? &m_Weight : NULL;
 
 		Get_Match(i > 0 ? pGrid : NULL);
 
@@ -229,7 +271,7 @@ bool CGrid_Merge::On_Execute(void)
 					{
 						if( ax + x >= 0 && !pGrid->is_NoData(x, y) )
 						{
-							Set_Value(ax + x, ay + y, pGrid->asDouble(x, y), Get_Weight(x, y));
+							Set_Value(m_pMosaic, &m_Weights, ax + x, ay + y, pGrid->asDouble(x, y), pWeight ? pWeight->asDouble(x, y) : 1.0);
 						}
 					}
 				}
@@ -256,7 +298,7 @@ bool CGrid_Merge::On_Execute(void)
 				{
 					double	px	= m_pMosaic->Get_XMin() + x * m_pMosaic->Get_Cellsize();
 
-					Set_Value(x, y, pGrid, px, py);
+					Set_Value(m_pMosaic, &m_Weights, x, y, pGrid, pWeight, px, py);
 				}
 			}
 		}
@@ -280,11 +322,271 @@ bool CGrid_Merge::On_Execute(void)
 		}
 	}
 
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define TILE_SIZE	512
+
+//---------------------------------------------------------
+bool CGrid_Merge::Set_Mosaic_Tiled(void)
+{
+	int		nGrids		= m_pGrids->Get_Count();
+	int		NX			= m_pMosaic->Get_NX();
+	int		NY			= m_pMosaic->Get_NY();
+	double	Cellsize	= m_pMosaic->Get_Cellsize();
+
+	int		nStrips		= 1 + (NY - 1) / TILE_SIZE;
+	int		nTiles		= 1 + (NX - 1) / TILE_SIZE;
+
 	//-----------------------------------------------------
-	m_Weight .Destroy();
-	m_Weights.Destroy();
+	// index the input grids by extent: for each grid the
+	// covered range of target cells (plus the offset of an
+	// aligned grid), for each strip of tiles the overlapping
+	// grids in input order
 
-	return( true );
+	int			*Ranges	= new int[6 * nGrids];
+	CSG_Array	*Strips	= new CSG_Array[nStrips];
+
+	for(int iStrip=0; iStrip<nStrips; iStrip++)
+	{
+		Strips[iStrip].Create(sizeof(int), 0, SG_ARRAY_GROWTH_1);
+	}
+
+	for(int i=0; i<nGrids; i++)
+	{
+		CSG_Grid	*pGrid	= m_pGrids->asGrid(i);
+		int			*r		= Ranges + 6 * i;
+
+		if( is_Aligned(pGrid) )
+		{
+			r[4]	= (int)floor(0.5 + (pGrid->Get_XMin() - m_pMosaic->Get_XMin()) / Cellsize);
+			r[5]	= (int)floor(0.5 + (pGrid->Get_YMin() - m_pMosaic->Get_YMin()) / Cellsize);
+
+			r[0]	= r[4];	r[2]	= r[4] + pGrid->Get_NX();
+			r[1]	= r[5];	r[3]	= r[5] + pGrid->Get_NY();
+		}
+		else	// resampled, values are interpolated up to half a source cell beyond the cell centres' extent
+		{
+			double	d	= 0.5 * pGrid->Get_Cellsize();
+
+			r[4]	= r[5]	= 0;
+
+			r[0]	= (int)floor((pGrid->Get_XMin() - d - m_pMosaic->Get_XMin()) / Cellsize);
+			r[1]	= (int)floor((pGrid->Get_YMin() - d - m_pMosaic->Get_YMin()) / Cellsize);
+			r[2]	= (int)ceil ((pGrid->Get_XMax() + d - m_pMosaic->Get_XMin()) / Cellsize) + 1;
+			r[3]	= (int)ceil ((pGrid->Get_YMax() + d - m_pMosaic->Get_YMin()) / Cellsize) + 1;
+		}
+
+		if( r[0] < 0  )	r[0]	= 0;
+		if( r[1] < 0  )	r[1]	= 0;
+		if( r[2] > NX )	r[2]	= NX;
+		if( r[3] > NY )	r[3]	= NY;
+
+		if( r[0] < r[2] && r[1] < r[3] )
+		{
+			for(int iStrip=r[1]/TILE_SIZE; iStrip<=(r[3]-1)/TILE_SIZE; iStrip++)
+			{
+				if( Strips[iStrip].Inc_Array() )
+				{
+					*((int *)Strips[iStrip].Get_Entry(Strips[iStrip].Get_Size() - 1))	= i;
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	// value and weight buffers of one tile for each thread
+
+	int	nBlocks	= M_GET_MAX(1, M_GET_MIN(nTiles, SG_Get_Max_Num_Threads_Omp()));
+
+	CSG_Grid	*Tiles	= new CSG_Grid[2 * nBlocks];
+
+	bool	bResult	= true;
+
+	for(int i=0; i<2*nBlocks && bResult; i++)
+	{
+		bResult	= Tiles[i].Create(SG_DATATYPE_Double, TILE_SIZE, TILE_SIZE, Cellsize);
+	}
+
+	if( !bResult )
+	{
+		Error_Set(_TL("could not create tile buffers"));
+	}
+
+	//-----------------------------------------------------
+	bool		bWeights	= m_Overlap == 5 || m_Overlap == 6;	// blending, feathering
+
+	CSG_Grid	**pWeights	= (CSG_Grid **)SG_Calloc(nGrids, sizeof(CSG_Grid *));
+
+	for(int iStrip=0; bResult && iStrip<nStrips; iStrip++)
+	{
+		if( !Set_Progress(iStrip, nStrips) )	// cancelled
+		{
+			bResult	= false;
+
+			break;
+		}
+
+		int	y0			= iStrip * TILE_SIZE;
+		int	y1			= M_GET_MIN(NY, y0 + TILE_SIZE);
+		int	nSources	= (int)Strips[iStrip].Get_Size();
+		int	*Sources	= (int *)Strips[iStrip].Get_Array();
+
+		//-------------------------------------------------
+		// distance weights of the grids entering this strip
+		for(int i=0; bWeights && i<nSources; i++)
+		{
+			if( !pWeights[Sources[i]] )
+			{
+				pWeights[Sources[i]]	= new CSG_Grid;
+
+				if( !Set_Weight(m_pGrids->asGrid(Sources[i]), *pWeights[Sources[i]]) )
+				{
+					bResult	= false;
+				}
+			}
+		}
+
+		if( !bResult )
+		{
+			break;
+		}
+
+		Process_Set_Text(CSG_String::Format(SG_T("[%d/%d] %s (%d %s)"), iStrip + 1, nStrips, _TL("mosaicking"), nSources, _TL("grids")));
+
+		//-------------------------------------------------
+		#pragma omp parallel for
+		for(int iBlock=0; iBlock<nBlocks; iBlock++)
+		{
+			for(int iTile=nTiles*iBlock/nBlocks; iTile<nTiles*(iBlock+1)/nBlocks; iTile++)
+			{
+				int	x0	= iTile * TILE_SIZE;
+
+				Set_Mosaic_Tile(x0, y0, M_GET_MIN(NX, x0 + TILE_SIZE), y1, nSources, Sources, Ranges, pWeights, Tiles + 2 * iBlock);
+			}
+		}
+
+		//-------------------------------------------------
+		// release the weights of grids not reaching the next strip
+		for(int i=0; bWeights && i<nSources; i++)
+		{
+			if( pWeights[Sources[i]] && (Ranges[6 * Sources[i] + 3] - 1) / TILE_SIZE <= iStrip )
+			{
+				delete(pWeights[Sources[i]]);
+
+				pWeights[Sources[i]]	= NULL;
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	for(int i=0; i<nGrids; i++)
+	{
+		if( pWeights[i] )
+		{
+			delete(pWeights[i]);
+		}
+	}
+
+	SG_Free(pWeights);
+
+	delete[](Tiles );
+	delete[](Strips);
+	delete[](Ranges);
+
+	return( bResult );
+}
+
+//---------------------------------------------------------
+// Mosaics the target cells x0 <= x < x1, y0 <= y < y1 in
+// the thread's tile buffers (pTile[0] values, pTile[1]
+// weights) and writes the result to the target grid.
+//---------------------------------------------------------
+void CGrid_Merge::Set_Mosaic_Tile(int x0, int y0, int x1, int y1, int nSources, const int *Sources, const int *Ranges, CSG_Grid **pWeights, CSG_Grid *pTile)
+{
+	int		x, y;
+
+	pTile[0].Assign_NoData();
+
+	if( m_Overlap == 4 || m_Overlap == 6 )	// mean, feathering
+	{
+		pTile[1].Assign(0.0);
+	}
+
+	//-----------------------------------------------------
+	for(int i=0; i<nSources; i++)
+	{
+		const int	*r	= Ranges + 6 * Sources[i];
+
+		int	ax	= M_GET_MAX(x0, r[0]), bx	= M_GET_MIN(x1, r[2]);
+		int	ay	= M_GET_MAX(y0, r[1]), by	= M_GET_MIN(y1, r[3]);
+
+		if( ax >= bx || ay >= by )
+		{
+			continue;
+		}
+
+		CSG_Grid	*pGrid		= m_pGrids->asGrid(Sources[i]);
+		CSG_Grid	*pWeight	= pWeights[Sources[i]];
+
+		if(	is_Aligned(pGrid) )
+		{
+			for(y=ay; y<by; y++)
+			{
+				int	sy	= y - r[5];
+
+				for(x=ax; x<bx; x++)
+				{
+					int	sx	= x - r[4];
+
+					if( !pGrid->is_NoData(sx, sy) )
+					{
+						Set_Value(pTile, pTile + 1, x - x0, y - y0, pGrid->asDouble(sx, sy), pWeight ? pWeight->asDouble(sx, sy) : 1.0);
+					}
+				}
+			}
+		}
+		else
+		{
+			for(y=ay; y<by; y++)
+			{
+				double	py	= m_pMosaic->Get_YMin() + y * m_pMosaic->Get_Cellsize();
+
+				for(x=ax; x<bx; x++)
+				{
+					double	px	= m_pMosaic->Get_XMin() + x * m_pMosaic->Get_Cellsize();
+
+					Set_Value(pTile, pTile + 1, x - x0, y - y0, pGrid, pWeight, px, py);
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	for(y=y0; y<y1; y++)
+	{
+		for(x=x0; x<x1; x++)
+		{
+			if( pTile[0].is_NoData(x - x0, y - y0) )
+			{
+				m_pMosaic->Set_NoData(x, y);
+			}
+			else if( m_Overlap == 4 )	// mean
+			{
+				m_pMosaic->Set_Value(x, y, pTile[0].asDouble(x - x0, y - y0) / pTile[1].asDouble(x - x0, y - y0));
+			}
+			else
+			{
+				m_pMosaic->Set_Value(x, y, pTile[0].asDouble(x - x0, y - y0));
+			}
+		}
+	}
 }
 
 
@@ -303,6 +605,8 @@ bool CGrid_Merge::Initialize(void)
 	m_pGrids	= Parameters("GRIDS"     )->asGridList();
 	m_dBlend	= Parameters("BLEND_DIST")->asDouble();
 
+	m_Match.Destroy();
+
 	if( m_pGrids->Get_Count() < 2 )
 	{
 		Error_Set(_TL("nothing to do, there are less than two grids in input list."));
@@ -341,27 +645,10 @@ bool CGrid_Merge::Initialize(void)
 	}
 
 	//-----------------------------------------------------
-	if( (m_pMosaic = m_Grid_Target.Get_Grid(Type)) != NULL )
+	if( (m_pMosaic = m_Grid_Target.Get_Grid(Type, Parameters("CACHE")->asBool() ? GRID_MEMORY_Cache : GRID_MEMORY_Normal)) != NULL )
 	{
 		m_pMosaic->Set_Name(_TL("Mosaic"));
 
-		m_pMosaic->Assign_NoData();
-
-		switch( m_Overlap )
-		{
-		case 4:	// mean
-		case 6:	// feathering
-			{
-				if( !m_Weights.Create(m_pMosaic->Get_System(), m_Overlap == 4 && m_pGrids->Get_Count() < 256 ? SG_DATATYPE_Byte : SG_DATATYPE_Word) )
-				{
-					Error_Set(_TL("could not create weights grid"));
-
-					return( false );
-				}
-			}
-			break;
-		}
-
 		return( true );
 	}
 
@@ -412,7 +699,7 @@ bool CGrid_Merge::is_Aligned(CSG_Grid *pGrid)
 }
 
 //---------------------------------------------------------
-inline void CGrid_Merge::Set_Value(int x, int y, double Value, double Weight)
+inline void CGrid_Merge::Set_Value(CSG_Grid *pMosaic, CSG_Grid *pWeights, int x, int y, double Value, double Weight)
 {
 	if( m_Match.Get_N() == 2 )
 	{
@@ -422,61 +709,61 @@ inline void CGrid_Merge::Set_Value(int x, int y, double Value, double Weight)
 	switch( m_Overlap )
 	{
 	case 0:	// first
-		if( m_pMosaic->is_NoData(x, y) )
+		if( pMosaic->is_NoData(x, y) )
 		{
-			m_pMosaic->Set_Value(x, y, Value);
+			pMosaic->Set_Value(x, y, Value);
 		}
 		break;
 
 	case 1:	// last
 		{
-			m_pMosaic->Set_Value(x, y, Value);
+			pMosaic->Set_Value(x, y, Value);
 		}
 		break;
 
 	case 2:	// minimum
-		if( m_pMosaic->is_NoData(x, y) || m_pMosaic->asDouble(x, y) > Value )
+		if( pMosaic->is_NoData(x, y) || pMosaic->asDouble(x, y) > Value )
 		{
-			m_pMosaic->Set_Value(x, y, Value);
+			pMosaic->Set_Value(x, y, Value);
 		}
 		break;
 
 	case 3:	// maximum
-		if( m_pMosaic->is_NoData(x, y) || m_pMosaic->asDouble(x, y) < Value )
+		if( pMosaic->is_NoData(x, y) || pMosaic->asDouble(x, y) < Value )
 		{
-			m_pMosaic->Set_Value(x, y, Value);
+			pMosaic->Set_Value(x, y, Value);
 		}
 		break;
 
 	case 4:	// mean
-		if( m_pMosaic->is_NoData(x, y) )
+		if( pMosaic->is_NoData(x, y) )
 		{
-			m_pMosaic->Set_Value(x, y, Value);
-			m_Weights .Set_Value(x, y, 1);
+			pMosaic->Set_Value(x, y, Value);
+			pWeights->Set_Value(x, y, 1);
 		}
 		else
 		{
-			m_pMosaic->Add_Value(x, y, Value);
-			m_Weights .Add_Value(x, y, 1);
+			pMosaic->Add_Value(x, y, Value);
+			pWeights->Add_Value(x, y, 1);
 		}
 		break;
 
 	case 5:	// blend
-		if( m_pMosaic->is_NoData(x, y) )
+		if( pMosaic->is_NoData(x, y) )
 		{
-			m_pMosaic->Set_Value(x, y, Value);
+			pMosaic->Set_Value(x, y, Value);
 		}
 		else
 		{
-			m_pMosaic->Set_Value(x, y, (1.0 - Weight) * m_pMosaic->asDouble(x, y) + Weight * Value);
+			pMosaic->Set_Value(x, y, (1.0 - Weight) * pMosaic->asDouble(x, y) + Weight * Value);
 		}
 		break;
 
 	case 6:	// feathering
-		if( m_pMosaic->is_NoData(x, y) )
+		if( pMosaic->is_NoData(x, y) )
 		{
-			m_pMosaic->Set_Value(x, y, Value);
-			m_Weights .Set_Value(x, y, Weight);
+			pMosaic->Set_Value(x, y, Value);
+			pWeights->Set_Value(x, y, Weight);
 		}
 		else
 		{
@@ -484,57 +771,57 @@ inline void CGrid_Merge::Set_Value(int x, int y, double Value, double Weight)
 
 			if( d >= 1.0 )
 			{
-				m_pMosaic->Set_Value(x, y, Value);
-				m_Weights .Set_Value(x, y, Weight);
+				pMosaic->Set_Value(x, y, Value);
+				pWeights->Set_Value(x, y, Weight);
 			}
 			else if( d > -1.0 )
 			{
 				d	= 0.5 * (1.0 + d);
 
-				m_pMosaic->Set_Value(x, y, (1.0 - d) * m_pMosaic->asDouble(x, y) + d * Value);
+				pMosaic->Set_Value(x, y, (1.0 - d) * pMosaic->asDouble(x, y) + d * Value);
 
 				if( d > 0.5 )
 				{
-					m_Weights .Set_Value(x, y, Weight);
+					pWeights->Set_Value(x, y, Weight);
 				}
 			}
 		}
 		break;
 
 	case 7:	// feathering
-		if( m_pMosaic->is_NoData(x, y) )
+		if( pMosaic->is_NoData(x, y) )
 		{
-			m_pMosaic->Set_Value(x, y, Weight * Value);
-			m_Weights .Set_Value(x, y, Weight);
+			pMosaic->Set_Value(x, y, Weight * Value);
+			pWeights->Set_Value(x, y, Weight);
 		}
 		else
 		{
-			m_pMosaic->Add_Value(x, y, Weight * Value);
-			m_Weights .Add_Value(x, y, Weight);
+			pMosaic->Add_Value(x, y, Weight * Value);
+			pWeights->Add_Value(x, y, Weight);
 		}
 		break;
 	}
 }
 
 //---------------------------------------------------------
-inline void CGrid_Merge::Set_Value(int x, int y, CSG_Grid *pGrid, double px, double py)
+inline void CGrid_Merge::Set_Value(CSG_Grid *pMosaic, CSG_Grid *pWeights, int x, int y, CSG_Grid *pGrid, CSG_Grid *pWeight, double px, double py)
 {
 	double	z;
 
 	if( pGrid->Get_Value(px, py, z, m_Interpolation) )
 	{
-		if( m_Weight.is_Valid() )
+		if( pWeight )
 		{
 			double	w;
 
-			if( m_Weight.Get_Value(px, py, w, GRID_INTERPOLATION_BSpline, true) )
+			if( pWeight->Get_Value(px, py, w, GRID_INTERPOLATION_BSpline, true) )
 			{
-				Set_Value(x, y, z, w);
+				Set_Value(pMosaic, pWeights, x, y, z, w);
 			}
 		}
 		else
 		{
-			Set_Value(x, y, z, 1.0);
+			Set_Value(pMosaic, pWeights, x, y, z, 1.0);
 		}
 	}
 }
@@ -547,13 +834,7 @@ inline void CGrid_Merge::Set_Value(int x, int y, CSG_Grid *pGrid, double px, dou
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-inline double CGrid_Merge::Get_Weight(int x, int y)
-{
-	return( m_Weight.is_Valid() ? m_Weight.asDouble(x, y) : 1.0 );
-}
-
-//---------------------------------------------------------
-bool CGrid_Merge::Set_Weight(CSG_Grid *pGrid)
+bool CGrid_Merge::Set_Weight(CSG_Grid *pGrid, CSG_Grid &Weight)
 {
 	int	dBlend;
 
@@ -572,9 +853,9 @@ bool CGrid_Merge::Set_Weight(CSG_Grid *pGrid)
 	}
 
 	//-----------------------------------------------------
-	if( !m_Weight.Get_System().is_Equal(pGrid->Get_System()) )
+	if( !Weight.Get_System().is_Equal(pGrid->Get_System()) )
 	{
-		if( !m_Weight.Create(pGrid->Get_System(), dBlend > 0 && dBlend < 255 ? SG_DATATYPE_Byte : SG_DATATYPE_Word) )
+		if( !Weight.Create(pGrid->Get_System(), dBlend > 0 && dBlend < 255 ? SG_DATATYPE_Byte : SG_DATATYPE_Word) )
 		{
 			Error_Set(_TL("could not create distance grid"));
 
@@ -590,9 +871,9 @@ bool CGrid_Merge::Set_Weight(CSG_Grid *pGrid)
 		for(x=0, d=1; x<pGrid->Get_NX(); x++)
 		{
 			if( pGrid->is_NoData(x, y) )
-				m_Weight.Set_Value(x, y, d = 0);
-			else //if( m_Weight.asInt(x, y) > d )
-				m_Weight.Set_Value(x, y, d);
+				Weight.Set_Value(x, y, d = 0);
+			else //if( Weight.asInt(x, y) > d )
+				Weight.Set_Value(x, y, d);
 
 			if( dBlend <= 0 || d < dBlend )	d++;
 		}
@@ -600,11 +881,11 @@ bool CGrid_Merge::Set_Weight(CSG_Grid *pGrid)
 		for(x=pGrid->Get_NX()-1, d=1; x>=0; x--)
 		{
 			if( pGrid->is_NoData(x, y) )
-				m_Weight.Set_Value(x, y, d = 0);
-			else if( m_Weight.asInt(x, y) > d )
-				m_Weight.Set_Value(x, y, d);
+				Weight.Set_Value(x, y, d = 0);
+			else if( Weight.asInt(x, y) > d )
+				Weight.Set_Value(x, y, d);
 			else
-				d	= m_Weight.asInt(x, y);
+				d	= Weight.asInt(x, y);
 
 			if( dBlend <= 0 || d < dBlend )	d++;
 		}
@@ -615,11 +896,11 @@ bool CGrid_Merge::Set_Weight(CSG_Grid *pGrid)
 		for(y=0, d=1; y<pGrid->Get_NY(); y++)
 		{
 			if( pGrid->is_NoData(x, y) )
-				m_Weight.Set_Value(x, y, d = 0);
-			else if( m_Weight.asInt(x, y) > d )
-				m_Weight.Set_Value(x, y, d);
+				Weight.Set_Value(x, y, d = 0);
+			else if( Weight.asInt(x, y) > d )
+				Weight.Set_Value(x, y, d);
 			else
-				d	= m_Weight.asInt(x, y);
+				d	= Weight.asInt(x, y);
 
 			if( dBlend <= 0 || d < dBlend )	d++;
 		}
@@ -627,11 +908,11 @@ bool CGrid_Merge::Set_Weight(CSG_Grid *pGrid)
 		for(y=pGrid->Get_NY()-1, d=1; y>=0; y--)
 		{
 			if( pGrid->is_NoData(x, y) )
-				m_Weight.Set_Value(x, y, d = 0);
-			else if( m_Weight.asInt(x, y) > d )
-				m_Weight.Set_Value(x, y, d);
+				Weight.Set_Value(x, y, d = 0);
+			else if( Weight.asInt(x, y) > d )
+				Weight.Set_Value(x, y, d);
 			else
-				d	= m_Weight.asInt(x, y);
+				d	= Weight.asInt(x, y);
 
 			if( dBlend <= 0 || d < dBlend )	d++;
 		}
@@ -641,11 +922,11 @@ bool CGrid_Merge::Set_Weight(CSG_Grid *pGrid)
 	switch( m_Overlap )
 	{
 	case 5:	// blending
-		m_Weight.Set_Scaling(1.0 / dBlend);	// normalize (0 <= z <= 1)
+		Weight.Set_Scaling(1.0 / dBlend);	// normalize (0 <= z <= 1)
 		break;
 
 	case 6:	// feathering
-		m_Weight.Set_Scaling(m_Weight.Get_Cellsize());
+		Weight.Set_Scaling(Weight.Get_Cellsize());
 		break;
 	}
 
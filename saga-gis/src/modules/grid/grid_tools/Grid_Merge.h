@@ -110,13 +110,16 @@ private:
 
 	bool						Initialize				(void);
 
+	bool						Set_Mosaic				(void);
+	bool						Set_Mosaic_Tiled		(void);
+	void						Set_Mosaic_Tile			(int x0, int y0, int x1, int y1, int nSources, const int *Sources, const int *Ranges, CSG_Grid **pWeights, CSG_Grid *pTile);
+
 	bool						is_Aligned				(CSG_Grid *pGrid);
 
-	void						Set_Value				(int x, int y, double Value, double Weight);
-	void						Set_Value				(int x, int y, CSG_Grid *pGrid, double px, double py);
+	void						Set_Value				(CSG_Grid *pMosaic, CSG_Grid *pWeights, int x, int y, double Value, double Weight);
+	void						Set_Value				(CSG_Grid *pMosaic, CSG_Grid *pWeights, int x, int y, CSG_Grid *pGrid, CSG_Grid *pWeight, double px, double py);
 
-	bool						Set_Weight				(CSG_Grid *pGrid);
-	double						Get_Weight				(int x, int y);
+	bool						Set_Weight				(CSG_Grid *pGrid, CSG_Grid &Weight);
 
 	void						Get_Match				(CSG_Grid *pGrid);
 
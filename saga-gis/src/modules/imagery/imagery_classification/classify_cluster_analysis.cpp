@@ -90,6 +90,19 @@ CGrid_Cluster_Analysis::CGrid_Cluster_Analysis(void)
 		"- Rubin, J. (1967):\n"
 		"  'Optimal Classification into Groups: An Approach for Solving the Taxonomy Problem',\n"
 		"  J. Theoretical Biology, 15:103-144\n\n"
+
+		"k-Means++:\n"
+		"- Arthur, D., Vassilvitskii, S. (2007):\n"
+		"  'k-means++: The Advantages of Careful Seeding',\n"
+		"  Proc. 18th ACM-SIAM Symposium on Discrete Algorithms, 1027-1035\n"
+		"- Hamerly, G. (2010):\n"
+		"  'Making k-means even faster',\n"
+		"  Proc. SIAM International Conference on Data Mining, 130-140\n\n"
+
+		"Mini-Batch k-Means:\n"
+		"- Sculley, D. (2010):\n"
+		"  'Web-Scale K-Means Clustering',\n"
+		"  Proc. 19th International Conference on World Wide Web, 1177-1178\n\n"
 	));
 
 	//-----------------------------------------------------
@@ -114,10 +127,12 @@ CGrid_Cluster_Analysis::CGrid_Cluster_Analysis(void)
 	Parameters.Add_Choice(
 		NULL	, "METHOD"		, _TL("Method"),
 		_TL(""),
-		CSG_String::Format(SG_T("%s|%s|%s|"),
+		CSG_String::Format(SG_T("%s|%s|%s|%s|%s|"),
 			_TL("Iterative Minimum Distance (Forgy 1965)"),
 			_TL("Hill-Climbing (Rubin 1967)"),
-			_TL("Combined Minimum Distance / Hillclimbing") 
+			_TL("Combined Minimum Distance / Hillclimbing"),
+			_TL("k-Means++ (Arthur & Vassilvitskii 2007)"),
+			_TL("Mini-Batch k-Means (Sculley 2010)")
 		), 1
 	);
 
@@ -133,6 +148,12 @@ CGrid_Cluster_Analysis::CGrid_Cluster_Analysis(void)
 		PARAMETER_TYPE_Int, 0, 0, true
 	);
 
+	Parameters.Add_Value(
+		NULL	, "BATCHSIZE"	, _TL("Batch Size"),
+		_TL("number of samples drawn in each iteration of the mini-batch method, chosen automatically if set to zero (default)"),
+		PARAMETER_TYPE_Int, 0, 0, true
+	);
+
 	Parameters.Add_Value(
 		NULL	, "NORMALISE"	, _TL("Normalise"),
 		_TL("Automatically normalise grids by standard deviation before clustering."),
@@ -155,10 +176,14 @@ CGrid_Cluster_Analysis::CGrid_Cluster_Analysis(void)
 //---------------------------------------------------------
 int CGrid_Cluster_Analysis::On_Parameters_Enable(CSG_Parameters *pParameters, CSG_Parameter *pParameter)
 {
-	if( !SG_STR_CMP(pParameter->Get_Identifier(), "OLDVERSION") )
+	if(	!SG_STR_CMP(pParameter->Get_Identifier(), "OLDVERSION")
+	||	!SG_STR_CMP(pParameter->Get_Identifier(), "METHOD"    ) )
 	{
-		pParameters->Set_Enabled("MAXITER"   , pParameter->asBool() == false);
-		pParameters->Set_Enabled("UPDATEVIEW", pParameter->asBool() == true );
+		bool	bOldVersion	= pParameters->Get_Parameter("OLDVERSION")->asBool();
+
+		pParameters->Set_Enabled("MAXITER"   , bOldVersion == false);
+		pParameters->Set_Enabled("UPDATEVIEW", bOldVersion == true );
+		pParameters->Set_Enabled("BATCHSIZE" , bOldVersion == false && pParameters->Get_Parameter("METHOD")->asInt() == 4);
 	}
 
 	return( 1 );
@@ -197,52 +222,85 @@ bool CGrid_Cluster_Analysis::On_Execute(void)
 	//-----------------------------------------------------
 	pCluster->Set_NoData_Value(-1.0);
 
-	for(iElement=0, nElements=0; iElement<Get_NCells() && Set_Progress_NCells(iElement); iElement++)
+	int		y;
+	sLong	*nRow	= (sLong *)SG_Calloc(Get_NY() + 1, sizeof(sLong));	// valid cells per row, turned into row offsets
+
+	for(y=0; y<Get_NY() && Set_Progress(y); y++)
 	{
-		bool	bNoData		= false;
+		sLong	n	= 0;
 
-		for(iFeature=0; iFeature<pGrids->Get_Count() && !bNoData; iFeature++)
+		#pragma omp parallel for reduction(+:n)
+		for(int x=0; x<Get_NX(); x++)
 		{
-			if( pGrids->asGrid(iFeature)->is_NoData(iElement) )
+			bool	bNoData		= false;
+
+			for(int iFeature=0; iFeature<pGrids->Get_Count() && !bNoData; iFeature++)
+			{
+				if( pGrids->asGrid(iFeature)->is_NoData(x, y) )
+				{
+					bNoData	= true;
+				}
+			}
+
+			pCluster->Set_Value(x, y, bNoData ? -1 : 0);
+
+			if( !bNoData )
 			{
-				bNoData	= true;
+				n++;
 			}
 		}
 
-		if( bNoData || !Analysis.Add_Element() )
+		nRow[y + 1]	= nRow[y] + n;
+	}
+
+	nElements	= nRow[Get_NY()];
+
+	if( nElements <= 1 || !Analysis.Set_nElements((int)nElements) )
+	{
+		SG_Free(nRow);
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	CSG_Vector	Mean(pGrids->Get_Count()), Scale(pGrids->Get_Count());
+
+	for(iFeature=0; iFeature<pGrids->Get_Count(); iFeature++)
+	{
+		Mean [iFeature]	= bNormalize ? pGrids->asGrid(iFeature)->Get_Mean  () : 0.0;
+		Scale[iFeature]	= bNormalize ? pGrids->asGrid(iFeature)->Get_StdDev() : 1.0;
+
+		if( Scale[iFeature] == 0.0 )
 		{
-			pCluster->Set_Value(iElement, -1);
+			Scale[iFeature]	= 1.0;
 		}
-		else
-		{
-			pCluster->Set_Value(iElement, 0);
+	}
 
-			for(iFeature=0; iFeature<pGrids->Get_Count(); iFeature++)
+	#pragma omp parallel for	// each row knows its first element, so rows can be processed independently
+	for(y=0; y<Get_NY(); y++)
+	{
+		for(int x=0, iElement=(int)nRow[y]; x<Get_NX(); x++)
+		{
+			if( !pCluster->is_NoData(x, y) )
 			{
-				double	d	= pGrids->asGrid(iFeature)->asDouble(iElement);
-
-				if( bNormalize )
+				for(int iFeature=0; iFeature<pGrids->Get_Count(); iFeature++)
 				{
-					d	= (d - pGrids->asGrid(iFeature)->Get_Mean()) / pGrids->asGrid(iFeature)->Get_StdDev();
+					Analysis.Set_Feature(iElement, iFeature, (pGrids->asGrid(iFeature)->asDouble(x, y) - Mean[iFeature]) / Scale[iFeature]);
 				}
 
-				Analysis.Set_Feature(nElements, iFeature, d);
+				iElement++;
 			}
-
-			nElements++;
 		}
 	}
 
-	if( nElements <= 1 )
-	{
-		return( false );
-	}
+	SG_Free(nRow);
 
 	//-----------------------------------------------------
 	bool	bResult	= Analysis.Execute(
-		Parameters("METHOD"  )->asInt(),
-		Parameters("NCLUSTER")->asInt(),
-		Parameters("MAXITER" )->asInt()
+		Parameters("METHOD"   )->asInt(),
+		Parameters("NCLUSTER" )->asInt(),
+		Parameters("MAXITER"  )->asInt(),
+		Parameters("BATCHSIZE")->asInt()
 	);
 
 	for(iElement=0, nElements=0; iElement<Get_NCells(); iElement++)
@@ -391,6 +449,14 @@ bool CGrid_Cluster_Analysis::_On_Execute(void)
 	CSG_Grid				**Grids, *pCluster;
 	CSG_Parameter_Grid_List	*pGrids;
 
+	//-----------------------------------------------------
+	if( Parameters("METHOD")->asInt() > 2 )
+	{
+		Error_Set(_TL("k-means++ and mini-batch k-means are not supported by the old version"));
+
+		return( false );
+	}
+
 	//-----------------------------------------------------
 	pGrids		= Parameters("GRIDS")	->asGridList();
 	pCluster	= Parameters("CLUSTER")	->asGrid();
@@ -436,7 +502,7 @@ bool CGrid_Cluster_Analysis::_On_Execute(void)
 	//-------------------------------------------------
 	switch( Parameters("METHOD")->asInt() )
 	{
-	case 0:		SP	= _MinimumDistance	(Grids, pGrids->Get_Count(), pCluster, nCluster, nMembers, Variances, Centroids, nElements = Get_NCells());	break;
+	default:	SP	= _MinimumDistance	(Grids, pGrids->Get_Count(), pCluster, nCluster, nMembers, Variances, Centroids, nElements = Get_NCells());	break;
 	case 1:		SP	= _HillClimbing		(Grids, pGrids->Get_Count(), pCluster, nCluster, nMembers, Variances, Centroids, nElements = Get_NCells());	break;
 	case 2:		SP	= _MinimumDistance	(Grids, pGrids->Get_Count(), pCluster, nCluster, nMembers, Variances, Centroids, nElements = Get_NCells());
 				SP	= _HillClimbing		(Grids, pGrids->Get_Count(), pCluster, nCluster, nMembers, Variances, Centroids, nElements = Get_NCells());	break;
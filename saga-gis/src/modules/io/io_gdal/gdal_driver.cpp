@@ -267,6 +267,11 @@ bool CSG_GDAL_DataSet::Open_Read(const CSG_String &File_Name)
 	m_NX		= m_pDataSet->GetRasterXSize();
 	m_NY		= m_pDataSet->GetRasterYSize();
 
+	m_Overview	= -1;
+	m_bVirtual	= false;
+
+	Del_Read_Window();
+
 	if( m_pDataSet->GetGeoTransform(Transform) != CE_None )
 	{
 		m_bTransform	= false;
@@ -663,6 +668,150 @@ bool CSG_GDAL_DataSet::Get_MetaData_Item(int i, const char *pszName, CSG_String
 	return( false );
 }
 
+//---------------------------------------------------------
+int CSG_GDAL_DataSet::Get_Overview_Count(int i)	const
+{
+	GDALRasterBand	*pBand	= m_pDataSet ? m_pDataSet->GetRasterBand(i + 1) : NULL;
+
+	return( pBand ? pBand->GetOverviewCount() : 0 );
+}
+
+//---------------------------------------------------------
+/**
+  * Overview (reduced resolution) level to be read by Read(),
+  * -1 for full resolution. Not supported for datasets that
+  * need to be transformed.
+*/
+bool CSG_GDAL_DataSet::Set_Read_Overview(int Overview)
+{
+	if( !is_Reading() || (Overview >= 0 && (m_bTransform || Overview >= Get_Overview_Count(0))) )
+	{
+		return( false );
+	}
+
+	m_Overview	= Overview < 0 ? -1 : Overview;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+  * Restricts Read() to the cells intersecting Extent. Not
+  * supported for datasets that need to be transformed.
+*/
+bool CSG_GDAL_DataSet::Set_Read_Window(const CSG_Rect &Extent)
+{
+	if( !is_Reading() || m_bTransform )
+	{
+		return( false );
+	}
+
+	double	xLeft	= Get_xMin() - 0.5 * Get_Cellsize();
+	double	yTop	= Get_yMax() - 0.5 * Get_Cellsize();
+
+	int	ax	= (int)floor((Extent.Get_XMin() - xLeft) / Get_Cellsize());	if( ax <  0     )	ax	= 0;
+	int	bx	= (int)ceil ((Extent.Get_XMax() - xLeft) / Get_Cellsize());	if( bx >  m_NX )	bx	= m_NX;
+	int	ay	= (int)floor((yTop - Extent.Get_YMax()) / Get_Cellsize());	if( ay <  0     )	ay	= 0;
+	int	by	= (int)ceil ((yTop - Extent.Get_YMin()) / Get_Cellsize());	if( by >  m_NY )	by	= m_NY;
+
+	if( ax >= bx || ay >= by )
+	{
+		return( false );
+	}
+
+	m_Window[0]	= ax;	m_Window[2]	= bx - ax;
+	m_Window[1]	= ay;	m_Window[3]	= by - ay;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+void CSG_GDAL_DataSet::Del_Read_Window(void)
+{
+	m_Window[0]	= 0;	m_Window[2]	= m_NX;
+	m_Window[1]	= 0;	m_Window[3]	= m_NY;
+}
+
+//---------------------------------------------------------
+/**
+  * If on, Read() creates virtual grids, which read their rows
+  * on demand from the dataset. Only supported for datasets
+  * that do not need to be transformed and bands whose data
+  * type is supported natively.
+*/
+bool CSG_GDAL_DataSet::Set_Read_Virtual(bool bOn)
+{
+	if( !is_Reading() || (bOn && (m_bTransform || m_File_Name.is_Empty())) )
+	{
+		return( false );
+	}
+
+	m_bVirtual	= bOn;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+GDALRasterBand * CSG_GDAL_DataSet::_Get_Read_Band(GDALDataset *pDataSet, int i)	const
+{
+	GDALRasterBand	*pBand	= pDataSet->GetRasterBand(i + 1);
+
+	if( pBand && m_Overview >= 0 )
+	{
+		pBand	= pBand->GetOverview(m_Overview);
+	}
+
+	return( pBand );
+}
+
+//---------------------------------------------------------
+// Rows transferred with one RasterIO call, a multiple of
+// the band's natural block height to use GDAL's block cache.
+int CSG_GDAL_DataSet::_Get_Strip_Rows(GDALRasterBand *pBand)	const
+{
+	int	bx, by;
+
+	pBand->GetBlockSize(&bx, &by);
+
+	if( by < 1 )
+	{
+		by	= 1;
+	}
+
+	return( by < 64 ? by * (64 / by) : by );
+}
+
+//---------------------------------------------------------
+// Rows of a virtual grid, read from a dataset handle of its own.
+//---------------------------------------------------------
+class CSG_GDAL_Line_Provider : public CSG_Grid_Line_Provider
+{
+public:
+	CSG_GDAL_Line_Provider(GDALDataset *pDataSet, GDALRasterBand *pBand, int xOff, int yOff, int NX, int NY)
+		: m_pDataSet(pDataSet), m_pBand(pBand), m_xOff(xOff), m_yOff(yOff), m_NX(NX), m_NY(NY)
+	{}
+
+	virtual ~CSG_GDAL_Line_Provider(void)
+	{
+		GDALClose(m_pDataSet);
+	}
+
+	virtual bool				Read_Line		(int y, void *Data)
+	{
+		return( m_pBand->RasterIO(GF_Read, m_xOff, m_yOff + m_NY - 1 - y, m_NX, 1, Data, m_NX, 1, m_pBand->GetRasterDataType(), 0, 0) == CE_None );
+	}
+
+
+private:
+
+	GDALDataset					*m_pDataSet;
+
+	GDALRasterBand				*m_pBand;
+
+	int							m_xOff, m_yOff, m_NX, m_NY;
+
+};
+
 //---------------------------------------------------------
 CSG_Grid * CSG_GDAL_DataSet::Read(int i)
 {
@@ -673,19 +822,52 @@ CSG_Grid * CSG_GDAL_DataSet::Read(int i)
 	}
 
 	//-------------------------------------------------
-	GDALRasterBand	*pBand	= m_pDataSet->GetRasterBand(i + 1);
+	GDALRasterBand	*pBand	= _Get_Read_Band(m_pDataSet, i);
 
 	if( !pBand )
 	{
 		return( NULL );
 	}
 
+	//-------------------------------------------------
+	// window in pixels of the band or overview to be read
+
+	double	dx	= (double)pBand->GetXSize() / m_NX;
+	double	dy	= (double)pBand->GetYSize() / m_NY;
+
+	int	xOff	= (int)(m_Window[0] * dx), NX = (int)(m_Window[2] * dx + 0.5);	if( NX < 1 )	NX	= 1;	if( xOff + NX > pBand->GetXSize() )	NX	= pBand->GetXSize() - xOff;
+	int	yOff	= (int)(m_Window[1] * dy), NY = (int)(m_Window[3] * dy + 0.5);	if( NY < 1 )	NY	= 1;	if( yOff + NY > pBand->GetYSize() )	NY	= pBand->GetYSize() - yOff;
+
+	double	Cellsize	= Get_Cellsize() / dx;
+	double	xMin		= Get_xMin() + Cellsize * (xOff + 0.5) - 0.5 * Get_Cellsize();
+	double	yMin		= Get_yMax() - Cellsize * (yOff + NY - 0.5) - 0.5 * Get_Cellsize();
+
 	//-------------------------------------------------
 	TSG_Data_Type	Type	= gSG_GDAL_Drivers.Get_SAGA_Type(pBand->GetRasterDataType());
 
-	CSG_Grid	*pGrid	= SG_Create_Grid(Type, Get_NX(), Get_NY(), Get_Cellsize(), Get_xMin(), Get_yMin());
+	CSG_Grid	*pGrid	= NULL;
 
-	if( !pGrid )
+	if( m_bVirtual && Type != SG_DATATYPE_Bit && gSG_GDAL_Drivers.Get_GDAL_Type(Type) == pBand->GetRasterDataType() )
+	{
+		GDALDataset		*pDataSet	= (GDALDataset *)GDALOpen(m_File_Name, GA_ReadOnly);
+		GDALRasterBand	*pVirtual	= pDataSet ? _Get_Read_Band(pDataSet, i) : NULL;
+
+		if( pVirtual )
+		{
+			pGrid	= new CSG_Grid;
+
+			if( !pGrid->Create(CSG_Grid_System(Cellsize, xMin, yMin, NX, NY), Type, new CSG_GDAL_Line_Provider(pDataSet, pVirtual, xOff, yOff, NX, NY)) )
+			{
+				delete(pGrid);	pGrid	= NULL;	// the provider has been deleted by the grid
+			}
+		}
+		else if( pDataSet )
+		{
+			GDALClose(pDataSet);
+		}
+	}
+
+	if( !pGrid && (pGrid = SG_Create_Grid(Type, NX, NY, Cellsize, xMin, yMin)) == NULL )
 	{
 		return( NULL );
 	}
@@ -712,24 +894,92 @@ CSG_Grid * CSG_GDAL_DataSet::Read(int i)
 
 	Get_MetaData(i, pGrid->Get_MetaData());
 
+	if( pGrid->is_Virtual() )
+	{
+		return( pGrid );
+	}
+
 	//-------------------------------------------------
-	double	*zLine	= (double *)SG_Malloc(Get_NX() * sizeof(double));
+	// Rows are read in strips aligned to the band's blocks.
+	// If the grid is held in memory the values are copied in
+	// their native data type and the strips are decoded in
+	// parallel, each thread with its own dataset handle.
+
+	bool	bMemory	= pGrid->Get_Line_Data(0) != NULL;
 
-	for(int y=0; y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++)
+	bool	bNative	= bMemory && Type != SG_DATATYPE_Bit && gSG_GDAL_Drivers.Get_GDAL_Type(Type) == pBand->GetRasterDataType();
+
+	int		nBytes	= bNative ? pGrid->Get_nValueBytes() : (int)sizeof(double);
+
+	int		nRows	= _Get_Strip_Rows(pBand);
+	int		iStrip	= yOff / nRows;
+	int		nStrips	= (yOff + NY - 1) / nRows - iStrip + 1;
+
+	int		k, nHandles	= bMemory && !m_File_Name.is_Empty() ? M_GET_MIN(SG_Get_Max_Num_Threads_Omp(), nStrips) : 1;
+
+	GDALDataset		**pDataSets	= (GDALDataset    **)SG_Calloc(nHandles, sizeof(GDALDataset    *));
+	GDALRasterBand	**pBands	= (GDALRasterBand **)SG_Calloc(nHandles, sizeof(GDALRasterBand *));
+
+	for(k=0, pBands[0]=pBand; k+1<nHandles; k++)
 	{
-		int	yy	= m_bTransform ? y : Get_NY() - 1 - y;
+		if( (pDataSets[k + 1] = (GDALDataset *)GDALOpen(m_File_Name, GA_ReadOnly)) == NULL
+		||  (pBands   [k + 1] = _Get_Read_Band(pDataSets[k + 1], i)) == NULL )
+		{
+			break;
+		}
+	}
+
+	nHandles	= k + 1;
 
-		if( pBand->RasterIO(GF_Read, 0, y, Get_NX(), 1, zLine, Get_NX(), 1, GDT_Float64, 0, 0) == CE_None )
+	char	*Buffer	= (char *)SG_Malloc(nHandles * (size_t)nRows * NX * nBytes);
+
+	//-------------------------------------------------
+	for(int jStrip=0; jStrip<nStrips && SG_UI_Process_Set_Progress(jStrip, nStrips); jStrip+=nHandles)
+	{
+		#pragma omp parallel for
+		for(int k=0; k<nHandles; k++)
 		{
-			for(int x=0; x<Get_NX(); x++)
+			if( jStrip + k < nStrips )
 			{
-			//	double	NaN	= 0.0;	NaN	= -1.0 / NaN;	if( NaN == zLine[x] )	pGrid->Set_NoData(x, yy); else
-				pGrid->Set_Value(x, yy, zLine[x], false);
+				int	y0	= (iStrip + jStrip + k    ) * nRows;	if( y0 < yOff      )	y0	= yOff;
+				int	y1	= (iStrip + jStrip + k + 1) * nRows;	if( y1 > yOff + NY )	y1	= yOff + NY;
+
+				char	*pStrip	= Buffer + k * (size_t)nRows * NX * nBytes;
+
+				if( pBands[k]->RasterIO(GF_Read, xOff, y0, NX, y1 - y0, pStrip, NX, y1 - y0, bNative ? pBand->GetRasterDataType() : GDT_Float64, 0, 0) == CE_None )
+				{
+					for(int y=y0; y<y1; y++, pStrip+=(size_t)NX * nBytes)
+					{
+						int	yy	= m_bTransform ? y - yOff : NY - 1 - (y - yOff);
+
+						if( bNative )
+						{
+							memcpy(pGrid->Get_Line_Data(yy), pStrip, (size_t)NX * nBytes);
+						}
+						else for(int x=0; x<NX; x++)
+						{
+							pGrid->Set_Value(x, yy, ((double *)pStrip)[x], false);
+						}
+					}
+				}
 			}
 		}
 	}
 
-	SG_Free(zLine);
+	//-------------------------------------------------
+	for(k=1; k<nHandles; k++)
+	{
+		GDALClose(pDataSets[k]);
+	}
+
+	SG_Free(pDataSets);
+	SG_Free(pBands   );
+	SG_Free(Buffer   );
+
+	if( bNative )
+	{
+		pGrid->Set_Modified();
+	}
 
 	return( pGrid );
 }
@@ -745,21 +995,65 @@ bool CSG_GDAL_DataSet::Write(int i, CSG_Grid *pGrid, double noDataValue)
 	GDALRasterBand	*pBand	= m_pDataSet->GetRasterBand(i + 1);
 
 	//-----------------------------------------------------
-	CPLErr	Error	= CE_None;
+	// Rows are written in strips aligned to the band's blocks.
+	// Values are copied in their native data type, if the band
+	// has the grid's type, the grid is held in memory and no
+	// scaling or no-data translation is needed.
+
+	bool	bMemory	= pGrid->Get_Line_Data(0) != NULL;
+
+	bool	bNative	= bMemory && pGrid->Get_Type() != SG_DATATYPE_Bit && !pGrid->is_Scaled()
+		&&	gSG_GDAL_Drivers.Get_GDAL_Type(pGrid->Get_Type()) == pBand->GetRasterDataType()
+		&&	pGrid->Get_NoData_Value() == noDataValue && pGrid->Get_NoData_hiValue() == noDataValue;
+
+	bool	bFloat	= pGrid->Get_Type() == SG_DATATYPE_Float || pGrid->Get_Type() == SG_DATATYPE_Double;
+
+	int		nBytes	= bNative ? pGrid->Get_nValueBytes() : (int)sizeof(double);
+
+	int		nRows	= _Get_Strip_Rows(pBand);
 
-	double	*zLine	= (double *)SG_Malloc(Get_NX() * sizeof(double));
+	char	*Buffer	= (char *)SG_Malloc((size_t)nRows * Get_NX() * nBytes);
 
-	for(int y=0, yy=Get_NY()-1; Error==CE_None && y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++, yy--)
+	CPLErr	Error	= CE_None;
+
+	for(int y0=0; Error==CE_None && y0<Get_NY() && SG_UI_Process_Set_Progress(y0, Get_NY()); y0+=nRows)
 	{
-		for(int x=0; x<Get_NX(); x++)
+		int	y1	= y0 + nRows < Get_NY() ? y0 + nRows : Get_NY();
+
+		#pragma omp parallel for if( bMemory )
+		for(int y=y0; y<y1; y++)
 		{
-			zLine[x]	= pGrid->is_NoData(x, yy) ? noDataValue : pGrid->asDouble(x, yy);
+			int		yy		= Get_NY() - 1 - y;
+			char	*pLine	= Buffer + (size_t)(y - y0) * Get_NX() * nBytes;
+
+			if( bNative )
+			{
+				memcpy(pLine, pGrid->Get_Line_Data(yy), (size_t)Get_NX() * nBytes);
+
+				if( bFloat )	// NaN is no-data, too
+				{
+					for(int x=0; x<Get_NX(); x++)
+					{
+						if( pGrid->Get_Type() == SG_DATATYPE_Float ? SG_is_NaN(((float *)pLine)[x]) : SG_is_NaN(((double *)pLine)[x]) )
+						{
+							if( pGrid->Get_Type() == SG_DATATYPE_Float )
+								((float  *)pLine)[x]	= (float)noDataValue;
+							else
+								((double *)pLine)[x]	= noDataValue;
+						}
+					}
+				}
+			}
+			else for(int x=0; x<Get_NX(); x++)
+			{
+				((double *)pLine)[x]	= pGrid->is_NoData(x, yy) ? noDataValue : pGrid->asDouble(x, yy);
+			}
 		}
 
-		Error	= pBand->RasterIO(GF_Write, 0, y, Get_NX(), 1, zLine, Get_NX(), 1, GDT_Float64, 0, 0);
+		Error	= pBand->RasterIO(GF_Write, 0, y0, Get_NX(), y1 - y0, Buffer, Get_NX(), y1 - y0, bNative ? pBand->GetRasterDataType() : GDT_Float64, 0, 0);
 	}
 
-	SG_Free(zLine);
+	SG_Free(Buffer);
 
 	//-----------------------------------------------------
 	if( Error != CE_None )
@@ -163,6 +163,13 @@ public:
 	bool						Get_MetaData		(int i, CSG_MetaData &MetaData)	const;
 	const char *				Get_MetaData_Item	(int i, const char *pszName)	const;
 	bool						Get_MetaData_Item	(int i, const char *pszName, CSG_String &MetaData)	const;
+	int							Get_Overview_Count	(int i)	const;
+
+	bool						Set_Read_Overview	(int Overview);
+	bool						Set_Read_Window		(const CSG_Rect &Extent);
+	void						Del_Read_Window		(void);
+	bool						Set_Read_Virtual	(bool bOn);
+
 	CSG_Grid *					Read				(int i);
 	bool						Write				(int i, CSG_Grid *pGrid, double NoDataValue);
 	bool						Write				(int i, CSG_Grid *pGrid);
@@ -170,9 +177,9 @@ public:
 
 private:
 
-	bool						m_bTransform;
+	bool						m_bTransform, m_bVirtual;
 
-	int							m_Access, m_NX, m_NY;
+	int							m_Access, m_NX, m_NY, m_Overview, m_Window[4];
 
 	double						m_xMin, m_yMin, m_Cellsize;
 
@@ -185,6 +192,11 @@ private:
 	class GDALDataset			*m_pDataSet;
 
 
+	class GDALRasterBand *		_Get_Read_Band		(class GDALDataset *pDataSet, int i)	const;
+
+	int							_Get_Strip_Rows		(class GDALRasterBand *pBand)			const;
+
+
 public:
 
 	bool						to_World			(double x, double y, double &xWorld, double &yWorld)
@@ -147,6 +147,30 @@ CGDAL_Import::CGDAL_Import(void)
 		), 4
 	);
 
+	//-----------------------------------------------------
+	Parameters.Add_Value(
+		NULL	, "OVERVIEW"	, _TL("Overview Level"),
+		_TL("read a reduced resolution overview instead of the full resolution data (zero), if the dataset provides overviews"),
+		PARAMETER_TYPE_Int, 0, 0, true
+	);
+
+	pNode	= Parameters.Add_Value(
+		NULL	, "WINDOW"		, _TL("Sub-Extent"),
+		_TL("only read the cells intersecting the given extent"),
+		PARAMETER_TYPE_Bool, false
+	);
+
+	Parameters.Add_Value(pNode, "XMIN", _TL("Left"  ), _TL(""), PARAMETER_TYPE_Double, 0.0);
+	Parameters.Add_Value(pNode, "XMAX", _TL("Right" ), _TL(""), PARAMETER_TYPE_Double, 0.0);
+	Parameters.Add_Value(pNode, "YMIN", _TL("Bottom"), _TL(""), PARAMETER_TYPE_Double, 0.0);
+	Parameters.Add_Value(pNode, "YMAX", _TL("Top"   ), _TL(""), PARAMETER_TYPE_Double, 0.0);
+
+	Parameters.Add_Value(
+		NULL	, "VIRTUAL"		, _TL("Read on Demand"),
+		_TL("rows are read from the file when they are accessed instead of loading the complete band, not available for datasets that need to be transformed"),
+		PARAMETER_TYPE_Bool, false
+	);
+
 	//-----------------------------------------------------
 	Add_Parameters("SELECTION", _TL("Select from Multiple Bands"), _TL(""));
 }
@@ -166,6 +190,14 @@ int CGDAL_Import::On_Parameters_Enable(CSG_Parameters *pParameters, CSG_Paramete
 		pParameters->Get_Parameter("INTERPOL")->Set_Enabled(pParameter->asBool());
 	}
 
+	if(	!SG_STR_CMP(pParameter->Get_Identifier(), "WINDOW") )
+	{
+		pParameters->Get_Parameter("XMIN")->Set_Enabled(pParameter->asBool());
+		pParameters->Get_Parameter("XMAX")->Set_Enabled(pParameter->asBool());
+		pParameters->Get_Parameter("YMIN")->Set_Enabled(pParameter->asBool());
+		pParameters->Get_Parameter("YMAX")->Set_Enabled(pParameter->asBool());
+	}
+
 	if( !SG_STR_CMP(pParameters->Get_Identifier(), "SELECTION")
 	&&  !SG_STR_CMP(pParameter ->Get_Identifier(), "ALL") && pParameters->Get_Parameter("BANDS") )
 	{
@@ -364,6 +396,24 @@ bool CGDAL_Import::Load(CSG_GDAL_DataSet &DataSet, const CSG_String &Name)
 
 	bool	bTransform	= Parameters("TRANSFORM")->asBool() && DataSet.Needs_Transformation();
 
+	//-----------------------------------------------------
+	if( Parameters("OVERVIEW")->asInt() > 0 && !DataSet.Set_Read_Overview(Parameters("OVERVIEW")->asInt() - 1) )
+	{
+		Message_Add(CSG_String::Format("\n%s: %s", _TL("Warning"), _TL("overview level not available, reading full resolution")), false);
+	}
+
+	if( Parameters("WINDOW")->asBool() && !DataSet.Set_Read_Window(CSG_Rect(
+		Parameters("XMIN")->asDouble(), Parameters("YMIN")->asDouble(),
+		Parameters("XMAX")->asDouble(), Parameters("YMAX")->asDouble())) )
+	{
+		Message_Add(CSG_String::Format("\n%s: %s", _TL("Warning"), _TL("sub-extent does not intersect dataset or dataset needs transformation, reading complete dataset")), false);
+	}
+
+	if( (Parameters("VIRTUAL")->asBool() || SG_Grid_Cache_Get_Virtual()) && !DataSet.Set_Read_Virtual(true) && Parameters("VIRTUAL")->asBool() )
+	{
+		Message_Add(CSG_String::Format("\n%s: %s", _TL("Warning"), _TL("dataset needs transformation, reading complete dataset")), false);
+	}
+
 	//-----------------------------------------------------
 	for(i=0, n=0; i<DataSet.Get_Count() && Process_Get_Okay(); i++)
 	{
@@ -331,7 +331,39 @@ bool CGrid_Export::On_Execute(void)
 		//-------------------------------------------------
 		Grid.Create(*Get_System(), SG_DATATYPE_Int);
 
-		for(y=0, iy=Get_NY()-1; y<Get_NY() && Set_Progress(y); y++, iy--)
+		if( Method <= 2 )	// stretched colours are drawn by the grid renderer
+		{
+			CSG_Array	Buffer(sizeof(int), Get_NX() * Get_NY());
+
+			int	*Image	= (int *)Buffer.Get_Array();
+
+			for(int i=0; i<Get_NX()*Get_NY(); i++)
+			{
+				Image[i]	= -1;	// no data
+			}
+
+			CSG_Grid_Renderer	Renderer;
+
+			Renderer.Set_Grid  (pGrid);
+			Renderer.Set_Colors(Colors, zMin, zMin + Colors.Get_Count() / zScale);
+			Renderer.Draw      (Image, Get_NX(), Get_NY(), pGrid->Get_Extent(true));
+
+			for(y=0; y<Get_NY() && Set_Progress(y); y++)
+			{
+				for(int x=0; x<Get_NX(); x++, Image++)
+				{
+					if( *Image < 0 )
+					{
+						Grid.Set_NoData(x, y);
+					}
+					else
+					{
+						Grid.Set_Value(x, y, *Image);
+					}
+				}
+			}
+		}
+		else for(y=0, iy=Get_NY()-1; y<Get_NY() && Set_Progress(y); y++, iy--)
 		{
 			#pragma omp parallel for
 			for(int x=0; x<Get_NX(); x++)
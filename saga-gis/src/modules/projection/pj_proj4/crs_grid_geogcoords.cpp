@@ -127,28 +127,60 @@ bool CCRS_Grid_GeogCoords::On_Execute(void)
 	CSG_Grid	*pLon	= Parameters("LON")->asGrid();
 	CSG_Grid	*pLat	= Parameters("LAT")->asGrid();
 
-	for(int y=0; y<Get_NY() && Set_Progress(y); y++)
+	//-----------------------------------------------------
+	// cell coordinates are transformed in batches of rows,
+	// which are projected in parallel
+
+	int		nRows	= M_GET_MAX(1, M_GET_MIN(Get_NY(), 0x100000 / Get_NX()));
+	double	*x		= (double *)SG_Malloc(2 * nRows * Get_NX() * sizeof(double));
+
+	if( !x )
 	{
-		double	yWorld	= Get_YMin() + y * Get_Cellsize();
+		Error_Set(_TL("failed to allocate memory"));
 
-		#pragma omp parallel for
-		for(int x=0; x<Get_NX(); x++)
+		return( false );
+	}
+
+	double	*y		= x + nRows * Get_NX();
+
+	for(int y0=0; y0<Get_NY() && Set_Progress(y0); y0+=nRows)
+	{
+		int	n	= M_GET_MIN(nRows, Get_NY() - y0);
+
+		for(int iy=0, i=0; iy<n; iy++)
 		{
-			CSG_Point	p(Get_XMin() + x * Get_Cellsize(), yWorld);
+			double	yWorld	= Get_YMin() + (y0 + iy) * Get_Cellsize();
 
-			if( Projector.Get_Projection(p) )
+			for(int ix=0; ix<Get_NX(); ix++, i++)
 			{
-				pLon->Set_Value(x, y, p.Get_X());
-				pLat->Set_Value(x, y, p.Get_Y());
+				x[i]	= Get_XMin() + ix * Get_Cellsize();
+				y[i]	= yWorld;
 			}
-			else
+		}
+
+		Projector.Get_Projections(n * Get_NX(), x, y, NULL, true);
+
+		#pragma omp parallel for
+		for(int iy=0; iy<n; iy++)
+		{
+			for(int ix=0, i=iy*Get_NX(); ix<Get_NX(); ix++, i++)
 			{
-				pLon->Set_NoData(x, y);
-				pLat->Set_NoData(x, y);
+				if( x[i] != HUGE_VAL )
+				{
+					pLon->Set_Value(ix, y0 + iy, x[i]);
+					pLat->Set_Value(ix, y0 + iy, y[i]);
+				}
+				else
+				{
+					pLon->Set_NoData(ix, y0 + iy);
+					pLat->Set_NoData(ix, y0 + iy);
+				}
 			}
 		}
 	}
 
+	SG_Free(x);
+
 	//-----------------------------------------------------
 	return( true );
 }
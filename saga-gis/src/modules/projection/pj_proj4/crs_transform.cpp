@@ -86,12 +86,19 @@ CSG_CRSProjector::CSG_CRSProjector(void)
 	m_pSource	= NULL;
 	m_pTarget	= NULL;
 	m_pGCS		= NULL;
+
+	m_pContext	= pj_ctx_alloc();	// each projector has its own context, so that projectors can be used concurrently
 }
 
 //---------------------------------------------------------
 CSG_CRSProjector::~CSG_CRSProjector(void)
 {
 	Destroy();
+
+	if( m_pContext )
+	{
+		pj_ctx_free((projCtx)m_pContext);
+	}
 }
 
 //---------------------------------------------------------
@@ -106,6 +113,38 @@ bool CSG_CRSProjector::Destroy(void)
 	return( true );
 }
 
+//---------------------------------------------------------
+// Initializes an independent copy of the given projector.
+// Proj.4 projections must not be shared among threads, so
+// each thread uses its own copy.
+//---------------------------------------------------------
+bool CSG_CRSProjector::Create(const CSG_CRSProjector &Projector)
+{
+	Destroy();
+
+	if( !Projector.m_pSource || !Projector.m_pTarget )
+	{
+		return( false );
+	}
+
+	if( !_Set_Projection(Projector.m_Source, &m_pSource,  true) || !m_Source.Create(Projector.m_Source)
+	||  !_Set_Projection(Projector.m_Target, &m_pTarget, false) || !m_Target.Create(Projector.m_Target) )
+	{
+		Destroy();
+
+		return( false );
+	}
+
+	if( (Projector.m_bInverse && !Set_Inverse(true)) || !Set_Precise_Mode(Projector.Get_Precise_Mode()) )
+	{
+		Destroy();
+
+		return( false );
+	}
+
+	return( true );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -145,9 +184,9 @@ bool CSG_CRSProjector::_Set_Projection(const CSG_Projection &Projection, void **
 	PROJ4_FREE(*ppProjection);
 
 	//-------------------------------------------------
-	if( (*ppProjection = pj_init_plus(Projection.Get_Proj4())) == NULL )
+	if( (*ppProjection = pj_init_plus_ctx((projCtx)m_pContext, Projection.Get_Proj4())) == NULL )
 	{
-		SG_UI_Msg_Add_Error(CSG_String::Format(SG_T("Proj4 [%s]: %s"), _TL("initialization"), SG_STR_MBTOSG(pj_strerrno(pj_errno))));
+		SG_UI_Msg_Add_Error(CSG_String::Format(SG_T("Proj4 [%s]: %s"), _TL("initialization"), SG_STR_MBTOSG(pj_strerrno(pj_ctx_get_errno((projCtx)m_pContext)))));
 
 		return( false );
 	}
@@ -215,7 +254,7 @@ bool CSG_CRSProjector::Set_Precise_Mode(bool bOn)
 	{
 		if( m_pGCS == NULL )
 		{
-			return( (m_pGCS = pj_init_plus("+proj=longlat +datum=WGS84")) != NULL );
+			return( (m_pGCS = pj_init_plus_ctx((projCtx)m_pContext, "+proj=longlat +datum=WGS84")) != NULL );
 		}
 	}
 	else
@@ -355,6 +394,179 @@ bool CSG_CRSProjector::Get_Projection(CSG_Point_Z &Point)	const
 	return( false );
 }
 
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define CHUNK_SIZE	4096
+
+//---------------------------------------------------------
+// Transforms the coordinates of nPoints points in place,
+// z is optional. The points are passed to Proj.4 in chunks,
+// which are processed by parallel threads if bParallel is
+// true, each thread using its own copy of the projector.
+// Points that cannot be transformed get a x coordinate of
+// HUGE_VAL. Returns the number of transformed points.
+//---------------------------------------------------------
+sLong CSG_CRSProjector::Get_Projections(sLong nPoints, double *x, double *y, double *z, bool bParallel)	const
+{
+	if( !m_pSource || !m_pTarget || nPoints < 1 || !x || !y )
+	{
+		return( 0 );
+	}
+
+	sLong	nChunks	= 1 + (nPoints - 1) / CHUNK_SIZE;
+	int		nBlocks	= bParallel ? (int)M_GET_MIN(nChunks, (sLong)SG_Get_Max_Num_Threads_Omp()) : 1;
+
+	//-----------------------------------------------------
+	CSG_CRSProjector	*Projectors	= nBlocks > 1 ? new CSG_CRSProjector[nBlocks - 1] : NULL;
+
+	for(int iBlock=1; iBlock<nBlocks; iBlock++)
+	{
+		if( !Projectors[iBlock - 1].Create(*this) )
+		{
+			nBlocks	= 1;
+		}
+	}
+
+	//-----------------------------------------------------
+	sLong	*nDone	= new sLong[nBlocks];
+
+	#pragma omp parallel for
+	for(int iBlock=0; iBlock<nBlocks; iBlock++)
+	{
+		const CSG_CRSProjector	&Projector	= iBlock == 0 ? *this : Projectors[iBlock - 1];
+
+		nDone[iBlock]	= 0;
+
+		for(sLong iChunk=nChunks*iBlock/nBlocks; iChunk<nChunks*(iBlock+1)/nBlocks; iChunk++)
+		{
+			sLong	i	= iChunk * CHUNK_SIZE;
+			int		n	= (int)M_GET_MIN((sLong)CHUNK_SIZE, nPoints - i);
+
+			nDone[iBlock]	+= Projector._Get_Projections(n, x + i, y + i, z ? z + i : NULL);
+		}
+	}
+
+	//-----------------------------------------------------
+	sLong	n	= 0;
+
+	for(int iBlock=0; iBlock<nBlocks; iBlock++)
+	{
+		n	+= nDone[iBlock];
+	}
+
+	delete[](nDone);
+
+	if( Projectors )
+	{
+		delete[](Projectors);
+	}
+
+	return( n );
+}
+
+//---------------------------------------------------------
+// Transforms a single chunk with one call to Proj.4.
+//---------------------------------------------------------
+int CSG_CRSProjector::_Get_Projections(int nPoints, double *x, double *y, double *z)	const
+{
+
+	int		i, n	= z ? 3 : 2;
+
+	//-----------------------------------------------------
+	// keep the input, a single invalid point can make Proj.4
+	// reject the whole batch (e.g. datum shifts)
+	double	*Copy	= (double *)SG_Malloc(n * nPoints * sizeof(double));
+
+	if( Copy )
+	{
+		memcpy(Copy          , x, nPoints * sizeof(double));
+		memcpy(Copy + nPoints, y, nPoints * sizeof(double));
+
+		if( z )	memcpy(Copy + 2 * nPoints, z, nPoints * sizeof(double));
+	}
+
+	//-----------------------------------------------------
+	if( pj_is_latlong((PJ *)m_pSource) )
+	{
+		for(i=0; i<nPoints; i++)
+		{
+			x[i]	*= DEG_TO_RAD;
+			y[i]	*= DEG_TO_RAD;
+		}
+	}
+
+	bool	bOkay;
+
+	if( m_pGCS )	// precise datum conversion
+	{
+		bOkay	= pj_transform((PJ *)m_pSource, (PJ *)m_pGCS   , nPoints, 1, x, y, z) == 0
+			&&    pj_transform((PJ *)m_pGCS   , (PJ *)m_pTarget, nPoints, 1, x, y, z) == 0;
+	}
+	else			// direct projection
+	{
+		bOkay	= pj_transform((PJ *)m_pSource, (PJ *)m_pTarget, nPoints, 1, x, y, z) == 0;
+	}
+
+	//-----------------------------------------------------
+	n	= 0;
+
+	if( !bOkay )	// batch rejected, fall back to point-wise transformation
+	{
+		for(i=0; i<nPoints; i++)
+		{
+			bool	bPoint	= false;
+
+			if( Copy )
+			{
+				x[i]	= Copy[i];
+				y[i]	= Copy[i + nPoints];
+
+				bPoint	= z ? Get_Projection(x[i], y[i], z[i] = Copy[i + 2 * nPoints]) : Get_Projection(x[i], y[i]);
+			}
+
+			if( bPoint )
+			{
+				n++;
+			}
+			else
+			{
+				x[i]	= y[i]	= HUGE_VAL;
+			}
+		}
+	}
+	else
+	{
+		bool	bGeog	= pj_is_latlong((PJ *)m_pTarget) != 0;
+
+		for(i=0; i<nPoints; i++)
+		{
+			if( x[i] != HUGE_VAL && y[i] != HUGE_VAL )
+			{
+				if( bGeog )
+				{
+					x[i]	*= RAD_TO_DEG;
+					y[i]	*= RAD_TO_DEG;
+				}
+
+				n++;
+			}
+			else
+			{
+				x[i]	= y[i]	= HUGE_VAL;
+			}
+		}
+	}
+
+	SG_FREE_SAFE(Copy);
+
+	return( n );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
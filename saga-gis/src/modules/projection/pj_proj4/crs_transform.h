@@ -81,6 +81,8 @@ public:
 
 	bool					Destroy						(void);
 
+	bool					Create						(const CSG_CRSProjector &Projector);
+
 	static CSG_String		Get_Version					(void);
 	static CSG_String		Get_Description				(void);
 
@@ -104,17 +106,21 @@ public:
 	bool					Get_Projection				(TSG_Point_Z &Point)				const;
 	bool					Get_Projection				(CSG_Point_Z &Point)				const;
 
+	sLong					Get_Projections				(sLong nPoints, double *x, double *y, double *z = NULL, bool bParallel = false)	const;
+
 private:
 
 	bool					m_bInverse;
 
-	void					*m_pSource, *m_pTarget, *m_pGCS;
+	void					*m_pContext, *m_pSource, *m_pTarget, *m_pGCS;
 
 	CSG_Projection			m_Source, m_Target;
 
 
 	bool					_Set_Projection			(const CSG_Projection &Projection, void **ppProjection, bool bInverse);
 
+	int						_Get_Projections		(int nPoints, double *x, double *y, double *z)	const;
+
 
 };
 
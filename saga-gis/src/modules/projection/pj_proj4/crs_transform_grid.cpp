@@ -147,6 +147,12 @@ CCRS_Transform_Grid::CCRS_Transform_Grid(bool bList)
 		_TL(""),
 		PARAMETER_TYPE_Bool, false
 	);
+
+	Parameters.Add_Value(
+		pNode	, "APPROXIMATION", _TL("Approximation Error"),
+		_TL("Maximum error, measured in source grid cells, accepted for linearly interpolating source coordinates along target rows instead of transforming each cell exactly. Set to zero for exact transformation."),
+		PARAMETER_TYPE_Double, 0.0, 0.0, true
+	);
 }
 
 
@@ -286,28 +292,6 @@ bool CCRS_Transform_Grid::Transform(CSG_Grid *pGrid, CSG_Grid *pTarget)
 	}
 
 	//-----------------------------------------------------
-	CSG_Grid	*pX, *pY;
-
-	if( (pX = m_Grid_Target.Get_Grid("OUT_X")) != NULL )
-	{
-		pX->Assign_NoData();
-		pX->Set_Name(_TL("X Coordinates"));
-		pX->Get_Projection().Create(m_Projector.Get_Target());
-	}
-
-	if( (pY = m_Grid_Target.Get_Grid("OUT_Y")) != NULL )
-	{
-		pY->Assign_NoData();
-		pY->Set_Name(_TL("Y Coordinates"));
-		pY->Get_Projection().Create(m_Projector.Get_Target());
-	}
-
-	//-----------------------------------------------------
-	Set_Target_Area(pGrid->Get_System(), pTarget->Get_System());
-
-	bool	bGeogCS_Adjust	= m_Projector.Get_Source().Get_Type() == SG_PROJ_TYPE_CS_Geographic && pGrid->Get_XMax() > 180.0;
-
-	//-------------------------------------------------
 	pTarget->Set_NoData_Value_Range	(pGrid->Get_NoData_Value(), pGrid->Get_NoData_hiValue());
 	pTarget->Set_Scaling			(pGrid->Get_Scaling(), pGrid->Get_Offset());
 	pTarget->Set_Name				(CSG_String::Format(SG_T("%s"), pGrid->Get_Name()));
@@ -316,43 +300,59 @@ bool CCRS_Transform_Grid::Transform(CSG_Grid *pGrid, CSG_Grid *pTarget)
 	pTarget->Get_Projection().Create(m_Projector.Get_Target());
 
 	//-----------------------------------------------------
-	for(int y=0; y<pTarget->Get_NY() && Set_Progress(y, pTarget->Get_NY()); y++)
+	CSG_Grid_System	System(pTarget->Get_System());
+
+	return( Transform(1, &pGrid, &pTarget, System) );
+}
+
+//---------------------------------------------------------
+bool CCRS_Transform_Grid::Transform(CSG_Parameter_Grid_List *pSources, CSG_Parameter_Grid_List *pTargets, const CSG_Grid_System &Target_System)
+{
+	if( !m_Projector.Set_Inverse(true) || !pTargets || !pSources || pSources->Get_Count() < 1 )
 	{
-		double	yTarget	= pTarget->Get_YMin() + y * pTarget->Get_Cellsize();
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	int			i, n	= 0, nSources	= pSources->Get_Count();
+
+	CSG_Grid	**pGrids	= (CSG_Grid **)SG_Malloc(2 * nSources * sizeof(CSG_Grid *));
 
-	//	#pragma omp parallel for
-		for(int x=0; x<pTarget->Get_NX(); x++)
+	for(i=0; i<nSources; i++)
+	{
+		CSG_Grid	*pSource	= pSources->asGrid(i);
+		CSG_Grid	*pTarget	= SG_Create_Grid(Target_System, m_Interpolation == 0 ? pSource->Get_Type() : SG_DATATYPE_Float);
+
+		if( pTarget )
 		{
-			double	z, ySource, xSource	= pTarget->Get_XMin() + x * pTarget->Get_Cellsize();
+			pTarget->Set_NoData_Value_Range	(pSource->Get_NoData_Value(), pSource->Get_NoData_hiValue());
+			pTarget->Set_Scaling			(pSource->Get_Scaling(), pSource->Get_Offset());
+			pTarget->Set_Name				(CSG_String::Format(SG_T("%s"), pSource->Get_Name()));
+			pTarget->Set_Unit				(pSource->Get_Unit());
+			pTarget->Assign_NoData();
+			pTarget->Get_Projection().Create(m_Projector.Get_Target());
 
-			if( is_In_Target_Area(x, y) && m_Projector.Get_Projection(xSource, ySource = yTarget) )
-			{
-				if( pX )	pX->Set_Value(x, y, xSource);
-				if( pY )	pY->Set_Value(x, y, ySource);
+			pTargets->Add_Item(pTarget);
 
-				if( bGeogCS_Adjust && xSource < 0.0 )
-				{
-					xSource	+= 360.0;
-				}
+			pGrids[n           ]	= pSource;
+			pGrids[n + nSources]	= pTarget;
 
-				if( pGrid->Get_Value(xSource, ySource, z, m_Interpolation) )
-				{
-					pTarget->Set_Value(x, y, z);
-				}
-			}
+			n++;
 		}
 	}
 
-	//-----------------------------------------------------
-	m_Target_Area.Destroy();
+	//-------------------------------------------------
+	bool	bResult	= Transform(n, pGrids, pGrids + nSources, Target_System);
 
-	return( true );
+	SG_Free(pGrids);
+
+	return( bResult );
 }
 
 //---------------------------------------------------------
-bool CCRS_Transform_Grid::Transform(CSG_Parameter_Grid_List *pSources, CSG_Parameter_Grid_List *pTargets, const CSG_Grid_System &Target_System)
+bool CCRS_Transform_Grid::Transform(int nGrids, CSG_Grid **pSources, CSG_Grid **pTargets, const CSG_Grid_System &Target_System)
 {
-	if( !m_Projector.Set_Inverse(true) || !pTargets || !pSources || pSources->Get_Count() < 1 )
+	if( nGrids < 1 )
 	{
 		return( false );
 	}
@@ -375,56 +375,76 @@ bool CCRS_Transform_Grid::Transform(CSG_Parameter_Grid_List *pSources, CSG_Param
 	}
 
 	//-----------------------------------------------------
-	bool	bGeogCS_Adjust	= m_Projector.Get_Source().Get_Type() == SG_PROJ_TYPE_CS_Geographic && pSources->asGrid(0)->Get_System().Get_XMax() > 180.0;
+	bool	bGeogCS_Adjust	= m_Projector.Get_Source().Get_Type() == SG_PROJ_TYPE_CS_Geographic && pSources[0]->Get_XMax() > 180.0;
+
+	Set_Target_Area(pSources[0]->Get_System(), Target_System);
 
-	Set_Target_Area(pSources->asGrid(0)->Get_System(), Target_System);
+	m_Approx_Error	= Parameters("APPROXIMATION")->asDouble() * pSources[0]->Get_Cellsize();
 
 	//-----------------------------------------------------
-	int	i, n	= pTargets->Get_Count();
+	// Proj.4 projections are not thread safe, each strip of rows gets its own projector
 
-	for(i=0; i<pSources->Get_Count(); i++)
-	{
-		CSG_Grid	*pSource	= pSources->asGrid(i);
-		CSG_Grid	*pTarget	= SG_Create_Grid(Target_System, m_Interpolation == 0 ? pSource->Get_Type() : SG_DATATYPE_Float);
+	int	NX		= Target_System.Get_NX();
+	int	NY		= Target_System.Get_NY();
+	int	nBlocks	= M_GET_MAX(1, M_GET_MIN(NY, SG_Get_Max_Num_Threads_Omp()));
 
-		if( pTarget )
+	CSG_CRSProjector	*Projectors	= new CSG_CRSProjector[nBlocks];
+
+	for(int iBlock=0; iBlock<nBlocks; iBlock++)
+	{
+		if( !Projectors[iBlock].Create(m_Projector) )
 		{
-			pTarget->Set_NoData_Value_Range	(pSource->Get_NoData_Value(), pSource->Get_NoData_hiValue());
-			pTarget->Set_Scaling			(pSource->Get_Scaling(), pSource->Get_Offset());
-			pTarget->Set_Name				(CSG_String::Format(SG_T("%s"), pSource->Get_Name()));
-			pTarget->Set_Unit				(pSource->Get_Unit());
-			pTarget->Assign_NoData();
-			pTarget->Get_Projection().Create(m_Projector.Get_Target());
+			delete[](Projectors);
 
-			pTargets->Add_Item(pTarget);
+			m_Target_Area.Destroy();
+
+			return( false );
 		}
 	}
 
-	//-------------------------------------------------
-	for(int y=0; y<Target_System.Get_NY() && Set_Progress(y, Target_System.Get_NY()); y++)
+	int		*Index	= (int    *)SG_Malloc(nBlocks * NX * sizeof(int   ));
+	double	*Source	= (double *)SG_Malloc(nBlocks * NX * sizeof(double) * 2);
+
+	//-----------------------------------------------------
+	int	nRows	= 16 * nBlocks;
+
+	for(int y0=0; y0<NY && Set_Progress(y0, NY); y0+=nRows)
 	{
-		double	yTarget	= Target_System.Get_YMin() + y * Target_System.Get_Cellsize();
+		int	n	= M_GET_MIN(nRows, NY - y0);
 
-	//	#pragma omp parallel for private(i)
-		for(int x=0; x<Target_System.Get_NX(); x++)
+		#pragma omp parallel for
+		for(int iBlock=0; iBlock<nBlocks; iBlock++)
 		{
-			double	z, ySource, xSource	= Target_System.Get_XMin() + x * Target_System.Get_Cellsize();
+			int		*xIndex		= Index  + iBlock * NX;
+			double	*xSource	= Source + iBlock * NX * 2;
+			double	*ySource	= xSource + NX;
 
-			if( is_In_Target_Area(x, y) && m_Projector.Get_Projection(xSource, ySource = yTarget) )
+			for(int y=y0+n*iBlock/nBlocks; y<y0+n*(iBlock+1)/nBlocks; y++)
 			{
-				if( pX )	pX->Set_Value(x, y, xSource);
-				if( pY )	pY->Set_Value(x, y, ySource);
-
-				if( bGeogCS_Adjust && xSource < 0.0 )
-				{
-					xSource	+= 360.0;
-				}
+				int	nCells	= Get_Source_Row(Projectors[iBlock], Target_System, y, xIndex, xSource, ySource);
 
-				for(i=0; i<pTargets->Get_Count(); i++)
+				for(int iCell=0; iCell<nCells; iCell++)
 				{
-					if( pSources->asGrid(i)->Get_Value(xSource, ySource, z, m_Interpolation) )
+					if( xSource[iCell] != HUGE_VAL )
 					{
-						pTargets->asGrid(n + i)->Set_Value(x, y, z);
+						int		x	= xIndex [iCell];
+						double	z, xs	= xSource[iCell], ys	= ySource[iCell];
+
+						if( pX )	pX->Set_Value(x, y, xs);
+						if( pY )	pY->Set_Value(x, y, ys);
+
+						if( bGeogCS_Adjust && xs < 0.0 )
+						{
+							xs	+= 360.0;
+						}
+
+						for(int i=0; i<nGrids; i++)
+						{
+							if( pSources[i]->Get_Value(xs, ys, z, m_Interpolation) )
+							{
+								pTargets[i]->Set_Value(x, y, z);
+							}
+						}
 					}
 				}
 			}
@@ -432,12 +452,121 @@ bool CCRS_Transform_Grid::Transform(CSG_Parameter_Grid_List *pSources, CSG_Param
 	}
 
 	//-----------------------------------------------------
+	SG_Free(Index );
+	SG_Free(Source);
+
+	delete[](Projectors);
+
 	m_Target_Area.Destroy();
 
 	return( true );
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Collects the world coordinates of the row's cells inside
+// the target area and transforms them to source coordinates.
+// Cells that cannot be transformed get a x coordinate of
+// HUGE_VAL. Returns the number of collected cells.
+//---------------------------------------------------------
+int CCRS_Transform_Grid::Get_Source_Row(const CSG_CRSProjector &Projector, const CSG_Grid_System &System, int y, int *xIndex, double *xSource, double *ySource)
+{
+	int		n	= 0;
+	double	yWorld	= System.Get_yGrid_to_World(y);
+
+	for(int x=0; x<System.Get_NX(); x++)
+	{
+		if( is_In_Target_Area(x, y) )
+		{
+			xIndex [n]	= x;
+			xSource[n]	= System.Get_xGrid_to_World(x);
+			ySource[n]	= yWorld;
+
+			n++;
+		}
+	}
+
+	//-----------------------------------------------------
+	if( m_Approx_Error > 0.0 && n > 2 )
+	{
+		Projector.Get_Projections(1, xSource        , ySource        );
+		Projector.Get_Projections(1, xSource + n - 1, ySource + n - 1);
+
+		Get_Source_Approx(Projector, n, xIndex, xSource, ySource);
+	}
+	else if( n > 0 )
+	{
+		Projector.Get_Projections(n, xSource, ySource);
+	}
+
+	return( n );
+}
+
+//---------------------------------------------------------
+// Expects the first and last point already transformed. The
+// exact transformation of the middle point is compared with
+// its linear interpolation. The inner points are interpolated
+// if the deviation does not exceed the approximation error,
+// else both halves are processed recursively (the approach
+// of GDAL's approximating transformer).
+//---------------------------------------------------------
+void CCRS_Transform_Grid::Get_Source_Approx(const CSG_CRSProjector &Projector, int n, const int *xIndex, double *x, double *y)
+{
+	if( n <= 2 )
+	{
+		return;
+	}
+
+	if( n < 8 || x[0] == HUGE_VAL || x[n - 1] == HUGE_VAL )
+	{
+		Projector.Get_Projections(n - 2, x + 1, y + 1);
+
+		return;
+	}
+
+	//-----------------------------------------------------
+	int		m	= n / 2;
+	double	xm	= x[m], ym	= y[m];
+
+	if( !Projector.Get_Projections(1, &xm, &ym) )
+	{
+		Projector.Get_Projections(n - 2, x + 1, y + 1);
+
+		return;
+	}
+
+	double	dx	= x[n - 1] - x[0];
+	double	dy	= y[n - 1] - y[0];
+	double	dIndex	= 1.0 / (xIndex[n - 1] - xIndex[0]);
+	double	d	= dIndex * (xIndex[m] - xIndex[0]);
+
+	if( fabs(x[0] + d * dx - xm) <= m_Approx_Error
+	&&  fabs(y[0] + d * dy - ym) <= m_Approx_Error )
+	{
+		for(int i=1; i<n-1; i++)
+		{
+			d		= dIndex * (xIndex[i] - xIndex[0]);
+
+			x[i]	= x[0] + d * dx;
+			y[i]	= y[0] + d * dy;
+		}
+
+		return;
+	}
+
+	//-----------------------------------------------------
+	x[m]	= xm;
+	y[m]	= ym;
+
+	Get_Source_Approx(Projector, m + 1, xIndex    , x    , y    );
+	Get_Source_Approx(Projector, n - m, xIndex + m, x + m, y + m);
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 ///////////////////////////////////////////////////////////
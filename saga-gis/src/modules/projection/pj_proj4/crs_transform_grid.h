@@ -93,6 +93,8 @@ private:
 
 	int							m_Interpolation;
 
+	double						m_Approx_Error;
+
 	CSG_Parameters_Grid_Target	m_Grid_Target;
 
 	CSG_Grid					m_Target_Area;
@@ -103,6 +105,10 @@ private:
 
 	bool						Transform					(CSG_Grid                *pGrid , CSG_Grid                *pTarget );
 	bool						Transform					(CSG_Parameter_Grid_List *pGrids, CSG_Parameter_Grid_List *pTargets, const CSG_Grid_System &Target_System);
+	bool						Transform					(int nGrids, CSG_Grid **pSources, CSG_Grid **pTargets, const CSG_Grid_System &Target_System);
+
+	int							Get_Source_Row				(const CSG_CRSProjector &Projector, const CSG_Grid_System &System, int y, int *xIndex, double *xSource, double *ySource);
+	void						Get_Source_Approx			(const CSG_CRSProjector &Projector, int n, const int *xIndex, double *x, double *y);
 
 	bool						Transform					(CSG_Grid                *pGrid , CSG_Shapes *pPoints);
 	bool						Transform					(CSG_Parameter_Grid_List *pGrids, CSG_Shapes *pPoints);
@@ -213,29 +213,62 @@ bool CCRS_Transform_PointCloud::Transform(CSG_PointCloud *pSource, CSG_PointClou
 		return( false );
 	}
 
+	//-----------------------------------------------------
+	// points are transformed in large batches of contiguous
+	// coordinate arrays, which are projected in parallel
+
+	int		nPoints	= pSource->Get_Point_Count();
+	int		nBuffer	= M_GET_MIN(nPoints, 0x100000);
+	double	*x		= (double *)SG_Malloc(3 * nBuffer * sizeof(double));
+
+	if( !x )
+	{
+		Error_Set(_TL("failed to allocate memory"));
+
+		return( false );
+	}
+
+	double	*y		= x + nBuffer;
+	double	*z		= y + nBuffer;
+
 	int		nDropped	= 0;
 
 	Process_Set_Text(CSG_String::Format(SG_T("%s: %s"), _TL("Processing"), pSource->Get_Name()));
 
-	for(int iPoint=0; iPoint<pSource->Get_Point_Count() && Set_Progress(iPoint, pSource->Get_Point_Count()); iPoint++)
+	for(int iOffset=0; iOffset<nPoints && Set_Progress(iOffset, nPoints); iOffset+=nBuffer)
 	{
-		TSG_Point_Z		Point = pSource->Get_Point(iPoint);
+		int	n	= M_GET_MIN(nBuffer, nPoints - iOffset);
+
+		#pragma omp parallel for
+		for(int i=0; i<n; i++)
+		{
+			x[i]	= pSource->Get_X(iOffset + i);
+			y[i]	= pSource->Get_Y(iOffset + i);
+			z[i]	= pSource->Get_Z(iOffset + i);
+		}
+
+		m_Projector.Get_Projections(n, x, y, z, true);
 
-		if( m_Projector.Get_Projection(Point.x, Point.y, Point.z) )
+		for(int i=0; i<n; i++)
 		{
-			pTarget->Add_Point(Point.x, Point.y, Point.z);
+			if( x[i] != HUGE_VAL )
+			{
+				pTarget->Add_Point(x[i], y[i], z[i]);
 
-			for(int iField=0; iField<pSource->Get_Attribute_Count(); iField++)
+				for(int iField=0; iField<pSource->Get_Attribute_Count(); iField++)
+				{
+					pTarget->Set_Attribute(iField, pSource->Get_Attribute(iOffset + i, iField));
+				}
+			}
+			else
 			{
-				pTarget->Set_Attribute(iField, pSource->Get_Attribute(iPoint, iField));
+				nDropped++;
 			}
 		}
-		else
-		{
-			nDropped++;
-		}
 	}
 
+	SG_Free(x);
+
 	if( nDropped > 0 )
 	{
 		Message_Add(CSG_String::Format(SG_T("%s: %d %s"), pTarget->Get_Name(), nDropped, _TL("points have been dropped")));
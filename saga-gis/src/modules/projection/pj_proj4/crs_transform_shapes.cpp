@@ -203,32 +203,84 @@ bool CCRS_Transform_Shapes::Transform(CSG_Shapes *pSource, CSG_Shapes *pTarget)
 		return( false );
 	}
 
-	int		nDropped	= 0;
+	//-----------------------------------------------------
+	// the vertices of consecutive shapes are collected in
+	// batches of contiguous coordinate arrays, which are
+	// projected in parallel
+
+	int			nDropped	= 0;
+	CSG_Array	Buffer(2 * sizeof(double));
 
 	Process_Set_Text(CSG_String::Format(SG_T("%s: %s"), _TL("Processing"), pSource->Get_Name()));
 
-	for(int iShape=0; iShape<pSource->Get_Count() && Set_Progress(iShape, pSource->Get_Count()); iShape++)
+	for(int iShape=0, jShape; iShape<pSource->Get_Count() && Set_Progress(iShape, pSource->Get_Count()); iShape=jShape)
 	{
-		CSG_Shape	*pShape_Source	= pSource->Get_Shape(iShape);
-		CSG_Shape	*pShape_Target	= pTarget->Add_Shape(pShape_Source, SHAPE_COPY_ATTR);
+		int	iShape_, iPart, iPoint, i, nPoints	= 0;
 
-		for(int iPart=0; iPart<pShape_Source->Get_Part_Count() && pShape_Target; iPart++)
+		for(jShape=iShape; jShape<pSource->Get_Count() && (jShape == iShape || nPoints < 0x10000); jShape++)
 		{
-			for(int iPoint=0; iPoint<pShape_Source->Get_Point_Count(iPart) && pShape_Target; iPoint++)
-			{
-				TSG_Point	Point	= pShape_Source->Get_Point(iPoint, iPart);
+			nPoints	+= pSource->Get_Shape(jShape)->Get_Point_Count();
+		}
+
+		if( nPoints > 0 && !Buffer.Set_Array(nPoints, false) )
+		{
+			Error_Set(_TL("failed to allocate memory"));
+
+			return( false );
+		}
+
+		double	*x	= nPoints > 0 ? (double *)Buffer.Get_Array() : NULL;
+		double	*y	= x + nPoints;
+
+		//-------------------------------------------------
+		for(iShape_=iShape, i=0; iShape_<jShape; iShape_++)
+		{
+			CSG_Shape	*pShape	= pSource->Get_Shape(iShape_);
 
-				if( m_Projector.Get_Projection(Point.x, Point.y) )
+			for(iPart=0; iPart<pShape->Get_Part_Count(); iPart++)
+			{
+				for(iPoint=0; iPoint<pShape->Get_Point_Count(iPart); iPoint++, i++)
 				{
-					pShape_Target->Add_Point(Point.x, Point.y, iPart);
+					TSG_Point	Point	= pShape->Get_Point(iPoint, iPart);
+
+					x[i]	= Point.x;
+					y[i]	= Point.y;
 				}
-				else
-				{
-					nDropped++;
+			}
+		}
 
-					pTarget->Del_Shape(pShape_Target);
+		if( nPoints > 0 )
+		{
+			m_Projector.Get_Projections(nPoints, x, y, NULL, true);
+		}
+
+		//-------------------------------------------------
+		for(iShape_=iShape, i=0; iShape_<jShape; iShape_++)
+		{
+			CSG_Shape	*pShape_Source	= pSource->Get_Shape(iShape_);
+			CSG_Shape	*pShape_Target	= pTarget->Add_Shape(pShape_Source, SHAPE_COPY_ATTR);
 
-					pShape_Target	= NULL;
+			for(iPart=0; iPart<pShape_Source->Get_Part_Count(); iPart++)
+			{
+				for(iPoint=0; iPoint<pShape_Source->Get_Point_Count(iPart); iPoint++, i++)
+				{
+					if( !pShape_Target )
+					{
+						continue;
+					}
+
+					if( x[i] != HUGE_VAL )
+					{
+						pShape_Target->Add_Point(x[i], y[i], iPart);
+					}
+					else
+					{
+						nDropped++;
+
+						pTarget->Del_Shape(pShape_Target);
+
+						pShape_Target	= NULL;
+					}
 				}
 			}
 		}
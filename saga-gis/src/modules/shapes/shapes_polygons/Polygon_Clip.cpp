@@ -357,15 +357,20 @@ TSG_Point CPolygon_Clip::Get_Crossing(CSG_Shape_Polygon *pPolygon, const TSG_Poi
 //---------------------------------------------------------
 void CPolygon_Clip::Clip_Polygons(CSG_Shapes *pClips, CSG_Shapes *pInputs, CSG_Shapes *pOutputs)
 {
+	CSG_Shapes_RTree	Inputs(pInputs);	// only polygons overlapping the clip's extent need to be clipped
+	CSG_Array			Candidates;
+
 	for(int iClip=0; iClip<pClips->Get_Count() && Process_Get_Okay(); iClip++)
 	{
 		Process_Set_Text(CSG_String::Format(SG_T("%s: %d/%d"), _TL("clip features"), iClip + 1, pClips->Get_Count()));
 
 		CSG_Shape	*pClip	= pClips->Get_Shape(iClip);
 
-		for(int iInput=0; iInput<pInputs->Get_Count() && Set_Progress(iInput, pInputs->Get_Count()); iInput++)
+		int	nCandidates	= Inputs.Get_Intersections(pClip->Get_Extent().m_rect, Candidates);
+
+		for(int i=0; i<nCandidates && Set_Progress(i, nCandidates); i++)
 		{
-			CSG_Shape	*pOutput	= pOutputs->Add_Shape(pInputs->Get_Shape(iInput));
+			CSG_Shape	*pOutput	= pOutputs->Add_Shape(pInputs->Get_Shape(*((int *)Candidates.Get_Entry(i))));
 
 			if( !SG_Polygon_Intersection(pOutput, pClip) )
 			{
@@ -156,38 +156,25 @@ bool CPolygon_Overlay::Initialize(CSG_Shapes **ppA, CSG_Shapes **ppB, bool bBoth
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CPolygon_Overlay::Get_Intersection(CSG_Shapes *pA, CSG_Shapes *pB)
+class CPolygon_Overlay_Engine : public CSG_Polygon_Overlay
 {
-	m_bInvert	= false;
-
-	m_pA	= pA;
-	m_pB	= pB;
-
-	CSG_Shapes	Tmp(SHAPE_TYPE_Polygon);
+public:
+	CPolygon_Overlay_Engine(CPolygon_Overlay *pTool)	{	m_pTool	= pTool;	}
 
-	CSG_Shape	*pShape_AB	= Tmp.Add_Shape();
+protected:
 
-	//-----------------------------------------------------
-	for(int id_A=0; id_A<m_pA->Get_Count() && Set_Progress(id_A, m_pA->Get_Count()); id_A++)
+	virtual bool			On_Result			(CSG_Shape *pResult, int id_A, int id_B)
 	{
-		if( m_pB->Select(m_pA->Get_Shape(id_A)->Get_Extent()) )
-		{
-			CSG_Shape	*pShape_A	= m_pA->Get_Shape(id_A);
-
-			for(int id_B=0; id_B<m_pB->Get_Selection_Count(); id_B++)
-			{
-				CSG_Shape	*pShape_B	= m_pB->Get_Selection(id_B);
+		m_pTool->Add_Polygon(pResult, id_A, id_B);
 
-				if( SG_Polygon_Intersection(pShape_A, pShape_B, pShape_AB) )
-				{
-					Add_Polygon(pShape_AB, id_A, pShape_B->Get_Index());
-				}
-			}
-		}
+		return( true );
 	}
 
-	return( true );
-}
+private:
+
+	CPolygon_Overlay		*m_pTool;
+
+};
 
 
 ///////////////////////////////////////////////////////////
@@ -195,46 +182,34 @@ bool CPolygon_Overlay::Get_Intersection(CSG_Shapes *pA, CSG_Shapes *pB)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CPolygon_Overlay::Get_Difference(CSG_Shapes *pA, CSG_Shapes *pB, bool bInvert)
+bool CPolygon_Overlay::Get_Intersection(CSG_Shapes *pA, CSG_Shapes *pB)
 {
-	m_bInvert	= bInvert;
+	m_bInvert	= false;
 
 	m_pA	= pA;
 	m_pB	= pB;
 
-	CSG_Shapes	Tmp(SHAPE_TYPE_Polygon);
+	CPolygon_Overlay_Engine	Engine(this);
 
-	CSG_Shape	*pShape_A	= Tmp.Add_Shape();
+	return( Engine.Execute(SG_POLYGON_OVERLAY_INTERSECTION, m_pA, m_pB) );
+}
 
-	//-----------------------------------------------------
-	for(int id_A=0; id_A<m_pA->Get_Count() && Set_Progress(id_A, m_pA->Get_Count()); id_A++)
-	{
-		if( m_pB->Select(m_pA->Get_Shape(id_A)->Get_Extent()) )
-		{
-			int		nIntersections	= 0;
 
-			pShape_A->Assign(m_pA->Get_Shape(id_A));
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
 
-			for(int id_B=0; id_B<m_pB->Get_Selection_Count(); id_B++)
-			{
-				if( SG_Polygon_Difference(pShape_A, m_pB->Get_Selection(id_B)) )
-				{
-					nIntersections++;
-				}
-			}
+//---------------------------------------------------------
+bool CPolygon_Overlay::Get_Difference(CSG_Shapes *pA, CSG_Shapes *pB, bool bInvert)
+{
+	m_bInvert	= bInvert;
 
-			if( nIntersections > 0 && pShape_A->is_Valid() )
-			{
-				Add_Polygon(pShape_A, id_A);
-			}
-		}
-		else
-		{
-			Add_Polygon(m_pA->Get_Shape(id_A), id_A);
-		}
-	}
+	m_pA	= pA;
+	m_pB	= pB;
 
-	return( true );
+	CPolygon_Overlay_Engine	Engine(this);
+
+	return( Engine.Execute(SG_POLYGON_OVERLAY_DIFFERENCE, m_pA, m_pB) );
 }
 
 
@@ -84,6 +84,8 @@
 //---------------------------------------------------------
 class CPolygon_Overlay : public CSG_Module
 {
+	friend class CPolygon_Overlay_Engine;
+
 public:
 	CPolygon_Overlay(const CSG_String &Name);
 
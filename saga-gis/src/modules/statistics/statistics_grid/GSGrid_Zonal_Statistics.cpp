@@ -157,15 +157,13 @@ CGSGrid_Zonal_Statistics::~CGSGrid_Zonal_Statistics(void)
 bool CGSGrid_Zonal_Statistics::On_Execute(void)
 {
 	bool					bShortNames;
-	int						x, y, nCatGrids, nStatGrids, iGrid, zoneID, catID, NDcount, catLevel, NDcountStat;
-	double					statID;
+	int						nCatGrids, nStatGrids, iGrid, iUnit;
+	sLong					NDcountStat;
 
-	CSG_Grid				*pZones, *pGrid, *pAspect;
+	CSG_Grid				*pZones, *pAspect;
 	CSG_Parameter_Grid_List	*pCatList;
 	CSG_Parameter_Grid_List	*pStatList;
 
-	CList_Conti				*newZone, *startList, *runList, *newSub, *parent, *runSub, *subList;
-	CList_Stat				*runStats;
 	CSG_Table				*pOutTab;
 	CSG_Table_Record		*pRecord;
 	CSG_String				fieldName, tmpName;
@@ -181,9 +179,6 @@ bool CGSGrid_Zonal_Statistics::On_Execute(void)
 	nCatGrids	= pCatList	->Get_Count();
 	nStatGrids	= pStatList	->Get_Count();
 
-	NDcount		= 0;						// NoData Counter (ZoneGrid)
-	NDcountStat	= 0;						// NoData Counter (StatGrids)
-
 	CSG_String	sTabName = Parameters("OUTTAB")->asString();
 	if (pOutTab != NULL)
 	{
@@ -191,210 +186,31 @@ bool CGSGrid_Zonal_Statistics::On_Execute(void)
 		pOutTab->Set_Name(sTabName);
 	}
 
-	newZone		= new CList_Conti();								// create first list entry (dummy)
-	startList	= newZone;
+	//-----------------------------------------------------
+	// collect unique condition units (zone and category combinations) and their statistics in one pass
+
+	CSG_Grid_Zonal_Statistics	Statistics;
+
+	Statistics.Create(pZones);
 
-	for(y=0; y<Get_NY() && Set_Progress(y); y++)
+	for(iGrid=0; iGrid<nCatGrids; iGrid++)
 	{
-		for(x=0; x<Get_NX(); x++)
-		{
-			runList		= startList;
-			zoneID		= pZones->asInt(x, y);								// get zone ID
-
-			while( runList->next != NULL && runList->cat < zoneID )			// search for last entry in list or insert point
-			{
-				runList = runList->next;
-			}
-
-			if( runList->dummy == true )
-			{
-				runList->cat = zoneID;										// first list entry, write and
-				runList->dummy = false;										// setup
-			}
-			else if( runList->cat == zoneID )
-				runList = runList;											// zoneID found
-			else if( runList->next == NULL && runList->cat < zoneID )		// append zoneID
-			{
-				newZone = new CList_Conti();
-				newZone->previous	= runList;
-				runList->next		= newZone;
-
-				newZone->cat	= zoneID;									// ... and write info
-				newZone->dummy	= false;
-				runList			= newZone;
-			}
-			else															// insert new entry
-			{
-				newZone = new CList_Conti();
-
-				newZone->next = runList;
-				if( runList->previous != NULL )
-				{
-					newZone->previous = runList->previous;
-					runList->previous->next = newZone;
-				}
-				runList->previous = newZone;
-
-				if( runList == startList )
-					startList = newZone;									// if new entry is first element, update startList pointer
-
-				newZone->cat	= zoneID;									// ... and write info
-				newZone->dummy	= false;
-				runList			= newZone;
-			}
-
-
-			for(iGrid=0; iGrid<nCatGrids; iGrid++)							// collect categories
-			{
-				parent  = runList;
-				if( runList->sub == NULL )									// no sub class found
-				{
-					newSub = new CList_Conti();
-					runList->sub = newSub;
-				}
-
-				runList = runList->sub;
-
-				pGrid	= pCatList->asGrid(iGrid);
-				if( !pGrid->is_NoData(x, y) )
-					catID	= pGrid->asInt(x, y);
-				else
-					catID	= (int)pGrid->Get_NoData_Value();
-
-
-				while( runList->next != NULL && runList->cat < catID )		// search for last entry in list or insert point
-				{
-					runList = runList->next;
-				}
-
-				if( runList->dummy == true )
-				{
-					runList->cat	= catID;								// first list entry, write and
-					runList->dummy	= false;								// setup
-					runList->parent	= parent;
-				}
-				else if( runList->cat == catID )
-					runList = runList;										// zoneID found, all infos already written
-				else if( runList->next == NULL && runList->cat < catID)		// append zoneID
-				{
-					newSub = new CList_Conti();
-					newSub->cat			= catID;							// ... and write info
-					newSub->previous	= runList;
-					newSub->parent		= parent;
-					newSub->dummy		= false;
-					runList->next		= newSub;
-					runList				= newSub;
-				}
-				else														// insert new entry
-				{
-					newSub = new CList_Conti();
-					newSub->cat		= catID;								// ... and write info
-					newSub->next	= runList;
-					newSub->parent	= parent;
-					newSub->dummy	= false;
-					if( runList->previous != NULL )
-					{
-						newSub->previous = runList->previous;
-						runList->previous->next = newSub;
-					}
-					else
-						parent->sub	 = newSub;
-
-					runList->previous = newSub;
-					runList	= newSub;
-				}
-			}
-
-
-			for(iGrid=0; iGrid<nStatGrids; iGrid++)							// collect statistics for StatGrids
-			{
-				if( iGrid == 0 )
-				{
-					if( runList->stats == NULL )
-						runList->stats = new CList_Stat();
-
-					runStats = runList->stats;
-				}
-				else
-				{
-					if( runStats->next == NULL )
-						runStats->next = new CList_Stat();
-
-					runStats = runStats->next;
-				}
-				if( !pStatList->asGrid(iGrid)->is_NoData(x, y) )
-				{
-					statID		= pStatList->asGrid(iGrid)->asDouble(x, y);
-
-					if( runStats->dummy == true )
-					{
-						runStats->min = statID;
-						runStats->max = statID;
-						runStats->dummy = false;
-					}
-					if( runStats->min > statID )
-						runStats->min = statID;
-					if( runStats->max < statID )
-						runStats->max = statID;
-
-					runStats->n	  += 1;
-					runStats->sum += statID;
-					runStats->dev += pow(statID, 2);
-				}
-				else
-					NDcountStat += 1;
-			}
-
-			if( pAspect != NULL )
-			{
-				for( int i=0; i<2; i++ )
-				{
-					if( nStatGrids == 0 && i == 0 )
-					{
-						if( runList->stats == NULL )
-							runList->stats = new CList_Stat();
-
-						runStats = runList->stats;
-					}
-					else
-					{
-						if( runStats->next == NULL )
-							runStats->next = new CList_Stat();
-
-						runStats = runStats->next;
-					}
-					if( !pAspect->is_NoData(x, y) )
-					{
-						statID	= pAspect->asDouble(x, y);
-
-						if( i == 0 )
-						{
-							if( runStats->dummy == true )
-							{
-								runStats->min = statID;
-								runStats->max = statID;
-								runStats->dummy = false;
-							}
-							if( runStats->min > statID )
-								runStats->min = statID;
-							if( runStats->max < statID )
-								runStats->max = statID;
-
-							statID	= sin(statID);
-						}
-						else
-							statID	= cos(statID);
-
-						runStats->n	  += 1;
-						runStats->sum += statID;
-					}
-					else
-						NDcountStat += 1;
-				}
-			}
-
-			runList->count += 1;											// sum up unique condition area
-		}
+		Statistics.Add_Category(pCatList->asGrid(iGrid));
+	}
+
+	for(iGrid=0; iGrid<nStatGrids; iGrid++)
+	{
+		Statistics.Add_Value(pStatList->asGrid(iGrid));
+	}
+
+	if( pAspect != NULL )
+	{
+		Statistics.Add_Value(pAspect, true);
+	}
+
+	if( !Statistics.Execute() || !Process_Get_Okay() )
+	{
+		return( false );
 	}
 
 
@@ -461,111 +277,67 @@ bool CGSGrid_Zonal_Statistics::On_Execute(void)
 
 	int	iStatFields = 6;	// number of table fields: n, min, max, mean, stddev, sum
 
-	while( startList != NULL )												// scan zone layer list and write cat values in table
+	for(iUnit=0; iUnit<Statistics.Get_Count() && Set_Progress(iUnit, Statistics.Get_Count()); iUnit++)
 	{
-		runList = startList;
-		while( runList->sub != NULL )										// fall down to lowest layer
-			runList = runList->sub;
+		pRecord	= pOutTab->Add_Record();									// create new record in table
 
-		subList = runList;													// use pointer to scan horizontal
+		pRecord->Set_Value(0, Statistics.Get_Zone(iUnit));					// read/write categories
 
-		while( subList != NULL )											// move forward and read all categories of this layer (including the parent layers)
+		for(iGrid=0; iGrid<nCatGrids; iGrid++)
 		{
-			runSub = subList;
-			catLevel = nCatGrids;
-			pRecord	= pOutTab->Add_Record();								// create new record in table
-			pRecord->Set_Value((catLevel+1), runSub->count);				// read/write field count
-
-			for(iGrid=0; iGrid<nStatGrids; iGrid++)							// read/write statistics
-			{
-				if( iGrid == 0 )
-					runStats = runSub->stats;
-				else
-					runStats = runStats->next;
-
-				pRecord->Set_Value(catLevel+2+iGrid*iStatFields, runStats->n);
-				pRecord->Set_Value(catLevel+3+iGrid*iStatFields, runStats->min);
-				pRecord->Set_Value(catLevel+4+iGrid*iStatFields, runStats->max);
-				pRecord->Set_Value(catLevel+5+iGrid*iStatFields, runStats->sum/runStats->n);
-				pRecord->Set_Value(catLevel+6+iGrid*iStatFields, sqrt((runStats->dev - runStats->n*pow(runStats->sum/runStats->n, 2)) / (runStats->n - 1))); // sample
-				//pRecord->Set_Value(catLevel+6+iGrid*iStatFields, sqrt((runStats->dev - pow(runStats->sum/runStats->n, 2)) / runStats->n)); // population
-				pRecord->Set_Value(catLevel+7+iGrid*iStatFields, runStats->sum);
-			}
-
-			if( pAspect != NULL )
-			{
-				iGrid		= nStatGrids * iStatFields;
-
-				int			n;
-				double		min, max, sumYcomp, sumXcomp, val, valYcomp, valXcomp;
-
-				if( nStatGrids == 0 )
-					runStats	= runSub->stats;
-				else
-					runStats	= runStats->next;
-				n			= runStats->n;
-				min			= runStats->min;
-				max			= runStats->max;
-				sumXcomp	= runStats->sum;
-
-				runStats	= runStats->next;
-				sumYcomp	= runStats->sum;
-
-				pRecord		->Set_Value(catLevel+2+iGrid, n);
-				pRecord		->Set_Value(catLevel+3+iGrid, min*M_RAD_TO_DEG);
-				pRecord		->Set_Value(catLevel+4+iGrid, max*M_RAD_TO_DEG);
-				valXcomp	= sumXcomp / n;
-				valYcomp	= sumYcomp / n;
-				val			= valXcomp ? fmod(M_PI_270 + atan2(valYcomp, valXcomp), M_PI_360) : (valYcomp > 0 ? M_PI_270 : (valYcomp < 0 ? M_PI_090 : -1));
-				val			= fmod(M_PI_360 - val, M_PI_360);
-				pRecord		->Set_Value(catLevel+5+iGrid, val*M_RAD_TO_DEG);
-			}
-
-			while( runSub != NULL )											// read/write categories
-			{
-				pRecord->Set_Value(catLevel, runSub->cat);
-				runSub = runSub->parent;
-				catLevel -= 1;
-			}
-			subList = subList->next;
+			pRecord->Set_Value(1+iGrid, Statistics.Get_Category(iUnit, iGrid));
 		}
 
-		while( runList->parent != NULL && runList->parent->next == NULL )	// move up to next 'Caterory with -> next'
-			runList = runList->parent;
+		pRecord->Set_Value(nCatGrids+1, (double)Statistics.Get_Cells(iUnit));	// read/write field count
 
-		if( runList->parent != NULL )										// if not upper layer (zones)
+		for(iGrid=0; iGrid<nStatGrids; iGrid++)								// read/write statistics
 		{
-			runList = runList->parent;										// move to parent of next 'Caterory with -> next'
-			if( runList->next != NULL && runList->parent != NULL )
-				runList->parent->sub = runList->next;						// redirect pointer to category which is next 'Categora with -> next' next
-			else if (runList->parent == NULL && runList->next != NULL )
-				startList = runList->next;									// when upper layer (zones) is reached, move to next zone
-			else
-				startList = NULL;											// reading finished
-
-			if( runList->parent == NULL )
-				startList = runList->next;									// ?? when upper layer is reached, move to next zone
-			else
-				runList->sub = runList->sub->next;							// on sub layers redirect pointer to ->next
+			const TSG_Zonal_Value	&Value	= Statistics.Get_Value(iUnit, iGrid);
+
+			pRecord->Set_Value(nCatGrids+2+iGrid*iStatFields, (double)Value.n);
+			pRecord->Set_Value(nCatGrids+3+iGrid*iStatFields, Value.Min);
+			pRecord->Set_Value(nCatGrids+4+iGrid*iStatFields, Value.Max);
+			pRecord->Set_Value(nCatGrids+5+iGrid*iStatFields, Statistics.Get_Mean  (iUnit, iGrid));
+			pRecord->Set_Value(nCatGrids+6+iGrid*iStatFields, Statistics.Get_StdDev(iUnit, iGrid));	// sample
+			pRecord->Set_Value(nCatGrids+7+iGrid*iStatFields, Value.Sum);
 		}
-		else
+
+		if( pAspect != NULL )
 		{
-			if( nCatGrids == 0 )
-				startList = NULL;
-			else
-				startList = runList->next;									// ?? upper layer is reached, move to next zone
+			iGrid		= nStatGrids * iStatFields;
+
+			const TSG_Zonal_Value	&Value	= Statistics.Get_Value(iUnit, nStatGrids);
+
+			double	val, valYcomp, valXcomp;
+
+			pRecord		->Set_Value(nCatGrids+2+iGrid, (double)Value.n);
+			pRecord		->Set_Value(nCatGrids+3+iGrid, Value.Min*M_RAD_TO_DEG);
+			pRecord		->Set_Value(nCatGrids+4+iGrid, Value.Max*M_RAD_TO_DEG);
+			valXcomp	= Value.Sum_Sin / Value.n;
+			valYcomp	= Value.Sum_Cos / Value.n;
+			val			= valXcomp ? fmod(M_PI_270 + atan2(valYcomp, valXcomp), M_PI_360) : (valYcomp > 0 ? M_PI_270 : (valYcomp < 0 ? M_PI_090 : -1));
+			val			= fmod(M_PI_360 - val, M_PI_360);
+			pRecord		->Set_Value(nCatGrids+5+iGrid, val*M_RAD_TO_DEG);
 		}
+	}
 
 
-		runList->next = NULL;
-		delete (runList);													// delete disconneted part of the list
+	//-----------------------------------------------------
+	NDcountStat	= 0;												// NoData Counter (StatGrids)
 
+	for(iGrid=0; iGrid<nStatGrids; iGrid++)
+	{
+		NDcountStat	+= Statistics.Get_NoData(iGrid);
 	}
 
+	if( pAspect != NULL )
+	{
+		NDcountStat	+= 2 * Statistics.Get_NoData(nStatGrids);		// counted for sine and cosine components
+	}
 
 	if( NDcountStat > 0 )
 	{
-		Message_Add(CSG_String::Format(SG_T("\n\n\n%s: %d %s\n\n\n"), _TL("WARNING"), NDcountStat, _TL("NoData value(s) in statistic grid(s)!")));
+		Message_Add(CSG_String::Format(SG_T("\n\n\n%s: %d %s\n\n\n"), _TL("WARNING"), (int)NDcountStat, _TL("NoData value(s) in statistic grid(s)!")));
 	}
 
 	return (true);
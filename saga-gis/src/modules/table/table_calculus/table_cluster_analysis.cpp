@@ -90,6 +90,19 @@ CTable_Cluster_Analysis::CTable_Cluster_Analysis(bool bShapes)
 		"- Rubin, J. (1967):\n"
 		"  'Optimal Classification into Groups: An Approach for Solving the Taxonomy Problem',\n"
 		"  J. Theoretical Biology, 15:103-144\n\n"
+
+		"k-Means++:\n"
+		"- Arthur, D., Vassilvitskii, S. (2007):\n"
+		"  'k-means++: The Advantages of Careful Seeding',\n"
+		"  Proc. 18th ACM-SIAM Symposium on Discrete Algorithms, 1027-1035\n"
+		"- Hamerly, G. (2010):\n"
+		"  'Making k-means even faster',\n"
+		"  Proc. SIAM International Conference on Data Mining, 130-140\n\n"
+
+		"Mini-Batch k-Means:\n"
+		"- Sculley, D. (2010):\n"
+		"  'Web-Scale K-Means Clustering',\n"
+		"  Proc. 19th International Conference on World Wide Web, 1177-1178\n\n"
 	));
 
 	//-----------------------------------------------------
@@ -130,10 +143,12 @@ CTable_Cluster_Analysis::CTable_Cluster_Analysis(bool bShapes)
 	Parameters.Add_Choice(
 		NULL	, "METHOD"		, _TL("Method"),
 		_TL(""),
-		CSG_String::Format(SG_T("%s|%s|%s|"),
+		CSG_String::Format(SG_T("%s|%s|%s|%s|%s|"),
 			_TL("Iterative Minimum Distance (Forgy 1965)"),
 			_TL("Hill-Climbing (Rubin 1967)"),
-			_TL("Combined Minimum Distance / Hillclimbing") 
+			_TL("Combined Minimum Distance / Hillclimbing"),
+			_TL("k-Means++ (Arthur & Vassilvitskii 2007)"),
+			_TL("Mini-Batch k-Means (Sculley 2010)")
 		), 1
 	);
 
@@ -143,6 +158,12 @@ CTable_Cluster_Analysis::CTable_Cluster_Analysis(bool bShapes)
 		PARAMETER_TYPE_Int, 10, 2, true
 	);
 
+	Parameters.Add_Value(
+		NULL	, "BATCHSIZE"	, _TL("Batch Size"),
+		_TL("number of samples drawn in each iteration of the mini-batch method, chosen automatically if set to zero (default)"),
+		PARAMETER_TYPE_Int, 0, 0, true
+	);
+
 	Parameters.Add_Value(
 		NULL	, "NORMALISE"	, _TL("Normalise"),
 		_TL("Automatically normalise grids by standard deviation before clustering."),
@@ -255,7 +276,7 @@ bool CTable_Cluster_Analysis::On_Execute(void)
 	}
 
 	//-----------------------------------------------------
-	bool	bResult	= Analysis.Execute(Parameters("METHOD")->asInt(), Parameters("NCLUSTER")->asInt());
+	bool	bResult	= Analysis.Execute(Parameters("METHOD")->asInt(), Parameters("NCLUSTER")->asInt(), 0, Parameters("BATCHSIZE")->asInt());
 
 	for(iElement=0, nElements=0; iElement<pTable->Get_Count(); iElement++)
 	{
@@ -107,6 +107,12 @@ CChannelNetwork::CChannelNetwork(void)
 		PARAMETER_INPUT_OPTIONAL
 	);
 
+	Parameters.Add_Grid(
+		NULL	, "FLOW_GRAPH"	, _TL("Flow Routing Graph"),
+		_TL("precomputed flow routing as created with the 'Flow Routing Graph' tool, each cell drains to the receiver getting its largest fraction, if set, flow direction and tracing weight are ignored"),
+		PARAMETER_INPUT_OPTIONAL
+	);
+
 
 	//-----------------------------------------------------
 	// Output...
@@ -219,6 +225,15 @@ bool CChannelNetwork::On_Execute(void)
 
 	maxDivCells			= Parameters("DIV_GRID" )->asGrid() ? Parameters("DIV_CELLS")->asInt() : -1;
 
+	CSG_Grid_Flow_Graph	Graph;
+
+	if( Parameters("FLOW_GRAPH")->asGrid() && !Graph.Set_Grid(Parameters("FLOW_GRAPH")->asGrid()) )
+	{
+		Error_Set(_TL("invalid flow routing graph"));
+
+		return( false );
+	}
+
 	if( !pDTM->Set_Index() )
 	{
 		Error_Set(_TL("index creation failed"));
@@ -241,7 +256,13 @@ bool CChannelNetwork::On_Execute(void)
 	{
 		for(x=0; x<Get_NX(); x++)
 		{
-			if( Trace_pRoute && (ID = Trace_pRoute->asChar(x, y)) >= 1 && ID <= 8 )
+			if( Graph.is_Okay() )
+			{
+				ID	= Graph.Get_Direction(x, y);
+
+				pChannels->Set_Value(x, y, ID < 0 ? 0 : ID == 0 ? 8 : ID);	// 1 to 8, with 8 pointing north
+			}
+			else if( Trace_pRoute && (ID = Trace_pRoute->asChar(x, y)) >= 1 && ID <= 8 )
 			{
 				pChannels->Set_Value(x, y, ID);
 			}
@@ -97,6 +97,12 @@ CWatersheds::CWatersheds(void)
 		PARAMETER_INPUT_OPTIONAL
 	);
 
+	Parameters.Add_Grid(
+		NULL, "FLOW_GRAPH"	, _TL("Flow Routing Graph"),
+		_TL("precomputed flow routing as created with the 'Flow Routing Graph' tool, each cell drains to the receiver getting its largest fraction, if set, the sink route is ignored"),
+		PARAMETER_INPUT_OPTIONAL
+	);
+
 	Parameters.Add_Grid(
 		NULL, "BASINS"		, _TL("Watershed Basins"),
 		_TL(""),
@@ -138,6 +144,15 @@ bool CWatersheds::On_Execute(void)
 	nCells_Min	= Parameters("MINSIZE"  )->asInt();
 	m_pBasins	= Parameters("BASINS"   )->asGrid();
 
+	CSG_Grid_Flow_Graph	Graph;
+
+	if( Parameters("FLOW_GRAPH")->asGrid() && !Graph.Set_Grid(Parameters("FLOW_GRAPH")->asGrid()) )
+	{
+		Error_Set(_TL("invalid flow routing graph"));
+
+		return( false );
+	}
+
 	m_pBasins->Set_NoData_Value(NO_BASIN);
 	m_pBasins->Assign_NoData();
 
@@ -158,6 +173,12 @@ bool CWatersheds::On_Execute(void)
 			{
 				m_Direction.Set_NoData(x, y);
 			}
+			else if( Graph.is_Okay() )
+			{
+				n	= Graph.Get_Direction(x, y);
+
+				m_Direction.Set_Value(x, y, (int)(n < 0 ? -1 : (n + 4) % 8));
+			}
 			else
 			{
 				if( !pRoute || (n = pRoute->asChar(x, y)) <= 0 )
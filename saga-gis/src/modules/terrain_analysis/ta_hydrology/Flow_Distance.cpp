@@ -119,6 +119,12 @@ CFlow_Distance::CFlow_Distance(void)
 		PARAMETER_INPUT_OPTIONAL
 	);
 
+	Parameters.Add_Grid(
+		NULL	, "FLOW_GRAPH"	, _TL("Flow Routing Graph"),
+		_TL("precomputed flow routing as created with the 'Flow Routing Graph' tool, if set, the chosen method is ignored"),
+		PARAMETER_INPUT_OPTIONAL
+	);
+
 
 	//-----------------------------------------------------
 	// Output...
@@ -160,6 +166,74 @@ CFlow_Distance::~CFlow_Distance(void)
 {}
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+class CFlow_Distance_Engine : public CSG_Grid_Flow_Accumulation
+{
+public:
+	CFlow_Distance_Engine(CSG_Grid *pSeed, CSG_Grid *pLength, bool bSeeds)
+		: m_bSeeds(bSeeds), m_pSeed(pSeed), m_pLength(pLength)
+	{}
+
+
+protected:
+
+	//-----------------------------------------------------
+	virtual void		On_Cell			(int x, int y)
+	{
+		if( m_pSeed && !m_pSeed->is_NoData(x, y) )
+		{
+			m_pLength->Set_Value(x, y, 0.0);
+
+			return;
+		}
+
+		double	Length	= 0.0, Weight	= 0.0, Donors[8];
+
+		if( Get_Donors(x, y, Donors) > 0 )
+		{
+			for(int i=0; i<8; i++)
+			{
+				int	ix	= CSG_Grid_System::Get_xTo(i, x);
+				int	iy	= CSG_Grid_System::Get_yTo(i, y);
+
+				if( Donors[i] > 0.0 && !m_pLength->is_NoData(ix, iy) )
+				{
+					Length	+= Donors[i] * (m_pLength->asDouble(ix, iy) + Get_System().Get_Length(i));
+					Weight	+= Donors[i];
+				}
+			}
+		}
+
+		if( Weight > 0.0 )
+		{
+			m_pLength->Set_Value(x, y, Length / Weight);
+		}
+		else if( m_bSeeds )
+		{
+			m_pLength->Set_NoData(x, y);
+		}
+		else
+		{
+			m_pLength->Set_Value(x, y, 0.0);
+		}
+	}
+
+
+private:
+
+	bool				m_bSeeds;
+
+	CSG_Grid			*m_pSeed, *m_pLength;
+
+};
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -182,6 +256,33 @@ bool CFlow_Distance::On_Execute(void)
 	bSeeds		= Parameters("SEEDS_ONLY" )->asBool();
 	Method		= Parameters("METHOD"     )	->asInt();
 
+	//-------------------------------------------------
+	CSG_Grid_Flow_Graph	Graph;
+
+	if( Parameters("FLOW_GRAPH")->asGrid() && !Graph.Set_Grid(Parameters("FLOW_GRAPH")->asGrid()) )
+	{
+		Error_Set(_TL("invalid flow routing graph"));
+
+		return( false );
+	}
+
+	if( Graph.is_Okay() )	// routing and processing order are taken from the graph
+	{
+		CFlow_Distance_Engine	Engine(pSeed, m_pLength, bSeeds);
+
+		m_pLength->Assign(0.0);
+
+		if( !Engine.Create(&Graph) || !Engine.Execute() )
+		{
+			return( false );
+		}
+
+		DataObject_Set_Colors(m_pLength, 100, SG_COLORS_WHITE_BLUE);
+
+		return( true );
+	}
+
+	//-------------------------------------------------
 	m_pWeight	= SG_Create_Grid(m_pLength, SG_DATATYPE_Float);
 	m_pWeight	->Assign(0.0);
 	m_pLength	->Assign(0.0);
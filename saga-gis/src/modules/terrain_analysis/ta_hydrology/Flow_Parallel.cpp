@@ -146,6 +146,12 @@ CFlow_Parallel::CFlow_Parallel(void)
 		PARAMETER_INPUT_OPTIONAL
 	);
 
+	Parameters.Add_Grid(
+		NULL	, "FLOW_GRAPH"	, _TL("Flow Routing Graph"),
+		_TL("precomputed flow routing as created with the 'Flow Routing Graph' tool, if set, the chosen method is ignored"),
+		PARAMETER_INPUT_OPTIONAL
+	);
+
 
 	//-----------------------------------------------------
 	Parameters.Add_Choice(
@@ -268,63 +274,204 @@ bool CFlow_Parallel::Calculate(int x, int y)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CFlow_Parallel::Set_Flow(void)
+class CFlow_Parallel_Engine : public CSG_Grid_Flow_Accumulation
 {
+public:
+	CFlow_Parallel_Engine(CFlow_Parallel *pFlow, double dLinear, CSG_Grid *pLinear_Val)
+		: m_pFlow(pFlow), m_dLinear(dLinear), m_pLinear_Val(pLinear_Val)
+	{}
+
+
+protected:
+
 	//-----------------------------------------------------
-	if( !m_pDTM->Set_Index() )
+	bool				is_Linear		(int x, int y)
 	{
-		return( false );
+		return( m_dLinear > 0.0 && m_dLinear <= (m_pLinear_Val && !m_pLinear_Val->is_NoData(x, y) ? m_pLinear_Val->asDouble(x, y) : m_pFlow->m_pCatch->asDouble(x, y)) );
 	}
 
 	//-----------------------------------------------------
-	int Method	= Parameters("METHOD")->asInt();
+	virtual bool		On_Routing		(int x, int y, double Fraction[8])
+	{
+		if( is_Linear(x, y) )	// the cell is complete, when its routing is requested
+		{
+			int	i	= m_pFlow->m_pDTM->Get_Gradient_NeighborDir(x, y);
+
+			for(int j=0; j<8; j++)
+			{
+				Fraction[j]	= i == j ? 1.0 : 0.0;
+			}
+
+			return( i >= 0 );
+		}
+
+		return( Get_Routing(x, y, Fraction) );
+	}
 
-	if( Method == 2 )
+	//-----------------------------------------------------
+	virtual int			On_Receivers	(int x, int y)
 	{
-		BRM_Init();
+		int		i, Mask	= 0;
+		double	Fraction[8];
+
+		if( Get_Routing(x, y, Fraction) )
+		{
+			for(i=0; i<8; i++)
+			{
+				if( Fraction[i] > 0.0 )
+				{
+					Mask	|= 1 << i;
+				}
+			}
+		}
+
+		if( m_dLinear > 0.0 && (i = m_pFlow->m_pDTM->Get_Gradient_NeighborDir(x, y)) >= 0 )
+		{
+			Mask	|= 1 << i;	// accumulation is not known yet, so linear flow might be applied
+		}
+
+		return( Mask );
 	}
 
 	//-----------------------------------------------------
+	virtual void		On_Cell			(int x, int y)
+	{
+		double	Donors[8];
+
+		if( Get_Donors(x, y, Donors) > 0 )
+		{
+			for(int i=0; i<8; i++)
+			{
+				if( Donors[i] > 0.0 )
+				{
+					m_pFlow->Add_Fraction(CSG_Grid_System::Get_xTo(i, x), CSG_Grid_System::Get_yTo(i, y), (i + 4) % 8, Donors[i]);
+				}
+			}
+		}
+
+		if( m_pFlow->m_bGT_Zero && m_pFlow->m_pCatch->asDouble(x, y) < 0.0 )
+		{
+			m_pFlow->m_pCatch->Set_Value(x, y, 0.0);
+		}
+	}
+
+
+private:
+
+	CFlow_Parallel		*m_pFlow;
+
+	double				m_dLinear;
+
+	CSG_Grid			*m_pLinear_Val;
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CFlow_Parallel::Set_Flow(void)
+{
+	//-----------------------------------------------------
+	int Method	= Parameters("METHOD")->asInt();
+
 	double	dLinear	= Parameters("LINEAR_DO")->asBool() ? Parameters("LINEAR_MIN")->asDouble() : -1.0;
 
 	CSG_Grid	*pLinear_Val	= Parameters("LINEAR_VAL")->asGrid();
 	CSG_Grid	*pLinear_Dir	= Parameters("LINEAR_DIR")->asGrid();
 
+	TSG_Flow_Routing	Routing;
+
+	switch( Method )
+	{
+	default:	Routing	= SG_FLOW_ROUTING_D8   ;	break;
+	case 1:		Routing	= SG_FLOW_ROUTING_Rho8 ;	break;
+	case 3:		Routing	= SG_FLOW_ROUTING_DInf ;	break;
+	case 4:		Routing	= SG_FLOW_ROUTING_MFD  ;	break;
+	case 5:		Routing	= SG_FLOW_ROUTING_MDInf;	break;
+	}
+
+	CSG_Grid_Flow_Graph	Graph;
+
+	if( Parameters("FLOW_GRAPH")->asGrid() && !Graph.Set_Grid(Parameters("FLOW_GRAPH")->asGrid()) )
+	{
+		Error_Set(_TL("invalid flow routing graph"));
+
+		return( false );
+	}
+
+	CFlow_Parallel_Engine	Engine(this, dLinear, pLinear_Val);
+
+	if( Graph.is_Okay() )
+	{
+		Engine.Create(&Graph);
+	}
+	else
+	{
+		Engine.Create(m_pDTM, Routing, m_Converge);
+	}
+
 	//-----------------------------------------------------
-	for(sLong n=0; n<Get_NCells() && Set_Progress_NCells(n); n++)
+	// dependency driven, parallel processing, no sorting required
+
+	if( !pLinear_Dir && (Graph.is_Okay() || (Method != 2 && Method != 6)) )
 	{
-		int		x, y;
+		if( !Engine.Execute() )
+		{
+			return( false );
+		}
+	}
+
+	//-----------------------------------------------------
+	// elevation sorted processing, channel directions may lead upwards
 
-		if( m_pDTM->Get_Sorted(n, x, y) )
+	else
+	{
+		if( !m_pDTM->Set_Index() )
 		{
-			if( m_bGT_Zero && m_pCatch->asDouble(x, y) < 0.0 )
-			{
-				m_pCatch->Set_Value(x, y, 0.0);
-			}
+			return( false );
+		}
 
-			if( pLinear_Dir && !pLinear_Dir->is_NoData(x, y) )
-			{
-				Set_D8(x, y, pLinear_Dir->asInt(x, y));
-			}
-			else if( dLinear > 0.0 && dLinear <= (pLinear_Val && !pLinear_Val->is_NoData(x, y) ? pLinear_Val->asDouble(x, y) : m_pCatch->asDouble(x, y)) )
-			{
-				Set_D8(x, y, pLinear_Dir && !pLinear_Dir->is_NoData(x, y) ? pLinear_Dir->asInt(x, y) : -1);
-			}
-			else switch( Method )
+		if( Method == 2 && !Graph.is_Okay() )
+		{
+			BRM_Init();
+		}
+
+		for(sLong n=0; n<Get_NCells() && Set_Progress_NCells(n); n++)
+		{
+			int		x, y;
+
+			if( m_pDTM->Get_Sorted(n, x, y) )
 			{
-			case 0:	Set_D8    (x, y);	break;
-			case 1:	Set_Rho8  (x, y);	break;
-			case 2:	Set_BRM   (x, y);	break;
-			case 3:	Set_DInf  (x, y);	break;
-			case 4:	Set_MFD   (x, y);	break;
-			case 5:	Set_MDInf (x, y);	break;
-			case 6:	Set_MMDGFD(x, y);	break;
+				if( m_bGT_Zero && m_pCatch->asDouble(x, y) < 0.0 )
+				{
+					m_pCatch->Set_Value(x, y, 0.0);
+				}
+
+				if( pLinear_Dir && !pLinear_Dir->is_NoData(x, y) )
+				{
+					Set_D8(x, y, pLinear_Dir->asInt(x, y));
+				}
+				else if( dLinear > 0.0 && dLinear <= (pLinear_Val && !pLinear_Val->is_NoData(x, y) ? pLinear_Val->asDouble(x, y) : m_pCatch->asDouble(x, y)) )
+				{
+					Set_D8(x, y);
+				}
+				else switch( Graph.is_Okay() ? -1 : Method )
+				{
+				case 2:	Set_BRM    (x, y);	break;
+				case 6:	Set_MMDGFD (x, y);	break;
+				default:	Set_Routing(x, y, Engine);	break;
+				}
 			}
 		}
 	}
 
 	//-----------------------------------------------------
-	if( m_pRoute )
+	if( m_pRoute && m_pDTM->Set_Index() )
 	{
 		for(sLong n=0; n<Get_NCells() && Set_Progress_NCells(n); n++)
 		{
@@ -413,168 +560,22 @@ void CFlow_Parallel::Set_D8(int x, int y, int Direction)
 
 ///////////////////////////////////////////////////////////
 //														 //
-//						Rho 8							 //
-//														 //
-///////////////////////////////////////////////////////////
-
-//---------------------------------------------------------
-void CFlow_Parallel::Set_Rho8(int x, int y)
-{
-	int		iMax	= -1;
-	double	dMax, z	= m_pDTM->asDouble(x, y);
-
-	for(int i=0; i<8; i++)
-	{
-		int	ix	= Get_xTo(i, x);
-		int	iy	= Get_yTo(i, y);
-
-		if( !m_pDTM->is_InGrid(ix, iy) )
-		{
-			return;
-		}
-		else
-		{
-			double	d	= z - m_pDTM->asDouble(ix, iy);
-
-			if( i % 2 == 1 )
-			{
-				d	/= 1.0 + rand() / (double)RAND_MAX;
-			}
-
-			if( iMax < 0 || dMax < d )
-			{
-				iMax	= i;
-				dMax	= d;
-			}
-		}
-	}
-
-	if( iMax >= 0 )
-	{
-		Add_Fraction(x, y, iMax);
-	}
-}
-
-/*void CFlow_Parallel::Set_Rho8(	int x, int y )
-{
-	int		Direction, ix, iy;
-
-	double 	Slope, Aspect;
-
-	Get_Gradient(x, y, Slope, Aspect);
-
-	if( Aspect >= 0 )
-	{
-		Direction	= (int)(Aspect / M_PI_045);
-
-		if( fmod(Aspect, M_PI_045) / M_PI_045 > rand() / (double)RAND_MAX )
-		{
-			Direction++;
-		}
-
-		Direction	%= 8;
-
-		ix			= Get_xTo(Direction, x);
-		iy			= Get_yTo(Direction, y);
-
-		if( is_InGrid(ix, iy) && m_pDTM->asDouble(ix, iy) >= m_pDTM->asDouble(x, y) )
-		{
-			Direction	= Get_Direction_Lowest(m_pDTM, x, y);
-		}
-
-		Add_Fraction(x, y, Direction);
-	}
-}/**/
-
-
-///////////////////////////////////////////////////////////
-//														 //
-//				Deterministic Infinity					 //
-//														 //
-///////////////////////////////////////////////////////////
-
-//---------------------------------------------------------
-void CFlow_Parallel::Set_DInf(int x, int y)
-{
-	double	s, a;
-
-	if( m_pDTM->Get_Gradient(x, y, s, a) && a >= 0.0 )
-	{
-		int	i, ix, iy;
-
-		i	= (int)(a / M_PI_045);
-		a	= fmod (a , M_PI_045) / M_PI_045;
-		s	= m_pDTM->asDouble(x, y);
-
-		if( m_pDTM->is_InGrid(ix = Get_xTo(i + 0, x), iy = Get_yTo(i + 0, y)) && m_pDTM->asDouble(ix, iy) < s
-		&&  m_pDTM->is_InGrid(ix = Get_xTo(i + 1, x), iy = Get_yTo(i + 1, y)) && m_pDTM->asDouble(ix, iy) < s )
-		{
-			Add_Fraction(x, y,  i         , 1.0 - a);
-			Add_Fraction(x, y, (i + 1) % 8,       a);
-
-			return;
-		}
-	}
-
-	Set_D8(x, y);
-}
-
-
-///////////////////////////////////////////////////////////
-//														 //
-//				Multiple Flow Direction					 //
+//		Rho 8, DInf, MFD, Triangular MFD				 //
 //														 //
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-void CFlow_Parallel::Set_MFD(int x, int y)
+void CFlow_Parallel::Set_Routing(int x, int y, const CSG_Grid_Flow_Accumulation &Routing)
 {
-	int		i, ix, iy;
-	double	z, d, dzSum, dz[8];
+	double	Fraction[8];
 
-	//-----------------------------------------------------
-	for(i=0, dzSum=0.0, z=m_pDTM->asDouble(x, y); i<8; i++)
+	if( Routing.Get_Routing(x, y, Fraction) )
 	{
-		ix	= Get_xTo(i, x);
-		iy	= Get_yTo(i, y);
-
-		if( m_pDTM->is_InGrid(ix, iy) )
+		for(int i=0; i<8; i++)
 		{
-			d	= z - m_pDTM->asDouble(ix, iy);
-		}
-		else
-		{
-			ix	= Get_xTo(i + 4, x);
-			iy	= Get_yTo(i + 4, y);
-
-			if( m_pDTM->is_InGrid(ix, iy) )
-			{
-				d	= m_pDTM->asDouble(ix, iy) - z;
-			}
-			else
+			if( Fraction[i] > 0.0 )
 			{
-				d	= 0.0;
-			}
-		}
-
-		if( d > 0.0 )
-		{
-			dzSum	+= (dz[i] = pow(d / Get_Length(i), m_Converge));
-		}
-		else
-		{
-			dz[i]	= 0.0;
-		}
-	}
-
-	//-----------------------------------------------------
-	if( dzSum > 0.0 )
-	{
-		for(i=0; i<8; i++)
-		{
-			if( dz[i] > 0.0 )
-			{
-				Add_Fraction(x, y, i, dz[i] / dzSum);
+				Add_Fraction(x, y, i, Fraction[i]);
 			}
 		}
 	}
@@ -657,183 +658,6 @@ void CFlow_Parallel::Set_MMDGFD(int x, int y)
 }
 
 
-///////////////////////////////////////////////////////////
-//														 //
-//			Multiple Triangular Flow Direction			 //
-//														 //
-///////////////////////////////////////////////////////////
-
-//---------------------------------------------------------
-void CFlow_Parallel::Set_MDInf(int x, int y)
-{
-	int		i, ix, iy;
-
-	double	dz[8], s_facet[8], r_facet[8], valley[8], portion[8];
-
-	bool	bInGrid[8];
-
-	//-----------------------------------------------------
-	double	z	= m_pDTM->asDouble(x, y);
-
-	for(i=0; i<8; i++)
-	{
-		s_facet[i]	= r_facet[i]	= -999.0;
-
-		ix	= Get_xTo(i, x);
-		iy	= Get_yTo(i, y);
-		
-		if( (bInGrid[i] = m_pDTM->is_InGrid(ix, iy)) )
-		{
-			dz[i]	= z - m_pDTM->asDouble(ix, iy);
-		}
-		else
-		{
-			dz[i]	= 0.0;
-		}
-	}
-
-	//-----------------------------------------------------
-	for(i=0; i<8; i++)
-	{
-		double	hs	= -999.;
-		double	hr	= -999.;
-		
-		if( bInGrid[i] )
-		{
-			int	j	= i < 7 ? i + 1 : 0;
-			
-			if( bInGrid[j] )
-			{			
-				double	nx	= (dz[j] * Get_yTo(i) - dz[i] * Get_yTo(j)) * Get_Cellsize();			// vb-code:  nx = (z1 * yd(j) - z2 * yd(i)) * gridsize
-/*ERROR?*/		double	ny	= (dz[i] * Get_xTo(j) - dz[j] * Get_xTo(i)) * Get_Cellsize();			// vb-code:  ny = (z1 * xd(j) - z2 * xd(i)) * gridsize
-				double	nz	= (Get_xTo(i) * Get_yTo(j) - Get_xTo(j) * Get_yTo(i)) * Get_Cellarea();	// vb-code:  nz = (xd(j) * yd(i) - xd(i) * yd(j)) * gridsize ^ 2
-				
-				double	n_norm	= sqrt(nx*nx + ny*ny +nz*nz);
-
-			/*	if( nx == 0.0 )
-				{
-					hr = (ny >= 0.0)? 0.0 : M_PI;
-				} 
-				else if( nx > 0.0 )
-				{
-					hr = M_PI_090 - atan(ny / nx);
-				} 
-				else
-				{
-					hr = M_PI_270 - atan(ny / nx);
-				}	*/
-
-				if( nx == 0.0 )
-				{
-					hr = (ny >= 0.0)? 0.0 : M_PI;
-				} 
-				else if( nx < 0.0 )
-				{
-					hr = M_PI_270 - atan(ny / nx);
-				} 
-				else
-				{
-					hr = M_PI_090 - atan(ny / nx);
-				}
-
-				hs	= -tan( acos( nz/n_norm ) );	// vb-code:  hs = -Tan(arccos(nz / betrag_n))
-				
-				// vb-code: If hr <= (i - 1) * PI / 4 Or hr >= i * PI / 4 Then
-				//SHOULD IT BE LIKE THIS: (( hr <= i * M_PI_045 || hr >= j * M_PI_045 )  OR AS BELOW???
-				if( hr < i * M_PI_045 || hr > (i+1) * M_PI_045 )
-				{
-					if( dz[i] > dz[j] )
-					{
-						hr	= i * M_PI_045;
-						hs	= dz[i] / Get_Length(i);
-					}
-					else
-					{
-						hr	= j * M_PI_045;
-						hs	= dz[j] / Get_Length(j);						
-					}
-				}				
-			}
-			else if( dz[i] > 0.0 )
-			{
-				hr	= i * M_PI_045;
-				hs	= dz[i] / Get_Length(i);
-			}
-			
-			s_facet[i]	= hs;
-			r_facet[i]	= hr;
-		}
-	}
-	
-	//-----------------------------------------------------
-	double	dzSum	= 0.0;
-	
-	for(i=0; i<8; i++)
-	{		
-		valley[i]	= 0.0;
-
-		int	j	= i < 7 ? i + 1 : 0;
-		
-		if( s_facet[i] > 0.0 )
-		{
-			if( r_facet[i] > i * M_PI_045 && r_facet[i] < (i+1) * M_PI_045 )
-			{
-				valley[i] = s_facet[i];
-			}
-			else if( r_facet[i] == r_facet[j] )
-			{
-				valley[i] = s_facet[i];
-			}
-			else if( s_facet[j] == -999.0 && r_facet[i] == (i+1) * M_PI_045 )
-			{
-				valley[i] = s_facet[i];
-			}
-			else
-			{
-				j = i > 0 ? i - 1 : 7;
-
-				if( s_facet[j] == -999.0 && r_facet[i] == i * M_PI_045 )
-				{
-					valley[i] = s_facet[i];
-				}
-			}
-			
-			valley[i] = pow(valley[i], m_Converge);
-			dzSum += valley[i];
-		} 
-		
-		portion[i] = 0.0;
-	}
-
-	//-----------------------------------------------------
-	if( dzSum )
-	{
-		for(i=0; i<8; i++)
-		{
-			int	j	= i < 7 ? i + 1 : 0;
-
-			if( i >= 7 && r_facet[i] == 0.0 )
-			{
-				r_facet[i]	= M_PI_360;
-			}
-
-			if( valley[i] )
-			{
-				valley[i]	/= dzSum;
-
-				portion[i]	+= valley[i] * ((i+1) * M_PI_045 - r_facet[i]) / M_PI_045;	// vb-code: portion(i) = portion(i) + valley(i) * (i * PI / 4 - r_facet(i)) / (PI / 4)
-				portion[j]	+= valley[i] * (r_facet[i] - (i  ) * M_PI_045) / M_PI_045;	// vb-code: portion(j) = portion(j) + valley(i) * (r_facet(i) - (i - 1) * PI / 4) / (PI / 4)
-			}
-		}
-
-		for(i=0; i<8; i++)
-		{
-			Add_Fraction(x, y, i, portion[i]);
-		}
-	}
-}
-
-
 ///////////////////////////////////////////////////////////
 //														 //
 //				Braunschweiger Reliefmodell				 //
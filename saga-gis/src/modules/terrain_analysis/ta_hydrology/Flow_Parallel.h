@@ -84,6 +84,8 @@
 //---------------------------------------------------------
 class ta_hydrology_EXPORT CFlow_Parallel : public CFlow  
 {
+	friend class CFlow_Parallel_Engine;
+
 public:
 	CFlow_Parallel(void);
 
@@ -105,11 +107,8 @@ private:
 	void					Check_Route		(int x, int y);
 
 	void					Set_D8			(int x, int y, int Direction = -1);
-	void					Set_Rho8		(int x, int y );
-	void					Set_DInf		(int x, int y );
-	void					Set_MFD			(int x, int y );
+	void					Set_Routing		(int x, int y, const CSG_Grid_Flow_Accumulation &Routing);
 	void					Set_MMDGFD		(int x, int y );	
-	void					Set_MDInf		(int x, int y );	
 	void					Set_BRM			(int x, int y );
 
 	//-----------------------------------------------------
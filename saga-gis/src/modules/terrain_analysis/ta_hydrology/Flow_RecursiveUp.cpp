@@ -118,6 +118,12 @@ CFlow_RecursiveUp::CFlow_RecursiveUp(void)
 		PARAMETER_INPUT_OPTIONAL
 	);
 
+	Parameters.Add_Grid(
+		NULL	, "FLOW_GRAPH"	, _TL("Flow Routing Graph"),
+		_TL("precomputed flow routing as created with the 'Flow Routing Graph' tool, if set, the chosen method is ignored"),
+		PARAMETER_INPUT_OPTIONAL
+	);
+
 
 	//-----------------------------------------------------
 	// Output...
@@ -158,12 +164,21 @@ CFlow_RecursiveUp::CFlow_RecursiveUp(void)
 		_TL("keep accumulated weights above zero; useful e.g. when accumulating measures of water balance."),
 		PARAMETER_TYPE_Bool, true
 	);
+}
 
-	
-	//-----------------------------------------------------
-	// Initialisations...
 
-	m_Flow	= NULL;
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+void CFlow_RecursiveUp::On_Initialize(void)
+{
+	m_pFlowPath	= Parameters("FLOWLEN")->asGrid();
+	m_Converge	= Parameters("CONVERGENCE")->asDouble();
+	m_bGT_Zero	= m_pWeight ? Parameters("WEIGHT_GT_0")->asBool() : false;
 }
 
 
@@ -174,84 +189,77 @@ CFlow_RecursiveUp::CFlow_RecursiveUp(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-void CFlow_RecursiveUp::On_Create(void)
+class CFlow_RecursiveUp_Engine : public CSG_Grid_Flow_Accumulation
 {
-	int	x, y;
+public:
+	CFlow_RecursiveUp_Engine(CFlow_RecursiveUp *pFlow, bool bUpslope)
+		: m_pFlow(pFlow), m_bUpslope(bUpslope)
+	{}
 
 	//-----------------------------------------------------
-	On_Destroy();
+	bool				Get_Flow		(int x, int y, double Fraction[8])
+	{
+		return( On_Routing(x, y, Fraction) );
+	}
 
-	m_Flow		= (double ***)SG_Malloc(    Get_NY    () * sizeof(double **));
-	double *p	= (double   *)SG_Malloc(8 * Get_NCells() * sizeof(double   ));
 
-	for(y=0; y<Get_NY(); y++)
-	{
-		m_Flow[y]	= (double **)SG_Malloc( Get_NX    () * sizeof(double  *));
+protected:
 
-		for(x=0; x<Get_NX(); x++, p+=8)
+	//-----------------------------------------------------
+	virtual bool		On_Routing		(int x, int y, double Fraction[8])
+	{
+		if( m_pFlow->m_pRoute && m_pFlow->m_pRoute->asChar(x, y) > 0 )
 		{
-			m_Flow[y][x]	= p;
+			int	i	= m_pFlow->m_pRoute->asChar(x, y) % 8;
+
+			for(int j=0; j<8; j++)
+			{
+				Fraction[j]	= i == j ? 1.0 : 0.0;
+			}
+
+			return( true );
 		}
+
+		return( Get_Routing(x, y, Fraction) );
 	}
 
 	//-----------------------------------------------------
-	Lock_Create();
+	virtual void		On_Cell			(int x, int y)
+	{
+		if( m_bUpslope && !m_pFlow->is_Locked(x, y) )
+		{
+			return;
+		}
 
-	int Method	= Parameters("METHOD")->asInt();
+		m_pFlow->Init_Cell(x, y);
 
-	memset(m_Flow[0][0], 0, 8 * Get_NCells() * sizeof(double) );
+		double	Donors[8];
 
-	for(y=0; y<Get_NY(); y++)
-	{
-		for(x=0; x<Get_NX(); x++)
+		if( Get_Donors(x, y, Donors) > 0 )
 		{
-			if( m_pRoute && m_pRoute->asChar(x, y) > 0 )
-			{
-				m_Flow[y][x][m_pRoute->asChar(x, y) % 8]	= 1.0;
-			}
-			else switch( Method )
+			for(int i=0; i<8; i++)
 			{
-				case 0:	Set_D8  (x, y);	break;
-				case 1:	Set_Rho8(x, y);	break;
-				case 2:	Set_DInf(x, y);	break;
-				case 3:	Set_MFD (x, y);	break;
+				if( Donors[i] > 0.0 )
+				{
+					m_pFlow->Add_Fraction(CSG_Grid_System::Get_xTo(i, x), CSG_Grid_System::Get_yTo(i, y), (i + 4) % 8, Donors[i]);
+				}
 			}
 		}
-	}
-}
 
-//---------------------------------------------------------
-void CFlow_RecursiveUp::On_Destroy(void)
-{
-	if( m_Flow )
-	{
-		SG_Free(m_Flow[0][0]);
-
-		for(int y=0; y<Get_NY(); y++)
+		if( m_pFlow->m_bGT_Zero && m_pFlow->m_pCatch->asDouble(x, y) < 0.0 )
 		{
-			SG_Free(m_Flow[y]);
+			m_pFlow->m_pCatch->Set_Value(x, y, 0.0);
 		}
+	}
 
-		SG_Free(m_Flow);
 
-		m_Flow	= NULL;
-	}
-}
+private:
 
+	CFlow_RecursiveUp	*m_pFlow;
 
-///////////////////////////////////////////////////////////
-//														 //
-//														 //
-//														 //
-///////////////////////////////////////////////////////////
+	bool				m_bUpslope;
 
-//---------------------------------------------------------
-void CFlow_RecursiveUp::On_Initialize(void)
-{
-	m_pFlowPath	= Parameters("FLOWLEN")->asGrid();
-	m_Converge	= Parameters("CONVERGENCE")->asDouble();
-	m_bGT_Zero	= m_pWeight ? Parameters("WEIGHT_GT_0")->asBool() : false;
-}
+};
 
 
 ///////////////////////////////////////////////////////////
@@ -265,122 +273,80 @@ bool CFlow_RecursiveUp::Calculate(void)
 {
 	CSG_Grid	*pTargets	= Parameters("TARGETS")->asGrid();
 
-	On_Create();
+	CSG_Grid_Flow_Graph			Graph;
+	CFlow_RecursiveUp_Engine	Engine(this, pTargets != NULL);
 
-	for(int y=0; y<Get_NY() && Set_Progress(y); y++)
+	if( !Set_Routing(Engine, Graph) )
 	{
-		for(int x=0; x<Get_NX(); x++)
-		{
-			if( !pTargets || !pTargets->is_NoData(x, y) )
-			{
-				Get_Flow(x, y);
-			}
-		}
+		return( false );
 	}
 
-	On_Destroy();
-
-	return( true );
-}
-
-//---------------------------------------------------------
-bool CFlow_RecursiveUp::Calculate(int x, int y)
-{
-	On_Create();
-
-	Get_Flow(x,y);
-
-	On_Destroy();
-
-	return( true );
-}
-
-
-///////////////////////////////////////////////////////////
-//														 //
-//														 //
-//														 //
-///////////////////////////////////////////////////////////
-
-//---------------------------------------------------------
-void CFlow_RecursiveUp::Get_Flow(int x, int y)
-{
-	if( is_Locked(x, y) == false )
+	if( pTargets )
 	{
-		Lock_Set (x, y);
-		Init_Cell(x, y);
+		Lock_Create();
 
-		for(int i=0; i<8; i++)
+		for(int y=0; y<Get_NY() && Set_Progress(y); y++)
 		{
-			int	ix	= Get_xTo(i, x);
-			int	iy	= Get_yTo(i, y);
-
-			if( is_InGrid(ix, iy) )
+			for(int x=0; x<Get_NX(); x++)
 			{
-				int		iDir	= (i + 4) % 8;
-				double	iFlow	= m_Flow[iy][ix][iDir];
-
-				if( iFlow > 0.0 )
+				if( !pTargets->is_NoData(x, y) )
 				{
-					Get_Flow    (ix, iy);
-					Add_Fraction(ix, iy, iDir, iFlow);
+					Set_Upslope(Engine, x, y);
 				}
 			}
 		}
-
-		if( m_bGT_Zero && m_pCatch->asDouble(x, y) < 0.0 )
-		{
-			m_pCatch->Set_Value(x, y, 0.0);
-		}
 	}
-}
 
+	bool	bResult	= Engine.Execute();
 
-///////////////////////////////////////////////////////////
-//														 //
-//														 //
-//														 //
-///////////////////////////////////////////////////////////
+	Lock_Destroy();
+
+	return( bResult );
+}
 
 //---------------------------------------------------------
-void CFlow_RecursiveUp::Set_D8(int x, int y)
+bool CFlow_RecursiveUp::Calculate(int x, int y)
 {
-	int		Direction	= m_pDTM->Get_Gradient_NeighborDir(x,y);
+	CSG_Grid_Flow_Graph			Graph;
+	CFlow_RecursiveUp_Engine	Engine(this, true);
 
-	if( Direction >= 0 )
+	if( !Set_Routing(Engine, Graph) )
 	{
-		m_Flow[y][x][Direction % 8]	= 1.0;
+		return( false );
 	}
-}
 
+	Lock_Create();
 
-///////////////////////////////////////////////////////////
-//														 //
-//														 //
-//														 //
-///////////////////////////////////////////////////////////
+	Set_Upslope(Engine, x, y);
 
-//---------------------------------------------------------
-void CFlow_RecursiveUp::Set_Rho8(int x, int y)
-{
-	int		Direction;
-
-	double 	Slope, Aspect;
+	bool	bResult	= Engine.Execute();
 
-	Get_Gradient(x, y, Slope, Aspect);
+	Lock_Destroy();
 
-	Aspect	*= M_RAD_TO_DEG;
+	return( bResult );
+}
 
-	if( Aspect >= 0 )
+//---------------------------------------------------------
+bool CFlow_RecursiveUp::Set_Routing(CFlow_RecursiveUp_Engine &Engine, CSG_Grid_Flow_Graph &Graph)
+{
+	if( Parameters("FLOW_GRAPH")->asGrid() )
 	{
-		Direction	= (int)(Aspect / 45.0);
+		if( !Graph.Set_Grid(Parameters("FLOW_GRAPH")->asGrid()) || !Engine.Create(&Graph) )
+		{
+			Error_Set(_TL("invalid flow routing graph"));
 
-		if( fmod(Aspect,45) / 45.0 > rand() / (double)RAND_MAX )
-			Direction++;
+			return( false );
+		}
 
-		Direction	%= 8;
+		return( true );
+	}
 
-		m_Flow[y][x][Direction]	= 1.0;
+	switch( Parameters("METHOD")->asInt() )
+	{
+	default:	return( Engine.Create(m_pDTM, SG_FLOW_ROUTING_D8  , m_Converge) );
+	case  1:	return( Engine.Create(m_pDTM, SG_FLOW_ROUTING_Rho8, m_Converge) );
+	case  2:	return( Engine.Create(m_pDTM, SG_FLOW_ROUTING_DInf, m_Converge) );
+	case  3:	return( Engine.Create(m_pDTM, SG_FLOW_ROUTING_MFD , m_Converge) );
 	}
 }
 
@@ -392,62 +358,36 @@ void CFlow_RecursiveUp::Set_Rho8(int x, int y)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-void CFlow_RecursiveUp::Set_DInf(int x, int y)
+void CFlow_RecursiveUp::Set_Upslope(CFlow_RecursiveUp_Engine &Engine, int x, int y)
 {
-	int		Direction;
-
-	double 	Slope, Aspect;
-
-	Get_Gradient(x, y, Slope, Aspect);
-
-	Aspect	*= M_RAD_TO_DEG;
-
-	if( Aspect >= 0 )
+	if( !is_InGrid(x, y) || is_Locked(x, y) )
 	{
-		Direction	= (int)(Aspect / 45.0);
-		Aspect		= fmod(Aspect,45) / 45.0;
-
-		m_Flow[y][x][(Direction    ) % 8]	= 1 - Aspect;
-		m_Flow[y][x][(Direction + 1) % 8]	=     Aspect;
+		return;
 	}
-}
 
+	CSG_Grid_Stack	Stack;
 
-///////////////////////////////////////////////////////////
-//														 //
-//														 //
-//														 //
-///////////////////////////////////////////////////////////
+	Lock_Set(x, y);
 
-//---------------------------------------------------------
-void CFlow_RecursiveUp::Set_MFD(int x, int y)
-{
-	int		i;
-	double	z, *dz, dzSum;
+	Stack.Push(x, y);
 
-	for(i=0, dzSum=0.0, dz=m_Flow[y][x], z=m_pDTM->asDouble(x, y); i<8; i++)
+	while( Stack.Pop(x, y) )
 	{
-		int	ix	= Get_xTo(i,x);
-		int	iy	= Get_yTo(i,y);
-
-		if( is_InGrid(ix,iy) )
+		for(int i=0; i<8; i++)
 		{
-			double	d	= z - m_pDTM->asDouble(ix,iy);
+			int	ix	= Get_xTo(i, x);
+			int	iy	= Get_yTo(i, y);
 
-			if( d > 0 )
+			if( is_InGrid(ix, iy) && !is_Locked(ix, iy) && !m_pDTM->is_NoData(ix, iy) )
 			{
-				dzSum	+= dz[i]	= pow(d / Get_Length(i), m_Converge);
-			}
-		}
-	}
+				double	Fraction[8];
 
-	if( dzSum )
-	{
-		for(i=0; i<8; i++)
-		{
-			if( dz[i] > 0 )
-			{
-				dz[i]	/= dzSum;
+				if( Engine.Get_Flow(ix, iy, Fraction) && Fraction[(i + 4) % 8] > 0.0 )
+				{
+					Lock_Set(ix, iy);
+
+					Stack.Push(ix, iy);
+				}
 			}
 		}
 	}
@@ -84,6 +84,8 @@
 //---------------------------------------------------------
 class ta_hydrology_EXPORT CFlow_RecursiveUp : public CFlow
 {
+	friend class CFlow_RecursiveUp_Engine;
+
 public:
 	CFlow_RecursiveUp(void);
 
@@ -98,18 +100,9 @@ protected:
 
 private:
 
-	double					***m_Flow;
-
-
-	void					On_Create		(void);
-	void					On_Destroy		(void);
-
-	void					Get_Flow		(int x, int y );
+	bool					Set_Routing		(class CFlow_RecursiveUp_Engine &Engine, CSG_Grid_Flow_Graph &Graph);
 
-	void					Set_D8			(int x, int y );
-	void					Set_Rho8		(int x, int y );
-	void					Set_DInf		(int x, int y );
-	void					Set_MFD			(int x, int y );
+	void					Set_Upslope		(class CFlow_RecursiveUp_Engine &Engine, int x, int y);
 };
 
 
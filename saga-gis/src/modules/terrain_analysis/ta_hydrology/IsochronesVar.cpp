@@ -52,6 +52,12 @@ CIsochronesVar::CIsochronesVar(void){
 						_TL(""),
 						PARAMETER_INPUT);
 
+	Parameters.Add_Grid(NULL,
+						"FLOW_GRAPH",
+						_TL("Flow Routing Graph"),
+						_TL("precomputed flow routing as created with the 'Flow Routing Graph' tool, each cell drains to the receiver getting its largest fraction"),
+						PARAMETER_INPUT_OPTIONAL);
+
 	Parameters.Add_Grid(NULL,
 						"SLOPE",
 						_TL("Slope"),
@@ -350,10 +356,33 @@ bool CIsochronesVar::On_Execute(void){
 
 	m_pTime->Assign(0.0);
 
+	CSG_Grid_Flow_Graph	Graph;
+
+	if( Parameters("FLOW_GRAPH")->asGrid() && !Graph.Set_Grid(Parameters("FLOW_GRAPH")->asGrid()) )
+	{
+		Error_Set(_TL("invalid flow routing graph"));
+
+		return( false );
+	}
+
 	m_Direction.Create(*Get_System(), SG_DATATYPE_Char);
 	m_Direction.Set_NoData_Value(-1);
 
-	Init_FlowDirectionsD8(m_pDEM, &m_Direction);
+	if( Graph.is_Okay() )
+	{
+		for(int y=0; y<Get_NY() && Set_Progress(y); y++)
+		{
+			#pragma omp parallel for
+			for(int x=0; x<Get_NX(); x++)
+			{
+				m_Direction.Set_Value(x, y, Graph.Get_Direction(x, y));
+			}
+		}
+	}
+	else
+	{
+		Init_FlowDirectionsD8(m_pDEM, &m_Direction);
+	}
 
 	return( true );
 
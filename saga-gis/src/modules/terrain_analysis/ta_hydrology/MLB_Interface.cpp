@@ -124,6 +124,8 @@ CSG_String Get_Info(int i)
 
 #include "flow_by_slope.h"
 
+#include "flow_graph.h"
+
 
 //---------------------------------------------------------
 CSG_Module *		Create_Module(int i)
@@ -157,6 +159,7 @@ CSG_Module *		Create_Module(int i)
 	case 24:	return( new CTCI_Low );
 	case 25:	return( new CErosion_LS_Fields );
 	case 26:	return( new CFlow_by_Slope );
+	case 27:	return( new CFlow_Graph );
 	}
 
 	return( NULL );
@@ -237,7 +237,7 @@ bool CSAGA_Wetness_Index::On_Execute(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-double CSAGA_Wetness_Index::Get_Local_Maximum(CSG_Grid *pGrid, int x, int y)
+double CSAGA_Wetness_Index_Modify::Get_Local_Maximum(CSG_Grid *pGrid, int x, int y)
 {
 	double	z	= pGrid->asDouble(x, y);
 
@@ -252,6 +252,19 @@ double CSAGA_Wetness_Index::Get_Local_Maximum(CSG_Grid *pGrid, int x, int y)
 	return( z );
 }
 
+//---------------------------------------------------------
+bool CSAGA_Wetness_Index_Modify::On_Relax(CSG_Grid *pArea, int x, int y, double &Area)
+{
+	if( m_pSuction->is_NoData(x, y) )
+	{
+		return( false );
+	}
+
+	Area	= m_pSuction->asDouble(x, y) * Get_Local_Maximum(pArea, x, y);
+
+	return( Area > pArea->asDouble(x, y) );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -371,59 +384,12 @@ bool CSAGA_Wetness_Index::Get_Modified(void)
 
 	CSG_Grid	Area(*m_pArea);
 
-	m_pAreaMod->Assign(m_pArea);
-
 	//-----------------------------------------------------
-	int		nChanges	= 1;
-
-	for(int Iteration=1; nChanges && Process_Get_Okay(); Iteration++)
-	{
-		nChanges	= 0;
-
-		#pragma omp parallel for private(y) reduction(+:nChanges)
-		for(y=0; y<Get_NY(); y++)
-		{
-			Process_Get_Okay();
-
-			for(int x=0; x<Get_NX(); x++)
-			{
-				if( !m_Suction.is_NoData(x, y) )
-				{
-					double z	= m_Suction.asDouble(x, y) * Get_Local_Maximum(&Area, x, y);
-
-					if( z > Area.asDouble(x, y) )
-					{
-						nChanges++;
-
-						Area.Set_Value(x, y, z);
-					}
-				}
-			}
-		}
-
-		if( nChanges > 0 )
-		{
-			nChanges	= 0;
-
-			#pragma omp parallel for private(y)
-			for(y=0; y<Get_NY(); y++)
-			{
-				Process_Get_Okay();
+	// only cells next to a cell changed in the previous pass are evaluated again
 
-				for(int x=0; x<Get_NX(); x++)
-				{
-					if( Area.asDouble(x, y) != m_pAreaMod->asDouble(x, y) )
-					{
-						nChanges++;
+	CSAGA_Wetness_Index_Modify	Modify(&m_Suction);
 
-						m_pAreaMod->Set_Value(x, y, Area.asDouble(x, y));
-					}
-				}
-			}
-		}
-
-		Process_Set_Text(CSG_String::Format(SG_T("pass %d (%d > 0)"), Iteration, nChanges));
-	}
+	Modify.Execute(&Area);
 
 	//-----------------------------------------------------
 	Process_Set_Text(_TL("post-processing..."));
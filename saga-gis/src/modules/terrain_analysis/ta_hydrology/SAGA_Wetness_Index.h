@@ -74,6 +74,28 @@
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+class CSAGA_Wetness_Index_Modify : public CSG_Grid_Relaxation
+{
+public:
+	CSAGA_Wetness_Index_Modify(CSG_Grid *pSuction)	{	m_pSuction	= pSuction;	}
+
+
+protected:
+
+	virtual bool			On_Relax			(CSG_Grid *pArea, int x, int y, double &Area);
+
+
+private:
+
+	CSG_Grid				*m_pSuction;
+
+
+	double					Get_Local_Maximum	(CSG_Grid *pGrid, int x, int y);
+
+};
+
+
 //---------------------------------------------------------
 class CSAGA_Wetness_Index : public CSG_Module_Grid
 {
@@ -93,8 +115,6 @@ private:
 	CSG_Grid				*m_pDEM, *m_pSlope, *m_pArea, *m_pAreaMod, *m_pTWI, m_Suction;
 
 
-	double					Get_Local_Maximum	(CSG_Grid *pGrid, int x, int y);
-
 	bool					Get_Area			(void);
 	bool					Get_Modified		(void);
 	bool					Get_TWI				(void);
@@ -36,6 +36,12 @@ CSinuosity::CSinuosity(void){
 						_TL("Elevation Grid"), 
 						_TL(""), 
 						PARAMETER_INPUT);
+
+	Parameters.Add_Grid(NULL, 
+						"FLOW_GRAPH", 
+						_TL("Flow Routing Graph"), 
+						_TL("precomputed flow routing as created with the 'Flow Routing Graph' tool, each cell drains to the receiver getting its largest fraction"), 
+						PARAMETER_INPUT_OPTIONAL);
 	
 	Parameters.Add_Grid(NULL, 
 						"SINUOS", 
@@ -51,6 +57,25 @@ CSinuosity::CSinuosity(void){
 CSinuosity::~CSinuosity(void)
 {}
 
+void CSinuosity::getNextCell(
+		int iX,
+		int iY,
+		int &iNextX,
+		int &iNextY) {
+
+	int iDir;
+
+	if (m_Graph.is_Okay()) {
+		iDir = m_Graph.Get_Direction(iX, iY);
+		iNextX = iDir < 0 ? iX : Get_xTo(iDir, iX);
+		iNextY = iDir < 0 ? iY : Get_yTo(iDir, iY);
+	}// if
+	else {
+		::getNextCell(m_pDEM, iX, iY, iNextX, iNextY);
+	}// else
+
+}// method
+
 void CSinuosity::writeDistOut(
         int iX1,
         int iY1,
@@ -71,7 +96,7 @@ void CSinuosity::writeDistOut(
 		for (int i = -1; i<2; i++){
 			for (int j = -1; j<2; j++){
 				if (!(i == 0) || !(j == 0)) {
-					getNextCell(m_pDEM, iX1 + i, iY1 + j, iNextX, iNextY);
+					getNextCell(iX1 + i, iY1 + j, iNextX, iNextY);
 					if (iNextY == iY1 && iNextX == iX1) {
 						writeDistOut(iX1 + i, iY1 + j, iX1, iY1);
 					}// if				
@@ -118,6 +143,11 @@ bool CSinuosity::On_Execute(void){
 	m_pDEM			= Parameters("DEM")->asGrid(); 
 	m_pSinuosity	= Parameters("SINUOS")->asGrid();
 
+	if (Parameters("FLOW_GRAPH")->asGrid() && !m_Graph.Set_Grid(Parameters("FLOW_GRAPH")->asGrid())) {
+		Error_Set(_TL("invalid flow routing graph"));
+		return false;
+	}//if
+
 	DataObject_Update(m_pSinuosity, true);
 
 	return true;
@@ -126,6 +156,8 @@ bool CSinuosity::On_Execute(void){
 
 bool CSinuosity::On_Execute_Finish(){
 
+	m_Graph.Destroy();
+
 	return( true );
 }
 
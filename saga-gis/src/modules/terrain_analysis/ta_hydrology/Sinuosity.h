@@ -42,6 +42,8 @@ protected:
 private:
 	CSG_Grid *m_pDEM;
 	CSG_Grid *m_pSinuosity;
+	CSG_Grid_Flow_Graph m_Graph;
+	void getNextCell(int,int,int&,int&);
 	void writeDistOut(int,int,int,int);
 	void ZeroToNoData(void);
 	void calculateSinuosity(void);
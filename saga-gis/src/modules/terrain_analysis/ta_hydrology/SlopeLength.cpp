@@ -53,6 +53,12 @@ CSlopeLength::CSlopeLength(void)
 		PARAMETER_INPUT
 	);
 
+	Parameters.Add_Grid(
+		NULL	, "FLOW_GRAPH"	, _TL("Flow Routing Graph"),
+		_TL("precomputed flow routing as created with the 'Flow Routing Graph' tool, each cell drains to the receiver getting its largest fraction"),
+		PARAMETER_INPUT_OPTIONAL
+	);
+
 	Parameters.Add_Grid(
 		NULL	, "LENGTH"	, _TL("Slope Length"),
 		_TL(""),
@@ -61,6 +67,64 @@ CSlopeLength::CSlopeLength(void)
 }
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+class CSlopeLength_Engine : public CSG_Grid_Flow_Accumulation
+{
+public:
+	CSlopeLength_Engine(CSG_Grid *pSlope, CSG_Grid *pLength)
+		: m_pSlope(pSlope), m_pLength(pLength)
+	{}
+
+
+protected:
+
+	//-----------------------------------------------------
+	virtual void		On_Cell			(int x, int y)
+	{
+		if( m_pSlope->is_NoData(x, y) )
+		{
+			return;
+		}
+
+		double	Length	= 0.0, Donors[8];
+
+		if( Get_Donors(x, y, Donors) > 0 )
+		{
+			for(int i=0; i<8; i++)
+			{
+				int	ix	= CSG_Grid_System::Get_xTo(i, x);
+				int	iy	= CSG_Grid_System::Get_yTo(i, y);
+
+				if( Donors[i] > 0.0 && Get_Graph()->Get_Direction(ix, iy) == (i + 4) % 8 && !m_pSlope->is_NoData(ix, iy)
+				&&  m_pSlope->asDouble(x, y) > 0.5 * m_pSlope->asDouble(ix, iy) )
+				{
+					double	d	= m_pLength->asDouble(ix, iy) + Get_System().Get_Length(i);
+
+					if( Length < d )
+					{
+						Length	= d;
+					}
+				}
+			}
+		}
+
+		m_pLength->Set_Value(x, y, Length);
+	}
+
+
+private:
+
+	CSG_Grid			*m_pSlope, *m_pLength;
+
+};
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 //                                                       //
@@ -76,7 +140,16 @@ bool CSlopeLength::On_Execute(void)
 	m_pDEM		= Parameters("DEM"   )->asGrid();
 	m_pLength	= Parameters("LENGTH")->asGrid();
 
-	if( !m_pDEM->Set_Index() )
+	CSG_Grid_Flow_Graph	Graph;
+
+	if( Parameters("FLOW_GRAPH")->asGrid() && !Graph.Set_Grid(Parameters("FLOW_GRAPH")->asGrid()) )
+	{
+		Error_Set(_TL("invalid flow routing graph"));
+
+		return( false );
+	}
+
+	if( !Graph.is_Okay() && !m_pDEM->Set_Index() )
 	{
 		Error_Set(_TL("index creation failed"));
 
@@ -107,11 +180,23 @@ bool CSlopeLength::On_Execute(void)
 	}
 
 	//-----------------------------------------------------
-	for(sLong n=0; n<Get_NCells() && Set_Progress_NCells(n); n++)
+	if( Graph.is_Okay() )	// routing and processing order are taken from the graph
+	{
+		CSlopeLength_Engine	Engine(&m_Slope, m_pLength);
+
+		if( Engine.Create(&Graph) )
+		{
+			Engine.Execute();
+		}
+	}
+	else
 	{
-		if( m_pDEM->Get_Sorted(n, x, y) )
+		for(sLong n=0; n<Get_NCells() && Set_Progress_NCells(n); n++)
 		{
-			Get_Length(x, y);
+			if( m_pDEM->Get_Sorted(n, x, y) )
+			{
+				Get_Length(x, y);
+			}
 		}
 	}
 
@@ -0,0 +1,185 @@
+/**********************************************************
+ * Version $Id$
+ *********************************************************/
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                    Module Library:                    //
+//                     ta_hydrology                      //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                    flow_graph.cpp                     //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation; version 2 of the License.   //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not,       //
+// write to the Free Software Foundation, Inc.,          //
+// 51 Franklin Street, 5th Floor, Boston, MA 02110-1301, //
+// USA.                                                  //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                Institute of Geography                 //
+//                University of Hamburg                  //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+
+
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "flow_graph.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CFlow_Graph::CFlow_Graph(void)
+{
+	Set_Name		(_TL("Flow Routing Graph"));
+
+	Set_Author		("SAGA User Group Association (c) 2026");
+
+	Set_Description	(_TW(
+		"Derives the flow routing of a DEM once and stores it in a compact form, "
+		"which can be used by other tools instead of deriving the routing again "
+		"from the elevation. For each cell the graph keeps the neighbours receiving "
+		"its flow and, for multiple flow direction methods, the quantized flow fractions. "
+		"Single flow direction methods are stored as 1 byte grid, multiple flow direction "
+		"methods as 8 byte floating point grid, which encodes the fractions in steps of 1/255. "
+	));
+
+	//-----------------------------------------------------
+	Parameters.Add_Grid(
+		NULL	, "ELEVATION"	, _TL("Elevation"),
+		_TL(""),
+		PARAMETER_INPUT
+	);
+
+	Parameters.Add_Grid(
+		NULL	, "GRAPH"		, _TL("Flow Routing Graph"),
+		_TL(""),
+		PARAMETER_OUTPUT, true, SG_DATATYPE_Double
+	);
+
+	Parameters.Add_Choice(
+		NULL	, "METHOD"		, _TL("Method"),
+		_TL(""),
+		CSG_String::Format(SG_T("%s|%s|%s|%s|%s|"),
+			_TL("Deterministic 8"),
+			_TL("Rho 8"),
+			_TL("Deterministic Infinity"),
+			_TL("Multiple Flow Direction"),
+			_TL("Multiple Triangular Flow Directon")
+		), 3
+	);
+
+	Parameters.Add_Value(
+		NULL	, "CONVERGENCE"	, _TL("Convergence"),
+		_TL("Convergence factor for Multiple Flow Direction Algorithm (Freeman 1991).\nApplies also to the Multiple Triangular Flow Directon Algorithm."),
+		PARAMETER_TYPE_Double, 1.1, 0.0, true
+	);
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+int CFlow_Graph::On_Parameters_Enable(CSG_Parameters *pParameters, CSG_Parameter *pParameter)
+{
+	if( !SG_STR_CMP(pParameter->Get_Identifier(), "METHOD") )
+	{
+		pParameters->Set_Enabled("CONVERGENCE", pParameter->asInt() >= 3);
+	}
+
+	return( CSG_Module_Grid::On_Parameters_Enable(pParameters, pParameter) );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CFlow_Graph::On_Execute(void)
+{
+	CSG_Grid	*pDEM	= Parameters("ELEVATION")->asGrid();
+	CSG_Grid	*pGraph	= Parameters("GRAPH"    )->asGrid();
+
+	TSG_Flow_Routing	Routing;
+
+	switch( Parameters("METHOD")->asInt() )
+	{
+	default:	Routing	= SG_FLOW_ROUTING_D8   ;	break;
+	case  1:	Routing	= SG_FLOW_ROUTING_Rho8 ;	break;
+	case  2:	Routing	= SG_FLOW_ROUTING_DInf ;	break;
+	case  3:	Routing	= SG_FLOW_ROUTING_MFD  ;	break;
+	case  4:	Routing	= SG_FLOW_ROUTING_MDInf;	break;
+	}
+
+	//-----------------------------------------------------
+	CSG_Grid_Flow_Graph	Graph;
+
+	if( !Graph.Create(pDEM, Routing, Parameters("CONVERGENCE")->asDouble()) || !Graph.Get_Grid(pGraph) )
+	{
+		Error_Set(_TL("failed to create flow routing graph"));
+
+		return( false );
+	}
+
+	pGraph->Set_Name(CSG_String::Format(SG_T("%s [%s]"), pDEM->Get_Name(), _TL("Flow Routing Graph")));
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
@@ -369,46 +369,6 @@ bool CMRVBF::Get_Values(CSG_Grid *pDEM, CSG_Grid *pSlopes, CSG_Grid *pPercentile
 //														 //
 ///////////////////////////////////////////////////////////
 
-//---------------------------------------------------------
-bool CMRVBF::Get_Percentile(CSG_Grid *pDEM, int x, int y, double &Percentile)
-{
-	if( pDEM && pDEM->is_Valid() && pDEM->is_InGrid(x, y, true) )
-	{
-		int		iRadius, iPoint, nPoints, nLower, ix, iy;
-		double	z	= pDEM->asDouble(x, y);
-
-		for(iRadius=0, nPoints=0, nLower=0; iRadius<m_Radius.Get_Maximum(); iRadius++)
-		{
-			for(iPoint=0; iPoint<m_Radius.Get_nPoints(iRadius); iPoint++)
-			{
-				m_Radius.Get_Point(iRadius, iPoint, ix, iy);
-
-				ix	+= x;
-				iy	+= y;
-
-				if( pDEM->is_InGrid(ix, iy) )
-				{
-					nPoints++;
-
-					if( pDEM->asDouble(ix, iy) < z )
-					{
-						nLower++;
-					}
-				}
-			}
-		}
-
-		if( nPoints > 1 )
-		{
-			Percentile	= (double)nLower / (double)(nPoints - 1.0);
-
-			return( true );
-		}
-	}
-
-	return( false );
-}
-
 //---------------------------------------------------------
 bool CMRVBF::Get_Percentiles(CSG_Grid *pDEM, CSG_Grid *pPercentiles, int Radius)
 {
@@ -416,26 +376,7 @@ bool CMRVBF::Get_Percentiles(CSG_Grid *pDEM, CSG_Grid *pPercentiles, int Radius)
 	{
 		pPercentiles->Create(pDEM->Get_System(), SG_DATATYPE_Float);
 
-		m_Radius.Create(Radius);
-
-		for(int y=0; y<pDEM->Get_NY() && Set_Progress(y, pDEM->Get_NY()); y++)
-		{
-			for(int x=0; x<pDEM->Get_NX(); x++)
-			{
-				double	Percentile;
-
-				if( !Get_Percentile(pDEM, x, y, Percentile) )
-				{
-					pPercentiles->Set_NoData(x, y);
-				}
-				else
-				{
-					pPercentiles->Set_Value (x, y, Percentile);
-				}
-			}
-		}
-
-		return( true );
+		return( SG_Grid_Filter_Percentile(pDEM, pPercentiles, Radius) );
 	}
 
 	return( false );
@@ -88,12 +88,9 @@ private:
 
 	double						m_P_Slope, m_P_Pctl, m_T_Pctl_V, m_T_Pctl_R;
 
-	CSG_Grid_Radius				m_Radius;
-
 
 	double						Get_Transformation		(double x, double t, double p);
 
-	bool						Get_Percentile			(CSG_Grid *pDEM, int x, int y, double &Percentile);
 	bool						Get_Percentiles			(CSG_Grid *pDEM, CSG_Grid *pPercentile, int Radius);
 	bool						Get_Slopes				(CSG_Grid *pDEM, CSG_Grid *pSlope);
 	bool						Get_Smoothed			(CSG_Grid *pDEM, CSG_Grid *pSmoothed, int Radius, double Smoothing);
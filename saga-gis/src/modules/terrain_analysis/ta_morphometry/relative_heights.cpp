@@ -315,7 +315,7 @@ bool CRelative_Heights::Get_Heights_Modified(CSG_Grid *pDEM, CSG_Grid *pH, doubl
 {
 	int			y;
 
-	CSG_Grid	H, H_Last, T;
+	CSG_Grid	H, T;
 
 	//-----------------------------------------------------
 	Process_Set_Text(_TL("Modify: pre-processing..."));
@@ -344,59 +344,13 @@ bool CRelative_Heights::Get_Heights_Modified(CSG_Grid *pDEM, CSG_Grid *pH, doubl
 	}
 
 	H     .Create(*pH);
-	H_Last.Create(*pH);
 
 	//-----------------------------------------------------
-	int		nChanges	= 1;
+	// only cells next to a cell changed in the previous pass are evaluated again
 
-	for(int Iteration=1; nChanges && Process_Get_Okay(); Iteration++)
-	{
-		nChanges	= 0;
-
-		#pragma omp parallel for private(y) reduction(+:nChanges)
-		for(y=0; y<Get_NY(); y++)
-		{
-			Process_Get_Okay();
-
-			for(int x=0; x<Get_NX(); x++)
-			{
-				if( !T.is_NoData(x, y) )
-				{
-					double	z	= T.asDouble(x, y) * Get_Local_Maximum(&H, x, y);
-
-					if( z  > H.asDouble(x, y) )
-					{
-						nChanges++;
-
-						H.Set_Value(x, y, z);
-					}
-				}
-			}
-		}
+	CRelative_Heights_Modify	Modify(&T);
 
-		if( nChanges > 0 )
-		{
-			nChanges	= 0;
-
-			#pragma omp parallel for private(y) reduction(+:nChanges)
-			for(y=0; y<Get_NY(); y++)
-			{
-				Process_Get_Okay();
-
-				for(int x=0; x<Get_NX(); x++)
-				{
-					if( H.asDouble(x, y) != H_Last.asDouble(x, y) )
-					{
-						nChanges++;
-
-						H_Last.Set_Value(x, y, H.asDouble(x, y));
-					}
-				}
-			}
-		}
-
-		Process_Set_Text(CSG_String::Format(SG_T("pass %d (%d > 0)"), Iteration, nChanges));
-	}
+	Modify.Execute(&H);
 
 	//-----------------------------------------------------
 	Process_Set_Text(_TL("Modify: post-processing..."));
@@ -458,7 +412,20 @@ bool CRelative_Heights::Get_Heights_Modified(CSG_Grid *pDEM, CSG_Grid *pH, doubl
 }
 
 //---------------------------------------------------------
-double CRelative_Heights::Get_Local_Maximum(CSG_Grid *pGrid, int x, int y)
+bool CRelative_Heights_Modify::On_Relax(CSG_Grid *pH, int x, int y, double &H)
+{
+	if( m_pT->is_NoData(x, y) )
+	{
+		return( false );
+	}
+
+	H	= m_pT->asDouble(x, y) * Get_Local_Maximum(pH, x, y);
+
+	return( H > pH->asDouble(x, y) );
+}
+
+//---------------------------------------------------------
+double CRelative_Heights_Modify::Get_Local_Maximum(CSG_Grid *pGrid, int x, int y)
 {
 	if( pGrid->is_InGrid(x, y) )
 	{
@@ -466,8 +433,8 @@ double CRelative_Heights::Get_Local_Maximum(CSG_Grid *pGrid, int x, int y)
 
 		for(int i=0; i<8; i++)
 		{
-			int	ix	= Get_xTo(i, x);
-			int	iy	= Get_yTo(i, y);
+			int	ix	= CSG_Grid_System::Get_xTo(i, x);
+			int	iy	= CSG_Grid_System::Get_yTo(i, y);
 
 			if( pGrid->is_InGrid(ix, iy) && pGrid->asDouble(ix, iy) > z )
 			{
@@ -74,6 +74,28 @@
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+class CRelative_Heights_Modify : public CSG_Grid_Relaxation
+{
+public:
+	CRelative_Heights_Modify(CSG_Grid *pT)	{	m_pT	= pT;	}
+
+
+protected:
+
+	virtual bool				On_Relax				(CSG_Grid *pH, int x, int y, double &H);
+
+
+private:
+
+	CSG_Grid					*m_pT;
+
+
+	double						Get_Local_Maximum		(CSG_Grid *pGrid, int x, int y);
+
+};
+
+
 //---------------------------------------------------------
 class CRelative_Heights : public CSG_Module_Grid
 {
@@ -92,7 +114,6 @@ private:
 	bool						Get_Heights_Catchment	(CSG_Grid *pDEM, CSG_Grid *pH, double w);
 
 	bool						Get_Heights_Modified	(CSG_Grid *pDEM, CSG_Grid *pH, double t, double e);
-	double						Get_Local_Maximum		(CSG_Grid *pGrid, int x, int y);
 
 	bool						Get_Results				(CSG_Grid *pDEM, CSG_Grid *pHO, CSG_Grid *pHU);
 
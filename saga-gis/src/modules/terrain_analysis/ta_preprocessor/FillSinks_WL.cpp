@@ -79,6 +79,8 @@ CFillSinks_WL::CFillSinks_WL(void)
 		"Wang, L. & H. Liu (2006): An efficient method for identifying and filling surface depressions in "
 		"digital elevation models for hydrologic analysis and modelling. International Journal of Geographical "
 		"Information Science, Vol. 20, No. 2: 193-213.\n"
+		"Barnes, R., Lehman, C. & D. Mulla (2014): Priority-flood: An optimal depression-filling and "
+		"watershed-labeling algorithm for digital elevation models. Computers & Geosciences, Vol. 62: 117-127.\n"
 	));
 
 
@@ -129,16 +131,8 @@ CFillSinks_WL::~CFillSinks_WL(void)
 
 bool CFillSinks_WL::On_Execute(void)		
 {
-	CSG_Grid	*pElev, *pSeed, *pFdir, *pWshed;
-	PriorityQ	theQueue;
-	CFillSinks_WL_Node		tempNode;
-
-	int			x, y, ix, iy, i;
-	int			inverse[8] = { 4, 5, 6, 7, 0, 1, 2, 3 };
-	double		z, iz, progress;
-	double		minslope, mindiff[8];
-	bool		preserve;
-	sLong		id;
+	CSG_Grid	*pElev, *pFilled, *pFdir, *pWshed;
+	double		minslope;
 
 	pElev		= Parameters("ELEV")->asGrid();
 	pFilled		= Parameters("FILLED")->asGrid();
@@ -149,145 +143,9 @@ bool CFillSinks_WL::On_Execute(void)
 	pFilled->Set_Name(CSG_String::Format(SG_T("%s [%s]"), pElev->Get_Name(), _TL("no sinks")));
 
 
-	if( minslope > 0.0 )
-	{
-		minslope = tan(minslope * M_DEG_TO_RAD);
-		for(i=0; i<8; i++)
-			mindiff[i] = minslope * Get_Length(i);
-		preserve = true;
-	}
-	else
-		preserve = false;
-
-
-	pSeed	= (CSG_Grid *) new CSG_Grid(SG_DATATYPE_Bit, pElev->Get_NX(), pElev->Get_NY(), pElev->Get_Cellsize(), pElev->Get_XMin(), pElev->Get_YMin());
-	
-	pFilled->Assign_NoData();
-	pWshed->Assign_NoData();
-	pFdir->Assign_NoData();
-	pSeed->Assign(0.0);
-
-
-	
-	// fill priority queue with boundary, i.e. seed cells
-	id = 0;
-	for(y=0; y<Get_NY(); y++)
-	{
-		for(x=0; x<Get_NX(); x++)
-		{
-			if( !pElev->is_NoData(x, y) )
-			{
-				for(i=0; i<8; i++)
-				{
-					ix = Get_xTo(i, x);
-					iy = Get_yTo(i, y);
-					if( !is_InGrid(ix, iy) || pElev->is_NoData(ix, iy) )
-					{
-						z = pElev->asDouble(x, y);
-						pFilled->Set_Value(x, y, z);
-						pSeed->Set_Value(x, y, 1.0);
-						pWshed->Set_Value(x, y, id);
-						id += 1;
-
-						tempNode.x		= x;
-						tempNode.y		= y;
-						tempNode.spill	= z;
-						theQueue.push( tempNode );
-						break;
-					}
-				}
-			}
-		}
-	}
-
-	// work through least cost path
-	progress = 0.0;
-
-	while( !theQueue.empty() )
-	{
-		PriorityQ::value_type tempNode = theQueue.top();
-
-		x = tempNode.x;
-		y = tempNode.y;
-		theQueue.pop();
-
-		id	= (sLong) pWshed->asDouble(x, y);
-		z	= pFilled->asDouble(x, y);
-
-		for(i=0; i<8; i++)
-		{
-			ix = Get_xTo(i, x);
-			iy = Get_yTo(i, y);
-			if( is_InGrid(ix, iy) && !pElev->is_NoData(ix, iy) )
-			{
-				if( pFilled->is_NoData(ix, iy) )
-				{
-					iz = pElev->asDouble(ix, iy);
-
-					if( preserve )
-					{
-						if( iz < (z + mindiff[i]) )
-							iz = z + mindiff[i];
-					}
-					else if( iz <= z )
-					{
-						iz = z;
-						pFdir->Set_Value(ix, iy, inverse[i]);
-					}
+	CSG_Grid_Fill_Sinks	Fill;
 
-					tempNode.x		= ix;
-					tempNode.y		= iy;
-					tempNode.spill	= iz;
-					theQueue.push( tempNode );
+	Fill.Set_Method(SG_FILL_SINKS_MINSLOPE, tan(minslope * M_DEG_TO_RAD));
 
-					pFilled->Set_Value(ix, iy, iz);
-					pWshed->Set_Value(ix, iy, id);
-				}
-				else if( pSeed->asInt(ix, iy) == 1 )
-					pWshed->Set_Value(ix, iy, id);
-			}
-		}
-
-		if( pFdir->is_NoData(x, y) )
-			pFdir->Set_Value(x, y, Get_Dir(x, y, z));
-
-
-		progress += 1.0;
-		if( ((int)progress) % 10000 == 0 )
-			Set_Progress(progress, (double)pElev->Get_NCells());
-			//DataObject_Update(pFilled, pElev->Get_ZMin(), pElev->Get_ZMax(), true);
-		
-	}
-
-
-	delete (pSeed);
-	return (true);
+	return( Fill.Execute(pElev, pFilled, pFdir, pWshed) );
 }
-
-
-int CFillSinks_WL::Get_Dir(int x, int y, double z)
-{
-	int		ix, iy, i, steepestn;
-	double	iz, max, gradient;
-
-	max = 0.0;
-	steepestn = -1;
-
-	for(i=0; i<8; i++)
-	{
-		ix = Get_xTo(i, x);
-		iy = Get_yTo(i, y);
-
-		if(	is_InGrid(ix, iy) && !pFilled->is_NoData(ix, iy) && (iz = pFilled->asDouble(ix, iy)) < z)
-		{
-			gradient = (z - iz) / Get_Length(i);
-			if( max < gradient )
-			{
-				max = gradient;
-				steepestn = i;
-			}
-		}
-	}
-
-	return (steepestn);
-}
\ No newline at end of file
@@ -64,10 +64,7 @@
 
 //---------------------------------------------------------
 #include "MLB_Interface.h"
-#include <iostream>
-#include <queue>
-#include <vector>
-using namespace std;
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -75,28 +72,6 @@ using namespace std;
 //														 //
 ///////////////////////////////////////////////////////////
 
-//---------------------------------------------------------
-class CFillSinks_WL_Node
-{
-public:
-	CFillSinks_WL_Node() : spill( 0 ) {}
-		~CFillSinks_WL_Node(){}
-
-	struct Greater : public binary_function< CFillSinks_WL_Node, CFillSinks_WL_Node, bool >
-	{
-		bool operator()(const CFillSinks_WL_Node n1, const CFillSinks_WL_Node n2) const
-		{
-			return n1.spill > n2.spill;
-		}
-	};
-
-	int		x;
-	int		y;
-	double	spill;
-};
-
-
-
 //---------------------------------------------------------
 class ta_preprocessor_EXPORT CFillSinks_WL : public CSG_Module_Grid
 {
@@ -109,16 +84,6 @@ protected:
 
 	virtual bool		On_Execute(void);
 
-
-private:
-
-	typedef				vector< CFillSinks_WL_Node > nodeVector;
-	typedef				priority_queue< CFillSinks_WL_Node, nodeVector, CFillSinks_WL_Node::Greater > PriorityQ;
-
-	CSG_Grid			*pFilled;
-
-	int					Get_Dir(int x, int y, double z);
-
 };
 
 //---------------------------------------------------------
@@ -133,12 +98,6 @@ protected:
 
 	virtual bool		On_Execute(void);
 
-
-private:
-
-	typedef		vector< CFillSinks_WL_Node > nodeVector;
-	typedef		priority_queue< CFillSinks_WL_Node, nodeVector, CFillSinks_WL_Node::Greater > PriorityQ;
-
 };
 
 
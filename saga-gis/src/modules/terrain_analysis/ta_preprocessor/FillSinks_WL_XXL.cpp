@@ -78,6 +78,8 @@ CFillSinks_WL_XXL::CFillSinks_WL_XXL(void)
 		"Wang, L. & H. Liu (2006): An efficient method for identifying and filling surface depressions in "
 		"digital elevation models for hydrologic analysis and modelling. International Journal of Geographical "
 		"Information Science, Vol. 20, No. 2: 193-213.\n"
+		"Barnes, R., Lehman, C. & D. Mulla (2014): Priority-flood: An optimal depression-filling and "
+		"watershed-labeling algorithm for digital elevation models. Computers & Geosciences, Vol. 62: 117-127.\n"
 	));
 
 
@@ -99,6 +101,12 @@ CFillSinks_WL_XXL::CFillSinks_WL_XXL(void)
 		PARAMETER_TYPE_Double, 0.1, 0.0, true
 	);
 
+	Parameters.Add_Value(
+		NULL, "TILE_SIZE", _TL("Tile Size"),
+		_TL("Processes the DEM in tiles of the given edge length [cells] in parallel, which bounds the working memory needed for very large data sets. With a minimum slope flat areas crossing tile borders might keep a flat seam along the border. Zero processes the DEM at once."),
+		PARAMETER_TYPE_Int, 0, 0, true
+	);
+
 }
 
 //---------------------------------------------------------
@@ -117,13 +125,7 @@ CFillSinks_WL_XXL::~CFillSinks_WL_XXL(void)
 bool CFillSinks_WL_XXL::On_Execute(void)		
 {
 	CSG_Grid	*pElev, *pFilled;
-	PriorityQ	theQueue;
-	CFillSinks_WL_Node		tempNode;
-
-	int			x, y, ix, iy, i;
-	double		z, iz, progress;
-	double		minslope, mindiff[8];
-	bool		preserve;
+	double		minslope;
 
 
 	pElev		= Parameters("ELEV")->asGrid();
@@ -133,94 +135,10 @@ bool CFillSinks_WL_XXL::On_Execute(void)
 	pFilled->Set_Name(CSG_String::Format(SG_T("%s [%s]"), pElev->Get_Name(), _TL("no sinks")));
 
 
-	if( minslope > 0.0 )
-	{
-		minslope = tan(minslope * M_DEG_TO_RAD);
-		for(i=0; i<8; i++)
-			mindiff[i] = minslope * Get_Length(i);
-		preserve = true;
-	}
-	else
-		preserve = false;
-
-	
-	pFilled->Assign_NoData();
-	
-
-	// fill priority queue with boundary cells, i.e. seed cells
-	for(y=0; y<Get_NY(); y++)
-	{
-		for(x=0; x<Get_NX(); x++)
-		{
-			if( !pElev->is_NoData(x, y) )
-			{
-				for(i=0; i<8; i++)
-				{
-					ix = Get_xTo(i, x);
-					iy = Get_yTo(i, y);
-					if( !is_InGrid(ix, iy) || pElev->is_NoData(ix, iy) )
-					{
-						z = pElev->asDouble(x, y);
-
-						tempNode.x		= x;
-						tempNode.y		= y;
-						tempNode.spill	= z;
-						theQueue.push( tempNode );
-
-						pFilled->Set_Value(x, y, z);
-						break;
-					}
-				}
-			}
-		}
-	}
-
-
-	// process queue
-	progress = 0.0;
-
-	while( !theQueue.empty() )
-	{
-		PriorityQ::value_type tempNode = theQueue.top();
-
-		x = tempNode.x;
-		y = tempNode.y;
-		theQueue.pop();
-
-		z = pFilled->asDouble(x, y);
-
-		for(i=0; i<8; i++)
-		{
-			ix = Get_xTo(i, x);
-			iy = Get_yTo(i, y);
-			if( is_InGrid(ix, iy) && !pElev->is_NoData(ix, iy) && pFilled->is_NoData(ix, iy) )
-			{
-				iz = pElev->asDouble(ix, iy);
-
-				if( preserve )
-				{
-					if( iz < (z + mindiff[i]) )
-						iz = z + mindiff[i];
-				}
-				else if( iz < z )
-					iz = z;
-
-				tempNode.x		= ix;
-				tempNode.y		= iy;
-				tempNode.spill	= iz;
-				theQueue.push( tempNode );
-
-				pFilled->Set_Value(ix, iy, iz);
-			}
-		}
-
-		progress += 1.0;
-		if( ((int)progress) % 10000 == 0 )
-			Set_Progress(progress, (double)pElev->Get_NCells());
-			//DataObject_Update(pFilled, pElev->Get_ZMin(), pElev->Get_ZMax(), true);
-		
-	}
-
-	return (true);
-}
+	CSG_Grid_Fill_Sinks	Fill;
+
+	Fill.Set_Method(SG_FILL_SINKS_MINSLOPE, tan(minslope * M_DEG_TO_RAD));
+	Fill.Set_Tile_Size(Parameters("TILE_SIZE")->asInt());
 
+	return( Fill.Execute(pElev, pFilled) );
+}
@@ -100,6 +100,8 @@ CSG_String Get_Info(int i)
 
 #include "burn_in_streams.h"
 
+#include "breach_depressions.h"
+
 
 //---------------------------------------------------------
 CSG_Module *		Create_Module(int i)
@@ -115,6 +117,8 @@ CSG_Module *		Create_Module(int i)
 	case  5:	return( new CFillSinks_WL_XXL );
 
 	case  6:	return( new CBurnIn_Streams );
+
+	case  7:	return( new CBreach_Depressions );
 	}
 
 	return( NULL );
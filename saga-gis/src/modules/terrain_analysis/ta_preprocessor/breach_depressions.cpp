@@ -0,0 +1,146 @@
+/**********************************************************
+ * Version $Id$
+ *********************************************************/
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                    Module Library:                    //
+//                    ta_preprocessor                    //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                breach_depressions.cpp                 //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation; version 2 of the License.   //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not,       //
+// write to the Free Software Foundation, Inc.,          //
+// 51 Franklin Street, 5th Floor, Boston, MA 02110-1301, //
+// USA.                                                  //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                Institute of Geography                 //
+//                University of Hamburg                  //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+
+
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "breach_depressions.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CBreach_Depressions::CBreach_Depressions(void)
+{
+	Set_Name		(_TL("Breach Depressions"));
+
+	Set_Author		("SAGA User Group Association (c) 2026");
+
+	Set_Description	(_TW(
+		"Removes the depressions of a DEM by breaching instead of filling. "
+		"The DEM is flooded from its edge in order of increasing elevation (priority-flood). "
+		"Whenever a cell is reached, which is lower than the cell it is reached from, "
+		"the path back to the outlet is lowered below it, so that the depression drains "
+		"along the lowest spill route. Cells along a breached path decrease by the smallest "
+		"increment the output grid is able to represent, integer grids get flat paths. "
+		"The depth and length of a breach are not limited.\n\n"
+		"References:\n"
+		"Barnes, R., Lehman, C. & D. Mulla (2014): Priority-flood: An optimal depression-filling and "
+		"watershed-labeling algorithm for digital elevation models. Computers & Geosciences, Vol. 62: 117-127.\n"
+		"Lindsay, J.B. (2016): Efficient hybrid breaching-filling sink removal methods for flow path "
+		"enforcement in digital elevation models. Hydrological Processes, Vol. 30: 846-857.\n"
+	));
+
+	//-----------------------------------------------------
+	Parameters.Add_Grid(
+		NULL	, "DEM"			, _TL("DEM"),
+		_TL("Digital elevation model"),
+		PARAMETER_INPUT
+	);
+
+	Parameters.Add_Grid(
+		NULL	, "BREACHED"	, _TL("Breached DEM"),
+		_TL("Depression-free digital elevation model"),
+		PARAMETER_OUTPUT
+	);
+
+	Parameters.Add_Grid(
+		NULL	, "FDIR"		, _TL("Flow Directions"),
+		_TL("Flow directions along the breached paths, 0=N, 1=NE, 2=E, ... 7=NW"),
+		PARAMETER_OUTPUT_OPTIONAL, true, SG_DATATYPE_Char
+	);
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CBreach_Depressions::On_Execute(void)
+{
+	CSG_Grid	*pDEM		= Parameters("DEM"     )->asGrid();
+	CSG_Grid	*pBreached	= Parameters("BREACHED")->asGrid();
+	CSG_Grid	*pFlowDir	= Parameters("FDIR"    )->asGrid();
+
+	pBreached->Set_Name(CSG_String::Format(SG_T("%s [%s]"), pDEM->Get_Name(), _TL("breached")));
+
+	//-----------------------------------------------------
+	CSG_Grid_Fill_Sinks	Breach;
+
+	Breach.Set_Method(SG_FILL_SINKS_BREACH);
+
+	return( Breach.Execute(pDEM, pBreached, pFlowDir) );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
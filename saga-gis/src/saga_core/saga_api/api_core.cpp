@@ -99,6 +99,26 @@ int		SG_Get_Max_Num_Procs_Omp		(void)
 {
 	return( omp_get_num_procs() );
 }
+
+//---------------------------------------------------------
+int		g_SG_Max_Num_Threads_IO = 4;
+
+//---------------------------------------------------------
+/**
+  * Sets the maximum number of threads used for concurrent file
+  * input and output. Disk access does not scale with the number
+  * of processors, so this is kept small by default.
+*/
+void	SG_Set_Max_Num_Threads_IO		(int nThreads)
+{
+	g_SG_Max_Num_Threads_IO	= nThreads < 1 ? 1 : nThreads;
+}
+
+//---------------------------------------------------------
+int		SG_Get_Max_Num_Threads_IO		(void)
+{
+	return( g_SG_Max_Num_Threads_IO < g_SG_Max_Num_Threads_Omp ? g_SG_Max_Num_Threads_IO : g_SG_Max_Num_Threads_Omp );
+}
 #endif
 
 ///////////////////////////////////////////////////////////
@@ -174,6 +174,8 @@
 SAGA_API_DLL_EXPORT int		SG_Get_Max_Num_Threads_Omp		(void);
 SAGA_API_DLL_EXPORT void	SG_Set_Max_Num_Threads_Omp		(int iCores);
 SAGA_API_DLL_EXPORT int		SG_Get_Max_Num_Procs_Omp		(void);
+SAGA_API_DLL_EXPORT int		SG_Get_Max_Num_Threads_IO		(void);
+SAGA_API_DLL_EXPORT void	SG_Set_Max_Num_Threads_IO		(int nThreads);
 #endif
 
 
@@ -61,6 +61,10 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "data_manager.h"
 #include "module_library.h"
 
@@ -94,6 +98,11 @@ CSG_Data_Collection::CSG_Data_Collection(CSG_Data_Manager *pManager, TSG_Data_Ob
 	m_Type		= Type;
 
 	m_Objects.Create(sizeof(CSG_Data_Object *));
+
+	m_Index		.Create(sizeof(size_t));
+	m_Index_Next.Create(sizeof(size_t));
+
+	m_bIndex	= false;
 }
 
 //---------------------------------------------------------
@@ -103,17 +112,100 @@ CSG_Data_Collection::~CSG_Data_Collection(void)
 }
 
 //---------------------------------------------------------
-CSG_Data_Object * CSG_Data_Collection::Get(const CSG_String &File, bool bNative) const
+static size_t	SG_Data_File_Hash	(const SG_Char *File)
 {
+	size_t	Hash	= 2166136261u;	// FNV-1a
+
+	for(; *File; File++)
+	{
+		Hash	= (Hash ^ (size_t)*File) * 16777619u;
+	}
+
+	return( Hash );
+}
+
+//---------------------------------------------------------
+void CSG_Data_Collection::_Index_Add(size_t i) const
+{
+	size_t	*Index	= (size_t *)m_Index.Get_Array();
+	size_t	 Hash	= SG_Data_File_Hash(Get(i)->Get_File_Name(false)) & (m_Index.Get_Size() - 1);
+
+	((size_t *)m_Index_Next.Get_Array())[i]	= Index[Hash];
+
+	Index[Hash]	= i + 1;	// zero marks the end of a chain
+}
+
+//---------------------------------------------------------
+void CSG_Data_Collection::_Index_Update(void) const
+{
+	if( m_bIndex && m_Index_Revision == CSG_Data_Object::m_File_Name_Revision )
+	{
+		return;
+	}
+
+	size_t	nBuckets	= 64;
+
+	while( nBuckets < 2 * Count() )
+	{
+		nBuckets	*= 2;
+	}
+
+	m_Index.Set_Array(nBuckets);
+
+	memset(m_Index.Get_Array(), 0, nBuckets * sizeof(size_t));
+
+	m_Index_Next.Set_Array(Count());
+
 	for(size_t i=0; i<Count(); i++)
 	{
-		if( !File.Cmp(Get(i)->Get_File_Name(bNative)) )
+		_Index_Add(i);
+	}
+
+	m_bIndex			= true;
+	m_Index_Revision	= CSG_Data_Object::m_File_Name_Revision;
+}
+
+//---------------------------------------------------------
+/**
+  * Looks up a data object by its file name. Uses a hash table that
+  * is rebuilt on demand, i.e. after objects have been removed or
+  * the file name of a collected object has been changed.
+*/
+//---------------------------------------------------------
+CSG_Data_Object * CSG_Data_Collection::Get(const CSG_String &File, bool bNative) const
+{
+	if( File.is_Empty() )	// non native files are reported with an empty name
+	{
+		for(size_t i=0; i<Count(); i++)
 		{
-			return( Get(i) );
+			if( !File.Cmp(Get(i)->Get_File_Name(bNative)) )
+			{
+				return( Get(i) );
+			}
 		}
+
+		return( NULL );
 	}
 
-	return( NULL );
+	//-----------------------------------------------------
+	CSG_Data_Object	*pObject	= NULL;
+
+	#pragma omp critical (sg_data_collection_index)
+	{
+		_Index_Update();
+
+		size_t	i	= ((size_t *)m_Index.Get_Array())[SG_Data_File_Hash(File.c_str()) & (m_Index.Get_Size() - 1)];
+
+		for( ; i>0 && !pObject; i=((size_t *)m_Index_Next.Get_Array())[i - 1])
+		{
+			if( !File.Cmp(Get(i - 1)->Get_File_Name(bNative)) )
+			{
+				pObject	= Get(i - 1);
+			}
+		}
+	}
+
+	return( pObject );
 }
 
 //---------------------------------------------------------
@@ -144,6 +236,20 @@ bool CSG_Data_Collection::Add(CSG_Data_Object *pObject)
 		{
 			((CSG_Data_Object **)m_Objects.Get_Array())[Count() - 1]	= pObject;
 
+			pObject->m_nCollections++;
+
+			#pragma omp critical (sg_data_collection_index)
+			{
+				if( m_bIndex && 2 * Count() <= m_Index.Get_Size() && m_Index_Next.Inc_Array() )
+				{
+					_Index_Add(Count() - 1);
+				}
+				else
+				{
+					m_bIndex	= false;
+				}
+			}
+
 			if( m_pManager == &g_Data_Manager )
 			{
 				SG_UI_DataObject_Add(pObject, SG_UI_DATAOBJECT_UPDATE_ONLY);
@@ -161,6 +267,8 @@ bool CSG_Data_Collection::Delete(CSG_Data_Object *pObject, bool bDetachOnly)
 {
 	CSG_Data_Object	**pObjects	= (CSG_Data_Object **)m_Objects.Get_Array();
 
+	bool	bDeleted	= false;
+
 	size_t	i, n;
 
 	for(i=0, n=0; i<Count(); i++)
@@ -171,7 +279,11 @@ bool CSG_Data_Collection::Delete(CSG_Data_Object *pObject, bool bDetachOnly)
 			{
 				delete(Get(i));
 
-				bDetachOnly	= true;	// just in case the same object has been added more than once
+				bDetachOnly	= bDeleted	= true;	// just in case the same object has been added more than once
+			}
+			else if( !bDeleted )
+			{
+				pObject->m_nCollections--;
 			}
 		}
 		else
@@ -184,6 +296,8 @@ bool CSG_Data_Collection::Delete(CSG_Data_Object *pObject, bool bDetachOnly)
 	{
 		m_Objects.Set_Array(n);
 
+		m_bIndex	= false;
+
 		return( true );
 	}
 
@@ -199,16 +313,22 @@ bool CSG_Data_Collection::Delete(size_t i, bool bDetachOnly)
 //---------------------------------------------------------
 bool CSG_Data_Collection::Delete_All(bool bDetachOnly)
 {
-	if( !bDetachOnly )
+	for(size_t i=0; i<Count(); i++)
 	{
-		for(size_t i=0; i<Count(); i++)
+		if( !bDetachOnly )
 		{
 			delete(Get(i));
 		}
+		else
+		{
+			Get(i)->m_nCollections--;
+		}
 	}
 
 	m_Objects.Set_Array(0);
 
+	m_bIndex	= false;
+
 	return( true );
 }
 
@@ -289,6 +409,12 @@ CSG_Data_Manager::CSG_Data_Manager(void)
 	m_pShapes		= new CSG_Data_Collection(this, DATAOBJECT_TYPE_Shapes    );
 
 	m_Grid_Systems.Create(sizeof(CSG_Grid_Collection *));
+
+#ifdef _OPENMP
+	omp_init_nest_lock((omp_nest_lock_t *)(m_pLock = SG_Malloc(sizeof(omp_nest_lock_t))));
+#else
+	m_pLock			= NULL;
+#endif
 }
 
 //---------------------------------------------------------
@@ -300,6 +426,33 @@ CSG_Data_Manager::~CSG_Data_Manager(void)
 	delete(m_pTIN        );
 	delete(m_pPoint_Cloud);
 	delete(m_pShapes     );
+
+#ifdef _OPENMP
+	omp_destroy_nest_lock((omp_nest_lock_t *)m_pLock);
+
+	SG_Free(m_pLock);
+#endif
+}
+
+//---------------------------------------------------------
+// Tools of a tool chain might share a data manager while running
+// concurrently. The lock is recursive, because adding an object
+// to the global manager notifies the user interface, which in
+// turn might query or add to the manager.
+//---------------------------------------------------------
+void CSG_Data_Manager::_Lock(void)	const
+{
+#ifdef _OPENMP
+	omp_set_nest_lock((omp_nest_lock_t *)m_pLock);
+#endif
+}
+
+//---------------------------------------------------------
+void CSG_Data_Manager::_Unlock(void)	const
+{
+#ifdef _OPENMP
+	omp_unset_nest_lock((omp_nest_lock_t *)m_pLock);
+#endif
 }
 
 
@@ -358,17 +511,20 @@ bool CSG_Data_Manager::Exists(const CSG_Grid_System &System) const
 //---------------------------------------------------------
 bool CSG_Data_Manager::Exists(CSG_Data_Object *pObject) const
 {
-	if( m_pTable      ->Exists(pObject) )	return( true );
-	if( m_pTIN        ->Exists(pObject) )	return( true );
-	if( m_pPoint_Cloud->Exists(pObject) )	return( true );
-	if( m_pShapes     ->Exists(pObject) )	return( true );
+	bool	bResult;
 
-	for(size_t i=0; i<Grid_System_Count(); i++)
+	_Lock();
+
+	bResult	= m_pTable->Exists(pObject) || m_pTIN->Exists(pObject) || m_pPoint_Cloud->Exists(pObject) || m_pShapes->Exists(pObject);
+
+	for(size_t i=0; !bResult && i<Grid_System_Count(); i++)
 	{
-		if( Get_Grid_System(i)->Exists(pObject) )	return( true );
+		bResult	= Get_Grid_System(i)->Exists(pObject);
 	}
 
-	return(	false );
+	_Unlock();
+
+	return(	bResult );
 }
 
 //---------------------------------------------------------
@@ -376,17 +532,22 @@ CSG_Data_Object *  CSG_Data_Manager::Find(const CSG_String &File, bool bNative)
 {
 	CSG_Data_Object	*pObject;
 
-	if( (pObject = m_pTable      ->Get(File, bNative)) != NULL )	return( pObject );
-	if( (pObject = m_pTIN        ->Get(File, bNative)) != NULL )	return( pObject );
-	if( (pObject = m_pPoint_Cloud->Get(File, bNative)) != NULL )	return( pObject );
-	if( (pObject = m_pShapes     ->Get(File, bNative)) != NULL )	return( pObject );
+	_Lock();
 
-	for(size_t i=0; i<Grid_System_Count(); i++)
+	if( (pObject = m_pTable      ->Get(File, bNative)) == NULL
+	&&  (pObject = m_pTIN        ->Get(File, bNative)) == NULL
+	&&  (pObject = m_pPoint_Cloud->Get(File, bNative)) == NULL
+	&&  (pObject = m_pShapes     ->Get(File, bNative)) == NULL )
 	{
-		if( (pObject = Get_Grid_System(i)->Get(File, bNative)) != NULL )	return( pObject );
+		for(size_t i=0; pObject == NULL && i<Grid_System_Count(); i++)
+		{
+			pObject	= Get_Grid_System(i)->Get(File, bNative);
+		}
 	}
 
-	return(	NULL );
+	_Unlock();
+
+	return(	pObject );
 }
 
 
@@ -397,6 +558,10 @@ CSG_Data_Object *  CSG_Data_Manager::Find(const CSG_String &File, bool bNative)
 //---------------------------------------------------------
 bool CSG_Data_Manager::Add(CSG_Data_Object *pObject)
 {
+	bool	bResult;
+
+	_Lock();
+
 	CSG_Data_Collection	*pCollection	= _Get_Collection(pObject);
 
 	if( pCollection == NULL && pObject != DATAOBJECT_NOTSET && pObject != DATAOBJECT_CREATE && pObject->Get_ObjectType() == DATAOBJECT_TYPE_Grid && m_Grid_Systems.Inc_Array() )
@@ -406,44 +571,55 @@ bool CSG_Data_Manager::Add(CSG_Data_Object *pObject)
 		((CSG_Data_Collection **)m_Grid_Systems.Get_Array())[m_Grid_Systems.Get_Size() - 1]	= pCollection;
 	}
 
-	return( pCollection && pCollection->Add(pObject) );
+	bResult	= pCollection && pCollection->Add(pObject);
+
+	_Unlock();
+
+	return( bResult );
 }
 
 //---------------------------------------------------------
-bool CSG_Data_Manager::Add(const CSG_String &File, TSG_Data_Object_Type Type)
+TSG_Data_Object_Type CSG_Data_Manager::_Get_Type(const CSG_String &File)
 {
-	//-----------------------------------------------------
-	if( Type == DATAOBJECT_TYPE_Undefined )
+	if( SG_File_Cmp_Extension(File, SG_T("txt" ))
+	||	SG_File_Cmp_Extension(File, SG_T("csv" ))
+	||	SG_File_Cmp_Extension(File, SG_T("dbf" )) )
 	{
-		if( SG_File_Cmp_Extension(File, SG_T("txt" ))
-		||	SG_File_Cmp_Extension(File, SG_T("csv" ))
-		||	SG_File_Cmp_Extension(File, SG_T("dbf" )) )
-		{
-			Type	= DATAOBJECT_TYPE_Table;
-		}
+		return( DATAOBJECT_TYPE_Table );
+	}
 
-		if( SG_File_Cmp_Extension(File, SG_T("shp" )) )
-		{
-			Type	= DATAOBJECT_TYPE_Shapes;
-		}
+	if( SG_File_Cmp_Extension(File, SG_T("shp" )) )
+	{
+		return( DATAOBJECT_TYPE_Shapes );
+	}
 
-		if( SG_File_Cmp_Extension(File, SG_T("spc" )) )
-		{
-			Type	= DATAOBJECT_TYPE_PointCloud;
-		}
+	if( SG_File_Cmp_Extension(File, SG_T("spc" )) )
+	{
+		return( DATAOBJECT_TYPE_PointCloud );
+	}
 
-		if(	SG_File_Cmp_Extension(File, SG_T("sgrd"))
-		||	SG_File_Cmp_Extension(File, SG_T("dgm" ))
-		||	SG_File_Cmp_Extension(File, SG_T("grd" )) )
-		{
-			Type	= DATAOBJECT_TYPE_Grid;
-		}
+	if(	SG_File_Cmp_Extension(File, SG_T("sgrd"))
+	||	SG_File_Cmp_Extension(File, SG_T("dgm" ))
+	||	SG_File_Cmp_Extension(File, SG_T("grd" )) )
+	{
+		return( DATAOBJECT_TYPE_Grid );
 	}
 
-	//-----------------------------------------------------
+	return( DATAOBJECT_TYPE_Undefined );
+}
+
+//---------------------------------------------------------
+/**
+  * Loads a data object from a file in one of the native formats.
+  * Does not add it to the data manager and does not touch any
+  * shared state, so that it can be called from concurrent threads.
+*/
+//---------------------------------------------------------
+CSG_Data_Object * CSG_Data_Manager::_Load(const CSG_String &File, TSG_Data_Object_Type Type)
+{
 	CSG_Data_Object	*pObject;
 
-	switch( Type )
+	switch( Type == DATAOBJECT_TYPE_Undefined ? _Get_Type(File) : Type )
 	{
 	default:							pObject	= NULL;							break;
 	case DATAOBJECT_TYPE_Table:			pObject	= new CSG_Table			(File);	break;
@@ -453,18 +629,74 @@ bool CSG_Data_Manager::Add(const CSG_String &File, TSG_Data_Object_Type Type)
 	case DATAOBJECT_TYPE_Grid:			pObject	= new CSG_Grid			(File);	break;
 	}
 
+	if( pObject && !pObject->is_Valid() )
+	{
+		delete(pObject);
+
+		pObject	= NULL;
+	}
+
+	return( pObject );
+}
+
+//---------------------------------------------------------
+bool CSG_Data_Manager::Add(const CSG_String &File, TSG_Data_Object_Type Type)
+{
+	CSG_Data_Object	*pObject	= _Load(File, Type);
+
 	if( pObject )
 	{
-		if( pObject->is_Valid() )
+		return( Add(pObject) );
+	}
+
+	//-----------------------------------------------------
+	return( _Add_External(File) );
+}
+
+//---------------------------------------------------------
+/**
+  * Adds a list of files. Files in native formats are loaded
+  * concurrently. Returns the number of files that have been
+  * added successfully.
+*/
+//---------------------------------------------------------
+int CSG_Data_Manager::Add(const CSG_Strings &Files, TSG_Data_Object_Type Type)
+{
+	int		i, nAdded	= 0;
+
+	CSG_Array	Objects(sizeof(CSG_Data_Object *), Files.Get_Count());
+
+	CSG_Data_Object	**pObjects	= (CSG_Data_Object **)Objects.Get_Array();
+
+	//-----------------------------------------------------
+	SG_UI_Progress_Lock(true);
+	SG_UI_Msg_Lock     (true);
+
+	#pragma omp parallel for schedule(dynamic) num_threads(SG_Get_Max_Num_Threads_IO())
+	for(i=0; i<Files.Get_Count(); i++)
+	{
+		pObjects[i]	= _Load(Files[i], Type);
+	}
+
+	SG_UI_Msg_Lock     (false);
+	SG_UI_Progress_Lock(false);
+
+	//-----------------------------------------------------
+	for(i=0; i<Files.Get_Count(); i++)	// foreign formats are imported one by one
+	{
+		if( pObjects[i] )
 		{
-			return( Add(pObject) );
+			SG_UI_Msg_Add(CSG_String::Format(SG_T("%s: %s..."), _TL("Load"), Files[i].c_str()), true);
+			SG_UI_Msg_Add(_TL("okay"), false, SG_UI_MSG_STYLE_SUCCESS);
 		}
 
-		delete(pObject);
+		if( pObjects[i] ? Add(pObjects[i]) : _Add_External(Files[i]) )
+		{
+			nAdded++;
+		}
 	}
 
-	//-----------------------------------------------------
-	return( _Add_External(File) );
+	return( nAdded );
 }
 
 //---------------------------------------------------------
@@ -660,6 +892,10 @@ bool CSG_Data_Manager::Delete(CSG_Data_Collection *pCollection, bool bDetachOnly
 //---------------------------------------------------------
 bool CSG_Data_Manager::Delete(CSG_Data_Object *pObject, bool bDetachOnly)
 {
+	bool	bResult	= false;
+
+	_Lock();
+
 	CSG_Data_Collection	*pCollection	= _Get_Collection(pObject);
 
 	if( pCollection && pCollection->Delete(pObject, bDetachOnly) )
@@ -669,10 +905,12 @@ bool CSG_Data_Manager::Delete(CSG_Data_Object *pObject, bool bDetachOnly)
 			Delete(pCollection, bDetachOnly);
 		}
 
-		return( true );
+		bResult	= true;
 	}
 
-	return( false );
+	_Unlock();
+
+	return( bResult );
 }
 
 //---------------------------------------------------------
@@ -114,6 +114,19 @@ protected:
 
 	CSG_Array						m_Objects;
 
+
+private:
+
+	mutable bool					m_bIndex;
+
+	mutable int						m_Index_Revision;
+
+	mutable CSG_Array				m_Index, m_Index_Next;	// file name hash table, chained by object index
+
+
+	void							_Index_Add			(size_t i)	const;
+	void							_Index_Update		(void)		const;
+
 };
 
 
@@ -172,6 +185,7 @@ public:
 
 	bool								Add					(CSG_Data_Object *pObject);
 	bool								Add					(const CSG_String &File, TSG_Data_Object_Type Type = DATAOBJECT_TYPE_Undefined);
+	int									Add					(const CSG_Strings &Files, TSG_Data_Object_Type Type = DATAOBJECT_TYPE_Undefined);
 
 	CSG_Table *							Add_Table			(const SG_Char *File)	{	return( Add(File, DATAOBJECT_TYPE_Table     ) ? (CSG_Table      *)Find(File) : NULL );	}
 	CSG_TIN *							Add_TIN				(const SG_Char *File)	{	return( Add(File, DATAOBJECT_TYPE_TIN       ) ? (CSG_TIN        *)Find(File) : NULL );	}
@@ -205,10 +219,18 @@ private:
 	CSG_Array							m_Grid_Systems;
 
 	CSG_Data_Collection					*m_pTable, *m_pTIN, *m_pPoint_Cloud, *m_pShapes;
+
+	void								*m_pLock;
 	
 
+	void								_Lock				(void)	const;
+	void								_Unlock				(void)	const;
+
 	CSG_Data_Collection *				_Get_Collection		(CSG_Data_Object *pObject)		const;
 
+	static TSG_Data_Object_Type			_Get_Type			(const CSG_String &File);
+	static CSG_Data_Object *			_Load				(const CSG_String &File, TSG_Data_Object_Type Type);
+
 	bool								_Add_External		(const CSG_String &File);
 
 };
@@ -131,6 +131,9 @@ int		SG_Get_History_Depth			(void)
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+int	CSG_Data_Object::m_File_Name_Revision	= 0;
+
 //---------------------------------------------------------
 CSG_Data_Object::CSG_Data_Object(void)
 {
@@ -146,6 +149,7 @@ CSG_Data_Object::CSG_Data_Object(void)
 	//-----------------------------------------------------
 	m_File_bNative		= false;
 	m_File_Type			= 0;
+	m_nCollections		= 0;
 	m_bModified			= true;
 
 	m_NoData_Value		= -99999.0;
@@ -205,6 +209,12 @@ void CSG_Data_Object::Set_File_Name(const CSG_String &File_Name, bool bNative)
 	m_File_Name		= File_Name;
 	m_File_bNative	= bNative;
 
+	if( m_nCollections > 0 )	// invalidates the file name look-up tables of data collections
+	{
+		#pragma omp atomic	// outputs might be saved concurrently
+		m_File_Name_Revision++;
+	}
+
 	m_Name			= SG_File_Get_Name(File_Name, false);
 
 	m_bModified		= false;
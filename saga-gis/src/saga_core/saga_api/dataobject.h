@@ -173,6 +173,8 @@ SAGA_API_DLL_EXPORT int			SG_Get_History_Depth			(void);
 //---------------------------------------------------------
 class SAGA_API_DLL_EXPORT CSG_Data_Object
 {
+	friend class CSG_Data_Collection;
+
 public:
 	CSG_Data_Object(void);
 	virtual ~CSG_Data_Object(void);
@@ -246,9 +248,12 @@ protected:
 
 private:
 
+	static int						m_File_Name_Revision;	// changes, whenever the file name of a collected data object changes
+
+
 	bool							m_bModified, m_bUpdate, m_File_bNative;
 
-	int								m_File_Type;
+	int								m_File_Type, m_nCollections;
 
 	double							m_NoData_Value, m_NoData_hiValue;
 
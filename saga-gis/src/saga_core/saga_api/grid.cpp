@@ -63,6 +63,10 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "grid.h"
 
 
@@ -243,6 +247,15 @@ void CSG_Grid::_On_Construction(void)
 	m_LineBuffer		= NULL;
 	m_LineBuffer_Count	= 5;
 
+#ifdef _OPENMP
+	omp_init_lock((omp_lock_t *)(m_LineBuffer_Lock = SG_Malloc(sizeof(omp_lock_t))));
+#else
+	m_LineBuffer_Lock	= NULL;
+#endif
+
+	m_pProvider			= NULL;
+	m_Virtual_bSaved	= NULL;
+
 	m_zScale			= 1.0;
 	m_zOffset			= 0.0;
 
@@ -318,6 +331,27 @@ bool CSG_Grid::Create(TSG_Data_Type Type, int NX, int NY, double Cellsize, doubl
 	return( m_bCreated );
 }
 
+//---------------------------------------------------------
+/**
+  * Creates a virtual grid, which reads its rows on demand from
+  * pProvider. The grid takes ownership of the provider.
+*/
+bool CSG_Grid::Create(const CSG_Grid_System &System, TSG_Data_Type Type, CSG_Grid_Line_Provider *pProvider)
+{
+	Destroy();
+
+	_Set_Properties(Type, System.Get_NX(), System.Get_NY(), System.Get_Cellsize(), System.Get_XMin(), System.Get_YMin());
+
+	Set_Buffer_Size(SG_Grid_Cache_Get_Threshold());
+
+	if( _Virtual_Create(pProvider) )
+	{
+		m_bCreated	= true;
+	}
+
+	return( m_bCreated );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -332,6 +366,12 @@ bool CSG_Grid::Create(TSG_Data_Type Type, int NX, int NY, double Cellsize, doubl
 CSG_Grid::~CSG_Grid(void)
 {
 	Destroy();
+
+#ifdef _OPENMP
+	omp_destroy_lock((omp_lock_t *)m_LineBuffer_Lock);
+
+	SG_Free(m_LineBuffer_Lock);
+#endif
 }
 
 /**
@@ -451,6 +491,9 @@ bool CSG_Grid::is_Valid(void) const
 
 		case GRID_MEMORY_Cache:
 			return( m_Cache_Stream.is_Open() );
+
+		case GRID_MEMORY_Virtual:
+			return( m_pProvider != NULL );
 		}
 	}
 
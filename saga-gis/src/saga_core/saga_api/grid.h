@@ -89,10 +89,34 @@ typedef enum ESG_Grid_Memory_Type
 {
 	GRID_MEMORY_Normal					= 0,
 	GRID_MEMORY_Cache,
-	GRID_MEMORY_Compression
+	GRID_MEMORY_Compression,
+	GRID_MEMORY_Virtual
 }
 TSG_Grid_Memory_Type;
 
+//---------------------------------------------------------
+/**
+  * Source of the rows of a virtual grid (GRID_MEMORY_Virtual).
+  * Rows are requested on demand and held in the grid's line
+  * buffer, so only the parts of the source that are actually
+  * accessed have to be read. Row 0 is the southernmost row,
+  * values are expected in the grid's data type. The provider
+  * is never written to, modified rows are kept in a temporary
+  * file instead.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Grid_Line_Provider
+{
+public:
+	virtual ~CSG_Grid_Line_Provider(void)	{}
+
+	virtual bool				Read_Line		(int y, void *Data)					= 0;
+
+	/// Returns true, if File is the source of the rows.
+	virtual bool				is_Source		(const CSG_String &File)	const	{	return( false );	}
+
+};
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -462,6 +486,8 @@ public:		///////////////////////////////////////////////
 								CSG_Grid	(TSG_Data_Type Type, int NX, int NY, double Cellsize = 0.0, double xMin = 0.0, double yMin = 0.0, TSG_Grid_Memory_Type Memory_Type = GRID_MEMORY_Normal);
 	bool						Create		(TSG_Data_Type Type, int NX, int NY, double Cellsize = 0.0, double xMin = 0.0, double yMin = 0.0, TSG_Grid_Memory_Type Memory_Type = GRID_MEMORY_Normal);
 
+	bool						Create		(const CSG_Grid_System &System, TSG_Data_Type Type, CSG_Grid_Line_Provider *pProvider);
+
 
 	//-----------------------------------------------------
 	virtual ~CSG_Grid(void);
@@ -483,6 +509,12 @@ public:		///////////////////////////////////////////////
 	int							Get_nValueBytes	(void)	const	{	return( (int)SG_Data_Type_Get_Size(m_Type) );	}
 	int							Get_nLineBytes	(void)	const	{	return( m_Type != SG_DATATYPE_Bit ? (int)SG_Data_Type_Get_Size(m_Type) * Get_NX() : 1 + Get_NX() / 8 );	}
 
+	/** Direct access to the raw (unscaled) values of row y in the grid's native data type.
+	  * Returns NULL if the grid is not completely held in memory (cache, compression).
+	  * Call Set_Modified() after writing to it.
+	*/
+	void *						Get_Line_Data	(int y)	const	{	return( m_Memory_Type == GRID_MEMORY_Normal && m_Values && y >= 0 && y < Get_NY() ? m_Values[y] : NULL );	}
+
 	void						Set_Unit		(const SG_Char *String);
 	const SG_Char *				Get_Unit		(void)	const;
 
@@ -560,6 +592,9 @@ public:		///////////////////////////////////////////////
 	bool						is_Compressed				(void)		const	{	return( m_Memory_Type == GRID_MEMORY_Compression );	};
 	double						Get_Compression_Ratio		(void)		const;
 
+	bool						Set_Virtual					(bool bOn);
+	bool						is_Virtual					(void)		const	{	return( m_Memory_Type == GRID_MEMORY_Virtual );	}
+
 
 	//-----------------------------------------------------
 	// Operations...
@@ -813,7 +848,7 @@ private:	///////////////////////////////////////////////
 	void						**m_Values;
 
 	bool						m_bCreated, m_bIndex, m_Memory_bLock,
-								m_Cache_bTemp, m_Cache_bSwap, m_Cache_bFlip;
+								m_Cache_bTemp, m_Cache_bSwap, m_Cache_bFlip, *m_Virtual_bSaved;
 
 	int							m_LineBuffer_Count;
 
@@ -829,6 +864,8 @@ private:	///////////////////////////////////////////////
 
 	TSG_Grid_Memory_Type		m_Memory_Type;
 
+	CSG_Grid_Line_Provider		*m_pProvider;
+
 	CSG_Grid_System				m_System;
 
 	CSG_String					m_Unit, m_Cache_Path;
@@ -848,6 +885,8 @@ private:	///////////////////////////////////////////////
 
 	TSG_Grid_Line				*m_LineBuffer;
 
+	void						*m_LineBuffer_Lock;
+
 
 	//-----------------------------------------------------
 	void						_On_Construction		(void);
@@ -871,6 +910,8 @@ private:	///////////////////////////////////////////////
 	TSG_Grid_Line *				_LineBuffer_Get_Line	(int y)							const;
 	void						_LineBuffer_Set_Value	(int x, int y, double Value);
 	double						_LineBuffer_Get_Value	(int x, int y)					const;
+	void						_LineBuffer_Lock		(void)							const;
+	void						_LineBuffer_Unlock		(void)							const;
 
 	bool						_Array_Create			(void);
 	void						_Array_Destroy			(void);
@@ -886,6 +927,11 @@ private:	///////////////////////////////////////////////
 	void						_Compr_LineBuffer_Save	(TSG_Grid_Line *pLine)			const;
 	void						_Compr_LineBuffer_Load	(TSG_Grid_Line *pLine, int y)	const;
 
+	bool						_Virtual_Create			(CSG_Grid_Line_Provider *pProvider);
+	bool						_Virtual_Destroy		(bool bMemory_Restore);
+	void						_Virtual_LineBuffer_Save(TSG_Grid_Line *pLine)			const;
+	void						_Virtual_LineBuffer_Load(TSG_Grid_Line *pLine, int y)	const;
+
 
 	//-----------------------------------------------------
 	// File access...
@@ -968,6 +1014,10 @@ SAGA_API_DLL_EXPORT void			SG_Grid_Cache_Set_Directory		(const SG_Char *Director
 SAGA_API_DLL_EXPORT void			SG_Grid_Cache_Set_Automatic		(bool bOn);
 SAGA_API_DLL_EXPORT bool			SG_Grid_Cache_Get_Automatic		(void);
 
+/** If on, grids are loaded as virtual grids reading their rows on demand */
+SAGA_API_DLL_EXPORT void			SG_Grid_Cache_Set_Virtual		(bool bOn);
+SAGA_API_DLL_EXPORT bool			SG_Grid_Cache_Get_Virtual		(void);
+
 SAGA_API_DLL_EXPORT void			SG_Grid_Cache_Set_Confirm		(int Confirm);
 SAGA_API_DLL_EXPORT int				SG_Grid_Cache_Get_Confirm		(void);
 
@@ -0,0 +1,1402 @@
+/**********************************************************
+ * Version $Id$
+ *********************************************************/
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                   Library: SAGA_API                   //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                  grid_fill_sinks.cpp                  //
+//                                                       //
+//                 Copyright (C) 2014 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, version 2.1 of the License.      //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, write to the Free Software Foundation, Inc.,     //
+// 51 Franklin Street, 5th Floor, Boston, MA 02110-1301, //
+// USA.                                                  //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                Institute of Geography                 //
+//                University of Hamburg                  //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+
+
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include <float.h>
+
+#include "grid_hydrology.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define FILL_LABEL_NODATA		-1
+#define FILL_LABEL_NONE			0
+#define FILL_LABEL_OUTLET		1
+
+#define FILL_PROGRESS_STEP		65536
+
+//---------------------------------------------------------
+typedef struct SFill_Cell
+{
+	double	z;
+
+	int		x, y;
+}
+TFill_Cell;
+
+//---------------------------------------------------------
+typedef struct SFill_Edge
+{
+	int		a, b;
+
+	double	z;
+}
+TFill_Edge;
+
+//---------------------------------------------------------
+typedef struct SFill_Tile
+{
+	int		x, y, nx, ny, nLabels, Offset, *Border;
+}
+TFill_Tile;
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// priority queue (binary min heap) of cells to be flooded
+//---------------------------------------------------------
+class CFill_Open
+{
+public:
+	CFill_Open(void)	{	m_Cells.Create(sizeof(TFill_Cell), 0, SG_ARRAY_GROWTH_3);	}
+
+	bool			is_Empty		(void)	const	{	return( m_Cells.Get_Size() == 0 );	}
+
+	double			Get_Top			(void)	const	{	return( ((TFill_Cell *)m_Cells.Get_Array())->z );	}
+
+	void			Push			(int x, int y, double z)
+	{
+		if( m_Cells.Inc_Array() )
+		{
+			TFill_Cell	*Cells	= (TFill_Cell *)m_Cells.Get_Array();
+
+			size_t	i	= m_Cells.Get_Size() - 1;
+
+			while( i > 0 && Cells[(i - 1) / 2].z > z )
+			{
+				Cells[i]	= Cells[(i - 1) / 2];	i	= (i - 1) / 2;
+			}
+
+			Cells[i].z	= z;
+			Cells[i].x	= x;
+			Cells[i].y	= y;
+		}
+	}
+
+	void			Pop				(int &x, int &y, double &z)
+	{
+		TFill_Cell	*Cells	= (TFill_Cell *)m_Cells.Get_Array();
+
+		size_t	i	= 0, n	= m_Cells.Get_Size() - 1;
+
+		x	= Cells[0].x;
+		y	= Cells[0].y;
+		z	= Cells[0].z;
+
+		for(size_t j=1; j<n; j=2*i+1)
+		{
+			if( j + 1 < n && Cells[j + 1].z < Cells[j].z )
+			{
+				j++;
+			}
+
+			if( Cells[n].z <= Cells[j].z )
+			{
+				break;
+			}
+
+			Cells[i]	= Cells[j];	i	= j;
+		}
+
+		Cells[i]	= Cells[n];
+
+		m_Cells.Set_Array(n, false);
+	}
+
+
+private:
+
+	CSG_Array		m_Cells;
+
+};
+
+//---------------------------------------------------------
+// plain first-in-first-out queue of cells, which have been
+// raised to the current spill elevation
+//---------------------------------------------------------
+class CFill_Pit
+{
+public:
+	CFill_Pit(void)	{	m_First	= 0;	m_Cells.Create(2 * sizeof(int), 0, SG_ARRAY_GROWTH_3);	}
+
+	bool			is_Empty		(void)	const	{	return( m_First >= m_Cells.Get_Size() );	}
+
+	void			Push			(int x, int y)
+	{
+		if( is_Empty() )
+		{
+			m_First	= 0;	m_Cells.Set_Array(0, false);
+		}
+		else if( m_First >= FILL_PROGRESS_STEP && 2 * m_First >= m_Cells.Get_Size() )	// drop what has already been processed
+		{
+			int	*Cells	= (int *)m_Cells.Get_Array();	size_t	n	= m_Cells.Get_Size() - m_First;
+
+			memmove(Cells, Cells + 2 * m_First, n * 2 * sizeof(int));	m_First	= 0;	m_Cells.Set_Array(n, false);
+		}
+
+		if( m_Cells.Inc_Array() )
+		{
+			int	*Cell	= (int *)m_Cells.Get_Entry(m_Cells.Get_Size() - 1);
+
+			Cell[0]	= x;
+			Cell[1]	= y;
+		}
+	}
+
+	void			Pop				(int &x, int &y)
+	{
+		int	*Cell	= (int *)m_Cells.Get_Entry(m_First++);
+
+		x	= Cell[0];
+		y	= Cell[1];
+	}
+
+
+private:
+
+	size_t			m_First;
+
+	CSG_Array		m_Cells;
+
+};
+
+//---------------------------------------------------------
+// undirected edges between labels keeping the lowest spill
+// elevation of each pair (open addressing hash table)
+//---------------------------------------------------------
+class CFill_Edges
+{
+public:
+	CFill_Edges(void)	{	m_nEdges	= m_nSlots	= 0;	m_Edges	= NULL;	}
+	~CFill_Edges(void)	{	Destroy();	}
+
+	void				Destroy			(void)	{	SG_FREE_SAFE(m_Edges);	m_nEdges	= m_nSlots	= 0;	}
+
+	size_t				Get_Count		(void)	const	{	return( m_nEdges );	}
+	size_t				Get_Slots		(void)	const	{	return( m_nSlots );	}
+
+	/// returns NULL for empty slots
+	const TFill_Edge *	Get_Edge		(size_t i)	const	{	return( m_Edges[i].a != FILL_LABEL_NONE ? m_Edges + i : NULL );	}
+
+	bool				Add				(int a, int b, double z)
+	{
+		if( a == b )
+		{
+			return( false );
+		}
+
+		if( a > b )
+		{
+			int	c	= a;	a	= b;	b	= c;
+		}
+
+		if( 2 * (m_nEdges + 1) > m_nSlots && !_Set_Slots(m_nSlots > 0 ? 2 * m_nSlots : 256) )
+		{
+			return( false );
+		}
+
+		for(size_t i=_Get_Hash(a, b); ; i=(i + 1) & (m_nSlots - 1))
+		{
+			TFill_Edge	*pEdge	= m_Edges + i;
+
+			if( pEdge->a == FILL_LABEL_NONE )
+			{
+				pEdge->a	= a;
+				pEdge->b	= b;
+				pEdge->z	= z;
+
+				m_nEdges++;
+
+				return( true );
+			}
+
+			if( pEdge->a == a && pEdge->b == b )
+			{
+				if( pEdge->z > z )
+				{
+					pEdge->z	= z;
+				}
+
+				return( true );
+			}
+		}
+	}
+
+
+private:
+
+	size_t				m_nEdges, m_nSlots;
+
+	TFill_Edge			*m_Edges;
+
+
+	size_t				_Get_Hash		(int a, int b)	const
+	{
+		return( ((size_t)a * 2654435761u ^ (size_t)b * 40503u) & (m_nSlots - 1) );
+	}
+
+	bool				_Set_Slots		(size_t nSlots)
+	{
+		TFill_Edge	*Edges	= (TFill_Edge *)SG_Calloc(nSlots, sizeof(TFill_Edge));
+
+		if( !Edges )
+		{
+			return( false );
+		}
+
+		size_t	nOld	= m_nSlots;	TFill_Edge	*Old	= m_Edges;
+
+		m_Edges	= Edges;	m_nSlots	= nSlots;	m_nEdges	= 0;
+
+		for(size_t i=0; i<nOld; i++)
+		{
+			if( Old[i].a != FILL_LABEL_NONE )
+			{
+				Add(Old[i].a, Old[i].b, Old[i].z);
+			}
+		}
+
+		SG_FREE_SAFE(Old);
+
+		return( true );
+	}
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// valid cells with a neighbour outside the grid or no-data
+// drain directly out of the DEM
+//---------------------------------------------------------
+static inline bool	Fill_is_Outlet	(CSG_Grid *pDEM, int x, int y)
+{
+	for(int i=0; i<8; i++)
+	{
+		if( !pDEM->is_InGrid(CSG_Grid_System::Get_xTo(i, x), CSG_Grid_System::Get_yTo(i, y)) )
+		{
+			return( true );
+		}
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+static inline bool	Fill_is_Border	(const TFill_Tile &Tile, int x, int y)
+{
+	return( x == 0 || y == 0 || x == Tile.nx - 1 || y == Tile.ny - 1 );
+}
+
+//---------------------------------------------------------
+// position of a border cell (local coordinates) in the tile's
+// list of border labels
+//---------------------------------------------------------
+static inline int	Fill_Border_Index	(const TFill_Tile &Tile, int x, int y)
+{
+	if( y == 0            )	return( x );
+	if( y == Tile.ny - 1  )	return( x + Tile.nx );
+	if( x == 0            )	return( y + Tile.nx * 2 );
+
+	return( y + Tile.nx * 2 + Tile.ny );
+}
+
+//---------------------------------------------------------
+// maps a tile's local label to the global label space
+//---------------------------------------------------------
+static inline int	Fill_Get_Label	(const TFill_Tile &Tile, int Label)
+{
+	return( Label <= FILL_LABEL_OUTLET ? Label : Tile.Offset + Label - (FILL_LABEL_OUTLET + 1) );
+}
+
+//---------------------------------------------------------
+// Floods a tile from its border cells and from the cells
+// draining out of the DEM, which get the outlet label. All
+// other border cells start a new label, if they have not been
+// reached from a lower one. Raised cells go to the plain queue.
+// Returns the number of labels, that have been started.
+//---------------------------------------------------------
+static int	Fill_Tile_Labels	(CSG_Grid *pDEM, TFill_Tile &Tile, double *z, int *Label, CFill_Edges *pEdges)
+{
+	CFill_Open	Open;	CFill_Pit	Pit;
+
+	for(int y=0; y<Tile.ny; y++)
+	{
+		for(int x=0; x<Tile.nx; x++)
+		{
+			sLong	n	= x + y * (sLong)Tile.nx;
+
+			if( pDEM->is_NoData(Tile.x + x, Tile.y + y) )
+			{
+				Label[n]	= FILL_LABEL_NODATA;
+			}
+			else
+			{
+				z[n]	= pDEM->asDouble(Tile.x + x, Tile.y + y);
+
+				if( Fill_is_Outlet(pDEM, Tile.x + x, Tile.y + y) )
+				{
+					Label[n]	= FILL_LABEL_OUTLET;
+
+					Open.Push(x, y, z[n]);
+				}
+				else
+				{
+					Label[n]	= FILL_LABEL_NONE;
+
+					if( Fill_is_Border(Tile, x, y) )
+					{
+						Open.Push(x, y, z[n]);
+					}
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	int	nLabels	= FILL_LABEL_OUTLET;
+
+	while( !Open.is_Empty() || !Pit.is_Empty() )
+	{
+		int	x, y;	double	zc;
+
+		if( !Pit.is_Empty() )
+		{
+			Pit.Pop(x, y);
+		}
+		else
+		{
+			Open.Pop(x, y, zc);
+		}
+
+		sLong	n	= x + y * (sLong)Tile.nx;	zc	= z[n];
+
+		if( Label[n] == FILL_LABEL_NONE )
+		{
+			Label[n]	= ++nLabels;
+		}
+
+		for(int i=0; i<8; i++)
+		{
+			int	ix	= CSG_Grid_System::Get_xTo(i, x);
+			int	iy	= CSG_Grid_System::Get_yTo(i, y);
+
+			if( ix < 0 || ix >= Tile.nx || iy < 0 || iy >= Tile.ny )
+			{
+				continue;
+			}
+
+			sLong	in	= ix + iy * (sLong)Tile.nx;
+
+			if( Label[in] != FILL_LABEL_NONE )
+			{
+				if( pEdges && Label[in] != FILL_LABEL_NODATA && Label[in] != Label[n] )
+				{
+					pEdges->Add(Label[n], Label[in], M_GET_MAX(zc, z[in]));
+				}
+			}
+			else
+			{
+				Label[in]	= Label[n];
+
+				if( !Fill_is_Border(Tile, ix, iy) )	// border cells are already queued and never lower than zc
+				{
+					if( z[in] <= zc )
+					{
+						z[in]	= zc;
+
+						Pit.Push(ix, iy);
+					}
+					else
+					{
+						Open.Push(ix, iy, z[in]);
+					}
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	for(int y=0; y<Tile.ny; y++)
+	{
+		for(int x=0; x<Tile.nx; x+=(y == 0 || y == Tile.ny - 1 || Tile.nx < 2 ? 1 : Tile.nx - 1))
+		{
+			Tile.Border[Fill_Border_Index(Tile, x, y)]	= Label[x + y * (sLong)Tile.nx];
+		}
+	}
+
+	return( nLabels - FILL_LABEL_OUTLET );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Grid_Fill_Sinks::CSG_Grid_Fill_Sinks(void)
+{
+	m_pDEM		= NULL;
+	m_pFilled	= NULL;
+
+	m_Tile_Size	= 0;
+	m_Method	= SG_FILL_SINKS_FLAT;
+	m_MinSlope	= 0.0;
+	m_Type		= SG_DATATYPE_Double;
+}
+
+//---------------------------------------------------------
+CSG_Grid_Fill_Sinks::~CSG_Grid_Fill_Sinks(void)
+{}
+
+//---------------------------------------------------------
+bool CSG_Grid_Fill_Sinks::Set_Method(TSG_Fill_Sinks_Method Method, double MinSlope)
+{
+	if( Method == SG_FILL_SINKS_MINSLOPE && MinSlope <= 0.0 )
+	{
+		Method	= SG_FILL_SINKS_FLAT;
+	}
+
+	m_Method	= Method;
+	m_MinSlope	= Method == SG_FILL_SINKS_MINSLOPE ? MinSlope : 0.0;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Fill_Sinks::Set_Tile_Size(int Size)
+{
+	if( Size < 0 )
+	{
+		return( false );
+	}
+
+	m_Tile_Size	= Size > 0 && Size < 16 ? 16 : Size;
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// next larger value the filled grid is able to store
+//---------------------------------------------------------
+double CSG_Grid_Fill_Sinks::_Get_Epsilon(double z)	const
+{
+	switch( m_Type )
+	{
+	case SG_DATATYPE_Float:
+		{
+			union	{	float f;	unsigned int i;	}	v;	v.f	= (float)z;
+
+			if( v.f == 0.0f )	{	v.i	 = 1;	}	else if( v.f > 0.0f )	{	v.i++;	}	else	{	v.i--;	}
+
+			return( v.f );
+		}
+
+	case SG_DATATYPE_Double:
+		{
+			union	{	double f;	uLong i;	}	v;	v.f	= z;
+
+			if( v.f == 0.0  )	{	v.i	 = 1;	}	else if( v.f > 0.0  )	{	v.i++;	}	else	{	v.i--;	}
+
+			return( v.f );
+		}
+
+	default:	// integer types
+		return( z + 1.0 );
+	}
+}
+
+//---------------------------------------------------------
+// next smaller value the filled grid is able to store, integer
+// types keep the value, so that breached paths become flat
+//---------------------------------------------------------
+double CSG_Grid_Fill_Sinks::_Get_Lowered(double z)	const
+{
+	switch( m_Type )
+	{
+	case SG_DATATYPE_Float:
+	case SG_DATATYPE_Double:
+		return( -_Get_Epsilon(-z) );
+
+	default:	// integer types
+		return( z );
+	}
+}
+
+//---------------------------------------------------------
+// Sets iz to the elevation neighbour i has to get at least,
+// when it is flooded from a cell with elevation z. Returns
+// true, if the neighbour has been raised (or is flat).
+//---------------------------------------------------------
+inline bool CSG_Grid_Fill_Sinks::_Get_Raised(double z, int i, double &iz)	const
+{
+	switch( m_Method )
+	{
+	default:	// SG_FILL_SINKS_FLAT
+		if( iz <= z )
+		{
+			iz	= z;	return( true );
+		}
+		break;
+
+	case SG_FILL_SINKS_EPSILON:
+		if( iz < (z = _Get_Epsilon(z)) )
+		{
+			iz	= z;	return( true );
+		}
+		break;
+
+	case SG_FILL_SINKS_MINSLOPE:
+		if( iz < (z = z + m_dz[i]) )
+		{
+			iz	= z;	return( true );
+		}
+		break;
+	}
+
+	return( false );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_Fill_Sinks::Execute(CSG_Grid *pDEM, CSG_Grid *pFilled, CSG_Grid *pDirection, CSG_Grid *pBasins)
+{
+	if( !pDEM || !pDEM->is_Valid() || !pFilled || !pFilled->is_Compatible(pDEM->Get_System()) )
+	{
+		return( false );
+	}
+
+	if( pDirection && !pDirection->is_Compatible(pDEM->Get_System()) )	{	pDirection	= NULL;	}
+	if( pBasins    && !pBasins   ->is_Compatible(pDEM->Get_System()) )	{	pBasins		= NULL;	}
+
+	m_pDEM		= pDEM;
+	m_pFilled	= pFilled;
+	m_Type		= pFilled->Get_Type();
+
+	for(int i=0; i<8; i++)
+	{
+		m_dz[i]	= m_MinSlope * pDEM->Get_System().Get_Length(i);
+	}
+
+	//-----------------------------------------------------
+	bool	bResult;
+
+	if( m_Tile_Size > 0 && m_Method != SG_FILL_SINKS_BREACH && !pDirection && !pBasins && (pDEM->Get_NX() > m_Tile_Size || pDEM->Get_NY() > m_Tile_Size) )
+	{
+		bResult	= _Fill_Tiled();
+	}
+	else
+	{
+		bResult	= _Fill_Grid(pDirection, pBasins);
+	}
+
+	m_pDEM		= NULL;
+	m_pFilled	= NULL;
+
+	return( bResult );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_Fill_Sinks::_Fill_Grid(CSG_Grid *pDirection, CSG_Grid *pBasins)
+{
+	int		nx		= m_pDEM->Get_NX();
+	int		ny		= m_pDEM->Get_NY();
+	sLong	nCells	= m_pDEM->Get_NCells();
+
+	BYTE	*Closed	= (BYTE *)SG_Calloc(nCells / 8 + 1, sizeof(BYTE));
+
+	BYTE	*Back	= m_Method == SG_FILL_SINKS_BREACH ? (BYTE *)SG_Malloc(nCells * sizeof(BYTE)) : NULL;	// direction to the cell each cell has been flooded from
+
+	if( !Closed || (m_Method == SG_FILL_SINKS_BREACH && !Back) )
+	{
+		SG_FREE_SAFE(Closed);
+		SG_FREE_SAFE(Back);
+
+		return( false );
+	}
+
+	if( m_pFilled != m_pDEM )
+	{
+		#pragma omp parallel for
+		for(int y=0; y<ny; y++)
+		{
+			for(int x=0; x<nx; x++)
+			{
+				if( m_pDEM->is_NoData(x, y) )
+				{
+					m_pFilled->Set_NoData(x, y);
+				}
+				else
+				{
+					m_pFilled->Set_Value(x, y, m_pDEM->asDouble(x, y));
+				}
+			}
+		}
+	}
+
+	if( pDirection )	{	pDirection->Assign_NoData();	}
+	if( pBasins    )	{	pBasins   ->Assign_NoData();	}
+
+	//-----------------------------------------------------
+	CFill_Open	Open;	CFill_Pit	Pit;	sLong	nOutlets	= 0;
+
+	for(int y=0; y<ny; y++)
+	{
+		for(int x=0; x<nx; x++)
+		{
+			if( !m_pDEM->is_NoData(x, y) && Fill_is_Outlet(m_pDEM, x, y) )
+			{
+				sLong	n	= x + y * (sLong)nx;
+
+				Closed[n / 8]	|= 1 << (n % 8);
+
+				if( Back )
+				{
+					Back[n]	= 8;	// outlet
+				}
+
+				Open.Push(x, y, m_pFilled->asDouble(x, y));
+
+				if( pBasins )
+				{
+					pBasins->Set_Value(x, y, (double)nOutlets++);
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	bool	bPitTop	= false;	double	PitTop	= 0.0;
+
+	for(sLong nProcessed=0; !Open.is_Empty() || !Pit.is_Empty(); nProcessed++)
+	{
+		if( nProcessed % FILL_PROGRESS_STEP == 0 && !SG_UI_Process_Set_Progress((double)nProcessed, (double)nCells) )
+		{
+			SG_Free(Closed);
+			SG_FREE_SAFE(Back);
+
+			return( false );
+		}
+
+		int	x, y;	double	z;
+
+		if( m_Method == SG_FILL_SINKS_EPSILON && bPitTop && !Open.is_Empty() && Open.Get_Top() == PitTop )
+		{
+			Open.Pop(x, y, z);	bPitTop	= false;	// an open cell at the pit's level floods it first (Barnes et al. 2014)
+		}
+		else if( !Pit.is_Empty() )
+		{
+			Pit.Pop(x, y);	z	= m_pFilled->asDouble(x, y);
+
+			if( !bPitTop )
+			{
+				bPitTop	= true;	PitTop	= z;
+			}
+		}
+		else
+		{
+			Open.Pop(x, y, z);	bPitTop	= false;
+		}
+
+		double	Basin	= pBasins ? pBasins->asDouble(x, y) : 0.0;
+
+		for(int i=0; i<8; i++)
+		{
+			int	ix	= CSG_Grid_System::Get_xTo(i, x);
+			int	iy	= CSG_Grid_System::Get_yTo(i, y);
+
+			if( !m_pDEM->is_InGrid(ix, iy) )
+			{
+				continue;
+			}
+
+			sLong	n	= ix + iy * (sLong)nx;
+
+			if( Closed[n / 8] & (1 << (n % 8)) )
+			{
+				if( pBasins && Fill_is_Outlet(m_pDEM, ix, iy) )	// outlets join the basin of their upslope neighbour
+				{
+					pBasins->Set_Value(ix, iy, Basin);
+				}
+
+				continue;
+			}
+
+			Closed[n / 8]	|= 1 << (n % 8);
+
+			double	iz	= m_pFilled->asDouble(ix, iy);
+
+			if( Back )	// breaching, lower cells are never raised
+			{
+				Back[n]	= (BYTE)((i + 4) % 8);
+
+				if( iz < z )
+				{
+					_Breach_Path(x, y, iz, Back);	z	= m_pFilled->asDouble(x, y);
+				}
+
+				Open.Push(ix, iy, iz);
+
+				if( pDirection )
+				{
+					pDirection->Set_Value(ix, iy, (i + 4) % 8);
+				}
+			}
+			else if( _Get_Raised(z, i, iz) )
+			{
+				m_pFilled->Set_Value(ix, iy, iz);
+
+				if( m_Method == SG_FILL_SINKS_MINSLOPE )
+				{
+					Open.Push(ix, iy, iz);
+				}
+				else
+				{
+					Pit.Push(ix, iy);
+
+					if( pDirection && m_Method == SG_FILL_SINKS_FLAT )
+					{
+						pDirection->Set_Value(ix, iy, (i + 4) % 8);
+					}
+				}
+			}
+			else
+			{
+				Open.Push(ix, iy, iz);
+			}
+
+			if( pBasins )
+			{
+				pBasins->Set_Value(ix, iy, Basin);
+			}
+		}
+	}
+
+	SG_Free(Closed);
+	SG_FREE_SAFE(Back);
+
+	//-----------------------------------------------------
+	// steepest descent for all cells not draining into a flat
+
+	if( pDirection )
+	{
+		#pragma omp parallel for
+		for(int y=0; y<ny; y++)
+		{
+			for(int x=0; x<nx; x++)
+			{
+				if( !m_pFilled->is_NoData(x, y) && pDirection->is_NoData(x, y) )
+				{
+					int		Direction	= -1;
+					double	z	= m_pFilled->asDouble(x, y), dzMax	= 0.0;
+
+					for(int i=0; i<8; i++)
+					{
+						int	ix	= CSG_Grid_System::Get_xTo(i, x);
+						int	iy	= CSG_Grid_System::Get_yTo(i, y);
+
+						if( m_pFilled->is_InGrid(ix, iy) )
+						{
+							double	dz	= (z - m_pFilled->asDouble(ix, iy)) / m_pFilled->Get_System().Get_Length(i);
+
+							if( dzMax < dz )
+							{
+								dzMax		= dz;
+								Direction	= i;
+							}
+						}
+					}
+
+					pDirection->Set_Value(x, y, Direction);
+				}
+			}
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+// Lowers the cells along the flooding path from cell (x, y)
+// back to its outlet below z, each one by the smallest
+// representable decrement, until a cell is reached, which
+// already is lower (Lindsay 2016).
+//---------------------------------------------------------
+void CSG_Grid_Fill_Sinks::_Breach_Path(int x, int y, double z, const BYTE *Back)
+{
+	for(;;)
+	{
+		z	= _Get_Lowered(z);
+
+		if( m_pFilled->asDouble(x, y) <= z )
+		{
+			return;
+		}
+
+		m_pFilled->Set_Value(x, y, z);
+
+		int	i	= Back[x + y * (sLong)m_pFilled->Get_NX()];
+
+		if( i > 7 )	// outlet
+		{
+			return;
+		}
+
+		x	= CSG_Grid_System::Get_xTo(i, x);
+		y	= CSG_Grid_System::Get_yTo(i, y);
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_Fill_Sinks::_Fill_Tiled(void)
+{
+	int	Size	= m_Tile_Size;
+	int	nxTiles	= 1 + (m_pDEM->Get_NX() - 1) / Size;
+	int	nyTiles	= 1 + (m_pDEM->Get_NY() - 1) / Size;
+	int	nTiles	= nxTiles * nyTiles;
+	int	nBlocks	= M_GET_MAX(1, SG_Get_Max_Num_Threads_Omp());
+
+	TFill_Tile	*Tiles	= (TFill_Tile *)SG_Calloc(nTiles, sizeof(TFill_Tile));
+
+	if( !Tiles )
+	{
+		return( false );
+	}
+
+	bool	bResult	= true;
+
+	for(int t=0; t<nTiles && bResult; t++)
+	{
+		TFill_Tile	&Tile	= Tiles[t];
+
+		Tile.x		= Size * (t % nxTiles);
+		Tile.y		= Size * (t / nxTiles);
+		Tile.nx		= M_GET_MIN(Size, m_pDEM->Get_NX() - Tile.x);
+		Tile.ny		= M_GET_MIN(Size, m_pDEM->Get_NY() - Tile.y);
+		Tile.Border	= (int *)SG_Malloc(2 * (Tile.nx + Tile.ny) * sizeof(int));
+
+		bResult		= Tile.Border != NULL;
+	}
+
+	//-----------------------------------------------------
+	// 1. label the depressions of each tile and note their spill elevations
+
+	CFill_Edges	*Edges	= new CFill_Edges[nTiles];
+
+	for(int t0=0; bResult && t0<nTiles; t0+=nBlocks)
+	{
+		if( !SG_UI_Process_Set_Progress(t0, 3.0 * nTiles) )
+		{
+			bResult	= false;	break;
+		}
+
+		int	t1	= M_GET_MIN(t0 + nBlocks, nTiles);
+
+		#pragma omp parallel for
+		for(int t=t0; t<t1; t++)
+		{
+			sLong	nCells	= Tiles[t].nx * (sLong)Tiles[t].ny;
+
+			double	*z		= (double *)SG_Malloc(nCells * sizeof(double));
+			int		*Label	= (int    *)SG_Malloc(nCells * sizeof(int   ));
+
+			if( z && Label )
+			{
+				Tiles[t].nLabels	= Fill_Tile_Labels(m_pDEM, Tiles[t], z, Label, Edges + t);
+			}
+			else
+			{
+				Tiles[t].nLabels	= -1;
+			}
+
+			SG_FREE_SAFE(z);
+			SG_FREE_SAFE(Label);
+		}
+	}
+
+	//-----------------------------------------------------
+	// 2. global labels, spillover graph of all tiles
+
+	int	nLabels	= FILL_LABEL_OUTLET + 1;
+
+	for(int t=0; bResult && t<nTiles; t++)
+	{
+		Tiles[t].Offset	= nLabels;	nLabels	+= Tiles[t].nLabels;
+
+		bResult	= Tiles[t].nLabels >= 0;
+	}
+
+	CFill_Edges	*Cross	= new CFill_Edges[nTiles];
+
+	if( bResult )
+	{
+		#pragma omp parallel for
+		for(int t=0; t<nTiles; t++)
+		{
+			const TFill_Tile	&Tile	= Tiles[t];
+
+			for(int y=0; y<Tile.ny; y++)
+			{
+				for(int x=0; x<Tile.nx; x+=(y == 0 || y == Tile.ny - 1 || Tile.nx < 2 ? 1 : Tile.nx - 1))
+				{
+					int	a	= Fill_Get_Label(Tile, Tile.Border[Fill_Border_Index(Tile, x, y)]);
+
+					if( a == FILL_LABEL_NODATA )
+					{
+						continue;
+					}
+
+					for(int i=0; i<8; i++)
+					{
+						int	ix	= CSG_Grid_System::Get_xTo(i, Tile.x + x);
+						int	iy	= CSG_Grid_System::Get_yTo(i, Tile.y + y);
+
+						if( m_pDEM->is_InGrid(ix, iy) && (ix / Size != Tile.x / Size || iy / Size != Tile.y / Size) )
+						{
+							const TFill_Tile	&Next	= Tiles[(iy / Size) * nxTiles + ix / Size];
+
+							int	b	= Fill_Get_Label(Next, Next.Border[Fill_Border_Index(Next, ix - Next.x, iy - Next.y)]);
+
+							Cross[t].Add(a, b, M_GET_MAX(m_pDEM->asDouble(Tile.x + x, Tile.y + y), m_pDEM->asDouble(ix, iy)));
+						}
+					}
+				}
+			}
+		}
+	}
+
+	CFill_Edges	Graph;
+
+	for(int t=0; bResult && t<nTiles; t++)
+	{
+		for(size_t i=0; i<Edges[t].Get_Slots(); i++)
+		{
+			const TFill_Edge	*pEdge	= Edges[t].Get_Edge(i);
+
+			if( pEdge )
+			{
+				Graph.Add(Fill_Get_Label(Tiles[t], pEdge->a), Fill_Get_Label(Tiles[t], pEdge->b), pEdge->z);
+			}
+		}
+
+		for(size_t i=0; i<Cross[t].Get_Slots(); i++)
+		{
+			const TFill_Edge	*pEdge	= Cross[t].Get_Edge(i);
+
+			if( pEdge )
+			{
+				Graph.Add(pEdge->a, pEdge->b, pEdge->z);
+			}
+		}
+
+		Edges[t].Destroy();
+		Cross[t].Destroy();
+	}
+
+	delete[](Edges);
+	delete[](Cross);
+
+	//-----------------------------------------------------
+	// spill elevation of each label, i.e. the lowest elevation
+	// at which its water finds a way out of the DEM
+
+	double	*Spill	= bResult ? (double *)SG_Malloc(nLabels * sizeof(double)) : NULL;
+	sLong	*First	= bResult ? (sLong  *)SG_Calloc(nLabels + 1, sizeof(sLong)) : NULL;
+	int		*Target	= bResult ? (int    *)SG_Malloc((2 * Graph.Get_Count() + 1) * sizeof(int   )) : NULL;
+	double	*Weight	= bResult ? (double *)SG_Malloc((2 * Graph.Get_Count() + 1) * sizeof(double)) : NULL;
+
+	if( (bResult = Spill && First && Target && Weight) == true )
+	{
+		for(size_t i=0; i<Graph.Get_Slots(); i++)
+		{
+			const TFill_Edge	*pEdge	= Graph.Get_Edge(i);
+
+			if( pEdge )
+			{
+				First[pEdge->a + 1]++;
+				First[pEdge->b + 1]++;
+			}
+		}
+
+		for(int i=0; i<nLabels; i++)
+		{
+			First[i + 1]	+= First[i];
+			Spill[i]		 = DBL_MAX;
+		}
+
+		sLong	*Next	= (sLong *)SG_Malloc(nLabels * sizeof(sLong));	memcpy(Next, First, nLabels * sizeof(sLong));
+
+		for(size_t i=0; i<Graph.Get_Slots(); i++)
+		{
+			const TFill_Edge	*pEdge	= Graph.Get_Edge(i);
+
+			if( pEdge )
+			{
+				Target[Next[pEdge->a]]	= pEdge->b;	Weight[Next[pEdge->a]++]	= pEdge->z;
+				Target[Next[pEdge->b]]	= pEdge->a;	Weight[Next[pEdge->b]++]	= pEdge->z;
+			}
+		}
+
+		SG_Free(Next);
+
+		Graph.Destroy();
+
+		//-------------------------------------------------
+		CFill_Open	Open;
+
+		Spill[FILL_LABEL_OUTLET]	= -DBL_MAX;	Open.Push(FILL_LABEL_OUTLET, 0, -DBL_MAX);
+
+		while( !Open.is_Empty() )
+		{
+			int	a, b;	double	z;	Open.Pop(a, b, z);
+
+			if( z <= Spill[a] )
+			{
+				for(sLong i=First[a]; i<First[a + 1]; i++)
+				{
+					double	zb	= M_GET_MAX(z, Weight[i]);
+
+					if( zb < Spill[b = Target[i]] )
+					{
+						Spill[b]	= zb;	Open.Push(b, 0, zb);
+					}
+				}
+			}
+		}
+
+		for(int i=0; i<nLabels; i++)
+		{
+			if( Spill[i] == DBL_MAX )	// not connected to an outlet, should not happen
+			{
+				Spill[i]	= -DBL_MAX;
+			}
+		}
+	}
+
+	SG_FREE_SAFE(First);
+	SG_FREE_SAFE(Target);
+	SG_FREE_SAFE(Weight);
+
+	//-----------------------------------------------------
+	// 3. flood each tile again and raise it to its spill elevations
+
+	for(int t0=0; bResult && t0<nTiles; t0+=nBlocks)
+	{
+		if( !SG_UI_Process_Set_Progress(nTiles + t0, 3.0 * nTiles) )
+		{
+			bResult	= false;	break;
+		}
+
+		int	t1	= M_GET_MIN(t0 + nBlocks, nTiles);
+
+		#pragma omp parallel for
+		for(int t=t0; t<t1; t++)
+		{
+			TFill_Tile	&Tile	= Tiles[t];
+
+			sLong	nCells	= Tile.nx * (sLong)Tile.ny;
+
+			double	*z		= (double *)SG_Malloc(nCells * sizeof(double));
+			int		*Label	= (int    *)SG_Malloc(nCells * sizeof(int   ));
+
+			if( z && Label )
+			{
+				Fill_Tile_Labels(m_pDEM, Tile, z, Label, NULL);
+
+				sLong	n	= 0;
+
+				for(int y=0; y<Tile.ny; y++)
+				{
+					for(int x=0; x<Tile.nx; x++, n++)
+					{
+						if( Label[n] == FILL_LABEL_NODATA )
+						{
+							m_pFilled->Set_NoData(Tile.x + x, Tile.y + y);
+						}
+						else
+						{
+							m_pFilled->Set_Value(Tile.x + x, Tile.y + y, M_GET_MAX(z[n], Spill[Fill_Get_Label(Tile, Label[n])]));
+						}
+					}
+				}
+			}
+			else
+			{
+				Tile.nLabels	= -1;
+			}
+
+			SG_FREE_SAFE(z);
+			SG_FREE_SAFE(Label);
+		}
+
+		for(int t=t0; bResult && t<t1; t++)
+		{
+			bResult	= Tiles[t].nLabels >= 0;
+		}
+	}
+
+	SG_FREE_SAFE(Spill);
+
+	//-----------------------------------------------------
+	// 4. drain flats within each tile
+
+	if( m_Method != SG_FILL_SINKS_FLAT )
+	{
+		for(int t0=0; bResult && t0<nTiles; t0+=nBlocks)
+		{
+			if( !SG_UI_Process_Set_Progress(2 * nTiles + t0, 3.0 * nTiles) )
+			{
+				bResult	= false;	break;
+			}
+
+			int	t1	= M_GET_MIN(t0 + nBlocks, nTiles);
+
+			#pragma omp parallel for
+			for(int t=t0; t<t1; t++)
+			{
+				if( !_Fill_Tile_Slope(Tiles[t].x, Tiles[t].y, Tiles[t].nx, Tiles[t].ny) )
+				{
+					Tiles[t].nLabels	= -1;
+				}
+			}
+
+			for(int t=t0; bResult && t<t1; t++)
+			{
+				bResult	= Tiles[t].nLabels >= 0;
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	for(int t=0; t<nTiles; t++)
+	{
+		SG_FREE_SAFE(Tiles[t].Border);
+	}
+
+	SG_Free(Tiles);
+
+	return( bResult );
+}
+
+//---------------------------------------------------------
+// Imposes epsilon or minimum slope on a tile of the filled
+// surface, flooding it from its border and outlet cells.
+//---------------------------------------------------------
+bool CSG_Grid_Fill_Sinks::_Fill_Tile_Slope(int xTile, int yTile, int nx, int ny)
+{
+	double	*z		= (double *)SG_Malloc(nx * (sLong)ny * sizeof(double));
+	BYTE	*Closed	= (BYTE   *)SG_Calloc(nx * (sLong)ny,  sizeof(BYTE  ));
+
+	if( !z || !Closed )
+	{
+		SG_FREE_SAFE(z);
+		SG_FREE_SAFE(Closed);
+
+		return( false );
+	}
+
+	CFill_Open	Open;	CFill_Pit	Pit;	sLong	n	= 0;
+
+	for(int y=0; y<ny; y++)
+	{
+		for(int x=0; x<nx; x++, n++)
+		{
+			if( m_pFilled->is_NoData(xTile + x, yTile + y) )
+			{
+				Closed[n]	= 1;
+			}
+			else
+			{
+				z[n]	= m_pFilled->asDouble(xTile + x, yTile + y);
+
+				if( x == 0 || y == 0 || x == nx - 1 || y == ny - 1 || Fill_is_Outlet(m_pDEM, xTile + x, yTile + y) )
+				{
+					Closed[n]	= 1;
+
+					Open.Push(x, y, z[n]);
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	bool	bPitTop	= false;	double	PitTop	= 0.0;
+
+	while( !Open.is_Empty() || !Pit.is_Empty() )
+	{
+		int	x, y;	double	zc;
+
+		if( m_Method == SG_FILL_SINKS_EPSILON && bPitTop && !Open.is_Empty() && Open.Get_Top() == PitTop )
+		{
+			Open.Pop(x, y, zc);	bPitTop	= false;
+		}
+		else if( !Pit.is_Empty() )
+		{
+			Pit.Pop(x, y);
+
+			if( !bPitTop )
+			{
+				bPitTop	= true;	PitTop	= z[x + y * (sLong)nx];
+			}
+		}
+		else
+		{
+			Open.Pop(x, y, zc);	bPitTop	= false;
+		}
+
+		zc	= z[x + y * (sLong)nx];
+
+		for(int i=0; i<8; i++)
+		{
+			int	ix	= CSG_Grid_System::Get_xTo(i, x);
+			int	iy	= CSG_Grid_System::Get_yTo(i, y);
+
+			if( ix >= 0 && ix < nx && iy >= 0 && iy < ny && !Closed[ix + iy * (sLong)nx] )
+			{
+				sLong	in	= ix + iy * (sLong)nx;	Closed[in]	= 1;
+
+				if( _Get_Raised(zc, i, z[in]) && m_Method != SG_FILL_SINKS_MINSLOPE )
+				{
+					Pit.Push(ix, iy);
+				}
+				else
+				{
+					Open.Push(ix, iy, z[in]);
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	n	= 0;
+
+	for(int y=0; y<ny; y++)
+	{
+		for(int x=0; x<nx; x++, n++)
+		{
+			if( !m_pFilled->is_NoData(xTile + x, yTile + y) )
+			{
+				m_pFilled->Set_Value(xTile + x, yTile + y, z[n]);
+			}
+		}
+	}
+
+	SG_Free(z);
+	SG_Free(Closed);
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
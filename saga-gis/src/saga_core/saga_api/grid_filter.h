@@ -0,0 +1,273 @@
+/**********************************************************
+ * Version $Id$
+ *********************************************************/
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                   Library: SAGA_API                   //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                     grid_filter.h                     //
+//                                                       //
+//                 Copyright (C) 2014 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, version 2.1 of the License.      //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, write to the Free Software Foundation, Inc.,     //
+// 51 Franklin Street, 5th Floor, Boston, MA 02110-1301, //
+// USA.                                                  //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                Institute of Geography                 //
+//                University of Hamburg                  //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#ifndef HEADER_INCLUDED__SAGA_API__grid_filter_H
+#define HEADER_INCLUDED__SAGA_API__grid_filter_H
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "grid.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//					Rank Window							 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * CSG_Grid_Rank_Window keeps the values of a square or circular
+  * moving window in order, so that ranks, quantiles and the number
+  * of values below a threshold can be requested without sorting.
+  * Moving the window one cell to the right only removes the
+  * leaving and adds the entering kernel cells. Integer grids with
+  * a moderate value range are counted in a histogram, all other
+  * grids are kept in a sorted value array. No-data cells and cells
+  * outside the grid are ignored. An instance must not be shared
+  * between threads, use one window per thread instead.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Grid_Rank_Window
+{
+public:
+	CSG_Grid_Rank_Window(void);
+	virtual ~CSG_Grid_Rank_Window(void);
+
+	bool						Create				(CSG_Grid *pGrid, int Radius, bool bSquare = false);
+	bool						Destroy				(void);
+
+	CSG_Grid *					Get_Grid			(void)	const	{	return( m_pGrid  );	}
+	int							Get_Radius			(void)	const	{	return( m_Radius );	}
+
+	/// Centres the window at cell (x, y). Updates incrementally, if x is the right neighbour of the previous call's column in the same row.
+	bool						Set_Cell			(int x, int y);
+
+	int							Get_Count			(void)	const	{	return( m_nValues );	}
+
+	/// Returns the i'th smallest value of the window (0 <= i < Get_Count()).
+	double						Get_Value			(int i)	const;
+
+	/// Rank in the range from 0 (minimum) to 1 (maximum), averages the two neighbouring values if the rank falls between them.
+	bool						Get_Rank			(double Rank, double &Value)	const;
+
+	/// Returns the number of window values that are lower than z.
+	int							Get_Lower			(double z)	const;
+
+
+private:
+
+	bool						m_bHistogram;
+
+	int							m_Radius, m_x, m_y, *m_Width, m_nValues, m_zMin, m_nBins, *m_Bins, *m_Blocks;
+
+	double						*m_Values;
+
+	CSG_Grid					*m_pGrid;
+
+
+	void						_Reset				(int x, int y);
+	void						_Move				(void);
+
+	void						_Add				(double z);
+	void						_Del				(double z);
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//					Integral Image						 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * CSG_Grid_Integral provides sums, cell counts and means of
+  * rectangular, square or circular grid windows in constant time
+  * per rectangle. It keeps summed area tables of the grid values
+  * and of the number of valid cells, so that no-data cells are
+  * excluded. Values are stored relative to the grid's mean to
+  * preserve precision in large grids. Circular kernels are split
+  * into a few rectangles of equal row width.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Grid_Integral
+{
+public:
+	CSG_Grid_Integral(void);
+	virtual ~CSG_Grid_Integral(void);
+
+	bool						Create				(CSG_Grid *pGrid);
+	bool						Destroy				(void);
+
+	bool						is_Valid			(void)	const	{	return( m_Sum != NULL );	}
+
+	bool						Set_Kernel			(int Radius, bool bSquare = false);
+
+	/// Sum and number of valid cells of the window from column ax to bx and row ay to by (inclusive, clipped to the grid).
+	bool						Get_Sum				(int ax, int ay, int bx, int by, double &Sum, sLong &Count)	const;
+
+	/// Sum and number of valid cells of the kernel centred at cell (x, y).
+	bool						Get_Sum				(int x, int y, double &Sum, sLong &Count)	const;
+	bool						Get_Mean			(int x, int y, double &Mean)	const;
+
+
+private:
+
+	int							m_NX, m_NY, m_nBands, *m_Bands;
+
+	sLong						*m_Count;
+
+	double						m_Offset, *m_Sum;
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//					Relaxation							 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * CSG_Grid_Relaxation repeats a monotone 3x3 neighbourhood
+  * operation until no cell changes any more. Instead of sweeping
+  * the whole grid in each pass, only the cells next to a cell,
+  * that changed in the previous pass, are evaluated again. The
+  * new values of a pass are buffered for the changed cells only
+  * and written back after the pass, so that all cells see the
+  * values of the previous pass and results do not depend on the
+  * number of threads. On_Relax() must only read the 3x3
+  * neighbourhood of a cell and must either never decrease or
+  * never increase its value, otherwise the iteration might not
+  * come to an end.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Grid_Relaxation
+{
+public:
+	CSG_Grid_Relaxation(void);
+	virtual ~CSG_Grid_Relaxation(void);
+
+	/// Relaxes pGrid in place, evaluating all of its valid cells in the first pass. Returns false, if stopped by the user.
+	bool						Execute				(CSG_Grid *pGrid);
+
+	/// Number of passes and of cell updates of the last call of Execute().
+	int							Get_Passes			(void)	const	{	return( m_nPasses  );	}
+	sLong						Get_Updates			(void)	const	{	return( m_nUpdates );	}
+
+
+protected:
+
+	/// Sets Value to the new value of cell (x, y), derived from the current values of its 3x3 neighbourhood. Returns false, if the value does not change.
+	virtual bool				On_Relax			(CSG_Grid *pGrid, int x, int y, double &Value)	= 0;
+
+
+private:
+
+	int							m_nPasses;
+
+	sLong						m_nUpdates;
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//					Kernel Filters						 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/// Moving window mean using summed area tables, constant time per cell for square and linear time in the radius for circular kernels.
+SAGA_API_DLL_EXPORT bool	SG_Grid_Filter_Mean		(CSG_Grid *pInput, CSG_Grid *pResult, int Radius, bool bSquare = false);
+
+/// Gaussian weighted mean, normalised by the weights of valid cells. Square kernels are convolved separably by rows and columns.
+SAGA_API_DLL_EXPORT bool	SG_Grid_Filter_Gaussian	(CSG_Grid *pInput, CSG_Grid *pResult, double Sigma, int Radius, bool bSquare = false);
+
+/// Moving window minimum (erosion) and maximum (dilation) with the van Herk/Gil-Werman algorithm, constant time per cell and kernel band.
+SAGA_API_DLL_EXPORT bool	SG_Grid_Filter_Minimum	(CSG_Grid *pInput, CSG_Grid *pResult, int Radius, bool bSquare = false);
+SAGA_API_DLL_EXPORT bool	SG_Grid_Filter_Maximum	(CSG_Grid *pInput, CSG_Grid *pResult, int Radius, bool bSquare = false);
+
+/// Percentile of each cell's value in its moving window, i.e. the number of lower values divided by the number of the other valid cells (0 = lowest, 1 = highest). Slides a rank window along the rows, strips of rows are processed in parallel.
+SAGA_API_DLL_EXPORT bool	SG_Grid_Filter_Percentile	(CSG_Grid *pInput, CSG_Grid *pResult, int Radius, bool bSquare = false);
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#endif // #ifndef HEADER_INCLUDED__SAGA_API__grid_filter_H
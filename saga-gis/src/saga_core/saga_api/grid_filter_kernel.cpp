@@ -0,0 +1,775 @@
+/**********************************************************
+ * Version $Id$
+ *********************************************************/
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                   Library: SAGA_API                   //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                grid_filter_kernel.cpp                 //
+//                                                       //
+//                 Copyright (C) 2014 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, version 2.1 of the License.      //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, write to the Free Software Foundation, Inc.,     //
+// 51 Franklin Street, 5th Floor, Boston, MA 02110-1301, //
+// USA.                                                  //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                Institute of Geography                 //
+//                University of Hamburg                  //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "grid_filter.h"
+
+#include <float.h>
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Splits a square or circular kernel into bands of rows with
+// equal half width, looking at the lower half (dy >= 0) only.
+// The first band (rows 0 to b) is mirrored to a centred band,
+// all others to a second band at -b to -a. Returns the number
+// of bands, each described by a, b and the half width w.
+// Uses the same cells as CSG_Grid_Cell_Addressor::Set_Radius().
+//---------------------------------------------------------
+int		SG_Grid_Filter_Get_Bands	(int Radius, bool bSquare, int *Bands)
+{
+	int	n	= 0;
+
+	for(int dy=0; dy<=Radius; dy++)
+	{
+		int	w	= bSquare ? Radius : (int)sqrt((double)(Radius*Radius - dy*dy));
+
+		if( n > 0 && Bands[3 * (n - 1) + 2] == w )
+		{
+			Bands[3 * (n - 1) + 1]	= dy;
+		}
+		else
+		{
+			Bands[3 * n + 0]	= dy;
+			Bands[3 * n + 1]	= dy;
+			Bands[3 * n + 2]	= w;
+
+			n++;
+		}
+	}
+
+	return( n );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//					Integral Image						 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Grid_Integral::CSG_Grid_Integral(void)
+{
+	m_Sum		= NULL;
+	m_Count		= NULL;
+	m_Bands		= NULL;
+	m_nBands	= 0;
+	m_NX		= 0;
+	m_NY		= 0;
+}
+
+//---------------------------------------------------------
+CSG_Grid_Integral::~CSG_Grid_Integral(void)
+{
+	Destroy();
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Integral::Destroy(void)
+{
+	SG_FREE_SAFE(m_Sum  );
+	SG_FREE_SAFE(m_Count);
+	SG_FREE_SAFE(m_Bands);
+
+	m_nBands	= 0;
+	m_NX		= 0;
+	m_NY		= 0;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+#define INTEGRAL_INDEX(x, y)	((x) + (sLong)(y) * (m_NX + 1))
+
+//---------------------------------------------------------
+bool CSG_Grid_Integral::Create(CSG_Grid *pGrid)
+{
+	Destroy();
+
+	if( !pGrid || !pGrid->is_Valid() )
+	{
+		return( false );
+	}
+
+	m_NX		= pGrid->Get_NX();
+	m_NY		= pGrid->Get_NY();
+	m_Offset	= pGrid->Get_Mean();
+
+	sLong	nCells	= (m_NX + 1) * (sLong)(m_NY + 1);
+
+	if( (m_Sum = (double *)SG_Malloc(nCells * sizeof(double))) == NULL
+	||  (m_Count = (sLong *)SG_Malloc(nCells * sizeof(sLong ))) == NULL )
+	{
+		Destroy();
+
+		return( false );
+	}
+
+	memset(m_Sum  , 0, (m_NX + 1) * sizeof(double));
+	memset(m_Count, 0, (m_NX + 1) * sizeof(sLong ));
+
+	//-----------------------------------------------------
+	// row-wise prefix sums...
+
+	#pragma omp parallel for
+	for(int y=0; y<m_NY; y++)
+	{
+		double	*pSum	= m_Sum   + INTEGRAL_INDEX(0, y + 1);
+		sLong	*pCount	= m_Count + INTEGRAL_INDEX(0, y + 1);
+
+		double	Sum		= 0.0;
+		sLong	Count	= 0;
+
+		*pSum	= 0.0;
+		*pCount	= 0;
+
+		for(int x=0; x<m_NX; x++)
+		{
+			if( !pGrid->is_NoData(x, y) )
+			{
+				Sum		+= pGrid->asDouble(x, y) - m_Offset;
+				Count	++;
+			}
+
+			pSum  [x + 1]	= Sum;
+			pCount[x + 1]	= Count;
+		}
+	}
+
+	//-----------------------------------------------------
+	// ...accumulated along columns, each thread taking a block of columns
+
+	int	nBlocks	= M_GET_MIN(SG_Get_Max_Num_Threads_Omp(), m_NX + 1);
+
+	#pragma omp parallel for
+	for(int iBlock=0; iBlock<nBlocks; iBlock++)
+	{
+		int	ax	= (int)(((sLong)(m_NX + 1) *  iBlock     ) / nBlocks);
+		int	bx	= (int)(((sLong)(m_NX + 1) * (iBlock + 1)) / nBlocks);
+
+		for(int y=2; y<=m_NY; y++)
+		{
+			double	*pSum	= m_Sum   + INTEGRAL_INDEX(0, y), *pSum_Last	= pSum   - (m_NX + 1);
+			sLong	*pCount	= m_Count + INTEGRAL_INDEX(0, y), *pCount_Last	= pCount - (m_NX + 1);
+
+			for(int x=ax; x<bx; x++)
+			{
+				pSum  [x]	+= pSum_Last  [x];
+				pCount[x]	+= pCount_Last[x];
+			}
+		}
+	}
+
+	return( Set_Kernel(1, true) );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Integral::Set_Kernel(int Radius, bool bSquare)
+{
+	if( Radius < 0 )
+	{
+		return( false );
+	}
+
+	m_Bands		= (int *)SG_Realloc(m_Bands, 3 * (Radius + 1) * sizeof(int));
+	m_nBands	= SG_Grid_Filter_Get_Bands(Radius, bSquare, m_Bands);
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_Integral::Get_Sum(int ax, int ay, int bx, int by, double &Sum, sLong &Count)	const
+{
+	if( ax <  0    )	{	ax	= 0;	}
+	if( bx >= m_NX )	{	bx	= m_NX - 1;	}
+	if( ay <  0    )	{	ay	= 0;	}
+	if( by >= m_NY )	{	by	= m_NY - 1;	}
+
+	if( !m_Sum || ax > bx || ay > by )
+	{
+		Sum		= 0.0;
+		Count	= 0;
+
+		return( false );
+	}
+
+	sLong	i00	= INTEGRAL_INDEX(ax    , ay    );
+	sLong	i10	= INTEGRAL_INDEX(bx + 1, ay    );
+	sLong	i01	= INTEGRAL_INDEX(ax    , by + 1);
+	sLong	i11	= INTEGRAL_INDEX(bx + 1, by + 1);
+
+	Count	= m_Count[i11] - m_Count[i10] - m_Count[i01] + m_Count[i00];
+	Sum		= m_Sum  [i11] - m_Sum  [i10] - m_Sum  [i01] + m_Sum  [i00] + Count * m_Offset;
+
+	return( Count > 0 );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Integral::Get_Sum(int x, int y, double &Sum, sLong &Count)	const
+{
+	Sum		= 0.0;
+	Count	= 0;
+
+	for(int iBand=0; iBand<m_nBands; iBand++)
+	{
+		int		*Band	= m_Bands + 3 * iBand;
+		sLong	n;
+		double	s;
+
+		if( iBand == 0 )
+		{
+			Get_Sum(x - Band[2], y - Band[1], x + Band[2], y + Band[1], s, n);	Sum	+= s;	Count	+= n;
+		}
+		else
+		{
+			Get_Sum(x - Band[2], y - Band[1], x + Band[2], y - Band[0], s, n);	Sum	+= s;	Count	+= n;
+			Get_Sum(x - Band[2], y + Band[0], x + Band[2], y + Band[1], s, n);	Sum	+= s;	Count	+= n;
+		}
+	}
+
+	return( Count > 0 );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Integral::Get_Mean(int x, int y, double &Mean)	const
+{
+	double	Sum;	sLong	Count;
+
+	if( Get_Sum(x, y, Sum, Count) )
+	{
+		Mean	= Sum / Count;
+
+		return( true );
+	}
+
+	return( false );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//						Mean							 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool	SG_Grid_Filter_Mean(CSG_Grid *pInput, CSG_Grid *pResult, int Radius, bool bSquare)
+{
+	CSG_Grid_Integral	Integral;
+
+	if( !pResult || !pResult->is_Compatible(pInput) || !Integral.Create(pInput) || !Integral.Set_Kernel(Radius, bSquare) )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	for(int y=0; y<pInput->Get_NY() && SG_UI_Process_Set_Progress(y, pInput->Get_NY()); y++)
+	{
+		#pragma omp parallel for
+		for(int x=0; x<pInput->Get_NX(); x++)
+		{
+			double	Mean;
+
+			if( !pInput->is_NoData(x, y) && Integral.Get_Mean(x, y, Mean) )
+			{
+				pResult->Set_Value(x, y, Mean);
+			}
+			else
+			{
+				pResult->Set_NoData(x, y);
+			}
+		}
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//						Gaussian						 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool	SG_Grid_Filter_Gaussian(CSG_Grid *pInput, CSG_Grid *pResult, double Sigma, int Radius, bool bSquare)
+{
+	if( !pResult || !pResult->is_Compatible(pInput) || Sigma <= 0.0 || Radius < 1 )
+	{
+		return( false );
+	}
+
+	int		NX	= pInput->Get_NX();
+	int		NY	= pInput->Get_NY();
+
+	//-----------------------------------------------------
+	// the normalising factor 1 / (2 Pi Sigma^2) cancels out, because
+	// results are divided by the weight sum of the valid cells
+
+	CSG_Vector	Weight(1 + Radius);
+
+	for(int d=0; d<=Radius; d++)
+	{
+		Weight[d]	= exp(-(d*d) / (2.0 * Sigma*Sigma));
+	}
+
+	//-----------------------------------------------------
+	if( !bSquare )	// a circular kernel is not separable, weights are looked up for the cells of each kernel row
+	{
+		CSG_Grid	Input;	if( pInput == pResult ) { Input.Create(*pInput); pInput = &Input; }
+
+		int	*Width	= (int *)SG_Malloc((2 * Radius + 1) * sizeof(int));
+
+		for(int dy=-Radius; dy<=Radius; dy++)
+		{
+			Width[Radius + dy]	= (int)sqrt((double)(Radius*Radius - dy*dy));
+		}
+
+		for(int y=0; y<NY && SG_UI_Process_Set_Progress(y, NY); y++)
+		{
+			#pragma omp parallel for
+			for(int x=0; x<NX; x++)
+			{
+				double	s = 0.0, n = 0.0;
+
+				if( !pInput->is_NoData(x, y) )
+				{
+					for(int dy=-Radius, iy=y-Radius; dy<=Radius; dy++, iy++)
+					{
+						if( iy >= 0 && iy < NY )
+						{
+							int	w	= Width[Radius + dy];
+
+							for(int dx=-w, ix=x-w; dx<=w; dx++, ix++)
+							{
+								if( ix >= 0 && ix < NX && !pInput->is_NoData(ix, iy) )
+								{
+									double	g	= Weight[abs(dx)] * Weight[abs(dy)];
+
+									s	+= g * pInput->asDouble(ix, iy);
+									n	+= g;
+								}
+							}
+						}
+					}
+				}
+
+				if( n > 0.0 )
+				{
+					pResult->Set_Value(x, y, s / n);
+				}
+				else
+				{
+					pResult->Set_NoData(x, y);
+				}
+			}
+		}
+
+		SG_Free(Width);
+
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	// square kernel: weighted sums of values and of valid cell weights,
+	// first along rows, then along columns
+
+	sLong	nCells	= (sLong)NX * NY;
+
+	double	*S	= (double *)SG_Malloc(nCells * sizeof(double));
+	double	*N	= (double *)SG_Malloc(nCells * sizeof(double));
+	double	*Z	= (double *)SG_Malloc(NX * sizeof(double));
+	double	*V	= (double *)SG_Malloc(NX * sizeof(double));
+
+	if( !S || !N || !Z || !V )
+	{
+		SG_FREE_SAFE(S); SG_FREE_SAFE(N); SG_FREE_SAFE(Z); SG_FREE_SAFE(V);
+
+		return( false );
+	}
+
+	for(int y=0; y<NY && SG_UI_Process_Set_Progress(y, 2 * NY); y++)
+	{
+		for(int x=0; x<NX; x++)
+		{
+			if( pInput->is_NoData(x, y) )
+			{
+				Z[x]	= 0.0;
+				V[x]	= 0.0;
+			}
+			else
+			{
+				Z[x]	= pInput->asDouble(x, y);
+				V[x]	= 1.0;
+			}
+		}
+
+		double	*pS	= S + (sLong)y * NX, *pN = N + (sLong)y * NX;
+
+		#pragma omp parallel for
+		for(int x=0; x<NX; x++)
+		{
+			int		ax	= x - Radius < 0 ? 0 : x - Radius;
+			int		bx	= x + Radius < NX ? x + Radius : NX - 1;
+
+			double	s	= 0.0, n = 0.0;
+
+			for(int ix=ax; ix<=bx; ix++)
+			{
+				double	g	= Weight[abs(ix - x)] * V[ix];
+
+				s	+= g * Z[ix];
+				n	+= g;
+			}
+
+			pS[x]	= s;
+			pN[x]	= n;
+		}
+	}
+
+	SG_Free(Z);
+	SG_Free(V);
+
+	//-----------------------------------------------------
+	for(int y=0; y<NY && SG_UI_Process_Set_Progress(NY + y, 2 * NY); y++)
+	{
+		int	ay	= y - Radius < 0 ? 0 : y - Radius;
+		int	by	= y + Radius < NY ? y + Radius : NY - 1;
+
+		#pragma omp parallel for
+		for(int x=0; x<NX; x++)
+		{
+			double	s	= 0.0, n = 0.0;
+
+			if( !pInput->is_NoData(x, y) )
+			{
+				for(int iy=ay; iy<=by; iy++)
+				{
+					sLong	i	= x + (sLong)iy * NX;
+					double	g	= Weight[abs(iy - y)];
+
+					s	+= g * S[i];
+					n	+= g * N[i];
+				}
+			}
+
+			if( n > 0.0 )
+			{
+				pResult->Set_Value(x, y, s / n);
+			}
+			else
+			{
+				pResult->Set_NoData(x, y);
+			}
+		}
+	}
+
+	SG_Free(S);
+	SG_Free(N);
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//					Minimum / Maximum					 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// van Herk/Gil-Werman running minimum of window size n over
+// the values z[0], z[Step], ..., z[(m - 1) * Step], using the
+// work arrays g and h (m + n elements each). The minimum of the
+// window starting at position i is written to z_min[i * Step]
+// for i = 0 to m - n. The blocks of n values, for which g holds
+// forward and h backward minima, are padded with +infinity.
+//---------------------------------------------------------
+void	SG_Grid_Filter_Min_Run	(const double *z, int Step, int m, int n, double *g, double *h, double *z_min)
+{
+	int	i, k, nPadded	= ((m + n - 1) / n) * n;	// multiple of the window size
+
+	for(i=0; i<nPadded; i+=n)
+	{
+		int	j	= i + n - 1;
+
+		g[i]	= i < m ? z[(sLong)i * Step] : DBL_MAX;
+		h[j]	= j < m ? z[(sLong)j * Step] : DBL_MAX;
+
+		for(k=i+1; k<=j; k++)
+		{
+			double	zk	= k < m ? z[(sLong)k * Step] : DBL_MAX;
+
+			g[k]	= g[k - 1] < zk ? g[k - 1] : zk;
+		}
+
+		for(k=j-1; k>=i; k--)
+		{
+			double	zk	= k < m ? z[(sLong)k * Step] : DBL_MAX;
+
+			h[k]	= h[k + 1] < zk ? h[k + 1] : zk;
+		}
+	}
+
+	for(i=0; i<=m-n; i++)
+	{
+		z_min[(sLong)i * Step]	= h[i] < g[i + n - 1] ? h[i] : g[i + n - 1];
+	}
+}
+
+//---------------------------------------------------------
+bool	SG_Grid_Filter_Min_Max	(CSG_Grid *pInput, CSG_Grid *pResult, int Radius, bool bSquare, bool bMaximum)
+{
+	if( !pResult || !pResult->is_Compatible(pInput) || Radius < 0 )
+	{
+		return( false );
+	}
+
+	int		NX	= pInput->Get_NX();
+	int		NY	= pInput->Get_NY();
+
+	sLong	nCells	= (sLong)NX * NY;
+
+	//-----------------------------------------------------
+	// maxima are found as minima of the negated values, no-data is +infinity
+
+	double	*Z	= (double *)SG_Malloc(nCells * sizeof(double));	// values
+	double	*H	= (double *)SG_Malloc(nCells * sizeof(double));	// row minima of current band width
+	double	*R	= (double *)SG_Malloc(nCells * sizeof(double));	// result
+
+	if( !Z || !H || !R )
+	{
+		SG_FREE_SAFE(Z); SG_FREE_SAFE(H); SG_FREE_SAFE(R);
+
+		return( false );
+	}
+
+	#pragma omp parallel for
+	for(int y=0; y<NY; y++)
+	{
+		for(int x=0; x<NX; x++)
+		{
+			sLong	i	= x + (sLong)y * NX;
+
+			Z[i]	= pInput->is_NoData(x, y) ? DBL_MAX : bMaximum ? -pInput->asDouble(x, y) : pInput->asDouble(x, y);
+			R[i]	= DBL_MAX;
+		}
+	}
+
+	//-----------------------------------------------------
+	int	*Bands	= (int *)SG_Malloc(3 * (Radius + 1) * sizeof(int));
+	int	nBands	= SG_Grid_Filter_Get_Bands(Radius, bSquare, Bands);
+
+	for(int iBand=0; iBand<nBands && SG_UI_Process_Set_Progress(iBand, nBands); iBand++)
+	{
+		int	a	= Bands[3 * iBand + 0];
+		int	b	= Bands[3 * iBand + 1];
+		int	w	= Bands[3 * iBand + 2];
+
+		//-------------------------------------------------
+		// minima of the band's row width, padded row: w cells of +infinity on each side
+
+		#pragma omp parallel
+		{
+			double	*z	= (double *)SG_Malloc((NX + 2 * w) * sizeof(double));
+			double	*g	= (double *)SG_Malloc((NX + 4 * w + 1) * sizeof(double));
+			double	*h	= (double *)SG_Malloc((NX + 4 * w + 1) * sizeof(double));
+
+			for(int i=0; i<w; i++)
+			{
+				z[i]	= z[NX + w + i]	= DBL_MAX;
+			}
+
+			#pragma omp for
+			for(int y=0; y<NY; y++)
+			{
+				memcpy(z + w, Z + (sLong)y * NX, NX * sizeof(double));
+
+				SG_Grid_Filter_Min_Run(z, 1, NX + 2 * w, 2 * w + 1, g, h, H + (sLong)y * NX);
+			}
+
+			SG_Free(z); SG_Free(g); SG_Free(h);
+		}
+
+		//-------------------------------------------------
+		// column minima over the band's rows, for the centred band (-b to b)
+		// or for both mirrored bands (-b to -a and a to b)
+
+		int	nBlocks	= M_GET_MIN(SG_Get_Max_Num_Threads_Omp(), NX);
+
+		#pragma omp parallel for
+		for(int iBlock=0; iBlock<nBlocks; iBlock++)
+		{
+			int	ax	= (int)(((sLong)NX *  iBlock     ) / nBlocks);
+			int	bx	= (int)(((sLong)NX * (iBlock + 1)) / nBlocks);
+
+			int	m	= NY + 2 * b;
+
+			double	*z	= (double *)SG_Malloc(m * sizeof(double));
+			double	*g	= (double *)SG_Malloc((m + 2 * b + 1) * sizeof(double));
+			double	*h	= (double *)SG_Malloc((m + 2 * b + 1) * sizeof(double));
+			double	*v	= (double *)SG_Malloc(m * sizeof(double));
+
+			for(int x=ax; x<bx; x++)
+			{
+				int	y;
+
+				for(y=0; y<b; y++)
+				{
+					z[y]	= z[NY + b + y]	= DBL_MAX;
+				}
+
+				for(y=0; y<NY; y++)
+				{
+					z[b + y]	= H[x + (sLong)y * NX];
+				}
+
+				if( iBand == 0 )	// window rows y - b to y + b start at padded position y
+				{
+					SG_Grid_Filter_Min_Run(z, 1, m, 2 * b + 1, g, h, v);
+
+					for(y=0; y<NY; y++)
+					{
+						double	*r	= R + x + (sLong)y * NX;	if( *r > v[y] ) *r = v[y];
+					}
+				}
+				else				// window rows y - b to y - a and y + a to y + b
+				{
+					SG_Grid_Filter_Min_Run(z, 1, m, b - a + 1, g, h, v);
+
+					for(y=0; y<NY; y++)
+					{
+						double	*r	= R + x + (sLong)y * NX;
+
+						if( *r > v[y        ] ) *r = v[y        ];	// starts at y - b
+						if( *r > v[y + b + a] ) *r = v[y + b + a];	// starts at y + a
+					}
+				}
+			}
+
+			SG_Free(z); SG_Free(g); SG_Free(h); SG_Free(v);
+		}
+	}
+
+	SG_Free(Bands);
+
+	//-----------------------------------------------------
+	#pragma omp parallel for
+	for(int y=0; y<NY; y++)
+	{
+		for(int x=0; x<NX; x++)
+		{
+			sLong	i	= x + (sLong)y * NX;
+
+			if( pInput->is_NoData(x, y) )
+			{
+				pResult->Set_NoData(x, y);
+			}
+			else
+			{
+				pResult->Set_Value(x, y, bMaximum ? -R[i] : R[i]);
+			}
+		}
+	}
+
+	SG_Free(Z);
+	SG_Free(H);
+	SG_Free(R);
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool	SG_Grid_Filter_Minimum	(CSG_Grid *pInput, CSG_Grid *pResult, int Radius, bool bSquare)
+{
+	return( SG_Grid_Filter_Min_Max(pInput, pResult, Radius, bSquare, false) );
+}
+
+//---------------------------------------------------------
+bool	SG_Grid_Filter_Maximum	(CSG_Grid *pInput, CSG_Grid *pResult, int Radius, bool bSquare)
+{
+	return( SG_Grid_Filter_Min_Max(pInput, pResult, Radius, bSquare, true) );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
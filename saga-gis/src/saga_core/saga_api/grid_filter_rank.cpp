@@ -0,0 +1,579 @@
+/**********************************************************
+ * Version $Id$
+ *********************************************************/
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                   Library: SAGA_API                   //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                 grid_filter_rank.cpp                  //
+//                                                       //
+//                 Copyright (C) 2014 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, version 2.1 of the License.      //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, write to the Free Software Foundation, Inc.,     //
+// 51 Franklin Street, 5th Floor, Boston, MA 02110-1301, //
+// USA.                                                  //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                Institute of Geography                 //
+//                University of Hamburg                  //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "grid_filter.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define HISTOGRAM_MAX_BINS	65536
+#define HISTOGRAM_SHIFT		8
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Grid_Rank_Window::CSG_Grid_Rank_Window(void)
+{
+	m_pGrid		= NULL;
+	m_Radius	= 0;
+	m_Width		= NULL;
+	m_Values	= NULL;
+	m_Bins		= NULL;
+	m_Blocks	= NULL;
+	m_nValues	= 0;
+	m_nBins		= 0;
+}
+
+//---------------------------------------------------------
+CSG_Grid_Rank_Window::~CSG_Grid_Rank_Window(void)
+{
+	Destroy();
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Rank_Window::Destroy(void)
+{
+	SG_FREE_SAFE(m_Width );
+	SG_FREE_SAFE(m_Values);
+	SG_FREE_SAFE(m_Bins  );
+	SG_FREE_SAFE(m_Blocks);
+
+	m_pGrid		= NULL;
+	m_Radius	= 0;
+	m_nValues	= 0;
+	m_nBins		= 0;
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_Rank_Window::Create(CSG_Grid *pGrid, int Radius, bool bSquare)
+{
+	Destroy();
+
+	if( !pGrid || !pGrid->is_Valid() || Radius < 0 )
+	{
+		return( false );
+	}
+
+	m_pGrid		= pGrid;
+	m_Radius	= Radius;
+
+	//-----------------------------------------------------
+	// half width of each kernel row, same cells as CSG_Grid_Cell_Addressor::Set_Radius()
+
+	int		nKernel	= 0;
+
+	m_Width	= (int *)SG_Malloc((2 * m_Radius + 1) * sizeof(int));
+
+	for(int dy=-m_Radius; dy<=m_Radius; dy++)
+	{
+		int	w	= bSquare ? m_Radius : (int)sqrt((double)(m_Radius*m_Radius - dy*dy));
+
+		m_Width[m_Radius + dy]	= w;
+
+		nKernel	+= 2 * w + 1;
+	}
+
+	//-----------------------------------------------------
+	// integer values with a moderate range are counted in a two-level histogram,
+	// if its query costs are below those of shifting a sorted array while moving
+
+	m_bHistogram	= false;
+
+	switch( m_pGrid->Get_Type() )
+	{
+	case SG_DATATYPE_Bit:
+	case SG_DATATYPE_Byte:
+	case SG_DATATYPE_Char:
+	case SG_DATATYPE_Word:
+	case SG_DATATYPE_Short:
+	case SG_DATATYPE_DWord:
+	case SG_DATATYPE_Int:
+		if( !m_pGrid->is_Scaled() && m_pGrid->Get_ZRange() < HISTOGRAM_MAX_BINS )
+		{
+			m_nBins	= 1 + (int)m_pGrid->Get_ZRange();
+
+			m_bHistogram	= (m_nBins >> HISTOGRAM_SHIFT) + (1 << HISTOGRAM_SHIFT) < (2 * m_Radius + 1) * nKernel / 4;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	if( m_bHistogram )
+	{
+		m_zMin		= (int)m_pGrid->Get_ZMin();
+		m_Bins		= (int *)SG_Calloc(m_nBins, sizeof(int));
+		m_Blocks	= (int *)SG_Calloc((m_nBins >> HISTOGRAM_SHIFT) + 1, sizeof(int));
+	}
+	else
+	{
+		m_nBins		= 0;
+		m_Values	= (double *)SG_Malloc(nKernel * sizeof(double));
+	}
+
+	m_x	= m_y	= -1;
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_Rank_Window::Set_Cell(int x, int y)
+{
+	if( !m_pGrid )
+	{
+		return( false );
+	}
+
+	if( y == m_y && x == m_x + 1 )
+	{
+		_Move();
+	}
+	else if( y != m_y || x != m_x )
+	{
+		_Reset(x, y);
+	}
+
+	return( m_nValues > 0 );
+}
+
+//---------------------------------------------------------
+void CSG_Grid_Rank_Window::_Reset(int x, int y)
+{
+	m_x	= x;
+	m_y	= y;
+
+	if( m_bHistogram )
+	{
+		memset(m_Bins  , 0, m_nBins * sizeof(int));
+		memset(m_Blocks, 0, ((m_nBins >> HISTOGRAM_SHIFT) + 1) * sizeof(int));
+	}
+
+	m_nValues	= 0;
+
+	for(int dy=-m_Radius; dy<=m_Radius; dy++)
+	{
+		int	iy	= y + dy;
+
+		if( iy >= 0 && iy < m_pGrid->Get_NY() )
+		{
+			int	w	= m_Width[m_Radius + dy];
+			int	ax	= x - w < 0 ? 0 : x - w;
+			int	bx	= x + w < m_pGrid->Get_NX() ? x + w : m_pGrid->Get_NX() - 1;
+
+			for(int ix=ax; ix<=bx; ix++)
+			{
+				if( !m_pGrid->is_NoData(ix, iy) )
+				{
+					if( m_bHistogram )
+					{
+						_Add(m_pGrid->asDouble(ix, iy));
+					}
+					else	// sort once after collecting
+					{
+						m_Values[m_nValues++]	= m_pGrid->asDouble(ix, iy);
+					}
+				}
+			}
+		}
+	}
+
+	if( !m_bHistogram && m_nValues > 1 )
+	{
+		qsort(m_Values, m_nValues, sizeof(double), SG_Compare_Double);
+	}
+}
+
+//---------------------------------------------------------
+void CSG_Grid_Rank_Window::_Move(void)
+{
+	for(int dy=-m_Radius; dy<=m_Radius; dy++)
+	{
+		int	iy	= m_y + dy;
+
+		if( iy >= 0 && iy < m_pGrid->Get_NY() )
+		{
+			int	w	= m_Width[m_Radius + dy];
+
+			int	ix	= m_x - w;		// leaving cell
+
+			if( ix >= 0 && ix < m_pGrid->Get_NX() && !m_pGrid->is_NoData(ix, iy) )
+			{
+				_Del(m_pGrid->asDouble(ix, iy));
+			}
+
+			ix	= m_x + 1 + w;		// entering cell
+
+			if( ix >= 0 && ix < m_pGrid->Get_NX() && !m_pGrid->is_NoData(ix, iy) )
+			{
+				_Add(m_pGrid->asDouble(ix, iy));
+			}
+		}
+	}
+
+	m_x++;
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+void CSG_Grid_Rank_Window::_Add(double z)
+{
+	if( m_bHistogram )
+	{
+		int	i	= (int)z - m_zMin;
+
+		if( i >= 0 && i < m_nBins )
+		{
+			m_Bins  [i]++;
+			m_Blocks[i >> HISTOGRAM_SHIFT]++;
+			m_nValues++;
+		}
+
+		return;
+	}
+
+	//-----------------------------------------------------
+	int	a = 0, b = m_nValues;	// first position with a value greater than z
+
+	while( a < b )
+	{
+		int	i	= (a + b) / 2;
+
+		if( m_Values[i] <= z ) { a = i + 1; } else { b = i; }
+	}
+
+	if( a < m_nValues )
+	{
+		memmove(m_Values + a + 1, m_Values + a, (m_nValues - a) * sizeof(double));
+	}
+
+	m_Values[a]	= z;
+
+	m_nValues++;
+}
+
+//---------------------------------------------------------
+void CSG_Grid_Rank_Window::_Del(double z)
+{
+	if( m_bHistogram )
+	{
+		int	i	= (int)z - m_zMin;
+
+		if( i >= 0 && i < m_nBins && m_Bins[i] > 0 )
+		{
+			m_Bins  [i]--;
+			m_Blocks[i >> HISTOGRAM_SHIFT]--;
+			m_nValues--;
+		}
+
+		return;
+	}
+
+	//-----------------------------------------------------
+	int	a = 0, b = m_nValues;	// first position with a value not less than z
+
+	while( a < b )
+	{
+		int	i	= (a + b) / 2;
+
+		if( m_Values[i] < z ) { a = i + 1; } else { b = i; }
+	}
+
+	if( a < m_nValues && m_Values[a] == z )
+	{
+		m_nValues--;
+
+		if( a < m_nValues )
+		{
+			memmove(m_Values + a, m_Values + a + 1, (m_nValues - a) * sizeof(double));
+		}
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+double CSG_Grid_Rank_Window::Get_Value(int i)	const
+{
+	if( i < 0 || i >= m_nValues )
+	{
+		return( 0.0 );
+	}
+
+	if( !m_bHistogram )
+	{
+		return( m_Values[i] );
+	}
+
+	//-----------------------------------------------------
+	int	iBin	= 0;
+
+	for(int iBlock=0; ; iBlock++, iBin+=1<<HISTOGRAM_SHIFT)
+	{
+		if( i < m_Blocks[iBlock] )
+		{
+			break;
+		}
+
+		i	-= m_Blocks[iBlock];
+	}
+
+	for( ; i >= m_Bins[iBin]; iBin++)
+	{
+		i	-= m_Bins[iBin];
+	}
+
+	return( (double)(m_zMin + iBin) );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Rank_Window::Get_Rank(double Rank, double &Value)	const
+{
+	switch( m_nValues )
+	{
+	case 0:
+		return( false );
+
+	case 1:
+		Value	= Get_Value(0);
+		return( true );
+
+	case 2:
+		Value	= (Get_Value(0) + Get_Value(1)) / 2.0;
+		return( true );
+
+	default:
+		Rank	= Rank * (m_nValues - 1.0);
+
+		int	i	= (int)Rank;
+
+		Value	= Get_Value(i);
+
+		if( Rank - i > 0.0 && i < m_nValues - 1 )
+		{
+			Value	= (Value + Get_Value(i + 1)) / 2.0;
+		}
+
+		return( true );
+	}
+}
+
+//---------------------------------------------------------
+int CSG_Grid_Rank_Window::Get_Lower(double z)	const
+{
+	if( !m_bHistogram )
+	{
+		int	a = 0, b = m_nValues;
+
+		while( a < b )
+		{
+			int	i	= (a + b) / 2;
+
+			if( m_Values[i] < z ) { a = i + 1; } else { b = i; }
+		}
+
+		return( a );
+	}
+
+	//-----------------------------------------------------
+	int	n = 0, iBin	= (int)ceil(z) - m_zMin;	// bins below iBin hold values lower than z
+
+	if( iBin <= 0 )
+	{
+		return( 0 );
+	}
+
+	if( iBin >= m_nBins )
+	{
+		return( m_nValues );
+	}
+
+	int	iBlock, nBlocks	= iBin >> HISTOGRAM_SHIFT;
+
+	for(iBlock=0; iBlock<nBlocks; iBlock++)
+	{
+		n	+= m_Blocks[iBlock];
+	}
+
+	for(int i=nBlocks<<HISTOGRAM_SHIFT; i<iBin; i++)
+	{
+		n	+= m_Bins[i];
+	}
+
+	return( n );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool	SG_Grid_Filter_Percentile(CSG_Grid *pInput, CSG_Grid *pResult, int Radius, bool bSquare)
+{
+	if( !pInput || !pInput->is_Valid() || !pResult || pResult == pInput || !pResult->is_Compatible(pInput) )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	// one window per strip, created in advance, because creation queries the grid's statistics
+
+	int		NY		= pInput->Get_NY();
+	int		nBlocks	= M_GET_MAX(1, M_GET_MIN(NY, SG_Get_Max_Num_Threads_Omp()));
+
+	CSG_Grid_Rank_Window	*Windows	= new CSG_Grid_Rank_Window[nBlocks];
+
+	for(int iBlock=0; iBlock<nBlocks; iBlock++)
+	{
+		if( !Windows[iBlock].Create(pInput, Radius, bSquare) )
+		{
+			delete[](Windows);
+
+			return( false );
+		}
+	}
+
+	//-----------------------------------------------------
+	int	nRows	= 16 * nBlocks;
+
+	for(int y0=0; y0<NY && SG_UI_Process_Set_Progress(y0, NY); y0+=nRows)
+	{
+		int	n	= M_GET_MIN(nRows, NY - y0);
+
+		#pragma omp parallel for
+		for(int iBlock=0; iBlock<nBlocks; iBlock++)
+		{
+			CSG_Grid_Rank_Window	&Window	= Windows[iBlock];
+
+			for(int y=y0+n*iBlock/nBlocks; y<y0+n*(iBlock+1)/nBlocks; y++)
+			{
+				for(int x=0; x<pInput->Get_NX(); x++)
+				{
+					if( Window.Set_Cell(x, y) && Window.Get_Count() > 1 && !pInput->is_NoData(x, y) )
+					{
+						pResult->Set_Value(x, y, Window.Get_Lower(pInput->asDouble(x, y)) / (Window.Get_Count() - 1.0));
+					}
+					else
+					{
+						pResult->Set_NoData(x, y);
+					}
+				}
+			}
+		}
+	}
+
+	delete[](Windows);
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
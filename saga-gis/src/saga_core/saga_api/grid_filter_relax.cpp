@@ -0,0 +1,256 @@
+/**********************************************************
+ * Version $Id$
+ *********************************************************/
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                   Library: SAGA_API                   //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                 grid_filter_relax.cpp                 //
+//                                                       //
+//                 Copyright (C) 2014 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, version 2.1 of the License.      //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, write to the Free Software Foundation, Inc.,     //
+// 51 Franklin Street, 5th Floor, Boston, MA 02110-1301, //
+// USA.                                                  //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                Institute of Geography                 //
+//                University of Hamburg                  //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+
+
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "grid_filter.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+typedef struct SRelax_Cell
+{
+	sLong	n;
+
+	double	z;
+}
+TRelax_Cell;
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Grid_Relaxation::CSG_Grid_Relaxation(void)
+{
+	m_nPasses	= 0;
+	m_nUpdates	= 0;
+}
+
+//---------------------------------------------------------
+CSG_Grid_Relaxation::~CSG_Grid_Relaxation(void)
+{}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_Relaxation::Execute(CSG_Grid *pGrid)
+{
+	m_nPasses	= 0;
+	m_nUpdates	= 0;
+
+	if( !pGrid || !pGrid->is_Valid() )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	int		nx		= pGrid->Get_NX();
+	int		ny		= pGrid->Get_NY();
+	int		nBlocks	= M_GET_MAX(1, SG_Get_Max_Num_Threads_Omp());
+
+	BYTE	*Active	= NULL;		// cells queued for the next pass
+
+	CSG_Array	Cells(sizeof(sLong), 0, SG_ARRAY_GROWTH_3), *Changed	= new CSG_Array[nBlocks];
+
+	for(int iBlock=0; iBlock<nBlocks; iBlock++)
+	{
+		Changed[iBlock].Create(sizeof(TRelax_Cell), 0, SG_ARRAY_GROWTH_3);
+	}
+
+	bool	bOkay	= true;
+
+	for(sLong nChanged=1; nChanged > 0 && bOkay; )
+	{
+		m_nPasses++;
+
+		sLong	nActive	= m_nPasses == 1 ? ny : (sLong)Cells.Get_Size(), *pCells = (sLong *)Cells.Get_Array();
+
+		//-------------------------------------------------
+		// evaluate, the first pass sweeps all rows
+
+		#pragma omp parallel for
+		for(int iBlock=0; iBlock<nBlocks; iBlock++)
+		{
+			for(sLong i=nActive*iBlock/nBlocks; i<nActive*(iBlock+1)/nBlocks; i++)
+			{
+				int		x, y, ax, bx;
+
+				if( m_nPasses == 1 )
+				{
+					y	= (int)i;	ax	= 0;	bx	= nx;
+				}
+				else
+				{
+					y	= (int)(pCells[i] / nx);	ax	= (int)(pCells[i] % nx);	bx	= ax + 1;	Active[pCells[i]]	= 0;
+				}
+
+				for(x=ax; x<bx; x++)
+				{
+					double	z;
+
+					if( !pGrid->is_NoData(x, y) && On_Relax(pGrid, x, y, z) && z != pGrid->asDouble(x, y) && Changed[iBlock].Inc_Array() )
+					{
+						TRelax_Cell	*pCell	= (TRelax_Cell *)Changed[iBlock].Get_Entry(Changed[iBlock].Get_Size() - 1);
+
+						pCell->n	= x + y * (sLong)nx;
+						pCell->z	= z;
+					}
+				}
+			}
+		}
+
+		//-------------------------------------------------
+		// write back, each cell has been evaluated only once
+
+		nChanged	= 0;
+
+		#pragma omp parallel for reduction(+:nChanged)
+		for(int iBlock=0; iBlock<nBlocks; iBlock++)
+		{
+			TRelax_Cell	*pCell	= (TRelax_Cell *)Changed[iBlock].Get_Array();
+
+			for(size_t i=0; i<Changed[iBlock].Get_Size(); i++, pCell++)
+			{
+				pGrid->Set_Value(pCell->n, pCell->z);
+			}
+
+			nChanged	+= Changed[iBlock].Get_Size();
+		}
+
+		m_nUpdates	+= nChanged;
+
+		SG_UI_Process_Set_Text(CSG_String::Format(SG_T("%s %d (%.0f > 0)"), _TL("pass"), m_nPasses, (double)nChanged));
+
+		bOkay	= SG_UI_Process_Get_Okay();
+
+		//-------------------------------------------------
+		// next pass: neighbourhood of all changed cells
+
+		if( nChanged > 0 && bOkay && !Active && (Active = (BYTE *)SG_Calloc(pGrid->Get_NCells(), sizeof(BYTE))) == NULL )
+		{
+			bOkay	= false;
+		}
+
+		Cells.Set_Array(0, false);
+
+		for(int iBlock=0; iBlock<nBlocks && bOkay; iBlock++)
+		{
+			TRelax_Cell	*pCell	= (TRelax_Cell *)Changed[iBlock].Get_Array();
+
+			for(size_t i=0; i<Changed[iBlock].Get_Size(); i++, pCell++)
+			{
+				int	x	= (int)(pCell->n % nx);
+				int	y	= (int)(pCell->n / nx);
+
+				for(int iy=y-1; iy<=y+1; iy++)
+				{
+					for(int ix=x-1; ix<=x+1; ix++)
+					{
+						sLong	n	= ix + iy * (sLong)nx;
+
+						if( pGrid->is_InGrid(ix, iy) && !Active[n] && Cells.Inc_Array() )
+						{
+							Active[n]	= 1;	*((sLong *)Cells.Get_Entry(Cells.Get_Size() - 1))	= n;
+						}
+					}
+				}
+			}
+		}
+
+		for(int iBlock=0; iBlock<nBlocks; iBlock++)
+		{
+			Changed[iBlock].Set_Array(0, false);
+		}
+	}
+
+	//-----------------------------------------------------
+	SG_FREE_SAFE(Active);
+
+	delete[](Changed);
+
+	return( bOkay );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
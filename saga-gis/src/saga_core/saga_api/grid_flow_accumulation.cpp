@@ -0,0 +1,978 @@
+/**********************************************************
+ * Version $Id$
+ *********************************************************/
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                   Library: SAGA_API                   //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//              grid_flow_accumulation.cpp               //
+//                                                       //
+//                 Copyright (C) 2014 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, version 2.1 of the License.      //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, write to the Free Software Foundation, Inc.,     //
+// 51 Franklin Street, 5th Floor, Boston, MA 02110-1301, //
+// USA.                                                  //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                Institute of Geography                 //
+//                University of Hamburg                  //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+
+
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "grid_hydrology.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define FLOW_STATE_PENDING		0
+#define FLOW_STATE_DONE			1
+#define FLOW_STATE_FRONT		2
+
+//---------------------------------------------------------
+#define FLOW_MIN_PARALLEL		1024
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Grid_Flow_Accumulation::CSG_Grid_Flow_Accumulation(void)
+{
+	m_pDEM			= NULL;
+	m_pGraph		= NULL;
+	m_pAccu			= NULL;
+	m_pWeight		= NULL;
+	m_pValue		= NULL;
+	m_pMean			= NULL;
+
+	m_Receivers		= NULL;
+	m_State			= NULL;
+	m_Fractions		= NULL;
+
+	m_nProcessed	= 0;
+	m_Routing		= SG_FLOW_ROUTING_D8;
+	m_Convergence	= 1.1;
+}
+
+//---------------------------------------------------------
+CSG_Grid_Flow_Accumulation::~CSG_Grid_Flow_Accumulation(void)
+{
+	Destroy();
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Accumulation::Create(CSG_Grid *pDEM, TSG_Flow_Routing Routing, double Convergence)
+{
+	Destroy();
+
+	if( !pDEM || !pDEM->is_Valid() )
+	{
+		return( false );
+	}
+
+	m_pDEM			= pDEM;
+	m_System		= pDEM->Get_System();
+	m_Routing		= Routing;
+	m_Convergence	= Convergence;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Accumulation::Create(const CSG_Grid_Flow_Graph *pGraph)
+{
+	Destroy();
+
+	if( !pGraph || !pGraph->is_Okay() )
+	{
+		return( false );
+	}
+
+	m_pGraph		= pGraph;
+	m_System		= pGraph->Get_System();
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Accumulation::Destroy(void)
+{
+	SG_FREE_SAFE(m_Receivers);
+	SG_FREE_SAFE(m_State);
+	SG_FREE_SAFE(m_Fractions);
+
+	m_pDEM			= NULL;
+	m_pGraph		= NULL;
+	m_nProcessed	= 0;
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Accumulation::Execute(void)
+{
+	if( !is_Okay() )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	int		nx		= m_System.Get_NX();
+	int		ny		= m_System.Get_NY();
+	sLong	nCells	= m_System.Get_NCells();
+
+	m_Receivers	= (BYTE *)SG_Malloc(nCells * sizeof(BYTE));
+	m_State		= (BYTE *)SG_Calloc(nCells,  sizeof(BYTE));
+
+	if( !m_Receivers || !m_State )
+	{
+		SG_FREE_SAFE(m_Receivers);
+		SG_FREE_SAFE(m_State);
+
+		return( false );
+	}
+
+	// the routing of each cell is stored once the cell is finished,
+	// falls back to calling On_Routing() for each receiver, if the
+	// memory (8 floats per cell) is not available
+	m_Fractions	= (float *)SG_Malloc(8 * nCells * sizeof(float));
+
+	m_nProcessed	= 0;
+
+	//-----------------------------------------------------
+	// receivers of each cell, restricted to valid cells
+
+	sLong	nValid	= 0;
+
+	#pragma omp parallel for reduction(+:nValid)
+	for(int y=0; y<ny; y++)
+	{
+		for(int x=0; x<nx; x++)
+		{
+			int	Mask	= 0;
+
+			if( _is_Valid(x, y) )
+			{
+				nValid++;
+
+				int	Receivers	= On_Receivers(x, y);
+
+				for(int i=0; i<8; i++)
+				{
+					if( (Receivers & (1 << i)) && _is_Valid(CSG_Grid_System::Get_xTo(i, x), CSG_Grid_System::Get_yTo(i, y)) )
+					{
+						Mask	|= 1 << i;
+					}
+				}
+			}
+
+			m_Receivers[x + y * (sLong)nx]	= (BYTE)Mask;
+		}
+	}
+
+	//-----------------------------------------------------
+	// first front: all valid cells without donors
+
+	int		iBlock, nBlocks	= M_GET_MAX(1, M_GET_MIN(ny, SG_Get_Max_Num_Threads_Omp()));
+
+	sLong	*nSources	= (sLong *)SG_Calloc(nBlocks + 1, sizeof(sLong));
+
+	#pragma omp parallel for
+	for(iBlock=0; iBlock<nBlocks; iBlock++)
+	{
+		for(int y=(int)((sLong)ny * iBlock / nBlocks); y<(int)((sLong)ny * (iBlock + 1) / nBlocks); y++)
+		{
+			for(int x=0; x<nx; x++)
+			{
+				if( _is_Valid(x, y) && Get_Donors_Count(x, y) == 0 )
+				{
+					nSources[iBlock + 1]++;
+				}
+			}
+		}
+	}
+
+	for(iBlock=0; iBlock<nBlocks; iBlock++)
+	{
+		nSources[iBlock + 1]	+= nSources[iBlock];
+	}
+
+	CSG_Array	Front(sizeof(sLong), (size_t)nSources[nBlocks]);
+
+	sLong	*pFront	= (sLong *)Front.Get_Array(), nFront = nSources[nBlocks];
+
+	#pragma omp parallel for
+	for(iBlock=0; iBlock<nBlocks; iBlock++)
+	{
+		sLong	*pSource	= pFront + nSources[iBlock];
+
+		for(int y=(int)((sLong)ny * iBlock / nBlocks); y<(int)((sLong)ny * (iBlock + 1) / nBlocks); y++)
+		{
+			for(int x=0; x<nx; x++)
+			{
+				if( _is_Valid(x, y) && Get_Donors_Count(x, y) == 0 )
+				{
+					*pSource++	= x + y * (sLong)nx;
+				}
+			}
+		}
+	}
+
+	SG_Free(nSources);
+
+	//-----------------------------------------------------
+	// propagate the front downslope
+
+	CSG_Array	*Next	= new CSG_Array[nBlocks];
+
+	for(iBlock=0; iBlock<nBlocks; iBlock++)
+	{
+		Next[iBlock].Create(sizeof(sLong), 0, SG_ARRAY_GROWTH_3);
+	}
+
+	while( nFront > 0 && SG_UI_Process_Set_Progress((double)m_nProcessed, (double)nCells) )
+	{
+		sLong	i;
+
+		#pragma omp parallel for if(nFront >= FLOW_MIN_PARALLEL)
+		for(i=0; i<nFront; i++)
+		{
+			sLong	n	= pFront[i];
+
+			On_Cell((int)(n % nx), (int)(n / nx));
+
+			if( m_Fractions )
+			{
+				_Set_Fractions(n);
+			}
+
+			m_State[n]	= FLOW_STATE_FRONT;
+		}
+
+		m_nProcessed	+= nFront;
+
+		//-------------------------------------------------
+		int	nParts	= nFront >= FLOW_MIN_PARALLEL ? nBlocks : 1;
+
+		#pragma omp parallel for if(nParts > 1)
+		for(iBlock=0; iBlock<nParts; iBlock++)
+		{
+			Next[iBlock].Set_Array(0, false);
+
+			for(sLong j=nFront*iBlock/nParts; j<nFront*(iBlock+1)/nParts; j++)
+			{
+				sLong	n	= pFront[j];
+				int		x	= (int)(n % nx);
+				int		y	= (int)(n / nx);
+
+				for(int k=0; k<8; k++)
+				{
+					if( m_Receivers[n] & (1 << k) )
+					{
+						sLong	r	= CSG_Grid_System::Get_xTo(k, x) + CSG_Grid_System::Get_yTo(k, y) * (sLong)nx;
+
+						if( _is_Ready(r, n) && Next[iBlock].Inc_Array() )
+						{
+							*((sLong *)Next[iBlock].Get_Entry(Next[iBlock].Get_Size() - 1))	= r;
+						}
+					}
+				}
+			}
+		}
+
+		#pragma omp parallel for if(nFront >= FLOW_MIN_PARALLEL)
+		for(i=0; i<nFront; i++)
+		{
+			m_State[pFront[i]]	= FLOW_STATE_DONE;
+		}
+
+		//-------------------------------------------------
+		for(iBlock=0, nFront=0; iBlock<nParts; iBlock++)
+		{
+			nFront	+= Next[iBlock].Get_Size();
+		}
+
+		pFront	= (sLong *)Front.Get_Array((size_t)nFront);
+
+		for(iBlock=0, i=0; iBlock<nParts; iBlock++)
+		{
+			if( Next[iBlock].Get_Size() > 0 )
+			{
+				memcpy(pFront + i, Next[iBlock].Get_Array(), Next[iBlock].Get_Size() * sizeof(sLong));
+
+				i	+= Next[iBlock].Get_Size();
+			}
+		}
+	}
+
+	delete[](Next);
+
+	//-----------------------------------------------------
+	SG_FREE_SAFE(m_Receivers);
+	SG_FREE_SAFE(m_State);
+	SG_FREE_SAFE(m_Fractions);
+
+	if( m_nProcessed < nValid && SG_UI_Process_Get_Okay() )
+	{
+		SG_UI_Msg_Add_Error(CSG_String::Format(SG_T("%s: %.0f"),
+			_TL("cells left unprocessed, flow routing forms cycles"), (double)(nValid - m_nProcessed)
+		));
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+void CSG_Grid_Flow_Accumulation::_Set_Fractions(sLong n)
+{
+	int		nx	= m_System.Get_NX();
+
+	double	Fraction[8];
+
+	bool	bRouting	= On_Routing((int)(n % nx), (int)(n / nx), Fraction);
+
+	float	*pFraction	= m_Fractions + 8 * n;
+
+	for(int i=0; i<8; i++)
+	{
+		pFraction[i]	= (float)(bRouting && (m_Receivers[n] & (1 << i)) ? Fraction[i] : 0.0);
+	}
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Accumulation::_is_Ready(sLong n, sLong nDonor)	const
+{
+	int		nx		= m_System.Get_NX();
+	int		x		= (int)(n % nx);
+	int		y		= (int)(n / nx);
+
+	sLong	nFirst	= -1;
+
+	for(int i=0; i<8; i++)
+	{
+		int	ix	= CSG_Grid_System::Get_xTo(i, x);
+		int	iy	= CSG_Grid_System::Get_yTo(i, y);
+
+		if( m_System.is_InGrid(ix, iy) )
+		{
+			sLong	d	= ix + iy * (sLong)nx;
+
+			if( m_Receivers[d] & (1 << ((i + 4) % 8)) )
+			{
+				if( m_State[d] == FLOW_STATE_PENDING )
+				{
+					return( false );
+				}
+
+				if( m_State[d] == FLOW_STATE_FRONT && nFirst < 0 )
+				{
+					nFirst	= d;	// the first donor of the current front queues the cell
+				}
+			}
+		}
+	}
+
+	return( nFirst == nDonor );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Accumulation::is_Donor(int x, int y, int Direction)	const
+{
+	int	ix	= CSG_Grid_System::Get_xTo(Direction, x);
+	int	iy	= CSG_Grid_System::Get_yTo(Direction, y);
+
+	return( m_Receivers && m_System.is_InGrid(ix, iy)
+		&& (m_Receivers[ix + iy * (sLong)m_System.Get_NX()] & (1 << ((Direction + 4) % 8))) != 0
+	);
+}
+
+//---------------------------------------------------------
+int CSG_Grid_Flow_Accumulation::Get_Donors_Count(int x, int y)	const
+{
+	int	n	= 0;
+
+	for(int i=0; i<8; i++)
+	{
+		if( is_Donor(x, y, i) )
+		{
+			n++;
+		}
+	}
+
+	return( n );
+}
+
+//---------------------------------------------------------
+int CSG_Grid_Flow_Accumulation::Get_Donors(int x, int y, double Fraction[8])
+{
+	int	n	= 0;
+
+	for(int i=0; i<8; i++)
+	{
+		Fraction[i]	= 0.0;
+
+		if( is_Donor(x, y, i) )
+		{
+			int	ix	= CSG_Grid_System::Get_xTo(i, x);
+			int	iy	= CSG_Grid_System::Get_yTo(i, y);
+
+			if( m_Fractions )	// routing of finished cells has been stored
+			{
+				Fraction[i]	= m_Fractions[8 * (ix + iy * (sLong)m_System.Get_NX()) + (i + 4) % 8];
+			}
+			else
+			{
+				double	Donor[8];
+
+				if( On_Routing(ix, iy, Donor) )
+				{
+					Fraction[i]	= Donor[(i + 4) % 8];
+				}
+			}
+
+			if( Fraction[i] > 0.0 )
+			{
+				n++;
+			}
+			else
+			{
+				Fraction[i]	= 0.0;
+			}
+		}
+	}
+
+	return( n );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Accumulation::On_Routing(int x, int y, double Fraction[8])
+{
+	return( Get_Routing(x, y, Fraction) );
+}
+
+//---------------------------------------------------------
+int CSG_Grid_Flow_Accumulation::On_Receivers(int x, int y)
+{
+	int		Mask	= 0;
+	double	Fraction[8];
+
+	if( On_Routing(x, y, Fraction) )
+	{
+		for(int i=0; i<8; i++)
+		{
+			if( Fraction[i] > 0.0 )
+			{
+				Mask	|= 1 << i;
+			}
+		}
+	}
+
+	return( Mask );
+}
+
+//---------------------------------------------------------
+void CSG_Grid_Flow_Accumulation::On_Cell(int x, int y)
+{
+	if( !m_pAccu )
+	{
+		return;
+	}
+
+	double	Accu	= !m_pWeight ? 1.0 : m_pWeight->is_NoData(x, y) ? 0.0 : m_pWeight->asDouble(x, y);
+	double	Sum		= !m_pMean || m_pValue->is_NoData(x, y) ? 0.0 : Accu * m_pValue->asDouble(x, y);
+
+	double	Donors[8];
+
+	if( Get_Donors(x, y, Donors) > 0 )
+	{
+		for(int i=0; i<8; i++)
+		{
+			if( Donors[i] > 0.0 )
+			{
+				int	ix	= CSG_Grid_System::Get_xTo(i, x);
+				int	iy	= CSG_Grid_System::Get_yTo(i, y);
+
+				Accu	+= Donors[i] * m_pAccu->asDouble(ix, iy);
+
+				if( m_pMean )
+				{
+					Sum	+= Donors[i] * m_pMean->asDouble(ix, iy);
+				}
+			}
+		}
+	}
+
+	m_pAccu->Set_Value(x, y, Accu);
+
+	if( m_pMean )
+	{
+		m_pMean->Set_Value(x, y, Sum);
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Accumulation::Execute(CSG_Grid *pAccu, CSG_Grid *pWeight, CSG_Grid *pValue, CSG_Grid *pMean)
+{
+	if( !is_Okay() || !pAccu || !pAccu->is_Compatible(m_System) )
+	{
+		return( false );
+	}
+
+	m_pAccu		= pAccu;
+	m_pWeight	= pWeight && pWeight->is_Compatible(m_System) ? pWeight : NULL;
+	m_pValue	= pValue  && pValue ->is_Compatible(m_System) ? pValue  : NULL;
+	m_pMean		= pMean   && pMean  ->is_Compatible(m_System) && m_pValue ? pMean : NULL;
+
+	m_pAccu->Assign_NoData();
+
+	if( m_pMean )
+	{
+		m_pMean->Assign_NoData();
+	}
+
+	bool	bResult	= Execute();
+
+	//-----------------------------------------------------
+	if( bResult && m_pMean )
+	{
+		#pragma omp parallel for
+		for(sLong n=0; n<m_System.Get_NCells(); n++)
+		{
+			if( !m_pMean->is_NoData(n) )
+			{
+				double	Accu	= m_pAccu->asDouble(n);
+
+				m_pMean->Set_Value(n, Accu != 0.0 ? m_pMean->asDouble(n) / Accu : 0.0);
+			}
+		}
+	}
+
+	m_pAccu		= NULL;
+	m_pWeight	= NULL;
+	m_pValue	= NULL;
+	m_pMean		= NULL;
+
+	return( bResult );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//						Routing							 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Accumulation::Get_Routing(int x, int y, double Fraction[8])	const
+{
+	for(int i=0; i<8; i++)
+	{
+		Fraction[i]	= 0.0;
+	}
+
+	if( !is_Okay() || !_is_Valid(x, y) )
+	{
+		return( false );
+	}
+
+	if( m_pGraph )
+	{
+		return( m_pGraph->Get_Fractions(x, y, Fraction) );
+	}
+
+	bool	bResult;
+
+	switch( m_Routing )
+	{
+	default:
+	case SG_FLOW_ROUTING_D8   :	bResult	= _Get_D8   (x, y, Fraction);	break;
+	case SG_FLOW_ROUTING_Rho8 :	bResult	= _Get_Rho8 (x, y, Fraction);	break;
+	case SG_FLOW_ROUTING_DInf :	bResult	= _Get_DInf (x, y, Fraction);	break;
+	case SG_FLOW_ROUTING_MFD  :	bResult	= _Get_MFD  (x, y, Fraction);	break;
+	case SG_FLOW_ROUTING_MDInf:	bResult	= _Get_MDInf(x, y, Fraction);	break;
+	}
+
+	//-----------------------------------------------------
+	if( bResult )	// never pass flow upwards, keeps the routing free of cycles
+	{
+		double	z	= m_pDEM->asDouble(x, y);
+
+		for(int i=0; i<8; i++)
+		{
+			if( Fraction[i] > 0.0 )
+			{
+				int	ix	= CSG_Grid_System::Get_xTo(i, x);
+				int	iy	= CSG_Grid_System::Get_yTo(i, y);
+
+				if( m_pDEM->is_InGrid(ix, iy) && m_pDEM->asDouble(ix, iy) >= z )
+				{
+					Fraction[i]	= 0.0;
+				}
+			}
+		}
+	}
+
+	return( bResult );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Accumulation::_Get_D8(int x, int y, double Fraction[8])	const
+{
+	int	i	= m_pDEM->Get_Gradient_NeighborDir(x, y);
+
+	if( i >= 0 )
+	{
+		Fraction[i]	= 1.0;
+
+		return( true );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Accumulation::_Get_Rho8(int x, int y, double Fraction[8])	const
+{
+	int		iMax	= -1;
+	double	dMax	= 0.0, z = m_pDEM->asDouble(x, y);
+
+	for(int i=0; i<8; i++)
+	{
+		int	ix	= CSG_Grid_System::Get_xTo(i, x);
+		int	iy	= CSG_Grid_System::Get_yTo(i, y);
+
+		if( !m_pDEM->is_InGrid(ix, iy) )
+		{
+			return( false );
+		}
+
+		double	d	= z - m_pDEM->asDouble(ix, iy);
+
+		if( i % 2 == 1 )	// the random diagonal weighting is derived from the cell position, so that it is reproducible
+		{
+			unsigned int	r	= (unsigned int)x * 73856093u ^ (unsigned int)y * 19349663u ^ (unsigned int)i * 83492791u;
+
+			r	^= r >> 13;	r	*= 0x5bd1e995u;	r	^= r >> 15;
+
+			d	/= 1.0 + (r & 0xFFFF) / 65535.0;
+		}
+
+		if( d > 0.0 && (iMax < 0 || dMax < d) )
+		{
+			iMax	= i;
+			dMax	= d;
+		}
+	}
+
+	if( iMax >= 0 )
+	{
+		Fraction[iMax]	= 1.0;
+
+		return( true );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Accumulation::_Get_DInf(int x, int y, double Fraction[8])	const
+{
+	double	s, a;
+
+	if( m_pDEM->Get_Gradient(x, y, s, a) && a >= 0.0 )
+	{
+		int	i, ix, iy;
+
+		i	= (int)(a / M_PI_045);
+		a	= fmod (a , M_PI_045) / M_PI_045;
+		s	= m_pDEM->asDouble(x, y);
+
+		if( m_pDEM->is_InGrid(ix = CSG_Grid_System::Get_xTo(i + 0, x), iy = CSG_Grid_System::Get_yTo(i + 0, y)) && m_pDEM->asDouble(ix, iy) < s
+		&&  m_pDEM->is_InGrid(ix = CSG_Grid_System::Get_xTo(i + 1, x), iy = CSG_Grid_System::Get_yTo(i + 1, y)) && m_pDEM->asDouble(ix, iy) < s )
+		{
+			Fraction[ i      % 8]	= 1.0 - a;
+			Fraction[(i + 1) % 8]	=       a;
+
+			return( true );
+		}
+	}
+
+	return( _Get_D8(x, y, Fraction) );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Accumulation::_Get_MFD(int x, int y, double Fraction[8])	const
+{
+	int		i;
+	double	dzSum	= 0.0, z = m_pDEM->asDouble(x, y);
+
+	for(i=0; i<8; i++)
+	{
+		double	d;
+
+		int	ix	= CSG_Grid_System::Get_xTo(i, x);
+		int	iy	= CSG_Grid_System::Get_yTo(i, y);
+
+		if( m_pDEM->is_InGrid(ix, iy) )
+		{
+			d	= z - m_pDEM->asDouble(ix, iy);
+		}
+		else	// flow leaving the grid is estimated from the opposite neighbour
+		{
+			ix	= CSG_Grid_System::Get_xTo(i + 4, x);
+			iy	= CSG_Grid_System::Get_yTo(i + 4, y);
+
+			d	= m_pDEM->is_InGrid(ix, iy) ? m_pDEM->asDouble(ix, iy) - z : 0.0;
+		}
+
+		if( d > 0.0 )
+		{
+			dzSum	+= (Fraction[i] = pow(d / m_pDEM->Get_System().Get_Length(i), m_Convergence));
+		}
+	}
+
+	if( dzSum > 0.0 )
+	{
+		for(i=0; i<8; i++)
+		{
+			Fraction[i]	/= dzSum;
+		}
+
+		return( true );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Accumulation::_Get_MDInf(int x, int y, double Fraction[8])	const
+{
+	int		i;
+	double	dz[8], s_facet[8], r_facet[8], valley[8];
+	bool	bInGrid[8];
+
+	double	Cellsize	= m_pDEM->Get_Cellsize();
+	double	Cellarea	= m_pDEM->Get_Cellarea();
+	double	z			= m_pDEM->asDouble(x, y);
+
+	//-----------------------------------------------------
+	for(i=0; i<8; i++)
+	{
+		int	ix	= CSG_Grid_System::Get_xTo(i, x);
+		int	iy	= CSG_Grid_System::Get_yTo(i, y);
+
+		dz[i]	= (bInGrid[i] = m_pDEM->is_InGrid(ix, iy)) ? z - m_pDEM->asDouble(ix, iy) : 0.0;
+	}
+
+	//-----------------------------------------------------
+	for(i=0; i<8; i++)
+	{
+		double	hs	= -999.0;
+		double	hr	= -999.0;
+
+		if( bInGrid[i] )
+		{
+			int	j	= i < 7 ? i + 1 : 0;
+
+			if( bInGrid[j] )
+			{
+				double	nx	= (dz[j] * CSG_Grid_System::Get_yTo(i) - dz[i] * CSG_Grid_System::Get_yTo(j)) * Cellsize;
+				double	ny	= (dz[i] * CSG_Grid_System::Get_xTo(j) - dz[j] * CSG_Grid_System::Get_xTo(i)) * Cellsize;
+				double	nz	= (CSG_Grid_System::Get_xTo(i) * CSG_Grid_System::Get_yTo(j) - CSG_Grid_System::Get_xTo(j) * CSG_Grid_System::Get_yTo(i)) * Cellarea;
+
+				double	n_norm	= sqrt(nx*nx + ny*ny + nz*nz);
+
+				if( nx == 0.0 )
+				{
+					hr	= ny >= 0.0 ? 0.0 : M_PI;
+				}
+				else if( nx < 0.0 )
+				{
+					hr	= M_PI_270 - atan(ny / nx);
+				}
+				else
+				{
+					hr	= M_PI_090 - atan(ny / nx);
+				}
+
+				hs	= -tan(acos(nz / n_norm));
+
+				if( hr < i * M_PI_045 || hr > (i + 1) * M_PI_045 )
+				{
+					if( dz[i] > dz[j] )
+					{
+						hr	= i * M_PI_045;
+						hs	= dz[i] / m_pDEM->Get_System().Get_Length(i);
+					}
+					else
+					{
+						hr	= j * M_PI_045;
+						hs	= dz[j] / m_pDEM->Get_System().Get_Length(j);
+					}
+				}
+			}
+			else if( dz[i] > 0.0 )
+			{
+				hr	= i * M_PI_045;
+				hs	= dz[i] / m_pDEM->Get_System().Get_Length(i);
+			}
+		}
+
+		s_facet[i]	= hs;
+		r_facet[i]	= hr;
+	}
+
+	//-----------------------------------------------------
+	double	dzSum	= 0.0;
+
+	for(i=0; i<8; i++)
+	{
+		valley[i]	= 0.0;
+
+		int	j	= i < 7 ? i + 1 : 0;
+
+		if( s_facet[i] > 0.0 )
+		{
+			if( r_facet[i] > i * M_PI_045 && r_facet[i] < (i + 1) * M_PI_045 )
+			{
+				valley[i]	= s_facet[i];
+			}
+			else if( r_facet[i] == r_facet[j] )
+			{
+				valley[i]	= s_facet[i];
+			}
+			else if( s_facet[j] == -999.0 && r_facet[i] == (i + 1) * M_PI_045 )
+			{
+				valley[i]	= s_facet[i];
+			}
+			else
+			{
+				j	= i > 0 ? i - 1 : 7;
+
+				if( s_facet[j] == -999.0 && r_facet[i] == i * M_PI_045 )
+				{
+					valley[i]	= s_facet[i];
+				}
+			}
+
+			valley[i]	= pow(valley[i], m_Convergence);
+			dzSum		+= valley[i];
+		}
+	}
+
+	//-----------------------------------------------------
+	if( dzSum > 0.0 )
+	{
+		for(i=0; i<8; i++)
+		{
+			int	j	= i < 7 ? i + 1 : 0;
+
+			if( i >= 7 && r_facet[i] == 0.0 )
+			{
+				r_facet[i]	= M_PI_360;
+			}
+
+			if( valley[i] )
+			{
+				valley[i]	/= dzSum;
+
+				Fraction[i]	+= valley[i] * ((i + 1) * M_PI_045 - r_facet[i]) / M_PI_045;
+				Fraction[j]	+= valley[i] * (r_facet[i] - (i    ) * M_PI_045) / M_PI_045;
+			}
+		}
+
+		return( true );
+	}
+
+	return( false );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
@@ -0,0 +1,662 @@
+/**********************************************************
+ * Version $Id$
+ *********************************************************/
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                   Library: SAGA_API                   //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                  grid_flow_graph.cpp                  //
+//                                                       //
+//                 Copyright (C) 2014 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, version 2.1 of the License.      //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, write to the Free Software Foundation, Inc.,     //
+// 51 Franklin Street, 5th Floor, Boston, MA 02110-1301, //
+// USA.                                                  //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                Institute of Geography                 //
+//                University of Hamburg                  //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+
+
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "grid_hydrology.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define GRAPH_NODATA_SINGLE		0xFF
+#define GRAPH_NODATA_MULTIPLE	-1.0
+
+#define GRAPH_MARKER_SINGLE		SG_T("flow graph (single)")		// the unit of a graph's exchange grid
+#define GRAPH_MARKER_MULTIPLE	SG_T("flow graph (multiple)")
+
+#define GRAPH_UNITS				255		// the quantized fractions of a cell sum up to this
+#define GRAPH_BINOMIALS			((GRAPH_UNITS - 1) * 8)
+
+//---------------------------------------------------------
+// Binomial coefficients C(c, k) = Binomials[8 * c + k] for
+// c < GRAPH_UNITS - 1 and k < 8, used to rank the quantized
+// fractions of a cell for the exchange grid.
+//---------------------------------------------------------
+static void	SG_Flow_Graph_Binomials(sLong *Binomials)
+{
+	for(int c=0; c<GRAPH_UNITS-1; c++)
+	{
+		Binomials[8 * c]	= 1;
+
+		for(int k=1; k<8; k++)
+		{
+			Binomials[8 * c + k]	= c < 1 ? 0 : Binomials[8 * (c - 1) + k - 1] + Binomials[8 * (c - 1) + k];
+		}
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Grid_Flow_Graph::CSG_Grid_Flow_Graph(void)
+{
+	m_Receivers	= NULL;
+	m_Donors	= NULL;
+	m_Fractions	= NULL;
+}
+
+//---------------------------------------------------------
+CSG_Grid_Flow_Graph::~CSG_Grid_Flow_Graph(void)
+{
+	Destroy();
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Graph::Destroy(void)
+{
+	SG_FREE_SAFE(m_Receivers);
+	SG_FREE_SAFE(m_Donors);
+	SG_FREE_SAFE(m_Fractions);
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Graph::Create(CSG_Grid *pDEM, TSG_Flow_Routing Routing, double Convergence)
+{
+	Destroy();
+
+	CSG_Grid_Flow_Accumulation	Flow;
+
+	if( !Flow.Create(pDEM, Routing, Convergence) )
+	{
+		return( false );
+	}
+
+	m_System	= pDEM->Get_System();
+
+	bool	bSingle	= Routing == SG_FLOW_ROUTING_D8 || Routing == SG_FLOW_ROUTING_Rho8;
+
+	m_Receivers	= (BYTE *)SG_Malloc(m_System.Get_NCells() * sizeof(BYTE));
+	m_Donors	= (BYTE *)SG_Malloc(m_System.Get_NCells() * sizeof(BYTE));
+	m_Fractions	= bSingle ? NULL : (BYTE *)SG_Malloc(8 * m_System.Get_NCells() * sizeof(BYTE));
+
+	if( !m_Receivers || !m_Donors || (!bSingle && !m_Fractions) )
+	{
+		Destroy();
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	#pragma omp parallel for
+	for(int y=0; y<m_System.Get_NY(); y++)
+	{
+		for(int x=0; x<m_System.Get_NX(); x++)
+		{
+			sLong	n	= _Get_Cell(x, y);
+
+			if( pDEM->is_NoData(x, y) )
+			{
+				_Set_NoData(n);
+			}
+			else
+			{
+				double	Fraction[8];
+				BYTE	Units[8];
+
+				Flow.Get_Routing(x, y, Fraction);
+
+				m_Receivers[n]	= (BYTE)_Quantize(Fraction, Units);
+
+				if( m_Fractions )
+				{
+					memcpy(m_Fractions + 8 * n, Units, 8);
+				}
+			}
+		}
+	}
+
+	return( _Set_Donors() );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Graph::Set_Grid(CSG_Grid *pGraph)
+{
+	Destroy();
+
+	if( !pGraph || !pGraph->is_Valid() )
+	{
+		return( false );
+	}
+
+	bool	bSingle	= pGraph->Get_Type() == SG_DATATYPE_Byte;
+
+	// only accept grids created with Get_Grid(), e.g. a byte grid
+	// with D8 direction codes 0-7 would otherwise pass as graph
+	if( (bSingle && CSG_String(GRAPH_MARKER_SINGLE  ).Cmp(pGraph->Get_Unit()))
+	|| (!bSingle && CSG_String(GRAPH_MARKER_MULTIPLE).Cmp(pGraph->Get_Unit()))
+	|| (!bSingle && pGraph->Get_Type() != SG_DATATYPE_Double) )
+	{
+		SG_UI_Msg_Add_Error(CSG_String::Format(SG_T("%s [%s]"), _TL("grid is not a flow routing graph"), pGraph->Get_Name()));
+
+		return( false );
+	}
+
+	m_System	= pGraph->Get_System();
+
+	m_Receivers	= (BYTE *)SG_Malloc(m_System.Get_NCells() * sizeof(BYTE));
+	m_Donors	= (BYTE *)SG_Malloc(m_System.Get_NCells() * sizeof(BYTE));
+	m_Fractions	= bSingle ? NULL : (BYTE *)SG_Malloc(8 * m_System.Get_NCells() * sizeof(BYTE));
+
+	if( !m_Receivers || !m_Donors || (!bSingle && !m_Fractions) )
+	{
+		Destroy();
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	sLong	Binomials[GRAPH_BINOMIALS];
+
+	SG_Flow_Graph_Binomials(Binomials);
+
+	int	nInvalid	= 0;
+
+	#pragma omp parallel for
+	for(int y=0; y<m_System.Get_NY(); y++)
+	{
+		for(int x=0; x<m_System.Get_NX(); x++)
+		{
+			sLong	n	= _Get_Cell(x, y);
+
+			if( pGraph->is_NoData(x, y) )
+			{
+				_Set_NoData(n);
+			}
+			else if( bSingle )
+			{
+				int	Receivers	= pGraph->asInt(x, y, false);
+
+				if( Receivers & (Receivers - 1) )	// more than one receiver
+				{
+					_Set_NoData(n);
+
+					#pragma omp atomic
+					nInvalid++;
+				}
+				else
+				{
+					m_Receivers[n]	= (BYTE)Receivers;
+				}
+			}
+			else
+			{
+				int	Receivers	= _Decode(pGraph->asDouble(x, y, false), m_Fractions + 8 * n, Binomials);
+
+				if( Receivers < 0 )
+				{
+					_Set_NoData(n);
+
+					#pragma omp atomic
+					nInvalid++;
+				}
+				else
+				{
+					m_Receivers[n]	= (BYTE)Receivers;
+				}
+			}
+		}
+	}
+
+	if( nInvalid > 0 )
+	{
+		SG_UI_Msg_Add_Error(CSG_String::Format(SG_T("%s [%s]: %d %s"), _TL("grid is not a flow routing graph"), pGraph->Get_Name(), nInvalid, _TL("invalid cells")));
+
+		Destroy();
+
+		return( false );
+	}
+
+	return( _Set_Donors() );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Graph::_Set_Donors(void)
+{
+	#pragma omp parallel for
+	for(int y=0; y<m_System.Get_NY(); y++)
+	{
+		for(int x=0; x<m_System.Get_NX(); x++)
+		{
+			int	Donors	= 0;
+
+			if( is_Valid(x, y) )
+			{
+				for(int i=0; i<8; i++)
+				{
+					int	ix	= CSG_Grid_System::Get_xTo(i, x);
+					int	iy	= CSG_Grid_System::Get_yTo(i, y);
+
+					if( is_Valid(ix, iy) && (m_Receivers[_Get_Cell(ix, iy)] & (1 << ((i + 4) % 8))) )
+					{
+						Donors	|= 1 << i;
+					}
+				}
+			}
+
+			m_Donors[_Get_Cell(x, y)]	= (BYTE)Donors;
+		}
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Graph::Get_Grid(CSG_Grid *pGraph)	const
+{
+	if( !is_Okay() || !pGraph )
+	{
+		return( false );
+	}
+
+	if( !pGraph->Create(m_System, is_Single() ? SG_DATATYPE_Byte : SG_DATATYPE_Double) )
+	{
+		return( false );
+	}
+
+	pGraph->Set_NoData_Value(is_Single() ? GRAPH_NODATA_SINGLE : GRAPH_NODATA_MULTIPLE);
+	pGraph->Set_Unit        (is_Single() ? GRAPH_MARKER_SINGLE : GRAPH_MARKER_MULTIPLE);
+
+	sLong	Binomials[GRAPH_BINOMIALS];
+
+	SG_Flow_Graph_Binomials(Binomials);
+
+	#pragma omp parallel for
+	for(int y=0; y<m_System.Get_NY(); y++)
+	{
+		for(int x=0; x<m_System.Get_NX(); x++)
+		{
+			if( is_Valid(x, y) )
+			{
+				sLong	n	= _Get_Cell(x, y);
+
+				pGraph->Set_Value(x, y, is_Single() ? m_Receivers[n] : _Encode(m_Receivers[n], m_Fractions + 8 * n, Binomials), false);
+			}
+			else
+			{
+				pGraph->Set_NoData(x, y);
+			}
+		}
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Graph::is_Valid(int x, int y)	const
+{
+	return( m_Receivers && m_System.is_InGrid(x, y) && !_is_NoData(_Get_Cell(x, y)) );
+}
+
+//---------------------------------------------------------
+int CSG_Grid_Flow_Graph::Get_Direction(int x, int y)	const
+{
+	double	Fraction[8];
+
+	int		Direction	= -1;
+
+	if( Get_Fractions(x, y, Fraction) )
+	{
+		for(int i=0; i<8; i++)
+		{
+			if( Fraction[i] > 0.0 && (Direction < 0 || Fraction[Direction] < Fraction[i]) )
+			{
+				Direction	= i;
+			}
+		}
+	}
+
+	return( Direction );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Graph::Get_Fractions(int x, int y, double Fraction[8])	const
+{
+	if( !is_Valid(x, y) )
+	{
+		for(int i=0; i<8; i++)
+		{
+			Fraction[i]	= 0.0;
+		}
+
+		return( false );
+	}
+
+	sLong	n	= _Get_Cell(x, y);
+
+	for(int i=0; i<8; i++)
+	{
+		Fraction[i]	= m_Fractions ? m_Fractions[8 * n + i] / (double)GRAPH_UNITS : (m_Receivers[n] & (1 << i)) ? 1.0 : 0.0;
+	}
+
+	return( m_Receivers[n] != 0 );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// NoData is marked with a receivers mask of 0xFF, which is not
+// a valid single flow direction. Multiple flow directions in
+// addition have no fractions then, whereas a valid cell with
+// eight receivers has at least one unit for each of them.
+//---------------------------------------------------------
+bool CSG_Grid_Flow_Graph::_is_NoData(sLong n)	const
+{
+	return( m_Receivers[n] == GRAPH_NODATA_SINGLE && (!m_Fractions || m_Fractions[8 * n] == 0) );
+}
+
+//---------------------------------------------------------
+void CSG_Grid_Flow_Graph::_Set_NoData(sLong n)
+{
+	m_Receivers[n]	= GRAPH_NODATA_SINGLE;
+
+	if( m_Fractions )
+	{
+		memset(m_Fractions + 8 * n, 0, 8);
+	}
+}
+
+//---------------------------------------------------------
+// Quantizes the fractions to GRAPH_UNITS units, one byte for
+// each direction. Receivers which would get less than half a
+// unit are dropped, each remaining receiver gets at least one
+// unit and the units always sum up to GRAPH_UNITS, i.e. any
+// flow that does not leave the cell through one of its
+// receivers is not kept. Returns the receivers mask.
+//---------------------------------------------------------
+int CSG_Grid_Flow_Graph::_Quantize(const double Fraction[8], BYTE Units[8])
+{
+	int		i, n, Receivers	= 0;
+	double	Sum	= 0.0, Rest[8];
+
+	for(i=0; i<8; i++)
+	{
+		Units[i]	= 0;
+
+		if( Fraction[i] > 0.0 )
+		{
+			Sum	+= Fraction[i];
+		}
+	}
+
+	for(i=0, n=0; i<8; i++)
+	{
+		if( Fraction[i] > 0.0 && GRAPH_UNITS * Fraction[i] >= 0.5 * Sum )
+		{
+			Receivers	|= 1 << i;	n++;
+		}
+	}
+
+	if( n < 1 )
+	{
+		return( 0 );
+	}
+
+	//-----------------------------------------------------
+	int	Total	= 0;
+
+	for(Sum=0.0, i=0; i<8; i++)
+	{
+		if( Receivers & (1 << i) )
+		{
+			Sum	+= Fraction[i];
+		}
+	}
+
+	for(i=0; i<8; i++)
+	{
+		if( Receivers & (1 << i) )
+		{
+			double	u	= GRAPH_UNITS * Fraction[i] / Sum;
+
+			Units[i]	= (BYTE)M_GET_MAX(1, (int)u);
+			Rest [i]	= u - Units[i];
+			Total		+= Units[i];
+		}
+	}
+
+	while( Total != GRAPH_UNITS )	// largest remainders get the units left, the excess of raising small fractions to one unit is taken from the largest ones
+	{
+		int	j	= -1;
+
+		for(i=0; i<8; i++)
+		{
+			if( Receivers & (1 << i) )
+			{
+				if( Total < GRAPH_UNITS ? (j < 0 || Rest[j] < Rest[i]) : (Units[i] > 1 && (j < 0 || Units[j] < Units[i])) )
+				{
+					j	= i;
+				}
+			}
+		}
+
+		if( Total < GRAPH_UNITS )
+		{
+			Units[j]++;	Rest[j]	= -1.0;	Total++;
+		}
+		else
+		{
+			Units[j]--;	Total--;
+		}
+	}
+
+	return( Receivers );
+}
+
+//---------------------------------------------------------
+// The exchange code of a multiple flow direction cell keeps
+// the receivers mask in the lower 8 bits. The units of the n
+// receivers (in direction order) are given by the n - 1 bar
+// positions s(k) = Units(1) + ... + Units(k), 1 <= s(k) < s(k + 1)
+// < GRAPH_UNITS, which are ranked in the combinatorial number
+// system. The rank is below C(254, 7), so that the code stays
+// below 2^52 and is kept exactly by a double precision grid.
+//---------------------------------------------------------
+double CSG_Grid_Flow_Graph::_Encode(int Receivers, const BYTE Units[8], const sLong *Binomials)
+{
+	int		i, k, n, s;
+
+	for(i=0, n=0; i<8; i++)
+	{
+		if( Receivers & (1 << i) )
+		{
+			n++;
+		}
+	}
+
+	sLong	Rank	= 0;
+
+	for(i=0, k=0, s=0; i<8 && k<n-1; i++)
+	{
+		if( Receivers & (1 << i) )
+		{
+			s	+= Units[i];	k++;
+
+			Rank	+= Binomials[8 * (s - 1) + k];
+		}
+	}
+
+	return( (double)Receivers + 256.0 * (double)Rank );
+}
+
+//---------------------------------------------------------
+// Returns the receivers mask or -1 for an invalid code.
+//---------------------------------------------------------
+int CSG_Grid_Flow_Graph::_Decode(double Code, BYTE Units[8], const sLong *Binomials)
+{
+	if( Code < 0.0 || Code >= 4503599627370496.0 )	// 2^52
+	{
+		return( -1 );
+	}
+
+	sLong	Value	= (sLong)Code;
+
+	int		i, k, c, n, Receivers	= (int)(Value & 0xFF), Receiver[8], s[8];
+
+	sLong	Rank	= Value >> 8;
+
+	for(i=0, n=0; i<8; i++)
+	{
+		Units[i]	= 0;
+
+		if( Receivers & (1 << i) )
+		{
+			Receiver[n++]	= i;
+		}
+	}
+
+	if( n < 1 )
+	{
+		return( Rank == 0 ? 0 : -1 );
+	}
+
+	//-----------------------------------------------------
+	s[n - 1]	= GRAPH_UNITS;
+
+	for(k=n-1, c=GRAPH_UNITS-2; k>=1; k--, c--)	// c(k) is the largest c < c(k + 1) with C(c, k) <= rank
+	{
+		while( c >= k && Binomials[8 * c + k] > Rank )	// stops at c = k - 1 at the latest, C(k - 1, k) = 0
+		{
+			c--;
+		}
+
+		Rank		-= Binomials[8 * c + k];
+		s[k - 1]	= c + 1;
+	}
+
+	if( Rank != 0 )
+	{
+		return( -1 );
+	}
+
+	for(k=0; k<n; k++)
+	{
+		int	u	= s[k] - (k > 0 ? s[k - 1] : 0);
+
+		if( u < 1 )
+		{
+			return( -1 );
+		}
+
+		Units[Receiver[k]]	= (BYTE)u;
+	}
+
+	return( Receivers );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
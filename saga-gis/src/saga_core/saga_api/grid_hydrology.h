@@ -0,0 +1,374 @@
+/**********************************************************
+ * Version $Id$
+ *********************************************************/
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                   Library: SAGA_API                   //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                   grid_hydrology.h                    //
+//                                                       //
+//                 Copyright (C) 2014 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, version 2.1 of the License.      //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, write to the Free Software Foundation, Inc.,     //
+// 51 Franklin Street, 5th Floor, Boston, MA 02110-1301, //
+// USA.                                                  //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                Institute of Geography                 //
+//                University of Hamburg                  //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+
+
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#ifndef HEADER_INCLUDED__SAGA_API__grid_hydrology_H
+#define HEADER_INCLUDED__SAGA_API__grid_hydrology_H
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "grid.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//					Flow Accumulation					 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+typedef enum ESG_Flow_Routing
+{
+	SG_FLOW_ROUTING_D8		= 0,	///< Deterministic 8 (O'Callaghan & Mark 1984)
+	SG_FLOW_ROUTING_Rho8,			///< Rho 8 (Fairfield & Leymarie 1991)
+	SG_FLOW_ROUTING_DInf,			///< Deterministic Infinity (Tarboton 1997)
+	SG_FLOW_ROUTING_MFD,			///< Multiple Flow Direction (Freeman 1991, Quinn et al. 1991)
+	SG_FLOW_ROUTING_MDInf			///< Triangular Multiple Flow Direction (Seibert & McGlynn 2007)
+}
+TSG_Flow_Routing;
+
+//---------------------------------------------------------
+/**
+  * CSG_Grid_Flow_Graph keeps the flow routing of a DEM in a compact
+  * form, so that it is derived only once and can be shared by any
+  * number of tools. Each cell stores a bit mask of its receivers
+  * (bit i for direction i) and a bit mask of its donors. Graphs
+  * with more than one receiver per cell additionally store one
+  * byte for each direction, the flow fraction quantized to 255
+  * units. Each receiver gets at least one unit and the units of
+  * a cell always sum up to 255. A graph can be exchanged as grid,
+  * which is of type byte (one receiver per cell) or of type double
+  * (any number of receivers, with the fractions encoded exactly).
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Grid_Flow_Graph
+{
+public:
+	CSG_Grid_Flow_Graph(void);
+	virtual ~CSG_Grid_Flow_Graph(void);
+
+	/// Derives the routing of each cell from the DEM.
+	bool						Create				(CSG_Grid *pDEM, TSG_Flow_Routing Routing = SG_FLOW_ROUTING_D8, double Convergence = 1.1);
+
+	bool						Destroy				(void);
+
+	bool						is_Okay				(void)	const	{	return( m_Receivers != NULL );	}
+
+	const CSG_Grid_System &		Get_System			(void)	const	{	return( m_System );	}
+
+	/// True, if no cell passes flow to more than one neighbour.
+	bool						is_Single			(void)	const	{	return( m_Fractions == NULL );	}
+
+	bool						is_Valid			(int x, int y)	const;
+
+	/// Bit mask of the neighbours cell (x, y) passes flow to. Might include directions leaving the grid.
+	int							Get_Receivers		(int x, int y)	const	{	return( is_Valid(x, y) ? m_Receivers[_Get_Cell(x, y)] : 0 );	}
+
+	/// Bit mask of the neighbours passing flow to cell (x, y).
+	int							Get_Donors			(int x, int y)	const	{	return( is_Valid(x, y) ? m_Donors   [_Get_Cell(x, y)] : 0 );	}
+
+	/// Direction of the receiver getting the largest fraction, -1 if the cell has no outflow.
+	int							Get_Direction		(int x, int y)	const;
+
+	bool						Get_Fractions		(int x, int y, double Fraction[8])	const;
+
+	/// Stores the graph in pGraph, which is (re-)created as byte or double precision grid.
+	bool						Get_Grid			(CSG_Grid *pGraph)	const;
+
+	/// Loads a graph, that has been stored with Get_Grid(). Grids not marked as graph by their unit are rejected.
+	bool						Set_Grid			(CSG_Grid *pGraph);
+
+
+private:
+
+	BYTE						*m_Receivers, *m_Donors, *m_Fractions;
+
+	CSG_Grid_System				m_System;
+
+
+	sLong						_Get_Cell			(int x, int y)	const	{	return( x + y * (sLong)m_System.Get_NX() );	}
+
+	bool						_is_NoData			(sLong n)	const;
+	void						_Set_NoData			(sLong n);
+
+	static int					_Quantize			(const double Fraction[8], BYTE Units[8]);
+
+	static double				_Encode				(int Receivers, const BYTE Units[8], const sLong *Binomials);
+	static int					_Decode				(double Code, BYTE Units[8], const sLong *Binomials);
+
+	bool						_Set_Donors			(void);
+
+};
+
+//---------------------------------------------------------
+/**
+  * CSG_Grid_Flow_Accumulation processes the cells of a DEM from
+  * upslope to downslope without sorting the grid and without
+  * recursion. Each cell first notes the neighbours it passes flow
+  * to. A cell is ready, as soon as all of its donors have been
+  * finished. Ready cells are processed as a front in parallel, a
+  * cell only writes to itself and collects the flow of its donors.
+  * The next front is formed by all receivers, whose donors are
+  * complete, each of them being queued by exactly one donor, so
+  * that neither locks nor atomic operations are needed and results
+  * do not depend on the number of threads.
+  * The simple Execute() accumulates cell counts or weights and the
+  * catchment mean of a property. Derived classes can override the
+  * routing and collect any other values in On_Cell(). The routing
+  * of a cell is queried once, right after its On_Cell() call, and
+  * kept until its receivers are processed. Routing must not form
+  * cycles, cells on a cycle are left unprocessed and reported.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Grid_Flow_Accumulation
+{
+public:
+	CSG_Grid_Flow_Accumulation(void);
+	virtual ~CSG_Grid_Flow_Accumulation(void);
+
+	bool						Create				(CSG_Grid *pDEM, TSG_Flow_Routing Routing = SG_FLOW_ROUTING_D8, double Convergence = 1.1);
+
+	/// Takes the routing from a precomputed flow graph instead of deriving it from a DEM.
+	bool						Create				(const CSG_Grid_Flow_Graph *pGraph);
+
+	bool						Destroy				(void);
+
+	bool						is_Okay				(void)	const	{	return( m_pDEM != NULL || m_pGraph != NULL );	}
+
+	const CSG_Grid_System &		Get_System			(void)	const	{	return( m_System      );	}
+	CSG_Grid *					Get_DEM				(void)	const	{	return( m_pDEM        );	}
+	const CSG_Grid_Flow_Graph *	Get_Graph			(void)	const	{	return( m_pGraph      );	}
+	TSG_Flow_Routing			Get_Routing			(void)	const	{	return( m_Routing     );	}
+	double						Get_Convergence		(void)	const	{	return( m_Convergence );	}
+
+	/// Fills Fraction with the portions of flow that cell (x, y) passes to its eight neighbours. Flow is only passed to lower cells or out of the grid. Returns false, if the cell has no outflow.
+	bool						Get_Routing			(int x, int y, double Fraction[8])	const;
+
+	/// Processes all cells calling On_Cell() for each of them after all of its donors have been processed.
+	bool						Execute				(void);
+
+	/// Accumulates the weights (default: 1 per cell) in pAccu and, if pValue and pMean are given, the weighted mean of pValue over each cell's catchment.
+	bool						Execute				(CSG_Grid *pAccu, CSG_Grid *pWeight = NULL, CSG_Grid *pValue = NULL, CSG_Grid *pMean = NULL);
+
+	/// Number of cells processed by the last call of Execute().
+	sLong						Get_Processed		(void)	const	{	return( m_nProcessed );	}
+
+
+protected:
+
+	/// Actual routing of cell (x, y), queried once right after its On_Cell() call. Defaults to Get_Routing().
+	virtual bool				On_Routing			(int x, int y, double Fraction[8]);
+
+	/// Bit mask of all neighbours (bit i for direction i), which might receive flow from cell (x, y) in On_Routing(). Defaults to the non-zero fractions of On_Routing().
+	virtual int					On_Receivers		(int x, int y);
+
+	/// Called once for each cell after all of its donors have been processed. Must only write to cell (x, y).
+	virtual void				On_Cell				(int x, int y);
+
+	/// Fills Fraction[i] with the portion of flow neighbour i (in direction i from x, y) passes to cell (x, y). Returns the number of donors.
+	int							Get_Donors			(int x, int y, double Fraction[8]);
+	int							Get_Donors_Count	(int x, int y)	const;
+
+	bool						is_Donor			(int x, int y, int Direction)	const;
+
+
+private:
+
+	TSG_Flow_Routing			m_Routing;
+
+	BYTE						*m_Receivers, *m_State;
+
+	float						*m_Fractions;
+
+	sLong						m_nProcessed;
+
+	double						m_Convergence;
+
+	CSG_Grid_System				m_System;
+
+	const CSG_Grid_Flow_Graph	*m_pGraph;
+
+	CSG_Grid					*m_pDEM, *m_pAccu, *m_pWeight, *m_pValue, *m_pMean;
+
+
+	bool						_is_Valid			(int x, int y)	const
+	{
+		return( m_System.is_InGrid(x, y) && (m_pGraph ? m_pGraph->is_Valid(x, y) : !m_pDEM->is_NoData(x, y)) );
+	}
+
+	bool						_Get_D8				(int x, int y, double Fraction[8])	const;
+	bool						_Get_Rho8			(int x, int y, double Fraction[8])	const;
+	bool						_Get_DInf			(int x, int y, double Fraction[8])	const;
+	bool						_Get_MFD			(int x, int y, double Fraction[8])	const;
+	bool						_Get_MDInf			(int x, int y, double Fraction[8])	const;
+
+	bool						_is_Ready			(sLong n, sLong nDonor)	const;
+
+	void						_Set_Fractions		(sLong n);
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//					Depression Filling					 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+typedef enum ESG_Fill_Sinks_Method
+{
+	SG_FILL_SINKS_FLAT		= 0,	///< Depressions are filled up to their spill elevation, leaving flat areas.
+	SG_FILL_SINKS_EPSILON,			///< Flats are raised by the smallest representable increment from cell to cell towards their outlet.
+	SG_FILL_SINKS_MINSLOPE,			///< A minimum slope gradient is preserved from cell to cell (Wang & Liu 2006).
+	SG_FILL_SINKS_BREACH			///< Depressions are drained by lowering the cells along the path to their outlet instead of being filled (Lindsay 2016).
+}
+TSG_Fill_Sinks_Method;
+
+//---------------------------------------------------------
+/**
+  * CSG_Grid_Fill_Sinks removes the depressions of a DEM with the
+  * improved priority-flood algorithm (Barnes et al. 2014). Cells
+  * are flooded from the DEM's edge and from cells next to no-data
+  * in order of increasing elevation. Cells of a depression, which
+  * are raised to the current spill elevation, are passed through a
+  * plain queue instead of the priority queue.
+  * Breaching uses the same flood, but each cell notes the cell it
+  * has been reached from. When a cell is lower than the cell it
+  * is reached from, the path back to the outlet is lowered below
+  * it instead of raising the cell. The path follows the lowest
+  * spill route found by the flood, its length and depth are not
+  * limited and breaching is not combined with filling. Breaching
+  * always processes the whole DEM at once.
+  * The tiled mode processes the DEM in square tiles in parallel,
+  * with working memory being bounded by the tile size rather than
+  * by the DEM size (Barnes 2016). Each tile is flooded from its
+  * border, labelling the depressions draining to the same border
+  * cell and noting the lowest spill elevations between them. The
+  * spillover graph of all tiles is solved for the elevation each
+  * label has to be raised to, then the tiles are flooded again and
+  * finished independently. Epsilon and minimum slope are imposed
+  * per tile in a final pass, so that flats crossing a tile border
+  * might keep a flat seam along that border.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Grid_Fill_Sinks
+{
+public:
+	CSG_Grid_Fill_Sinks(void);
+	virtual ~CSG_Grid_Fill_Sinks(void);
+
+	/// Minimum slope is given as gradient (tangent of the slope angle) and only used with SG_FILL_SINKS_MINSLOPE.
+	bool						Set_Method			(TSG_Fill_Sinks_Method Method, double MinSlope = 0.0);
+	TSG_Fill_Sinks_Method		Get_Method			(void)	const	{	return( m_Method    );	}
+	double						Get_MinSlope		(void)	const	{	return( m_MinSlope  );	}
+
+	/// Edge length of the tiles in cells, zero processes the whole DEM at once.
+	bool						Set_Tile_Size		(int Size);
+	int							Get_Tile_Size		(void)	const	{	return( m_Tile_Size );	}
+
+	/// Stores the depression-free surface of pDEM in pFilled, which might be pDEM itself. Optionally provides flow directions (0 = N, 1 = NE, ..., -1 = no outflow) and the basins of the outlet cells. Directions and basins are not supported in tiled mode, which is skipped, if one of them is requested.
+	bool						Execute				(CSG_Grid *pDEM, CSG_Grid *pFilled, CSG_Grid *pDirection = NULL, CSG_Grid *pBasins = NULL);
+
+
+private:
+
+	int							m_Tile_Size;
+
+	double						m_MinSlope, m_dz[8];
+
+	TSG_Data_Type				m_Type;
+
+	TSG_Fill_Sinks_Method		m_Method;
+
+	CSG_Grid					*m_pDEM, *m_pFilled;
+
+
+	double						_Get_Epsilon		(double z)	const;
+	double						_Get_Lowered		(double z)	const;
+	bool						_Get_Raised			(double z, int Direction, double &iz)	const;
+
+	bool						_Fill_Grid			(CSG_Grid *pDirection, CSG_Grid *pBasins);
+	void						_Breach_Path		(int x, int y, double z, const BYTE *Back);
+	bool						_Fill_Tiled			(void);
+	bool						_Fill_Tile_Slope	(int xTile, int yTile, int nx, int ny);
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#endif // #ifndef HEADER_INCLUDED__SAGA_API__grid_hydrology_H
@@ -166,6 +166,11 @@ bool CSG_Grid::Save(const CSG_String &File_Name, int Format, int xA, int yA, int
 	//-----------------------------------------------------
 	SG_UI_Msg_Add(CSG_String::Format(SG_T("%s: %s..."), _TL("Save grid"), File_Name.c_str()), true);
 
+	if( is_Virtual() && m_pProvider->is_Source(SG_File_Make_Path(NULL, sFile_Name, SG_T("sdat"))) )
+	{
+		_Virtual_Destroy(true);	// the source of the rows is going to be overwritten
+	}
+
 	switch( Format )
 	{
 	default:
@@ -588,6 +593,75 @@ sLong SG_Grid_Cache_Check(CSG_Grid_System &m_System, int nValueBytes)
 	return( 0 );
 }
 
+//---------------------------------------------------------
+// Reads the rows of a virtual grid directly from the binary
+// data file of a native grid. The file is opened read-only.
+//---------------------------------------------------------
+class CSG_Grid_File_Line_Provider : public CSG_Grid_Line_Provider
+{
+public:
+	CSG_Grid_File_Line_Provider(void)	{}
+
+	bool						Open			(const CSG_String &File, const CSG_Grid_File_Info &Info, int nLineBytes)
+	{
+		if( m_Stream.Open(File, SG_FILE_R, true) )
+		{
+			m_File			= File;
+			m_NY			= Info.m_System.Get_NY();
+			m_nLineBytes	= nLineBytes;
+			m_nValueBytes	= Info.m_Type == SG_DATATYPE_Bit ? 0 : (int)SG_Data_Type_Get_Size(Info.m_Type);
+			m_Offset		= Info.m_Offset;
+			m_bSwap			= Info.m_bSwapBytes && m_nValueBytes > 1;
+			m_bFlip			= Info.m_bFlip;
+
+			return( true );
+		}
+
+		return( false );
+	}
+
+	virtual bool				Read_Line		(int y, void *Data)
+	{
+		if( !m_Stream.Seek(m_Offset + (m_bFlip ? m_NY - 1 - y : y) * (sLong)m_nLineBytes)
+		||  !m_Stream.Read(Data, sizeof(char), m_nLineBytes) )
+		{
+			return( false );
+		}
+
+		if( m_bSwap )
+		{
+			for(char *pValue=(char *)Data, *pEnd=pValue+m_nLineBytes; pValue<pEnd; pValue+=m_nValueBytes)
+			{
+				for(int i=0, j=m_nValueBytes-1; i<j; i++, j--)
+				{
+					char	c	= pValue[i];	pValue[i]	= pValue[j];	pValue[j]	= c;
+				}
+			}
+		}
+
+		return( true );
+	}
+
+	virtual bool				is_Source		(const CSG_String &File)	const
+	{
+		return( !m_File.CmpNoCase(File) );
+	}
+
+
+private:
+
+	bool						m_bSwap, m_bFlip;
+
+	int							m_NY, m_nLineBytes, m_nValueBytes;
+
+	sLong						m_Offset;
+
+	CSG_File					m_Stream;
+
+	CSG_String					m_File;
+
+};
+
 //---------------------------------------------------------
 bool CSG_Grid::_Load_Native(const CSG_String &File_Name, TSG_Grid_Memory_Type Memory_Type, bool bLoadData)
 {
@@ -638,6 +712,24 @@ bool CSG_Grid::_Load_Native(const CSG_String &File_Name, TSG_Grid_Memory_Type Me
 	//-----------------------------------------------------
 	else	// Binary...
 	{
+		if( Memory_Type == GRID_MEMORY_Virtual || (Memory_Type == GRID_MEMORY_Normal && SG_Grid_Cache_Get_Virtual()) )
+		{
+			CSG_Grid_File_Line_Provider	*pProvider	= new CSG_Grid_File_Line_Provider;
+
+			if( pProvider->Open(Info.m_Data_File                                , Info, Get_nLineBytes())
+			||  pProvider->Open(SG_File_Make_Path(NULL, File_Name, SG_T( "dat")), Info, Get_nLineBytes())
+			||  pProvider->Open(SG_File_Make_Path(NULL, File_Name, SG_T("sdat")), Info, Get_nLineBytes()) )
+			{
+				Set_Buffer_Size(SG_Grid_Cache_Get_Threshold());
+
+				return( _Virtual_Create(pProvider) );
+			}
+
+			delete(pProvider);
+
+			return( false );
+		}
+
 		if( SG_Grid_Cache_Check(m_System, Get_nValueBytes()) > 0 )
 		{
 			Set_Buffer_Size(SG_Grid_Cache_Check(m_System, Get_nValueBytes()));
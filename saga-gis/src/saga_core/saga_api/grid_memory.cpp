@@ -65,6 +65,10 @@
 //---------------------------------------------------------
 #include <memory.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "grid.h"
 #include "parameters.h"
 
@@ -104,6 +108,19 @@ bool				SG_Grid_Cache_Get_Automatic(void)
 	return( gSG_Grid_Cache_bAutomatic );
 }
 
+//---------------------------------------------------------
+static bool			gSG_Grid_Cache_bVirtual		= false;
+
+void				SG_Grid_Cache_Set_Virtual(bool bOn)
+{
+	gSG_Grid_Cache_bVirtual		= bOn;
+}
+
+bool				SG_Grid_Cache_Get_Virtual(void)
+{
+	return( gSG_Grid_Cache_bVirtual );
+}
+
 //---------------------------------------------------------
 static int			gSG_Grid_Cache_Confirm		= 2;
 
@@ -210,6 +227,7 @@ bool CSG_Grid::_Memory_Create(TSG_Grid_Memory_Type Memory_Type)
 		switch( Memory_Type )
 		{
 		case GRID_MEMORY_Normal:
+		case GRID_MEMORY_Virtual:	// needs a line provider, see Create(System, Type, pProvider)
 			return( _Array_Create() );
 
 		case GRID_MEMORY_Cache:
@@ -234,6 +252,7 @@ void CSG_Grid::_Memory_Destroy(void)
 	case GRID_MEMORY_Normal:		_Array_Destroy();		break;
 	case GRID_MEMORY_Cache:			_Cache_Destroy(false);	break;
 	case GRID_MEMORY_Compression:	_Compr_Destroy(false);	break;
+	case GRID_MEMORY_Virtual:		_Virtual_Destroy(false);	break;
 	}
 
 	_LineBuffer_Destroy();
@@ -353,6 +372,10 @@ void CSG_Grid::_LineBuffer_Flush(void)
 			case GRID_MEMORY_Compression:
 				_Compr_LineBuffer_Save(m_LineBuffer + i);
 				break;
+
+			case GRID_MEMORY_Virtual:
+				_Virtual_LineBuffer_Save(m_LineBuffer + i);
+				break;
 			}
 		}
 	}
@@ -396,6 +419,11 @@ CSG_Grid::TSG_Grid_Line * CSG_Grid::_LineBuffer_Get_Line(int y) const
 					_Compr_LineBuffer_Save(m_LineBuffer + iLine);
 					_Compr_LineBuffer_Load(m_LineBuffer + iLine, y);
 					break;
+
+				case GRID_MEMORY_Virtual:
+					_Virtual_LineBuffer_Save(m_LineBuffer + iLine);
+					_Virtual_LineBuffer_Load(m_LineBuffer + iLine, y);
+					break;
 				}
 			}
 
@@ -417,9 +445,32 @@ CSG_Grid::TSG_Grid_Line * CSG_Grid::_LineBuffer_Get_Line(int y) const
 	return( NULL );
 }
 
+//---------------------------------------------------------
+// The line buffer is shared by all threads, so that access
+// from parallelized loops has to be serialized. Each grid
+// has its own lock, threads working on different grids do
+// not wait for each other.
+//---------------------------------------------------------
+void CSG_Grid::_LineBuffer_Lock(void)	const
+{
+#ifdef _OPENMP
+	omp_set_lock((omp_lock_t *)m_LineBuffer_Lock);
+#endif
+}
+
+//---------------------------------------------------------
+void CSG_Grid::_LineBuffer_Unlock(void)	const
+{
+#ifdef _OPENMP
+	omp_unset_lock((omp_lock_t *)m_LineBuffer_Lock);
+#endif
+}
+
 //---------------------------------------------------------
 void CSG_Grid::_LineBuffer_Set_Value(int x, int y, double Value)
 {
+	_LineBuffer_Lock();
+
 	TSG_Grid_Line	*pLine;
 
 	if( (pLine = _LineBuffer_Get_Line(y)) != NULL )
@@ -464,11 +515,17 @@ void CSG_Grid::_LineBuffer_Set_Value(int x, int y, double Value)
 
 		pLine->bModified	= true;
 	}
+
+	_LineBuffer_Unlock();
 }
 
 //---------------------------------------------------------
 double CSG_Grid::_LineBuffer_Get_Value(int x, int y) const
 {
+	double	Value	= 0.0;
+
+	_LineBuffer_Lock();
+
 	TSG_Grid_Line	*pLine;
 
 	if( (pLine = _LineBuffer_Get_Line(y)) != NULL )
@@ -479,32 +536,42 @@ double CSG_Grid::_LineBuffer_Get_Value(int x, int y) const
 			break;
 
 		case SG_DATATYPE_Byte:
-			return( ((BYTE   *)pLine->Data)[x] );
+			Value	= ((BYTE   *)pLine->Data)[x];
+			break;
 
 		case SG_DATATYPE_Char:
-			return( ((char   *)pLine->Data)[x] );
+			Value	= ((char   *)pLine->Data)[x];
+			break;
 
 		case SG_DATATYPE_Word:
-			return( ((WORD   *)pLine->Data)[x] );
+			Value	= ((WORD   *)pLine->Data)[x];
+			break;
 
 		case SG_DATATYPE_Short:
-			return( ((short  *)pLine->Data)[x] );
+			Value	= ((short  *)pLine->Data)[x];
+			break;
 
 		case SG_DATATYPE_DWord:
-			return( ((DWORD  *)pLine->Data)[x] );
+			Value	= ((DWORD  *)pLine->Data)[x];
+			break;
 
 		case SG_DATATYPE_Int:
-			return( ((int    *)pLine->Data)[x] );
+			Value	= ((int    *)pLine->Data)[x];
+			break;
 
 		case SG_DATATYPE_Float:
-			return( ((float  *)pLine->Data)[x] );
+			Value	= ((float  *)pLine->Data)[x];
+			break;
 
 		case SG_DATATYPE_Double:
-			return( ((double *)pLine->Data)[x] );
+			Value	= ((double *)pLine->Data)[x];
+			break;
 		}
 	}
 
-	return( 0.0 );
+	_LineBuffer_Unlock();
+
+	return( Value );
 }
 
 
@@ -784,6 +851,149 @@ void CSG_Grid::_Cache_LineBuffer_Load(TSG_Grid_Line *pLine, int y) const
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//						Virtual							 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * Virtual grids read their rows on demand from a line provider.
+  * Setting virtual mode off loads all rows into memory and
+  * releases the provider. Switching a grid into virtual mode
+  * needs a provider, see Create(System, Type, pProvider).
+*/
+bool CSG_Grid::Set_Virtual(bool bOn)
+{
+	return( bOn ? is_Virtual() : _Virtual_Destroy(true) );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid::_Virtual_Create(CSG_Grid_Line_Provider *pProvider)
+{
+	if( pProvider && m_System.is_Valid() && m_Type != SG_DATATYPE_Undefined && m_Memory_Type == GRID_MEMORY_Normal )
+	{
+		m_Cache_Path	= SG_File_Get_Name_Temp(SG_T("sg_grd"), SG_Grid_Cache_Get_Directory());
+
+		if( m_Cache_Stream.Open(m_Cache_Path, SG_FILE_RW, true) )	// receives the rows that have been modified
+		{
+			m_Memory_bLock	= true;
+
+			_Array_Destroy();
+
+			m_Cache_bTemp	= true;
+
+			m_Cache_Offset	= 0;
+			m_Cache_bSwap	= false;
+			m_Cache_bFlip	= false;
+
+			m_pProvider			= pProvider;
+			m_Virtual_bSaved	= (bool *)SG_Calloc(Get_NY(), sizeof(bool));
+
+			_LineBuffer_Create();
+
+			m_Memory_bLock	= false;
+			m_Memory_Type	= GRID_MEMORY_Virtual;
+
+			return( true );
+		}
+	}
+
+	if( pProvider )
+	{
+		delete(pProvider);
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid::_Virtual_Destroy(bool bMemory_Restore)
+{
+	int				y;
+	TSG_Grid_Line	*pLine;
+
+	if( m_Memory_Type == GRID_MEMORY_Virtual )
+	{
+		m_Memory_bLock	= true;
+
+		if( bMemory_Restore && _Array_Create() )
+		{
+			for(y=0; y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++)
+			{
+				if( (pLine = _LineBuffer_Get_Line(y)) != NULL )
+				{
+					memcpy(m_Values[y], pLine->Data, Get_nLineBytes());
+				}
+			}
+
+			SG_UI_Process_Set_Ready();
+		}
+
+		_LineBuffer_Destroy();
+
+		m_Memory_bLock	= false;
+		m_Memory_Type	= GRID_MEMORY_Normal;
+
+		//-------------------------------------------------
+		delete(m_pProvider);
+
+		m_pProvider	= NULL;
+
+		SG_FREE_SAFE(m_Virtual_bSaved);
+
+		m_Cache_Stream.Close();
+
+		SG_File_Delete(m_Cache_Path);
+
+		return( true );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+void CSG_Grid::_Virtual_LineBuffer_Save(TSG_Grid_Line *pLine) const
+{
+	if( pLine && pLine->bModified )
+	{
+		pLine->bModified	= false;
+
+		if( pLine->y >= 0 && pLine->y < Get_NY() )
+		{
+			m_Cache_Stream.Seek(pLine->y * (sLong)Get_nLineBytes());
+			m_Cache_Stream.Write(pLine->Data, sizeof(char), Get_nLineBytes());
+
+			m_Virtual_bSaved[pLine->y]	= true;
+		}
+	}
+}
+
+//---------------------------------------------------------
+void CSG_Grid::_Virtual_LineBuffer_Load(TSG_Grid_Line *pLine, int y) const
+{
+	if( pLine )
+	{
+		pLine->bModified	= false;
+		pLine->y			= y;
+
+		if( pLine->y >= 0 && pLine->y < Get_NY() )
+		{
+			if( m_Virtual_bSaved[y] )
+			{
+				m_Cache_Stream.Seek(y * (sLong)Get_nLineBytes());
+				m_Cache_Stream.Read(pLine->Data, sizeof(char), Get_nLineBytes());
+			}
+			else if( !m_pProvider->Read_Line(y, pLine->Data) )
+			{
+				memset(pLine->Data, 0, Get_nLineBytes());
+			}
+		}
+	}
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //					RTL - Compression					 //
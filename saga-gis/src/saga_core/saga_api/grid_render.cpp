@@ -0,0 +1,307 @@
+/**********************************************************
+ * Version $Id$
+ *********************************************************/
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                   Library: SAGA_API                   //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                    grid_render.cpp                    //
+//                                                       //
+//                 Copyright (C) 2014 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, version 2.1 of the License.      //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, write to the Free Software Foundation, Inc.,     //
+// 51 Franklin Street, 5th Floor, Boston, MA 02110-1301, //
+// USA.                                                  //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                Institute of Geography                 //
+//                University of Hamburg                  //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "grid_render.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Grid_Renderer::CSG_Grid_Renderer(void)
+{
+	m_pGrid			= NULL;
+	m_pPyramid		= NULL;
+
+	m_bPyramid		= true;
+	m_Interpolation	= GRID_INTERPOLATION_NearestNeighbour;
+	m_Transparency	= 0.0;
+
+	m_zMin			= 0.0;
+	m_zScale		= 1.0;
+
+	Set_Shading(false);
+}
+
+//---------------------------------------------------------
+CSG_Grid_Renderer::~CSG_Grid_Renderer(void)
+{
+	Invalidate();
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_Renderer::Set_Grid(CSG_Grid *pGrid)
+{
+	if( m_pGrid != pGrid )
+	{
+		Invalidate();
+
+		m_pGrid	= pGrid;
+	}
+
+	return( m_pGrid && m_pGrid->is_Valid() );
+}
+
+//---------------------------------------------------------
+void CSG_Grid_Renderer::Invalidate(void)
+{
+	if( m_pPyramid )
+	{
+		delete(m_pPyramid);
+
+		m_pPyramid	= NULL;
+	}
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Renderer::Set_Colors(const CSG_Colors &Colors, double Minimum, double Maximum)
+{
+	if( Colors.Get_Count() < 1 || Minimum >= Maximum )
+	{
+		return( false );
+	}
+
+	m_Colors	= Colors;
+
+	m_zMin		= Minimum;
+	m_zScale	= m_Colors.Get_Count() / (Maximum - Minimum);
+
+	return( true );
+}
+
+//---------------------------------------------------------
+void CSG_Grid_Renderer::Set_Transparency(double Transparency)
+{
+	m_Transparency	= Transparency < 0.0 ? 0.0 : Transparency > 1.0 ? 1.0 : Transparency;
+}
+
+//---------------------------------------------------------
+void CSG_Grid_Renderer::Set_Shading(bool bOn, double Azimuth, double Height, double Exaggeration)
+{
+	m_bShade				= bOn;
+
+	m_Shade_Azimuth			= Azimuth * M_DEG_TO_RAD;
+	m_Shade_Height			= Height  * M_DEG_TO_RAD;
+	m_Shade_Exaggeration	= Exaggeration;
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * Returns the coarsest pyramid level with a cell size not larger
+  * than the requested one, or the grid itself, if the requested
+  * cell size is less than twice the grid's cell size.
+*/
+//---------------------------------------------------------
+CSG_Grid * CSG_Grid_Renderer::Get_Level(double Cellsize)
+{
+	if( !m_bPyramid || !m_pGrid || Cellsize < 2.0 * m_pGrid->Get_Cellsize() )
+	{
+		return( m_pGrid );
+	}
+
+	if( !m_pPyramid )
+	{
+		m_pPyramid	= new CSG_Grid_Pyramid;
+
+		SG_UI_Progress_Lock(true);
+
+		m_pPyramid->Create(m_pGrid, 2.0, GRID_PYRAMID_Mean, GRID_PYRAMID_Geometric);
+
+		SG_UI_Progress_Lock(false);
+	}
+
+	for(int i=m_pPyramid->Get_Count()-1; i>=0; i--)
+	{
+		if( m_pPyramid->Get_Grid(i)->Get_Cellsize() <= Cellsize )
+		{
+			return( m_pPyramid->Get_Grid(i) );
+		}
+	}
+
+	return( m_pGrid );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+inline bool CSG_Grid_Renderer::_Get_Color(CSG_Grid *pGrid, double x, double y, double d, int &Color)	const
+{
+	double	z;
+
+	if( !pGrid->Get_Value(x, y, z, m_Interpolation, false, true) )
+	{
+		return( false );
+	}
+
+	int	i	= (int)(m_zScale * (z - m_zMin));
+
+	Color	= m_Colors.Get_Color(i);	// index is clamped to the valid range
+
+	//-----------------------------------------------------
+	if( m_bShade )
+	{
+		double	zx[2], zy[2];
+
+		if( !pGrid->Get_Value(x - d, y, zx[0], m_Interpolation, false, true) )	zx[0]	= z;
+		if( !pGrid->Get_Value(x + d, y, zx[1], m_Interpolation, false, true) )	zx[1]	= z;
+		if( !pGrid->Get_Value(x, y - d, zy[0], m_Interpolation, false, true) )	zy[0]	= z;
+		if( !pGrid->Get_Value(x, y + d, zy[1], m_Interpolation, false, true) )	zy[1]	= z;
+
+		double	dx	= m_Shade_Exaggeration * (zx[1] - zx[0]) / (2.0 * d);
+		double	dy	= m_Shade_Exaggeration * (zy[1] - zy[0]) / (2.0 * d);
+
+		double	Shade	= (sin(m_Shade_Height) - cos(m_Shade_Height) * (dx * sin(m_Shade_Azimuth) + dy * cos(m_Shade_Azimuth)))
+						/ sqrt(1.0 + dx*dx + dy*dy);
+
+		if( Shade < 0.0 )	Shade	= 0.0;
+
+		Color	= SG_GET_RGB(Shade * SG_GET_R(Color), Shade * SG_GET_G(Color), Shade * SG_GET_B(Color));
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+  * Draws the grid into Image, which is expected to hold nx * ny
+  * RGB values, with the first row being the northern one. Extent
+  * gives the area covered by the image. Pixels without data keep
+  * their previous value.
+*/
+//---------------------------------------------------------
+bool CSG_Grid_Renderer::Draw(int *Image, int nx, int ny, const CSG_Rect &Extent)
+{
+	if( !Image || nx < 1 || ny < 1 || !m_pGrid || !m_pGrid->is_Valid() || m_Colors.Get_Count() < 1 )
+	{
+		return( false );
+	}
+
+	double	dx	= Extent.Get_XRange() / nx;
+	double	dy	= Extent.Get_YRange() / ny;
+
+	CSG_Grid	*pGrid	= Get_Level(dx < dy ? dx : dy);
+
+	double	d	= pGrid->Get_Cellsize() > dx ? pGrid->Get_Cellsize() : dx;	// distance used for gradients
+
+	//-----------------------------------------------------
+	#pragma omp parallel for schedule(dynamic) if( !pGrid->is_Cached() && !pGrid->is_Compressed() )
+	for(int y=0; y<ny; y++)
+	{
+		int		*pPixel	= Image + y * nx;
+		double	 yWorld	= Extent.Get_YMax() - (0.5 + y) * dy;
+		double	 xWorld	= Extent.Get_XMin() +  0.5      * dx;
+
+		for(int x=0; x<nx; x++, pPixel++, xWorld+=dx)
+		{
+			int	Color;
+
+			if( _Get_Color(pGrid, xWorld, yWorld, d, Color) )
+			{
+				if( m_Transparency > 0.0 )
+				{
+					Color	= SG_GET_RGB(
+						m_Transparency * SG_GET_R(*pPixel) + (1.0 - m_Transparency) * SG_GET_R(Color),
+						m_Transparency * SG_GET_G(*pPixel) + (1.0 - m_Transparency) * SG_GET_G(Color),
+						m_Transparency * SG_GET_B(*pPixel) + (1.0 - m_Transparency) * SG_GET_B(Color)
+					);
+				}
+
+				*pPixel	= Color;
+			}
+		}
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
@@ -0,0 +1,147 @@
+/**********************************************************
+ * Version $Id$
+ *********************************************************/
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                   Library: SAGA_API                   //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                     grid_render.h                     //
+//                                                       //
+//                 Copyright (C) 2014 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, version 2.1 of the License.      //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, write to the Free Software Foundation, Inc.,     //
+// 51 Franklin Street, 5th Floor, Boston, MA 02110-1301, //
+// USA.                                                  //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                Institute of Geography                 //
+//                University of Hamburg                  //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#ifndef HEADER_INCLUDED__SAGA_API__grid_render_H
+#define HEADER_INCLUDED__SAGA_API__grid_render_H
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "grid_pyramid.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * CSG_Grid_Renderer draws a grid into an RGB image buffer without
+  * any user interface dependencies. Values are coloured with a
+  * linearly stretched colour ramp, optionally combined with an
+  * analytical hillshading and blended over the buffer's previous
+  * content. If the requested resolution is coarser than the grid's
+  * cell size, values are taken from a grid pyramid, which is
+  * created on demand and kept until the grid is changed.
+  * Image rows are rendered concurrently.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Grid_Renderer
+{
+public:
+	CSG_Grid_Renderer(void);
+	virtual ~CSG_Grid_Renderer(void);
+
+	bool						Set_Grid			(CSG_Grid *pGrid);
+	CSG_Grid *					Get_Grid			(void)	const	{	return( m_pGrid );	}
+
+	/// Call this, whenever the grid's values have been changed, to have the pyramid rebuilt.
+	void						Invalidate			(void);
+
+	bool						Set_Colors			(const CSG_Colors &Colors, double Minimum, double Maximum);
+	void						Set_Interpolation	(TSG_Grid_Interpolation Interpolation)	{	m_Interpolation	= Interpolation;	}
+	void						Set_Transparency	(double Transparency);
+	void						Set_Shading			(bool bOn, double Azimuth = 315.0, double Height = 45.0, double Exaggeration = 1.0);
+	void						Set_Pyramid			(bool bOn)	{	m_bPyramid	= bOn;	}
+
+	CSG_Grid *					Get_Level			(double Cellsize);
+
+	bool						Draw				(int *Image, int nx, int ny, const CSG_Rect &Extent);
+
+
+private:
+
+	bool						m_bPyramid, m_bShade;
+
+	double						m_zMin, m_zScale, m_Transparency, m_Shade_Azimuth, m_Shade_Height, m_Shade_Exaggeration;
+
+	TSG_Grid_Interpolation		m_Interpolation;
+
+	CSG_Colors					m_Colors;
+
+	CSG_Grid					*m_pGrid;
+
+	CSG_Grid_Pyramid			*m_pPyramid;
+
+
+	bool						_Get_Color			(CSG_Grid *pGrid, double x, double y, double d, int &Color)	const;
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#endif // #ifndef HEADER_INCLUDED__SAGA_API__grid_render_H
@@ -0,0 +1,557 @@
+/**********************************************************
+ * Version $Id$
+ *********************************************************/
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                   Library: SAGA_API                   //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                    grid_zonal.cpp                     //
+//                                                       //
+//                 Copyright (C) 2014 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, version 2.1 of the License.      //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, write to the Free Software Foundation, Inc.,     //
+// 51 Franklin Street, 5th Floor, Boston, MA 02110-1301, //
+// USA.                                                  //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                Institute of Geography                 //
+//                University of Hamburg                  //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "grid_zonal.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Grid_Zonal_Statistics::CSG_Grid_Zonal_Statistics(void)
+{
+	m_pZones		= NULL;
+	m_pCategories	= NULL;
+	m_pValues		= NULL;
+	m_bCircular		= NULL;
+	m_NoData		= NULL;
+	m_Slots			= NULL;
+	m_Index			= NULL;
+	m_nSlots		= 0;
+	m_nKey			= 1;
+	m_nValues		= 0;
+}
+
+//---------------------------------------------------------
+CSG_Grid_Zonal_Statistics::~CSG_Grid_Zonal_Statistics(void)
+{
+	Destroy();
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Zonal_Statistics::Destroy(void)
+{
+	SG_FREE_SAFE(m_pCategories);
+	SG_FREE_SAFE(m_pValues    );
+	SG_FREE_SAFE(m_bCircular  );
+	SG_FREE_SAFE(m_NoData     );
+	SG_FREE_SAFE(m_Slots      );
+	SG_FREE_SAFE(m_Index      );
+
+	m_Units.Destroy();
+
+	m_pZones	= NULL;
+	m_nSlots	= 0;
+	m_nKey		= 1;
+	m_nValues	= 0;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Zonal_Statistics::Create(CSG_Grid *pZones)
+{
+	Destroy();
+
+	if( pZones && pZones->is_Valid() )
+	{
+		m_pZones	= pZones;
+
+		return( true );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Zonal_Statistics::Add_Category(CSG_Grid *pGrid)
+{
+	if( m_pZones && pGrid && pGrid->is_Compatible(m_pZones) )
+	{
+		m_pCategories	= (CSG_Grid **)SG_Realloc(m_pCategories, m_nKey * sizeof(CSG_Grid *));
+		m_pCategories[m_nKey++ - 1]	= pGrid;
+
+		return( true );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Zonal_Statistics::Add_Value(CSG_Grid *pGrid, bool bCircular)
+{
+	if( m_pZones && pGrid && pGrid->is_Compatible(m_pZones) )
+	{
+		m_pValues	= (CSG_Grid **)SG_Realloc(m_pValues  , (m_nValues + 1) * sizeof(CSG_Grid *));
+		m_bCircular	= (bool      *)SG_Realloc(m_bCircular, (m_nValues + 1) * sizeof(bool      ));
+		m_NoData	= (sLong     *)SG_Realloc(m_NoData   , (m_nValues + 1) * sizeof(sLong     ));
+
+		m_pValues  [m_nValues]	= pGrid;
+		m_bCircular[m_nValues]	= bCircular;
+		m_NoData   [m_nValues]	= 0;
+
+		m_nValues++;
+
+		return( true );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+void CSG_Grid_Zonal_Statistics::_Set_Layout(const CSG_Grid_Zonal_Statistics &Layout)
+{
+	Create(Layout.m_pZones);
+
+	for(int iCategory=0; iCategory<Layout.m_nKey-1; iCategory++)
+	{
+		Add_Category(Layout.m_pCategories[iCategory]);
+	}
+
+	for(int iValue=0; iValue<Layout.m_nValues; iValue++)
+	{
+		Add_Value(Layout.m_pValues[iValue], Layout.m_bCircular[iValue]);
+	}
+
+	//-----------------------------------------------------
+	// unit layout: cell count, key (zone and categories), value statistics
+
+	m_Key_Offset	= sizeof(sLong);
+	m_Value_Offset	= sizeof(sLong) * ((m_Key_Offset + m_nKey * sizeof(int) + sizeof(sLong) - 1) / sizeof(sLong));
+
+	m_Units.Create(m_Value_Offset + m_nValues * sizeof(TSG_Zonal_Value), 0, SG_ARRAY_GROWTH_3);
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid_Zonal_Statistics::Execute(void)
+{
+	if( !m_pZones )
+	{
+		return( false );
+	}
+
+	CSG_Grid_Zonal_Statistics	Layout;	Layout._Set_Layout(*this);	_Set_Layout(Layout);	// resets previous results, keeps the input grids
+
+	//-----------------------------------------------------
+	// each thread collects the units of a block of columns in its own table
+
+	int	NX	= m_pZones->Get_NX();
+	int	NY	= m_pZones->Get_NY();
+
+	int	nBlocks	= M_GET_MIN(SG_Get_Max_Num_Threads_Omp(), NX);
+
+	CSG_Grid_Zonal_Statistics	*Partials	= new CSG_Grid_Zonal_Statistics[nBlocks];
+
+	int	*Keys	= (int *)SG_Malloc(nBlocks * m_nKey * sizeof(int));
+
+	for(int iBlock=0; iBlock<nBlocks; iBlock++)
+	{
+		Partials[iBlock]._Set_Layout(*this);
+	}
+
+	for(int y=0; y<NY && SG_UI_Process_Set_Progress(y, NY); y++)
+	{
+		#pragma omp parallel for
+		for(int iBlock=0; iBlock<nBlocks; iBlock++)
+		{
+			int	ax	= (int)(((sLong)NX *  iBlock     ) / nBlocks);
+			int	bx	= (int)(((sLong)NX * (iBlock + 1)) / nBlocks);
+
+			for(int x=ax; x<bx; x++)
+			{
+				Partials[iBlock]._Add_Cell(x, y, Keys + iBlock * m_nKey);
+			}
+		}
+	}
+
+	SG_Free(Keys);
+
+	//-----------------------------------------------------
+	for(int iBlock=0; iBlock<nBlocks; iBlock++)
+	{
+		_Merge(Partials[iBlock]);
+	}
+
+	delete[](Partials);
+
+	return( _Sort() );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+inline unsigned int	SG_Zonal_Get_Hash	(const int *Key, int nKey)
+{
+	unsigned int	Hash	= 2166136261u;
+
+	for(int i=0; i<nKey; i++)
+	{
+		Hash	^= (unsigned int)Key[i];
+		Hash	*= 16777619u;
+		Hash	^= Hash >> 15;
+	}
+
+	return( Hash ^ (Hash >> 13) );
+}
+
+//---------------------------------------------------------
+char * CSG_Grid_Zonal_Statistics::_Find(const int *Key)
+{
+	int	nUnits	= (int)m_Units.Get_Size();
+
+	//-----------------------------------------------------
+	if( 2 * nUnits >= m_nSlots )	// keep the load factor below one half
+	{
+		m_nSlots	= m_nSlots < 64 ? 64 : 2 * m_nSlots;
+		m_Slots		= (int *)SG_Realloc(m_Slots, m_nSlots * sizeof(int));
+
+		memset(m_Slots, -1, m_nSlots * sizeof(int));
+
+		for(int iUnit=0; iUnit<nUnits; iUnit++)
+		{
+			unsigned int	iSlot	= SG_Zonal_Get_Hash(_Get_Key((char *)m_Units.Get_Entry(iUnit)), m_nKey) & (m_nSlots - 1);
+
+			while( m_Slots[iSlot] >= 0 )
+			{
+				iSlot	= (iSlot + 1) & (m_nSlots - 1);
+			}
+
+			m_Slots[iSlot]	= iUnit;
+		}
+	}
+
+	//-----------------------------------------------------
+	unsigned int	iSlot	= SG_Zonal_Get_Hash(Key, m_nKey) & (m_nSlots - 1);
+
+	while( m_Slots[iSlot] >= 0 )
+	{
+		char	*pUnit	= (char *)m_Units.Get_Entry(m_Slots[iSlot]);
+
+		if( !memcmp(_Get_Key(pUnit), Key, m_nKey * sizeof(int)) )
+		{
+			return( pUnit );
+		}
+
+		iSlot	= (iSlot + 1) & (m_nSlots - 1);
+	}
+
+	//-----------------------------------------------------
+	if( !m_Units.Inc_Array() )
+	{
+		return( NULL );
+	}
+
+	m_Slots[iSlot]	= nUnits;
+
+	char	*pUnit	= (char *)m_Units.Get_Entry(nUnits);
+
+	memset(pUnit, 0, m_Units.Get_Value_Size());
+	memcpy(_Get_Key(pUnit), Key, m_nKey * sizeof(int));
+
+	return( pUnit );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Zonal_Statistics::_Add_Cell(int x, int y, int *Key)
+{
+	Key[0]	= m_pZones->asInt(x, y);
+
+	for(int iCategory=1; iCategory<m_nKey; iCategory++)
+	{
+		CSG_Grid	*pGrid	= m_pCategories[iCategory - 1];
+
+		Key[iCategory]	= pGrid->is_NoData(x, y) ? (int)pGrid->Get_NoData_Value() : pGrid->asInt(x, y);
+	}
+
+	char	*pUnit	= _Find(Key);
+
+	if( !pUnit )
+	{
+		return( false );
+	}
+
+	(*((sLong *)pUnit))++;
+
+	//-----------------------------------------------------
+	TSG_Zonal_Value	*pValue	= _Get_Values(pUnit);
+
+	for(int iValue=0; iValue<m_nValues; iValue++, pValue++)
+	{
+		if( m_pValues[iValue]->is_NoData(x, y) )
+		{
+			m_NoData[iValue]++;
+		}
+		else
+		{
+			double	z	= m_pValues[iValue]->asDouble(x, y);
+
+			if( pValue->n < 1 )
+			{
+				pValue->Min	= pValue->Max	= z;
+			}
+			else if( pValue->Min > z )
+			{
+				pValue->Min	= z;
+			}
+			else if( pValue->Max < z )
+			{
+				pValue->Max	= z;
+			}
+
+			pValue->n		++;
+			pValue->Sum		+= z;
+			pValue->Sum2	+= z*z;
+
+			if( m_bCircular[iValue] )
+			{
+				pValue->Sum_Sin	+= sin(z);
+				pValue->Sum_Cos	+= cos(z);
+			}
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Zonal_Statistics::_Merge(const CSG_Grid_Zonal_Statistics &Partial)
+{
+	for(int iValue=0; iValue<m_nValues; iValue++)
+	{
+		m_NoData[iValue]	+= Partial.m_NoData[iValue];
+	}
+
+	for(int iUnit=0; iUnit<Partial.Get_Count(); iUnit++)
+	{
+		char	*pPartial	= (char *)Partial.m_Units.Get_Entry(iUnit);
+		char	*pUnit		= _Find(Partial._Get_Key(pPartial));
+
+		if( !pUnit )
+		{
+			return( false );
+		}
+
+		*((sLong *)pUnit)	+= *((sLong *)pPartial);
+
+		TSG_Zonal_Value	*pValue	= _Get_Values(pUnit), *pAdd = Partial._Get_Values(pPartial);
+
+		for(int iValue=0; iValue<m_nValues; iValue++, pValue++, pAdd++)
+		{
+			if( pAdd->n > 0 )
+			{
+				if( pValue->n < 1 )
+				{
+					*pValue	= *pAdd;
+				}
+				else
+				{
+					if( pValue->Min > pAdd->Min )	pValue->Min	= pAdd->Min;
+					if( pValue->Max < pAdd->Max )	pValue->Max	= pAdd->Max;
+
+					pValue->n		+= pAdd->n;
+					pValue->Sum		+= pAdd->Sum;
+					pValue->Sum2	+= pAdd->Sum2;
+					pValue->Sum_Sin	+= pAdd->Sum_Sin;
+					pValue->Sum_Cos	+= pAdd->Sum_Cos;
+				}
+			}
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Zonal_Statistics::_Sort(void)
+{
+	int	i, n	= Get_Count();
+
+	SG_FREE_SAFE(m_Index);
+	SG_FREE_SAFE(m_Slots);	m_nSlots	= 0;	// the hash table is not needed any more
+
+	if( n < 1 )
+	{
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	// bottom-up merge sort of the unit keys
+
+	int	*Index	= (int *)SG_Malloc(n * sizeof(int));
+	int	*Merge	= (int *)SG_Malloc(n * sizeof(int));
+
+	for(i=0; i<n; i++)
+	{
+		Index[i]	= i;
+	}
+
+	for(int Width=1; Width<n; Width*=2)
+	{
+		for(int a=0; a<n; a+=2*Width)
+		{
+			int	m	= M_GET_MIN(a +     Width, n);
+			int	b	= M_GET_MIN(a + 2 * Width, n);
+
+			for(int i=a, j=m, k=a; k<b; k++)
+			{
+				if( i < m && (j >= b || _Compare(Index[i], Index[j]) <= 0) )
+				{
+					Merge[k]	= Index[i++];
+				}
+				else
+				{
+					Merge[k]	= Index[j++];
+				}
+			}
+		}
+
+		int	*p	= Index; Index = Merge; Merge = p;
+	}
+
+	SG_Free(Merge);
+
+	m_Index	= Index;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+int CSG_Grid_Zonal_Statistics::_Compare(int iUnit_1, int iUnit_2)	const
+{
+	int	*Key_1	= _Get_Key((char *)m_Units.Get_Entry(iUnit_1));
+	int	*Key_2	= _Get_Key((char *)m_Units.Get_Entry(iUnit_2));
+
+	for(int i=0; i<m_nKey; i++)
+	{
+		if( Key_1[i] < Key_2[i] )	return( -1 );
+		if( Key_1[i] > Key_2[i] )	return(  1 );
+	}
+
+	return( 0 );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+double CSG_Grid_Zonal_Statistics::Get_Mean(int iUnit, int iValue)	const
+{
+	const TSG_Zonal_Value	&Value	= Get_Value(iUnit, iValue);
+
+	return( Value.n > 0 ? Value.Sum / Value.n : 0.0 );
+}
+
+//---------------------------------------------------------
+double CSG_Grid_Zonal_Statistics::Get_Variance(int iUnit, int iValue)	const
+{
+	const TSG_Zonal_Value	&Value	= Get_Value(iUnit, iValue);
+
+	if( Value.n > 1 )
+	{
+		double	Variance	= (Value.Sum2 - Value.Sum * Value.Sum / Value.n) / (Value.n - 1.0);
+
+		return( Variance > 0.0 ? Variance : 0.0 );
+	}
+
+	return( 0.0 );
+}
+
+//---------------------------------------------------------
+double CSG_Grid_Zonal_Statistics::Get_Circular_Mean(int iUnit, int iValue)	const
+{
+	const TSG_Zonal_Value	&Value	= Get_Value(iUnit, iValue);
+
+	double	Mean	= atan2(Value.Sum_Sin, Value.Sum_Cos);
+
+	return( Mean < 0.0 ? Mean + M_PI_360 : Mean );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
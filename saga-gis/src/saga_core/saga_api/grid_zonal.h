@@ -0,0 +1,181 @@
+/**********************************************************
+ * Version $Id$
+ *********************************************************/
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                   Library: SAGA_API                   //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                     grid_zonal.h                      //
+//                                                       //
+//                 Copyright (C) 2014 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, version 2.1 of the License.      //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, write to the Free Software Foundation, Inc.,     //
+// 51 Franklin Street, 5th Floor, Boston, MA 02110-1301, //
+// USA.                                                  //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                Institute of Geography                 //
+//                University of Hamburg                  //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#ifndef HEADER_INCLUDED__SAGA_API__grid_zonal_H
+#define HEADER_INCLUDED__SAGA_API__grid_zonal_H
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "grid.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+typedef struct SSG_Zonal_Value
+{
+	sLong						n;
+
+	double						Min, Max, Sum, Sum2, Sum_Sin, Sum_Cos;
+}
+TSG_Zonal_Value;
+
+//---------------------------------------------------------
+/**
+  * CSG_Grid_Zonal_Statistics aggregates the cells of a zone grid
+  * and any number of categorical grids into unique condition units
+  * (UCUs), i.e. unique combinations of zone and category values,
+  * and collects cell counts and descriptive statistics of any number
+  * of value grids for each unit. Units are found in an open
+  * addressing hash table. Rows are processed in one parallel pass,
+  * each thread collecting its own partial table, which are merged
+  * afterwards. Units are finally sorted by zone and categories.
+  * Zone and category values are taken as integers. No-data cells
+  * of value grids are skipped and counted.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Grid_Zonal_Statistics
+{
+public:
+	CSG_Grid_Zonal_Statistics(void);
+	virtual ~CSG_Grid_Zonal_Statistics(void);
+
+	bool						Create				(CSG_Grid *pZones);
+	bool						Destroy				(void);
+
+	bool						Add_Category		(CSG_Grid *pGrid);
+
+	/// For circular values (e.g. aspect, in radians) sine and cosine sums are collected, too.
+	bool						Add_Value			(CSG_Grid *pGrid, bool bCircular = false);
+
+	bool						Execute				(void);
+
+	int							Get_Category_Count	(void)	const	{	return( m_nKey - 1 );		}
+	int							Get_Value_Count		(void)	const	{	return( m_nValues );		}
+
+	/// Number of unique condition units, sorted by zone and categories after Execute().
+	int							Get_Count			(void)	const	{	return( (int)m_Units.Get_Size() );	}
+
+	int							Get_Zone			(int iUnit)					const	{	return( _Get_Key(_Get_Unit(iUnit))[0] );			}
+	int							Get_Category		(int iUnit, int iCategory)	const	{	return( _Get_Key(_Get_Unit(iUnit))[1 + iCategory] );	}
+	sLong						Get_Cells			(int iUnit)					const	{	return( *((sLong *)_Get_Unit(iUnit)) );			}
+
+	const TSG_Zonal_Value &		Get_Value			(int iUnit, int iValue)		const	{	return( _Get_Values(_Get_Unit(iUnit))[iValue] );	}
+
+	double						Get_Mean			(int iUnit, int iValue)		const;
+	double						Get_Variance		(int iUnit, int iValue)		const;	///< sample variance
+	double						Get_StdDev			(int iUnit, int iValue)		const	{	return( sqrt(Get_Variance(iUnit, iValue)) );	}
+	double						Get_Circular_Mean	(int iUnit, int iValue)		const;	///< 0 to 2 Pi
+
+	/// Number of no-data cells found in a value grid.
+	sLong						Get_NoData			(int iValue)	const	{	return( iValue >= 0 && iValue < m_nValues ? m_NoData[iValue] : 0 );	}
+
+
+private:
+
+	int							m_nKey, m_nValues, m_nSlots, *m_Slots, *m_Index, m_Key_Offset, m_Value_Offset;
+
+	sLong						*m_NoData;
+
+	CSG_Array					m_Units;
+
+	CSG_Grid					*m_pZones, **m_pCategories, **m_pValues;
+
+	bool						*m_bCircular;
+
+
+	void						_Set_Layout			(const CSG_Grid_Zonal_Statistics &Layout);
+
+	char *						_Get_Unit			(int iUnit)	const	{	return( (char *)m_Units.Get_Entry(m_Index ? m_Index[iUnit] : iUnit) );	}
+	int *						_Get_Key			(char *pUnit)	const	{	return( (int             *)(pUnit + m_Key_Offset  ) );	}
+	TSG_Zonal_Value *			_Get_Values			(char *pUnit)	const	{	return( (TSG_Zonal_Value *)(pUnit + m_Value_Offset) );	}
+
+	char *						_Find				(const int *Key);
+	bool						_Add_Cell			(int x, int y, int *Key);
+	bool						_Merge				(const CSG_Grid_Zonal_Statistics &Partial);
+	bool						_Sort				(void);
+	int							_Compare			(int iUnit_1, int iUnit_2)	const;
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#endif // #ifndef HEADER_INCLUDED__SAGA_API__grid_zonal_H
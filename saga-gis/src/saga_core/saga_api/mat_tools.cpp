@@ -715,7 +715,13 @@ bool CSG_Cluster_Analysis::Set_Feature(int iElement, int iFeature, double Value)
 }
 
 //---------------------------------------------------------
-bool CSG_Cluster_Analysis::Execute(int Method, int nClusters, int nMaxIterations)
+bool CSG_Cluster_Analysis::Set_nElements(int nElements)
+{
+	return( m_nFeatures > 0 && nElements >= 0 && m_Features.Set_Array(nElements) );
+}
+
+//---------------------------------------------------------
+bool CSG_Cluster_Analysis::Execute(int Method, int nClusters, int nMaxIterations, int Batch_Size)
 {
 	if( Get_nElements() <= 1 || nClusters <= 1 )
 	{
@@ -748,6 +754,10 @@ bool CSG_Cluster_Analysis::Execute(int Method, int nClusters, int nMaxIterations
 	case  1:	bResult	= Hill_Climbing   (true , nMaxIterations);	break;
 	case  2:	bResult	= Minimum_Distance(true , nMaxIterations)
 					   && Hill_Climbing   (false, nMaxIterations);	break;
+	case  3:	bResult	= _Set_Seeds(Get_nElements())
+					   && _Set_Clusters() >= 0
+					   && Minimum_Distance(false, nMaxIterations);	break;
+	case  4:	bResult	= Mini_Batch      (nMaxIterations, Batch_Size);	break;
 	}
 
 	if( bResult )
@@ -761,11 +771,17 @@ bool CSG_Cluster_Analysis::Execute(int Method, int nClusters, int nMaxIterations
 	return( bResult );
 }
 
+//---------------------------------------------------------
+// Iterative minimum distance (Forgy, k-means) using Hamerly's
+// bounds: for each element an upper bound of the distance to its
+// own and a lower bound of the distance to the second closest
+// centroid are kept and updated by the centroid shifts, so that
+// most distances need not be calculated once the clustering
+// starts to settle. Elements are assigned in parallel.
 //---------------------------------------------------------
 bool CSG_Cluster_Analysis::Minimum_Distance(bool bInitialize, int nMaxIterations)
 {
-	int		iElement, iFeature, iCluster, nShifts;
-	double	*Feature, SP_Last	= -1.0;
+	int		iElement, iCluster, jCluster, iFeature;
 
 	//-----------------------------------------------------
 	for(iElement=0; iElement<Get_nElements(); iElement++)
@@ -779,92 +795,131 @@ bool CSG_Cluster_Analysis::Minimum_Distance(bool bInitialize, int nMaxIterations
 	}
 
 	//-----------------------------------------------------
+	double	*Upper	= (double *)SG_Malloc(Get_nElements() * sizeof(double));
+	double	*Lower	= (double *)SG_Malloc(Get_nElements() * sizeof(double));
+	double	*Shift	= (double *)SG_Malloc(m_nClusters     * sizeof(double));
+	double	*Half	= (double *)SG_Malloc(m_nClusters     * sizeof(double));
+	double	*Last	= (double *)SG_Malloc(m_nClusters * m_nFeatures * sizeof(double));
+
 	for(m_Iteration=1; SG_UI_Process_Get_Okay(); m_Iteration++)
 	{
 		for(iCluster=0; iCluster<m_nClusters; iCluster++)
 		{
-			m_Variance[iCluster]	= 0.0;
-			m_nMembers[iCluster]	= 0;
+			memcpy(Last + iCluster * m_nFeatures, m_Centroid[iCluster], m_nFeatures * sizeof(double));
+		}
+
+		_Set_Centroids();
+
+		//-------------------------------------------------
+		int		iMax	= 0;
+		double	Max_1	= 0.0, Max_2 = 0.0;	// largest and second largest centroid shift
+
+		for(iCluster=0; iCluster<m_nClusters; iCluster++)
+		{
+			double	d	= 0.0;
 
 			for(iFeature=0; iFeature<m_nFeatures; iFeature++)
 			{
-				m_Centroid[iCluster][iFeature]	= 0.0;
+				d	+= SG_Get_Square(m_Centroid[iCluster][iFeature] - Last[iCluster * m_nFeatures + iFeature]);
+			}
+
+			if( (Shift[iCluster] = sqrt(d)) > Max_1 )
+			{
+				Max_2	= Max_1;
+				Max_1	= Shift[iCluster];
+				iMax	= iCluster;
 			}
+			else if( Shift[iCluster] > Max_2 )
+			{
+				Max_2	= Shift[iCluster];
+			}
+
+			Half[iCluster]	= -1.0;
 		}
 
-		//-------------------------------------------------
-		for(iElement=0, Feature=(double *)m_Features.Get_Array(); iElement<Get_nElements(); iElement++, Feature+=m_nFeatures)
+		for(iCluster=0; iCluster<m_nClusters; iCluster++)	// half the distance to the closest other centroid
 		{
-			if( (iCluster = m_Cluster[iElement]) >= 0 )
+			for(jCluster=iCluster+1; jCluster<m_nClusters; jCluster++)
 			{
-				m_nMembers[iCluster]++;
+				double	d	= 0.0;
 
 				for(iFeature=0; iFeature<m_nFeatures; iFeature++)
 				{
-					m_Centroid[iCluster][iFeature]	+= Feature[iFeature];
+					d	+= SG_Get_Square(m_Centroid[iCluster][iFeature] - m_Centroid[jCluster][iFeature]);
 				}
-			}
-		}
 
-		//-------------------------------------------------
-		for(iCluster=0; iCluster<m_nClusters; iCluster++)
-		{
-			double	d	= m_nMembers[iCluster] > 0 ? 1.0 / m_nMembers[iCluster] : 0.0;
+				d	= 0.5 * sqrt(d);
 
-			for(iFeature=0; iFeature<m_nFeatures; iFeature++)
-			{
-				m_Centroid[iCluster][iFeature]	*= d;
+				if( Half[iCluster] < 0.0 || Half[iCluster] > d )	Half[iCluster]	= d;
+				if( Half[jCluster] < 0.0 || Half[jCluster] > d )	Half[jCluster]	= d;
 			}
 		}
 
 		//-------------------------------------------------
-		for(iElement=0, Feature=(double *)m_Features.Get_Array(), m_SP=0.0, nShifts=0; iElement<Get_nElements(); iElement++, Feature+=m_nFeatures)
+		int	nShifts	= 0;
+
+		#pragma omp parallel for reduction(+:nShifts)
+		for(int iElement=0; iElement<Get_nElements(); iElement++)
 		{
-			double	minVariance	= -1.0;
-			int		minCluster	= -1;
+			double	*Feature	= (double *)m_Features.Get_Entry(iElement);
+			int		iCluster	= m_Cluster[iElement];
 
-			for(iCluster=0; iCluster<m_nClusters; iCluster++)
+			if( m_Iteration > 1 )
 			{
-				double	iVariance	= 0.0;
+				Upper[iElement]	+= Shift[iCluster];
+				Lower[iElement]	-= iCluster == iMax ? Max_2 : Max_1;
 
-				for(iFeature=0; iFeature<m_nFeatures; iFeature++)
+				double	Bound	= Half[iCluster] > Lower[iElement] ? Half[iCluster] : Lower[iElement];
+
+				if( Upper[iElement] <= Bound )
+				{
+					continue;
+				}
+
+				double	d	= 0.0;
+
+				for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
 				{
-					iVariance	+= SG_Get_Square(m_Centroid[iCluster][iFeature] - Feature[iFeature]);
+					d	+= SG_Get_Square(m_Centroid[iCluster][iFeature] - Feature[iFeature]);
 				}
 
-				if( minVariance < 0.0 || iVariance < minVariance )
+				if( (Upper[iElement] = sqrt(d)) <= Bound )
 				{
-					minVariance	= iVariance;
-					minCluster	= iCluster;
+					continue;
 				}
 			}
 
-			if( m_Cluster[iElement] != minCluster )
+			int	minCluster	= _Get_Nearest(Feature, Upper[iElement], Lower[iElement]);
+
+			if( iCluster != minCluster )
 			{
 				m_Cluster[iElement]	= minCluster;
+
 				nShifts++;
 			}
-
-			m_SP					+= minVariance;
-			m_Variance[minCluster]	+= minVariance;
 		}
 
 		//-------------------------------------------------
-		m_SP	/= Get_nElements();
-
-		SG_UI_Process_Set_Text(CSG_String::Format(SG_T("%s: %d >> %s %f"),
+		SG_UI_Process_Set_Text(CSG_String::Format(SG_T("%s: %d >> %s %d"),
 			_TL("pass")		, m_Iteration,
-			_TL("change")	, m_Iteration <= 1 ? m_SP : SP_Last - m_SP
+			_TL("changes")	, nShifts
 		));
 
-		SP_Last	 = m_SP;
-
 		if( nShifts == 0 || (nMaxIterations > 0 && nMaxIterations <= m_Iteration) )
 		{
 			break;
 		}
 	}
 
+	SG_Free(Upper);
+	SG_Free(Lower);
+	SG_Free(Shift);
+	SG_Free(Half );
+	SG_Free(Last );
+
+	//-----------------------------------------------------
+	_Set_Variances();
+
 	return( true );
 }
 
@@ -1010,6 +1065,378 @@ bool CSG_Cluster_Analysis::Hill_Climbing(bool bInitialize, int nMaxIterations)
 	return( true );
 }
 
+//---------------------------------------------------------
+// Mini-batch k-means (Sculley 2010): centroids are moved towards
+// the members of small random samples with a learning rate that
+// decreases with the number of members a centroid has seen.
+// Only the final assignment visits all elements.
+//---------------------------------------------------------
+// Simple xorshift generator, keeps seeding and sampling
+// reproducible and independent of the global rand() state.
+//---------------------------------------------------------
+static double	SG_Cluster_Get_Random(unsigned int &Random)
+{
+	Random	^= Random << 13;
+	Random	^= Random >> 17;
+	Random	^= Random <<  5;
+
+	return( Random / 4294967296.0 );
+}
+
+//---------------------------------------------------------
+bool CSG_Cluster_Analysis::Mini_Batch(int nMaxIterations, int Batch_Size)
+{
+	if( Batch_Size <= 0 )
+	{
+		Batch_Size	= 256 * m_nClusters;
+	}
+
+	if( Batch_Size > Get_nElements() )
+	{
+		Batch_Size	= Get_nElements();
+	}
+
+	if( nMaxIterations <= 0 )
+	{
+		nMaxIterations	= 100;
+	}
+
+	if( !_Set_Seeds(4 * Batch_Size) )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	int		*Batch		= (int   *)SG_Malloc(Batch_Size  * sizeof(int  ));
+	int		*Nearest	= (int   *)SG_Malloc(Batch_Size  * sizeof(int  ));
+	sLong	*nSeen		= (sLong *)SG_Calloc(m_nClusters , sizeof(sLong));
+
+	unsigned int	Random	= 2463534242u;
+
+	for(m_Iteration=1; m_Iteration<=nMaxIterations && SG_UI_Process_Get_Okay(); m_Iteration++)
+	{
+		int		i;
+
+		for(i=0; i<Batch_Size; i++)
+		{
+			Batch[i]	= (int)(SG_Cluster_Get_Random(Random) * Get_nElements());
+		}
+
+		#pragma omp parallel for
+		for(i=0; i<Batch_Size; i++)
+		{
+			double	d1, d2;
+
+			Nearest[i]	= _Get_Nearest((double *)m_Features.Get_Entry(Batch[i]), d1, d2);
+		}
+
+		double	Shift	= 0.0;
+
+		for(i=0; i<Batch_Size; i++)
+		{
+			double	*Feature	= (double *)m_Features.Get_Entry(Batch[i]);
+			double	*Centroid	= m_Centroid[Nearest[i]];
+			double	Rate		= 1.0 / ++nSeen[Nearest[i]];
+
+			for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
+			{
+				double	d	= Rate * (Feature[iFeature] - Centroid[iFeature]);
+
+				Centroid[iFeature]	+= d;
+				Shift				+= d*d;
+			}
+		}
+
+		SG_UI_Process_Set_Text(CSG_String::Format(SG_T("%s: %d >> %s %f"),
+			_TL("batch")	, m_Iteration,
+			_TL("change")	, sqrt(Shift)
+		));
+	}
+
+	SG_Free(Batch  );
+	SG_Free(Nearest);
+	SG_Free(nSeen  );
+
+	//-----------------------------------------------------
+	_Set_Clusters();
+
+	_Set_Variances();
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// k-means++ seeding (Arthur & Vassilvitskii 2007): the first
+// centroid is a random element, each further one is drawn with
+// a probability proportional to the squared distance to the
+// closest centroid chosen so far. For large data sets the seeds
+// are taken from a random sample of nSamples elements.
+//---------------------------------------------------------
+bool CSG_Cluster_Analysis::_Set_Seeds(int nSamples)
+{
+	int		i, iCluster;
+
+	if( nSamples > Get_nElements() )
+	{
+		nSamples	= Get_nElements();
+	}
+
+	if( nSamples < 1 )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	int		*Sample		= (int    *)SG_Malloc(nSamples * sizeof(int   ));
+	double	*Distance	= (double *)SG_Malloc(nSamples * sizeof(double));
+
+	unsigned int	Random	= 88172645u;
+
+	for(i=0; i<nSamples; i++)
+	{
+		Sample[i]	= nSamples < Get_nElements() ? (int)(SG_Cluster_Get_Random(Random) * Get_nElements()) : i;
+	}
+
+	for(iCluster=0; iCluster<m_nClusters; iCluster++)
+	{
+		double	Sum	= 0.0;
+
+		for(i=0; iCluster>0 && i<nSamples; i++)
+		{
+			Sum	+= Distance[i];
+		}
+
+		//-------------------------------------------------
+		int	iSample	= (int)(SG_Cluster_Get_Random(Random) * nSamples);
+
+		if( Sum > 0.0 )
+		{
+			double	Position	= SG_Cluster_Get_Random(Random) * Sum;
+
+			for(iSample=0; iSample<nSamples-1 && (Position -= Distance[iSample]) > 0.0; iSample++)	{}
+		}
+
+		memcpy(m_Centroid[iCluster], m_Features.Get_Entry(Sample[iSample]), m_nFeatures * sizeof(double));
+
+		//-------------------------------------------------
+		double	*Centroid	= m_Centroid[iCluster];
+
+		#pragma omp parallel for
+		for(i=0; i<nSamples; i++)
+		{
+			double	d	= 0.0, *Feature	= (double *)m_Features.Get_Entry(Sample[i]);
+
+			for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
+			{
+				d	+= SG_Get_Square(Centroid[iFeature] - Feature[iFeature]);
+			}
+
+			if( iCluster == 0 || Distance[i] > d )
+			{
+				Distance[i]	= d;
+			}
+		}
+	}
+
+	SG_Free(Sample  );
+	SG_Free(Distance);
+
+	return( true );
+}
+
+//---------------------------------------------------------
+// Centroids as means of the current cluster members. Elements
+// are summed in blocks, one per thread, that are merged in a
+// fixed order to keep results independent of the scheduling.
+//---------------------------------------------------------
+void CSG_Cluster_Analysis::_Set_Centroids(void)
+{
+	int	iCluster, iFeature, nBlocks	= M_GET_MIN(SG_Get_Max_Num_Threads_Omp(), Get_nElements());
+
+	double	*Sums	= (double *)SG_Calloc(nBlocks * m_nClusters * m_nFeatures, sizeof(double));
+	int		*nSums	= (int    *)SG_Calloc(nBlocks * m_nClusters              , sizeof(int   ));
+
+	#pragma omp parallel for
+	for(int iBlock=0; iBlock<nBlocks; iBlock++)
+	{
+		int	a	= (int)(((sLong)Get_nElements() *  iBlock     ) / nBlocks);
+		int	b	= (int)(((sLong)Get_nElements() * (iBlock + 1)) / nBlocks);
+
+		for(int iElement=a; iElement<b; iElement++)
+		{
+			int	iCluster	= m_Cluster[iElement];
+
+			if( iCluster >= 0 )
+			{
+				double	*Sum		= Sums + (iBlock * m_nClusters + iCluster) * m_nFeatures;
+				double	*Feature	= (double *)m_Features.Get_Entry(iElement);
+
+				nSums[iBlock * m_nClusters + iCluster]++;
+
+				for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
+				{
+					Sum[iFeature]	+= Feature[iFeature];
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	for(iCluster=0; iCluster<m_nClusters; iCluster++)
+	{
+		m_nMembers[iCluster]	= 0;
+
+		memset(m_Centroid[iCluster], 0, m_nFeatures * sizeof(double));
+
+		for(int iBlock=0; iBlock<nBlocks; iBlock++)
+		{
+			double	*Sum	= Sums + (iBlock * m_nClusters + iCluster) * m_nFeatures;
+
+			m_nMembers[iCluster]	+= nSums[iBlock * m_nClusters + iCluster];
+
+			for(iFeature=0; iFeature<m_nFeatures; iFeature++)
+			{
+				m_Centroid[iCluster][iFeature]	+= Sum[iFeature];
+			}
+		}
+
+		double	d	= m_nMembers[iCluster] > 0 ? 1.0 / m_nMembers[iCluster] : 0.0;
+
+		for(iFeature=0; iFeature<m_nFeatures; iFeature++)
+		{
+			m_Centroid[iCluster][iFeature]	*= d;
+		}
+	}
+
+	SG_Free(Sums );
+	SG_Free(nSums);
+}
+
+//---------------------------------------------------------
+// Assigns each element to its closest centroid, returns the number of changes.
+//---------------------------------------------------------
+int CSG_Cluster_Analysis::_Set_Clusters(void)
+{
+	int	nShifts	= 0;
+
+	#pragma omp parallel for reduction(+:nShifts)
+	for(int iElement=0; iElement<Get_nElements(); iElement++)
+	{
+		double	d1, d2;
+
+		int	iCluster	= _Get_Nearest((double *)m_Features.Get_Entry(iElement), d1, d2);
+
+		if( m_Cluster[iElement] != iCluster )
+		{
+			m_Cluster[iElement]	= iCluster;
+
+			nShifts++;
+		}
+	}
+
+	return( nShifts );
+}
+
+//---------------------------------------------------------
+// Members, summed squared distances to the centroids (divided
+// by the number of members in Execute()) and their overall mean.
+//---------------------------------------------------------
+void CSG_Cluster_Analysis::_Set_Variances(void)
+{
+	int	iCluster, nBlocks	= M_GET_MIN(SG_Get_Max_Num_Threads_Omp(), Get_nElements());
+
+	double	*Sums	= (double *)SG_Calloc(nBlocks * m_nClusters, sizeof(double));
+	int		*nSums	= (int    *)SG_Calloc(nBlocks * m_nClusters, sizeof(int   ));
+
+	#pragma omp parallel for
+	for(int iBlock=0; iBlock<nBlocks; iBlock++)
+	{
+		int	a	= (int)(((sLong)Get_nElements() *  iBlock     ) / nBlocks);
+		int	b	= (int)(((sLong)Get_nElements() * (iBlock + 1)) / nBlocks);
+
+		for(int iElement=a; iElement<b; iElement++)
+		{
+			int	iCluster	= m_Cluster[iElement];
+
+			if( iCluster >= 0 )
+			{
+				double	d	= 0.0, *Feature	= (double *)m_Features.Get_Entry(iElement);
+
+				for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
+				{
+					d	+= SG_Get_Square(m_Centroid[iCluster][iFeature] - Feature[iFeature]);
+				}
+
+				Sums [iBlock * m_nClusters + iCluster]	+= d;
+				nSums[iBlock * m_nClusters + iCluster]	++;
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	for(iCluster=0, m_SP=0.0; iCluster<m_nClusters; iCluster++)
+	{
+		m_Variance[iCluster]	= 0.0;
+		m_nMembers[iCluster]	= 0;
+
+		for(int iBlock=0; iBlock<nBlocks; iBlock++)
+		{
+			m_Variance[iCluster]	+= Sums [iBlock * m_nClusters + iCluster];
+			m_nMembers[iCluster]	+= nSums[iBlock * m_nClusters + iCluster];
+		}
+
+		m_SP	+= m_Variance[iCluster];
+	}
+
+	m_SP	/= Get_nElements();
+
+	SG_Free(Sums );
+	SG_Free(nSums);
+}
+
+//---------------------------------------------------------
+// Returns the closest centroid, its distance and the distance
+// to the second closest centroid (not squared).
+//---------------------------------------------------------
+int CSG_Cluster_Analysis::_Get_Nearest(const double *Feature, double &Distance, double &Distance_2)	const
+{
+	int		minCluster	= -1;
+	double	min_1 = -1.0, min_2 = -1.0;
+
+	for(int iCluster=0; iCluster<m_nClusters; iCluster++)
+	{
+		double	d	= 0.0, *Centroid	= m_Centroid[iCluster];
+
+		for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
+		{
+			d	+= SG_Get_Square(Centroid[iFeature] - Feature[iFeature]);
+		}
+
+		if( minCluster < 0 || d < min_1 )
+		{
+			min_2		= min_1;
+			min_1		= d;
+			minCluster	= iCluster;
+		}
+		else if( min_2 < 0.0 || d < min_2 )
+		{
+			min_2		= d;
+		}
+	}
+
+	Distance	= sqrt(min_1);
+	Distance_2	= min_2 < 0.0 ? Distance : sqrt(min_2);
+
+	return( minCluster );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
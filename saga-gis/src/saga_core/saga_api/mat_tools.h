@@ -695,7 +695,9 @@ enum ESG_Cluster_Analysis_Method
 {
 	SG_CLUSTERANALYSIS_Minimum_Distance	= 0,
 	SG_CLUSTERANALYSIS_Hill_Climbing,
-	SG_CLUSTERANALYSIS_Combined
+	SG_CLUSTERANALYSIS_Combined,
+	SG_CLUSTERANALYSIS_KMeans,
+	SG_CLUSTERANALYSIS_MiniBatch
 };
 
 //---------------------------------------------------------
@@ -711,9 +713,13 @@ public:
 	bool					Add_Element			(void);
 	bool					Set_Feature			(int iElement, int iFeature, double Value);
 
+	/// Allocates all elements at once, e.g. to set the features of many elements in parallel.
+	bool					Set_nElements		(int nElements);
+
 	int						Get_Cluster			(int iElement)	const	{	return( iElement >= 0 && iElement < Get_nElements() ? m_Cluster[iElement] : -1 );	}
 
-	bool					Execute				(int Method, int nClusters, int nMaxIterations = 0);
+	/// Batch_Size is only used by the mini-batch method and is chosen automatically if zero.
+	bool					Execute				(int Method, int nClusters, int nMaxIterations = 0, int Batch_Size = 0);
 
 	int						Get_nElements		(void)	const	{	return( (int)m_Features.Get_Size() );	}
 	int						Get_nFeatures		(void)	const	{	return( m_nFeatures );	}
@@ -739,6 +745,14 @@ private:
 
 	bool					Minimum_Distance	(bool bInitialize, int nMaxIterations);
 	bool					Hill_Climbing		(bool bInitialize, int nMaxIterations);
+	bool					Mini_Batch			(int nMaxIterations, int Batch_Size);
+
+	bool					_Set_Seeds			(int nSamples);
+	void					_Set_Centroids		(void);
+	int						_Set_Clusters		(void);
+	void					_Set_Variances		(void);
+
+	int						_Get_Nearest		(const double *Feature, double &Distance, double &Distance_2)	const;
 
 };
 
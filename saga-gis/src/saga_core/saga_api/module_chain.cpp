@@ -61,6 +61,8 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+#include <wx/utils.h>
+
 #include "saga_api.h"
 
 #include "module_chain.h"
@@ -297,10 +299,11 @@ bool CSG_Module_Chain::On_Execute(void)
 	{
 		Error_Set(_TL("no data objects"));
 	}
-
-	for(int i=0; bResult && i<m_Chain["tools"].Get_Children_Count(); i++)
+	else	// independent tools might run concurrently, if requested by the chain and not executed from gui
 	{
-		bResult	= Tool_Run(m_Chain["tools"][i]);
+		bResult	= Tools_Run(IS_TRUE_PROPERTY(m_Chain["tools"], "parallel")
+			&& SG_UI_Get_Window_Main() == NULL && SG_Get_Max_Num_Threads_Omp() > 1
+		);
 	}
 
 	Data_Finalize();
@@ -384,6 +387,51 @@ bool CSG_Module_Chain::Data_Exists(CSG_Data_Object *pData)
 	return( false );
 }
 
+//---------------------------------------------------------
+bool CSG_Module_Chain::Data_Free(const CSG_String &ID)
+{
+	CSG_Parameter	*pData	= m_Data(ID);
+
+	if( !pData || Parameters(ID) )	// never free the tool chain's own data
+	{
+		return( false );
+	}
+
+	CSG_Array	Objects(sizeof(CSG_Data_Object *));
+
+	if( pData->is_DataObject() && pData->asDataObject() )
+	{
+		if( Objects.Inc_Array() )
+		{
+			((CSG_Data_Object **)Objects.Get_Array())[0]	= pData->asDataObject();
+		}
+	}
+	else if( pData->is_DataObject_List() )
+	{
+		for(int i=0; i<pData->asList()->Get_Count(); i++)
+		{
+			if( Objects.Inc_Array() )
+			{
+				((CSG_Data_Object **)Objects.Get_Array())[Objects.Get_Size() - 1]	= pData->asList()->asDataObject(i);
+			}
+		}
+	}
+
+	m_Data.Del_Parameter(ID);
+
+	for(size_t i=0; i<Objects.Get_Size(); i++)
+	{
+		CSG_Data_Object	*pObject	= ((CSG_Data_Object **)Objects.Get_Array())[i];
+
+		if( !Data_Exists(pObject) )	// might still be referenced by another variable
+		{
+			m_Data_Manager.Delete(pObject);
+		}
+	}
+
+	return( true );
+}
+
 //---------------------------------------------------------
 bool CSG_Module_Chain::Data_Initialize(void)
 {
@@ -592,13 +640,271 @@ bool CSG_Module_Chain::Check_Condition(const CSG_MetaData &Condition, CSG_Parame
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+static bool	SG_Strings_Contain(const CSG_Strings &Strings, const CSG_String &String)
+{
+	for(int i=0; i<Strings.Get_Count(); i++)
+	{
+		if( !Strings[i].Cmp(String) )
+		{
+			return( true );
+		}
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+static bool	SG_Strings_Intersect(const CSG_Strings &A, const CSG_Strings &B)
+{
+	for(int i=0; i<A.Get_Count(); i++)
+	{
+		if( SG_Strings_Contain(B, A[i]) )
+		{
+			return( true );
+		}
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+static void	SG_Strings_Add_Unique(CSG_Strings &Strings, const CSG_String &String)
+{
+	if( !String.is_Empty() && !SG_Strings_Contain(Strings, String) )
+	{
+		Strings	+= String;
+	}
+}
+
+//---------------------------------------------------------
+/**
+  * Collects the data variables read (input) and written (output)
+  * by a tool or by all tools of a condition block, as well as the
+  * tool instances involved, which can not be shared by concurrent
+  * steps.
+*/
+//---------------------------------------------------------
+bool CSG_Module_Chain::Tools_Get_Variables(const CSG_MetaData &Tool, CSG_Strings &Input, CSG_Strings &Output, CSG_Strings &Modules)
+{
+	if( Tool.Cmp_Name("condition") )
+	{
+		CSG_String	Type;
+
+		if( Tool.Get_Property("type", Type) && (!Type.CmpNoCase("exists") || !Type.CmpNoCase("not_exists")) )
+		{
+			SG_Strings_Add_Unique(Input, Tool.Get_Property("variable") ? CSG_String(Tool.Get_Property("variable")) : Tool.Get_Content());
+		}
+
+		for(int i=0; i<Tool.Get_Children_Count(); i++)
+		{
+			Tools_Get_Variables(Tool[i], Input, Output, Modules);
+		}
+	}
+	else if( Tool.Cmp_Name("tool") )
+	{
+		SG_Strings_Add_Unique(Modules, CSG_String(Tool.Get_Property("library")) + "|" + Tool.Get_Property("module"));
+
+		for(int i=0; i<Tool.Get_Children_Count(); i++)
+		{
+			if( Tool[i].Cmp_Name("input" ) )	{	SG_Strings_Add_Unique(Input , Tool[i].Get_Content());	}
+			if( Tool[i].Cmp_Name("output") )	{	SG_Strings_Add_Unique(Output, Tool[i].Get_Content());	}
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+static int	SG_Strings_Find(const CSG_Strings &Strings, const CSG_String &String)
+{
+	for(int i=0; i<Strings.Get_Count(); i++)
+	{
+		if( !Strings[i].Cmp(String) )
+		{
+			return( i );
+		}
+	}
+
+	return( -1 );
+}
+
+//---------------------------------------------------------
+/**
+  * Runs the tools of the chain. A step (i.e. a tool or a condition
+  * block) depends on a preceding step, if one of them writes a data
+  * variable the other one reads or writes too, or if both use the
+  * same tool. In parallel mode a step is started as soon as all
+  * steps it depends on have finished, otherwise steps are executed
+  * in the order of their definition. Intermediate data is freed as
+  * soon as all steps using it have finished.
+*/
+//---------------------------------------------------------
+bool CSG_Module_Chain::Tools_Run(bool bParallel)
+{
+	const CSG_MetaData	&Tools	= m_Chain["tools"];
+
+	int		i, j, nSteps	= Tools.Get_Children_Count();
+
+	if( nSteps < 1 )
+	{
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	CSG_Strings	*Input	= new CSG_Strings[nSteps];
+	CSG_Strings	*Output	= new CSG_Strings[nSteps];
+	CSG_Strings	*Modules	= new CSG_Strings[nSteps];
+	CSG_Strings	*Used	= new CSG_Strings[nSteps];	// all variables of a step
+	CSG_Strings	Variables;
+
+	for(i=0; i<nSteps; i++)
+	{
+		Tools_Get_Variables(Tools[i], Input[i], Output[i], Modules[i]);
+
+		for(j=0; j<Input [i].Get_Count(); j++)	{	SG_Strings_Add_Unique(Used[i], Input [i][j]);	}
+		for(j=0; j<Output[i].Get_Count(); j++)	{	SG_Strings_Add_Unique(Used[i], Output[i][j]);	}
+
+		for(j=0; j<Used[i].Get_Count(); j++)
+		{
+			SG_Strings_Add_Unique(Variables, Used[i][j]);
+		}
+	}
+
+	//-----------------------------------------------------
+	// for each variable the number of steps still using it,
+	// for each step the number of steps it still waits for
+
+	CSG_Array	Users  (sizeof(int ), Variables.Get_Count());
+	CSG_Array	Pending(sizeof(int ), nSteps);
+	CSG_Array	Depends(sizeof(char), nSteps * nSteps);
+	CSG_Array	Started(sizeof(char), nSteps);
+
+	int		*nUsers		= (int  *)Users  .Get_Array();	memset(nUsers  , 0, Variables.Get_Count() * sizeof(int));
+	int		*nPending	= (int  *)Pending.Get_Array();	memset(nPending, 0, nSteps * sizeof(int));
+	char	*bDepends	= (char *)Depends.Get_Array();
+	char	*bStarted	= (char *)Started.Get_Array();	memset(bStarted, 0, nSteps);
+
+	for(i=0; i<nSteps; i++)
+	{
+		for(j=0; j<nSteps; j++)
+		{
+			bDepends[i * nSteps + j]	= j < i && (
+				SG_Strings_Intersect(Output [j], Input  [i])	// read after write
+			||	SG_Strings_Intersect(Input  [j], Output [i])	// write after read
+			||	SG_Strings_Intersect(Output [j], Output [i])	// write after write
+			||	SG_Strings_Intersect(Modules[j], Modules[i])	// same tool instance
+			);
+
+			if( bDepends[i * nSteps + j] )
+			{
+				nPending[i]++;
+			}
+		}
+
+		for(j=0; j<Used[i].Get_Count(); j++)
+		{
+			nUsers[SG_Strings_Find(Variables, Used[i][j])]++;
+		}
+	}
+
+	//-----------------------------------------------------
+	bool	bResult	= true;
+	int		nRunning	= 0;
+
+	if( bParallel )
+	{
+		SG_UI_Progress_Lock(true);
+	}
+
+	#pragma omp parallel private(i, j) if(bParallel && nSteps > 1)
+	{
+		for(bool bWork=true; bWork; )
+		{
+			int	iStep	= -1;
+
+			#pragma omp critical (module_chain)
+			{
+				for(i=0; bResult && iStep<0 && i<nSteps; i++)	// lowest index first, i.e. definition order if not parallel
+				{
+					if( !bStarted[i] && nPending[i] == 0 )
+					{
+						bStarted[iStep = i]	= 1;	nRunning++;
+					}
+				}
+
+				bWork	= iStep >= 0 || nRunning > 0;
+			}
+
+			if( iStep < 0 )
+			{
+				if( bWork )	// wait for a running step to release its dependents
+				{
+					wxMilliSleep(10);
+				}
+
+				continue;
+			}
+
+			//---------------------------------------------
+			bool	bOkay	= Tool_Run(Tools[iStep]);
+
+			#pragma omp critical (module_chain)
+			{
+				for(j=0; j<Used[iStep].Get_Count(); j++)
+				{
+					if( --nUsers[SG_Strings_Find(Variables, Used[iStep][j])] == 0 )
+					{
+						Data_Free(Used[iStep][j]);	// does not free the tool chain's own data
+					}
+				}
+
+				for(j=iStep+1; j<nSteps; j++)
+				{
+					if( bDepends[j * nSteps + iStep] )
+					{
+						nPending[j]--;
+					}
+				}
+
+				if( !bOkay )
+				{
+					bResult	= false;
+				}
+
+				nRunning--;
+			}
+		}
+	}
+
+	if( bParallel )
+	{
+		SG_UI_Progress_Lock(false);
+	}
+
+	//-----------------------------------------------------
+	delete[](Input);
+	delete[](Output);
+	delete[](Modules);
+	delete[](Used);
+
+	return( bResult );
+}
+
 //---------------------------------------------------------
 bool CSG_Module_Chain::Tool_Run(const CSG_MetaData &Tool)
 {
 	//-----------------------------------------------------
 	if( Tool.Cmp_Name("condition") )
 	{
-		if( !Check_Condition(Tool, &m_Data) )
+		bool	bCondition;
+
+		#pragma omp critical (module_chain)
+		{
+			bCondition	= Check_Condition(Tool, &m_Data);
+		}
+
+		if( !bCondition )
 		{
 			return( true );
 		}
@@ -626,33 +932,48 @@ bool CSG_Module_Chain::Tool_Run(const CSG_MetaData &Tool)
 
 	CSG_Module	*pModule;
 
-	if(	!(pModule = SG_Get_Module_Library_Manager().Get_Module(Tool.Get_Property("library"), Module)) )
-	{
-		Error_Fmt("%s [%s].[%s]", _TL("could not find tool"),  Tool.Get_Property("library"), Module.c_str());
-
-		return( false );
-	}
+	bool	bResult	= false;
 
-	//-----------------------------------------------------
-	Process_Set_Text(pModule->Get_Name());
-	Message_Add(CSG_String::Format("\n%s: %s", _TL("Run Tool"), pModule->Get_Name().c_str()), false);
+	#pragma omp critical (module_chain)	// access to library manager and chain data is serialized
+	{
+		if(	!(pModule = SG_Get_Module_Library_Manager().Get_Module(Tool.Get_Property("library"), Module)) )
+		{
+			Error_Fmt("%s [%s].[%s]", _TL("could not find tool"),  Tool.Get_Property("library"), Module.c_str());
+		}
+		else
+		{
+			Process_Set_Text(pModule->Get_Name());
+			Message_Add(CSG_String::Format("\n%s: %s", _TL("Run Tool"), pModule->Get_Name().c_str()), false);
 
-	pModule->Settings_Push(&m_Data_Manager);
+			pModule->Settings_Push(&m_Data_Manager);
 
-	bool	bResult	= false;
+			if( !(bResult = Tool_Initialize(Tool, pModule)) )
+			{
+				Error_Fmt("%s [%s].[%s]", _TL("tool initialization failed"), pModule->Get_Library().c_str(), pModule->Get_Name().c_str());
+			}
+		}
+	}
 
-	if( !Tool_Initialize(Tool, pModule) )
+	if( !pModule )
 	{
-		Error_Fmt("%s [%s].[%s]", _TL("tool initialization failed"), pModule->Get_Library().c_str(), pModule->Get_Name().c_str());
+		return( false );
 	}
-	else if( !(bResult = pModule->Execute()) )
+
+	//-----------------------------------------------------
+	if( bResult && !(bResult = pModule->Execute()) )
 	{
-		Error_Fmt("%s [%s].[%s]", _TL("tool execution failed"     ), pModule->Get_Library().c_str(), pModule->Get_Name().c_str());
+		#pragma omp critical (module_chain)
+		{
+			Error_Fmt("%s [%s].[%s]", _TL("tool execution failed"     ), pModule->Get_Library().c_str(), pModule->Get_Name().c_str());
+		}
 	}
 
-	Tool_Finalize(Tool, pModule);
+	#pragma omp critical (module_chain)
+	{
+		Tool_Finalize(Tool, pModule);
 
-	pModule->Settings_Pop();
+		pModule->Settings_Pop();
+	}
 
 	return( bResult );
 }
@@ -126,11 +126,15 @@ private:
 
 	bool						Data_Add				(const CSG_String &ID, CSG_Parameter *pData);
 	bool						Data_Exists				(CSG_Data_Object *pData);
+	bool						Data_Free				(const CSG_String &ID);
 	bool						Data_Initialize			(void);
 	bool						Data_Finalize			(void);
 
 	bool						Check_Condition			(const CSG_MetaData &Condition, CSG_Parameters *pData);
 
+	bool						Tools_Run				(bool bParallel);
+	bool						Tools_Get_Variables		(const CSG_MetaData &Tool, CSG_Strings &Input, CSG_Strings &Output, CSG_Strings &Modules);
+
 	bool						Tool_Run				(const CSG_MetaData &Tool);
 	bool						Tool_Check_Condition	(const CSG_MetaData &Tool);
 	bool						Tool_Get_Parameter		(const CSG_MetaData &Parameter, CSG_Module *pModule, CSG_Parameter **ppParameter, CSG_Parameter **ppParameters);
@@ -346,6 +346,8 @@ CSG_Module_Library_Manager::CSG_Module_Library_Manager(void)
 	m_pLibraries	= NULL;
 	m_nLibraries	= 0;
 
+	m_bCatalogue	= false;
+
 	if( this == &g_Module_Library_Manager )
 	{
 		CSG_Random::Initialize();	// initialize with current time on startup
@@ -424,7 +426,7 @@ int CSG_Module_Library_Manager::Add_Directory(const SG_Char *Directory, bool bOn
 		{
 			do
 			{	if( File_Name.Find("saga_") < 0 && File_Name.Find("wx") < 0 )
-				if( Add_Library(SG_File_Make_Path(Dir.GetName(), File_Name, NULL)) )
+				if( has_Catalogue() ? _Add_Catalogue(SG_File_Make_Path(Dir.GetName(), File_Name, NULL)) : Add_Library(SG_File_Make_Path(Dir.GetName(), File_Name, NULL)) != NULL )
 				{
 					nOpened++;
 				}
@@ -634,7 +636,7 @@ bool CSG_Module_Library_Manager::Del_Library(int i)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-CSG_Module_Library * CSG_Module_Library_Manager::Get_Library(const SG_Char *Name, bool bLibrary) const
+CSG_Module_Library * CSG_Module_Library_Manager::Get_Library(const SG_Char *Name, bool bLibrary)
 {
 	for(int i=0; i<Get_Count(); i++)
 	{
@@ -646,7 +648,7 @@ CSG_Module_Library * CSG_Module_Library_Manager::Get_Library(const SG_Char *Name
 		}
 	}
 
-	return( NULL );
+	return( _Get_Catalogue(Name, bLibrary) );
 }
 
 //---------------------------------------------------------
@@ -669,7 +671,7 @@ bool CSG_Module_Library_Manager::is_Loaded(CSG_Module_Library *pLibrary) const
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-CSG_Module * CSG_Module_Library_Manager::Get_Module(const CSG_String &Library, int ID)	const
+CSG_Module * CSG_Module_Library_Manager::Get_Module(const CSG_String &Library, int ID)
 {
 	CSG_Module_Library	*pLibrary	= Get_Library(Library, true);
 
@@ -677,7 +679,7 @@ CSG_Module * CSG_Module_Library_Manager::Get_Module(const CSG_String &Library, i
 }
 
 //---------------------------------------------------------
-CSG_Module * CSG_Module_Library_Manager::Get_Module(const CSG_String &Library, const CSG_String &Module)	const
+CSG_Module * CSG_Module_Library_Manager::Get_Module(const CSG_String &Library, const CSG_String &Module)
 {
 	CSG_Module_Library	*pLibrary	= Get_Library(Library, true);
 
@@ -685,6 +687,295 @@ CSG_Module * CSG_Module_Library_Manager::Get_Module(const CSG_String &Library, c
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//						Catalogue						 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// The tool catalogue lists file name, modification time,
+// library and tool identifiers of all libraries found by
+// Add_Directory(). If a catalogue has been set, libraries are
+// only inspected if they are not yet listed or have changed
+// since, and are not loaded before they are requested the
+// first time by Get_Library() or Get_Module().
+
+//---------------------------------------------------------
+enum
+{
+	CAT_FILE	= 0,
+	CAT_TIME,
+	CAT_LIBRARY,
+	CAT_NAME,
+	CAT_TOOLS,
+	CAT_STATE
+};
+
+enum
+{
+	CAT_STATE_UNKNOWN	= 0,	// listed in the catalogue file, but not found by Add_Directory()
+	CAT_STATE_AVAILABLE,		// found, but not loaded yet
+	CAT_STATE_LOADED
+};
+
+//---------------------------------------------------------
+#define CAT_HEADER	SG_T("SAGA Tool Catalogue ") SAGA_VERSION
+
+//---------------------------------------------------------
+bool CSG_Module_Library_Manager::Set_Catalogue(const CSG_String &File_Name)
+{
+	m_Catalogue.Destroy();
+
+	m_Catalogue.Add_Field("FILE"   , SG_DATATYPE_String);
+	m_Catalogue.Add_Field("TIME"   , SG_DATATYPE_Long  );
+	m_Catalogue.Add_Field("LIBRARY", SG_DATATYPE_String);
+	m_Catalogue.Add_Field("NAME"   , SG_DATATYPE_String);
+	m_Catalogue.Add_Field("TOOLS"  , SG_DATATYPE_String);
+	m_Catalogue.Add_Field("STATE"  , SG_DATATYPE_Int   );
+
+	m_Catalogue_File	= File_Name;
+	m_bCatalogue		= false;
+
+	//-----------------------------------------------------
+	CSG_File	Stream;
+
+	if( !Stream.Open(File_Name, SG_FILE_R, false) )
+	{
+		return( false );
+	}
+
+	CSG_String	sLine;
+
+	if( !Stream.Read_Line(sLine) || sLine.Cmp(CAT_HEADER) )	// created by another version
+	{
+		m_bCatalogue	= true;
+
+		return( false );
+	}
+
+	while( Stream.Read_Line(sLine) )
+	{
+		CSG_String_Tokenizer	Values(sLine, "\t", SG_TOKEN_RET_EMPTY_ALL);
+
+		if( Values.Get_Tokens_Count() == CAT_STATE )
+		{
+			CSG_Table_Record	*pRecord	= m_Catalogue.Add_Record();
+
+			for(int i=0; i<CAT_STATE; i++)
+			{
+				pRecord->Set_Value(i, Values.Get_Next_Token());
+			}
+
+			pRecord->Set_Value(CAT_STATE, CAT_STATE_UNKNOWN);
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Module_Library_Manager::Save_Catalogue(void)
+{
+	if( !has_Catalogue() )
+	{
+		return( false );
+	}
+
+	for(int i=m_Catalogue.Get_Count()-1; i>=0; i--)	// remove libraries that have not been found this time
+	{
+		if( m_Catalogue.Get_Record(i)->asInt(CAT_STATE) == CAT_STATE_UNKNOWN )
+		{
+			m_Catalogue.Del_Record(i);
+
+			m_bCatalogue	= true;
+		}
+	}
+
+	if( !m_bCatalogue )	// nothing has changed
+	{
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	// write to a temporary file in the same directory and rename it
+	// afterwards, so that a concurrently started saga_cmd never reads
+	// a partially written catalogue
+	CSG_String	Temp_File	= SG_File_Get_Name_Temp(SG_T("saga_cmd_tools"), SG_File_Get_Path(m_Catalogue_File));
+
+	CSG_File	Stream;
+
+	if( Temp_File.is_Empty() || !Stream.Open(Temp_File, SG_FILE_W, false) )
+	{
+		SG_File_Delete(Temp_File);
+
+		return( false );
+	}
+
+	Stream.Printf(SG_T("%s\n"), CAT_HEADER);
+
+	for(int i=0; i<m_Catalogue.Get_Count(); i++)
+	{
+		CSG_Table_Record	*pRecord	= m_Catalogue.Get_Record(i);
+
+		Stream.Printf(SG_T("%s\t%s\t%s\t%s\t%s\n"),
+			pRecord->asString(CAT_FILE   ),
+			pRecord->asString(CAT_TIME   ),
+			pRecord->asString(CAT_LIBRARY),
+			pRecord->asString(CAT_NAME   ),
+			pRecord->asString(CAT_TOOLS  )
+		);
+	}
+
+	Stream.Close();
+
+	if( !wxRenameFile(Temp_File.c_str(), m_Catalogue_File.c_str(), true) )
+	{
+		SG_File_Delete(Temp_File);
+
+		return( false );
+	}
+
+	m_bCatalogue	= false;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Module_Library_Manager::_Add_Catalogue(const CSG_String &File_Name)
+{
+	if( !SG_File_Cmp_Extension(File_Name, SG_T("mlb"  ))
+	&&	!SG_File_Cmp_Extension(File_Name, SG_T("dll"  ))
+	&&	!SG_File_Cmp_Extension(File_Name, SG_T("so"   ))
+	&&	!SG_File_Cmp_Extension(File_Name, SG_T("dylib"))
+	&&	!SG_File_Cmp_Extension(File_Name, SG_T("xml"  )) )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	sLong	Time	= (sLong)wxFileModificationTime(File_Name.c_str());
+
+	CSG_Table_Record	*pRecord	= NULL;
+
+	for(int i=0; !pRecord && i<m_Catalogue.Get_Count(); i++)
+	{
+		if( !File_Name.Cmp(m_Catalogue.Get_Record(i)->asString(CAT_FILE)) )
+		{
+			pRecord	= m_Catalogue.Get_Record(i);
+		}
+	}
+
+	if( pRecord && pRecord->asLong(CAT_TIME) == Time )
+	{
+		if( pRecord->asInt(CAT_STATE) == CAT_STATE_UNKNOWN )
+		{
+			pRecord->Set_Value(CAT_STATE, CAT_STATE_AVAILABLE);
+		}
+
+		return( true );	// up-to-date
+	}
+
+	//-----------------------------------------------------
+	m_bCatalogue	= true;
+
+	CSG_Module_Library	*pLibrary	= Add_Library(File_Name);
+
+	if( !pLibrary )
+	{
+		if( pRecord )
+		{
+			m_Catalogue.Del_Record(pRecord->Get_Index());
+		}
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	CSG_String	Tools;
+
+	for(int i=0; i<pLibrary->Get_Count(); i++)
+	{
+		CSG_Module	*pModule	= pLibrary->Get_Module(i);
+
+		if( pModule && (pLibrary->Get_Type() != MODULE_CHAINS || !File_Name.Cmp(((CSG_Module_Chain *)pModule)->Get_File_Name())) )
+		{
+			CSG_String	Name(pModule->Get_Name());	Name.Replace("|", " ");	Name.Replace(";", " ");	Name.Replace("\t", " ");
+
+			Tools	+= CSG_String::Format(SG_T("%s%s|%s"), Tools.is_Empty() ? SG_T("") : SG_T(";"), pModule->Get_ID().c_str(), Name.c_str());
+		}
+	}
+
+	if( !pRecord )
+	{
+		pRecord	= m_Catalogue.Add_Record();
+	}
+
+	pRecord->Set_Value(CAT_FILE   , File_Name);
+	pRecord->Set_Value(CAT_TIME   , (double)Time);
+	pRecord->Set_Value(CAT_LIBRARY, pLibrary->Get_Library_Name());
+	pRecord->Set_Value(CAT_NAME   , pLibrary->Get_Name());
+	pRecord->Set_Value(CAT_TOOLS  , Tools);
+	pRecord->Set_Value(CAT_STATE  , CAT_STATE_LOADED);
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Module_Library_Manager::_Load_Catalogue(CSG_Table_Record *pRecord)
+{
+	if( pRecord->asInt(CAT_STATE) != CAT_STATE_AVAILABLE )
+	{
+		return( false );
+	}
+
+	pRecord->Set_Value(CAT_STATE, CAT_STATE_LOADED);
+
+	return( Add_Library(pRecord->asString(CAT_FILE)) != NULL );
+}
+
+//---------------------------------------------------------
+CSG_Module_Library * CSG_Module_Library_Manager::_Get_Catalogue(const SG_Char *Name, bool bLibrary)
+{
+	bool	bLoaded	= false;
+
+	for(int i=0; i<m_Catalogue.Get_Count(); i++)
+	{
+		CSG_Table_Record	*pRecord	= m_Catalogue.Get_Record(i);
+
+		if( !SG_STR_CMP(Name, pRecord->asString(bLibrary ? CAT_LIBRARY : CAT_NAME)) )
+		{
+			SG_UI_Msg_Lock(true);	// load silently
+
+			if( _Load_Catalogue(pRecord) )
+			{
+				bLoaded	= true;
+			}
+
+			SG_UI_Msg_Lock(false);
+		}
+	}
+
+	return( bLoaded ? Get_Library(Name, bLibrary) : NULL );
+}
+
+//---------------------------------------------------------
+int CSG_Module_Library_Manager::Load_Catalogue(void)
+{
+	int	nLoaded	= 0;
+
+	for(int i=0; i<m_Catalogue.Get_Count(); i++)
+	{
+		if( _Load_Catalogue(m_Catalogue.Get_Record(i)) )
+		{
+			nLoaded++;
+		}
+	}
+
+	return( nLoaded );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 ///////////////////////////////////////////////////////////
@@ -194,16 +194,21 @@ public:
 	bool							Del_Library			(CSG_Module_Library *pLibrary);
 
 	CSG_Module_Library *			Get_Library			(int i)	const	{	return( i >= 0 && i < Get_Count() ? m_pLibraries[i] : NULL );	}
-	CSG_Module_Library *			Get_Library			(const SG_Char *Name, bool bLibrary)	const;
+	CSG_Module_Library *			Get_Library			(const SG_Char *Name, bool bLibrary);
 
 	bool							is_Loaded			(CSG_Module_Library *pLibrary)	const;
 
-	CSG_Module *					Get_Module			(const CSG_String &Library, int               ID    )	const;
-	CSG_Module *					Get_Module			(const CSG_String &Library, const CSG_String &Module)	const;
+	CSG_Module *					Get_Module			(const CSG_String &Library, int               ID    );
+	CSG_Module *					Get_Module			(const CSG_String &Library, const CSG_String &Module);
 
 	CSG_String						Get_Summary			(int Format = SG_SUMMARY_FMT_HTML)	const;
 	bool							Get_Summary			(const CSG_String &Path)			const;
 
+	bool							Set_Catalogue		(const CSG_String &File_Name);
+	bool							Save_Catalogue		(void);
+	bool							has_Catalogue		(void)	const	{	return( m_Catalogue.Get_Field_Count() > 0 );	}
+	int								Load_Catalogue		(void);
+
 
 private:
 
@@ -211,9 +216,19 @@ private:
 
 	CSG_Module_Library				**m_pLibraries;
 
+	bool							m_bCatalogue;
+
+	CSG_String						m_Catalogue_File;
+
+	CSG_Table						m_Catalogue;
+
 
 	CSG_Module_Library *			_Add_Module_Chain	(const SG_Char *File_Name);
 
+	bool							_Add_Catalogue		(const CSG_String &File_Name);
+	CSG_Module_Library *			_Get_Catalogue		(const SG_Char *Name, bool bLibrary);
+	bool							_Load_Catalogue		(CSG_Table_Record *pRecord);
+
 };
 
 //---------------------------------------------------------
@@ -1139,7 +1139,7 @@ CSG_Grid_System CSG_Parameters_Grid_Target::Get_System(void)
 }
 
 //---------------------------------------------------------
-CSG_Grid * CSG_Parameters_Grid_Target::Get_Grid(const CSG_String &Identifier, TSG_Data_Type Type)
+CSG_Grid * CSG_Parameters_Grid_Target::Get_Grid(const CSG_String &Identifier, TSG_Data_Type Type, TSG_Grid_Memory_Type Memory_Type)
 {
 	if( !m_pParameters )
 	{
@@ -1167,7 +1167,7 @@ CSG_Grid * CSG_Parameters_Grid_Target::Get_Grid(const CSG_String &Identifier, TS
 		if( m_pParameters->Get_Parameter(Identifier + "_CREATE") == NULL
 		||  m_pParameters->Get_Parameter(Identifier + "_CREATE")->asBool() )
 		{
-			pGrid	= SG_Create_Grid(System, Type);
+			pGrid	= SG_Create_Grid(System, Type, Memory_Type);
 		}
 	}
 	else
@@ -1176,7 +1176,7 @@ CSG_Grid * CSG_Parameters_Grid_Target::Get_Grid(const CSG_String &Identifier, TS
 
 		if( (pGrid == DATAOBJECT_NOTSET && !pParameter->is_Optional()) || pGrid == DATAOBJECT_CREATE )
 		{
-			pGrid	= SG_Create_Grid(System, Type);
+			pGrid	= SG_Create_Grid(System, Type, Memory_Type);
 		}
 	}
 
@@ -1189,9 +1189,9 @@ CSG_Grid * CSG_Parameters_Grid_Target::Get_Grid(const CSG_String &Identifier, TS
 }
 
 //---------------------------------------------------------
-CSG_Grid * CSG_Parameters_Grid_Target::Get_Grid(TSG_Data_Type Type)
+CSG_Grid * CSG_Parameters_Grid_Target::Get_Grid(TSG_Data_Type Type, TSG_Grid_Memory_Type Memory_Type)
 {
-	return( Get_Grid(m_Prefix + "OUT_GRID", Type) );
+	return( Get_Grid(m_Prefix + "OUT_GRID", Type, Memory_Type) );
 }
 
 
@@ -1207,8 +1207,8 @@ public:
 
 	CSG_Grid_System				Get_System				(void);
 
-	CSG_Grid *					Get_Grid				(const CSG_String &Identifier, TSG_Data_Type Type = SG_DATATYPE_Float);
-	CSG_Grid *					Get_Grid				(                              TSG_Data_Type Type = SG_DATATYPE_Float);
+	CSG_Grid *					Get_Grid				(const CSG_String &Identifier, TSG_Data_Type Type = SG_DATATYPE_Float, TSG_Grid_Memory_Type Memory_Type = GRID_MEMORY_Normal);
+	CSG_Grid *					Get_Grid				(                              TSG_Data_Type Type = SG_DATATYPE_Float, TSG_Grid_Memory_Type Memory_Type = GRID_MEMORY_Normal);
 
 
 private:
@@ -78,7 +78,11 @@
 #include "data_manager.h"
 #include "geo_tools.h"
 #include "grid.h"
+#include "grid_filter.h"
+#include "grid_hydrology.h"
 #include "grid_pyramid.h"
+#include "grid_render.h"
+#include "grid_zonal.h"
 #include "mat_tools.h"
 #include "metadata.h"
 #include "module.h"
@@ -117,6 +121,10 @@
 //---------------------------------------------------------
 #include "module_library.h"
 #include "data_manager.h"
+#include "grid_filter.h"
+#include "grid_hydrology.h"
+#include "grid_render.h"
+#include "grid_zonal.h"
 
 
 ///////////////////////////////////////////////////////////
@@ -123,44 +123,68 @@ bool CSG_Shape_Part::_Alloc_Memory(int nPoints)
 		return( true );
 	}
 
-	m_nBuffer	= nBuffer;
+	CSG_Shapes				*pShapes	= (CSG_Shapes *)m_pOwner->Get_Table();
+	CSG_Shapes_Vertex_Pool	&Pool		= pShapes->m_Vertex_Pool;
+
+	void	**Arrays[3]	= { (void **)&m_Points, (void **)&m_Z, (void **)&m_M };
+	size_t	Sizes [3]	= { sizeof(TSG_Point), sizeof(double), sizeof(double) };
+	bool	bArray[3]	= { true,
+		m_Z || pShapes->Get_Vertex_Type() != SG_VERTEX_TYPE_XY,
+		m_M || pShapes->Get_Vertex_Type() == SG_VERTEX_TYPE_XYZM
+	};
 
 	//-----------------------------------------------------
-	TSG_Point	*Points	= (TSG_Point *)SG_Realloc(m_Points, m_nBuffer * sizeof(TSG_Point));
+	// all new blocks are requested before any old one is released,
+	// so that a failed allocation leaves the part as it was and the
+	// block sizes always match m_nBuffer
 
-	if( Points == NULL )
-	{
-		return( false );
-	}
+	void	*Blocks[3]	= { NULL, NULL, NULL };
 
-	m_Points	= Points;
+	int		i;
 
-	//-----------------------------------------------------
-	if( m_Z || ((CSG_Shapes *)m_pOwner->Get_Table())->Get_Vertex_Type() != SG_VERTEX_TYPE_XY )
+	for(i=0; i<3; i++)
 	{
-		double	*Z	= (double *)SG_Realloc(m_Z, m_nBuffer * sizeof(double));
+		if( !bArray[i] )
+		{
+			continue;
+		}
 
-		if( !Z )
+		if( *Arrays[i] && Pool.is_In_Place(m_nBuffer * Sizes[i], nBuffer * Sizes[i]) )
 		{
-			return( false );
+			Blocks[i]	= *Arrays[i];
 		}
+		else if( (Blocks[i] = Pool.Realloc(NULL, 0, nBuffer * Sizes[i])) == NULL )
+		{
+			while( --i >= 0 )
+			{
+				if( Blocks[i] != *Arrays[i] )
+				{
+					Pool.Free(Blocks[i], nBuffer * Sizes[i]);
+				}
+			}
 
-		m_Z	= Z;
+			return( false );
+		}
 	}
 
 	//-----------------------------------------------------
-	if( m_M || ((CSG_Shapes *)m_pOwner->Get_Table())->Get_Vertex_Type() == SG_VERTEX_TYPE_XYZM )
+	for(i=0; i<3; i++)
 	{
-		double	*M	= (double *)SG_Realloc(m_M, m_nBuffer * sizeof(double));
-
-		if( !M )
+		if( Blocks[i] && Blocks[i] != *Arrays[i] )
 		{
-			return( false );
-		}
+			if( *Arrays[i] )
+			{
+				memcpy(Blocks[i], *Arrays[i], M_GET_MIN(m_nBuffer, nBuffer) * Sizes[i]);
+
+				Pool.Free(*Arrays[i], m_nBuffer * Sizes[i]);
+			}
 
-		m_M	= M;
+			*Arrays[i]	= Blocks[i];
+		}
 	}
 
+	m_nBuffer	= nBuffer;
+
 	return( true );
 }
 
@@ -174,20 +198,11 @@ bool CSG_Shape_Part::_Alloc_Memory(int nPoints)
 //---------------------------------------------------------
 bool CSG_Shape_Part::Destroy(void)
 {
-	if( m_Points != NULL )
-	{
-		SG_Free(m_Points);
-	}
+	CSG_Shapes_Vertex_Pool	&Pool	= ((CSG_Shapes *)m_pOwner->Get_Table())->m_Vertex_Pool;
 
-	if( m_Z != NULL )
-	{
-		SG_Free(m_Z);
-	}
-
-	if( m_M != NULL )
-	{
-		SG_Free(m_M);
-	}
+	Pool.Free(m_Points, m_nBuffer * sizeof(TSG_Point));
+	Pool.Free(m_Z     , m_nBuffer * sizeof(double   ));
+	Pool.Free(m_M     , m_nBuffer * sizeof(double   ));
 
 	m_Points	= NULL;
 	m_Z			= NULL;
@@ -289,6 +304,39 @@ int CSG_Shape_Part::Ins_Point(double x, double y, int iPoint)
 	return( 0 );
 }
 
+//---------------------------------------------------------
+/**
+  * Appends nPoints vertices with one memory allocation. Z and M
+  * values are optional and set to zero if not given.
+*/
+int CSG_Shape_Part::Add_Points(const TSG_Point *Points, int nPoints, const double *Z, const double *M)
+{
+	if( Points && nPoints > 0 && _Alloc_Memory(m_nPoints + nPoints) )
+	{
+		memcpy(m_Points + m_nPoints, Points, nPoints * sizeof(TSG_Point));
+
+		if( m_Z )
+		{
+			if( Z )	{	memcpy(m_Z + m_nPoints, Z, nPoints * sizeof(double));	}
+			else	{	memset(m_Z + m_nPoints, 0, nPoints * sizeof(double));	}
+
+			if( m_M )
+			{
+				if( M )	{	memcpy(m_M + m_nPoints, M, nPoints * sizeof(double));	}
+				else	{	memset(m_M + m_nPoints, 0, nPoints * sizeof(double));	}
+			}
+		}
+
+		m_nPoints	+= nPoints;
+
+		_Invalidate();
+
+		return( m_nPoints );
+	}
+
+	return( 0 );
+}
+
 //---------------------------------------------------------
 int CSG_Shape_Part::Set_Point(double x, double y, int iPoint)
 {
@@ -432,6 +480,219 @@ void CSG_Shape_Part::_Update_Extent(void)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//					Vertex Pool							 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define POOL_CLASS_MAX		(256 * 1024)		// largest pooled block in bytes, larger blocks come from the heap
+#define POOL_CLASS_COUNT	(16 + 4 * 10)		// 16 byte steps up to 256 bytes, then four steps per doubling
+#define POOL_CHUNK_MIN		(  16 * 1024)
+#define POOL_CHUNK_MAX		(4096 * 1024)
+
+//---------------------------------------------------------
+CSG_Shapes_Vertex_Pool::CSG_Shapes_Vertex_Pool(void)
+{
+	m_pChunk		= NULL;
+	m_Chunks		= NULL;
+	m_nChunks		= 0;
+	m_Chunk_Size	= 0;
+	m_Chunk_Used	= 0;
+	m_Memory		= 0;
+
+	m_Free			= (void **)SG_Calloc(POOL_CLASS_COUNT, sizeof(void *));
+}
+
+//---------------------------------------------------------
+CSG_Shapes_Vertex_Pool::~CSG_Shapes_Vertex_Pool(void)
+{
+	Destroy();
+
+	SG_Free(m_Free);
+}
+
+//---------------------------------------------------------
+void CSG_Shapes_Vertex_Pool::Destroy(void)
+{
+	for(int i=0; i<m_nChunks; i++)
+	{
+		SG_Free(m_Chunks[i]);
+	}
+
+	SG_FREE_SAFE(m_Chunks);
+
+	memset(m_Free, 0, POOL_CLASS_COUNT * sizeof(void *));
+
+	m_pChunk		= NULL;
+	m_nChunks		= 0;
+	m_Chunk_Size	= 0;
+	m_Chunk_Used	= 0;
+	m_Memory		= 0;
+}
+
+//---------------------------------------------------------
+int CSG_Shapes_Vertex_Pool::_Get_Class(size_t Size, size_t &Class_Size)
+{
+	if( Size <= 256 )
+	{
+		int	i	= Size > 16 ? (int)((Size + 15) / 16) : 1;
+
+		Class_Size	= 16 * i;
+
+		return( i - 1 );
+	}
+
+	if( Size > POOL_CLASS_MAX )
+	{
+		return( -1 );
+	}
+
+	int		e	= 8;	while( ((size_t)2 << e) < Size )	{	e++;	}	// 2^e < Size <= 2^(e+1)
+
+	size_t	Step	= ((size_t)1 << e) / 4;
+	int		j		= (int)((Size - ((size_t)1 << e) + Step - 1) / Step);	// 1...4
+
+	Class_Size	= ((size_t)1 << e) + j * Step;
+
+	return( 16 + 4 * (e - 8) + j - 1 );
+}
+
+//---------------------------------------------------------
+void * CSG_Shapes_Vertex_Pool::_Alloc(int Class, size_t Class_Size)
+{
+	void	*Block	= m_Free[Class];
+
+	if( Block )	// recycle
+	{
+		m_Free[Class]	= *(void **)Block;
+
+		return( Block );
+	}
+
+	if( !m_pChunk || m_Chunk_Used + Class_Size > m_Chunk_Size )	// start a new chunk, chunks grow with the layer
+	{
+		size_t	Size	= M_GET_MAX(Class_Size, M_GET_MIN(POOL_CHUNK_MAX, (size_t)POOL_CHUNK_MIN << M_GET_MIN(m_nChunks, 8)));
+
+		void	**Chunks	= (void **)SG_Realloc(m_Chunks, (m_nChunks + 1) * sizeof(void *));
+
+		if( !Chunks )
+		{
+			return( NULL );
+		}
+
+		m_Chunks	= Chunks;
+
+		if( (m_pChunk = (char *)SG_Malloc(Size)) == NULL )
+		{
+			return( NULL );
+		}
+
+		m_Chunks[m_nChunks++]	= m_pChunk;
+
+		m_Chunk_Size	= Size;
+		m_Chunk_Used	= 0;
+		m_Memory		+= Size;
+	}
+
+	Block	= m_pChunk + m_Chunk_Used;
+
+	m_Chunk_Used	+= Class_Size;
+
+	return( Block );
+}
+
+//---------------------------------------------------------
+/**
+  * Resizes Block from Size to New_Size bytes, preserving its
+  * content. Blocks are only moved, if the size class changes.
+*/
+void * CSG_Shapes_Vertex_Pool::Realloc(void *Block, size_t Size, size_t New_Size)
+{
+	if( !Block )
+	{
+		Size	= 0;
+	}
+
+	size_t	Class_Size, New_Class_Size;
+
+	int	Class		= Size > 0 ? _Get_Class(Size, Class_Size) : -1;
+	int	New_Class	= _Get_Class(New_Size, New_Class_Size);
+
+	if( Size > 0 && Class == New_Class && Class >= 0 )	// same size class, nothing to do
+	{
+		return( Block );
+	}
+
+	if( Size > 0 && Class < 0 && New_Class < 0 )	// both on the heap
+	{
+		return( SG_Realloc(Block, New_Size) );
+	}
+
+	//-----------------------------------------------------
+	void	*New_Block;
+
+	if( New_Class < 0 )
+	{
+		New_Block	= SG_Malloc(New_Size);
+	}
+	else
+	{
+		#pragma omp critical (sg_shapes_vertex_pool)
+		{
+			New_Block	= _Alloc(New_Class, New_Class_Size);
+		}
+	}
+
+	if( New_Block && Size > 0 )
+	{
+		memcpy(New_Block, Block, M_GET_MIN(Size, New_Size));
+
+		Free(Block, Size);
+	}
+
+	return( New_Block );
+}
+
+//---------------------------------------------------------
+/**
+  * Returns true, if Realloc() can resize a block from Size to
+  * New_Size bytes without moving it.
+*/
+bool CSG_Shapes_Vertex_Pool::is_In_Place(size_t Size, size_t New_Size)	const
+{
+	size_t	Class_Size;
+
+	int	Class	= Size > 0 ? _Get_Class(Size, Class_Size) : -1;
+
+	return( Class >= 0 && Class == _Get_Class(New_Size, Class_Size) );
+}
+
+//---------------------------------------------------------
+void CSG_Shapes_Vertex_Pool::Free(void *Block, size_t Size)
+{
+	if( Block )
+	{
+		size_t	Class_Size;
+
+		int	Class	= _Get_Class(Size, Class_Size);
+
+		if( Class < 0 )
+		{
+			SG_Free(Block);
+		}
+		else
+		{
+			#pragma omp critical (sg_shapes_vertex_pool)
+			{
+				*(void **)Block	= m_Free[Class];	m_Free[Class]	= Block;
+			}
+		}
+	}
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
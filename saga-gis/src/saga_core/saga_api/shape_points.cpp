@@ -224,6 +224,20 @@ int CSG_Shape_Points::Add_Point(double x, double y, int iPart)
 	return( iPart >= 0 && iPart < m_nParts ? m_pParts[iPart]->Add_Point(x, y) : 0 );
 }
 
+//---------------------------------------------------------
+int CSG_Shape_Points::Add_Points(const TSG_Point *Points, int nPoints, const double *Z, const double *M, int iPart)
+{
+	if( iPart >= m_nParts )
+	{
+		for(int i=m_nParts; i<=iPart; i++)
+		{
+			_Add_Part();
+		}
+	}
+
+	return( iPart >= 0 && iPart < m_nParts ? m_pParts[iPart]->Add_Points(Points, nPoints, Z, M) : 0 );
+}
+
 //---------------------------------------------------------
 int CSG_Shape_Points::Ins_Point(double x, double y, int iPoint, int iPart)
 {
@@ -283,7 +283,11 @@ CSG_Shapes::~CSG_Shapes(void)
 //---------------------------------------------------------
 bool CSG_Shapes::Destroy(void)
 {
-	return( CSG_Table::Destroy() );
+	bool	bResult	= CSG_Table::Destroy();
+
+	m_Vertex_Pool.Destroy();	// all parts have been deleted, release vertex memory at once
+
+	return( bResult );
 }
 
 
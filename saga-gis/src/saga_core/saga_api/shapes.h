@@ -310,6 +310,8 @@ public:
 
 	int							Get_Count			(void)	{	return( m_nPoints );	}
 
+	const TSG_Point *			Get_Points			(void)	const	{	return( m_Points );	}
+
 	TSG_Point					Get_Point			(int iPoint, bool bAscending = true)
 	{
 		if( iPoint >= 0 && iPoint < m_nPoints )
@@ -329,6 +331,8 @@ public:
 	int							Set_Point			(double x, double y, int iPoint);
 	int							Del_Point			(                    int iPoint);
 
+	int							Add_Points			(const TSG_Point *Points, int nPoints, const double *Z = NULL, const double *M = NULL);
+
 	void						Set_Z				(double z, int iPoint)					{	if    ( m_Z && iPoint >= 0 && iPoint < m_nPoints ) { m_Z[iPoint] = z; _Invalidate(); }	}
 	double						Get_Z				(int iPoint, bool bAscending = true)	{	return( m_Z && iPoint >= 0 && iPoint < m_nPoints ?   m_Z[bAscending ? iPoint : m_nPoints - 1 - iPoint] : 0.0 );	}
 	double						Get_ZMin			(void)									{	_Update_Extent(); return( m_ZMin );	}
@@ -395,6 +399,8 @@ public:
 	int							Ins_Point			(const TSG_Point &p, int iPoint, int iPart = 0)	{	return( Ins_Point(p.x, p.y, iPoint, iPart) );	}
 	int							Set_Point			(const TSG_Point &p, int iPoint, int iPart = 0)	{	return( Set_Point(p.x, p.y, iPoint, iPart) );	}
 
+	int							Add_Points			(const TSG_Point *Points, int nPoints, const double *Z = NULL, const double *M = NULL, int iPart = 0);
+
 	virtual int					Add_Part			(class CSG_Shape_Part *pPart);
 	virtual int					Del_Part			(int iPart);
 	virtual int					Del_Parts			(void);
@@ -623,10 +629,55 @@ typedef enum ESG_Shape_Copy_Mode
 }
 TSG_ADD_Shape_Copy_Mode;
 
+//---------------------------------------------------------
+/**
+  * CSG_Shapes_Vertex_Pool serves the vertex arrays of all shape
+  * parts of a layer from a few large memory chunks. Blocks are
+  * organized in size classes, freed blocks are recycled through
+  * per class free lists and the chunks are released at once, when
+  * the layer is destroyed. Blocks exceeding the largest size class
+  * are allocated from the heap.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Shapes_Vertex_Pool
+{
+public:
+	CSG_Shapes_Vertex_Pool(void);
+	virtual ~CSG_Shapes_Vertex_Pool(void);
+
+	void							Destroy					(void);
+
+	void *							Realloc					(void *Block, size_t Size, size_t New_Size);
+	bool							is_In_Place				(size_t Size, size_t New_Size)	const;
+	void							Free					(void *Block, size_t Size);
+
+	sLong							Get_Memory				(void)	const	{	return( m_Memory );	}
+
+
+private:
+
+	char							*m_pChunk;
+
+	void							**m_Chunks, **m_Free;
+
+	int								m_nChunks;
+
+	size_t							m_Chunk_Size, m_Chunk_Used;
+
+	sLong							m_Memory;
+
+
+	static int						_Get_Class				(size_t Size, size_t &Class_Size);
+
+	void *							_Alloc					(int Class, size_t Class_Size);
+
+};
+
 //---------------------------------------------------------
 class SAGA_API_DLL_EXPORT CSG_Shapes : public CSG_Table
 {
 	friend class CSG_Shape;
+	friend class CSG_Shape_Part;
 
 public:
 
@@ -697,6 +748,8 @@ protected:
 
 	CSG_Rect						m_Extent, m_Extent_Selected;
 
+	CSG_Shapes_Vertex_Pool			m_Vertex_Pool;
+
 
 	virtual bool					On_Update				(void);
 
@@ -1140,6 +1193,97 @@ protected:
 };
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//						R-Tree							 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * CSG_Shapes_RTree is a static R-tree of the shapes' extents,
+  * packed with the Sort-Tile-Recursive (STR) algorithm. Once
+  * created, queries are thread safe as long as the shapes are
+  * not modified.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Shapes_RTree
+{
+public:
+	CSG_Shapes_RTree(void);
+	virtual ~CSG_Shapes_RTree(void);
+
+									CSG_Shapes_RTree		(CSG_Shapes *pShapes, int Node_Size = 16);
+	bool							Create					(CSG_Shapes *pShapes, int Node_Size = 16);
+
+	bool							Destroy					(void);
+
+	bool							is_Okay					(void)	const	{	return( m_pShapes != NULL );	}
+
+	CSG_Shapes *					Get_Shapes				(void)	const	{	return( m_pShapes );	}
+
+	int								Get_Intersections		(const TSG_Rect &Extent, CSG_Array &Indices)	const;
+
+
+private:
+
+	int								m_nNodes, m_Root, *m_First, *m_Count;
+
+	TSG_Rect						*m_Extent;
+
+	CSG_Shapes						*m_pShapes;
+
+
+	void							_Sort					(int First, int nEntries, int Node_Size);
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//					Polygon Overlay						 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+typedef enum ESG_Polygon_Overlay
+{
+	SG_POLYGON_OVERLAY_INTERSECTION	= 0,
+	SG_POLYGON_OVERLAY_DIFFERENCE
+}
+TSG_Polygon_Overlay;
+
+//---------------------------------------------------------
+/**
+  * CSG_Polygon_Overlay intersects or subtracts all polygons of
+  * layer B from each polygon of layer A. Candidate pairs are
+  * found with an R-tree and clipped on worker threads, results
+  * are reported through On_Result() from the calling thread in
+  * the same order a sequential loop over A and B would produce.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Polygon_Overlay
+{
+public:
+	CSG_Polygon_Overlay(void);
+	virtual ~CSG_Polygon_Overlay(void);
+
+	bool							Execute					(TSG_Polygon_Overlay Type, CSG_Shapes *pA, CSG_Shapes *pB);
+
+
+protected:
+
+	/// Called for each result, id_B is -1 for differences. Results are temporary, unless a difference had no candidates, then the shape of A itself is passed.
+	virtual bool					On_Result				(CSG_Shape *pResult, int id_A, int id_B)	= 0;
+
+
+private:
+
+	void							_Prepare				(CSG_Shapes *pShapes);
+
+};
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //					Polygon Tools						 //
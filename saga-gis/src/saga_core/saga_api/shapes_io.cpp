@@ -74,13 +74,130 @@
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+#define SHP_BLOCK_BYTES	0x1000000	// shape and attribute records are read and written in blocks of 16 MB
+
+//---------------------------------------------------------
+static bool	SG_Shape_Load_ESRI(CSG_Shape *pShape, TSG_Shape_Type Type, TSG_Vertex_Type Vertex_Type, const char *Content, int Length)
+{
+	int			iPart, nParts, nPoints, *Parts;
+	double		*pZ	= NULL, *pM	= NULL;
+	TSG_Point	*pPoint;
+
+	switch( Type )
+	{
+	default:	break;
+
+	//-----------------------------------------------------
+	case SHAPE_TYPE_Point: ////////////////////////////////
+
+		if( Length < 20 )
+		{
+			return( false );
+		}
+
+		pPoint	= (TSG_Point *)(Content + 4);
+
+		pShape->Add_Point(pPoint->x, pPoint->y);
+
+		switch( Vertex_Type )	// read Z + M
+		{
+		case SG_VERTEX_TYPE_XYZM:	if( Length >= 36 )	pShape->Set_M(SG_Mem_Get_Double(Content + 28, false), 0);
+		case SG_VERTEX_TYPE_XYZ:	if( Length >= 28 )	pShape->Set_Z(SG_Mem_Get_Double(Content + 20, false), 0);
+		default:	break;
+		}
+
+		break;
+
+	//-----------------------------------------------------
+	case SHAPE_TYPE_Points: ///////////////////////////////
+
+		if( Length < 40 || (nPoints = SG_Mem_Get_Int(Content + 36, false)) < 0 || 40 + nPoints * 16 > Length )
+		{
+			return( false );
+		}
+
+		pPoint	= (TSG_Point *)(Content + 40);
+
+		switch( Vertex_Type )	// read Z + M
+		{
+		case SG_VERTEX_TYPE_XYZ:
+			pZ	= 56 + nPoints * 24 <= Length ? (double *)(Content + 56 + nPoints * 16) : NULL;	// [40 + nPoints * 16 + 2 * 8] + [nPoints * 8]
+			break;
+
+		case SG_VERTEX_TYPE_XYZM:
+			pZ	= 56 + nPoints * 24 <= Length ? (double *)(Content + 56 + nPoints * 16) : NULL;	// [40 + nPoints * 16 + 2 * 8] + [nPoints * 8]
+			pM	= 72 + nPoints * 32 <= Length ? (double *)(Content + 72 + nPoints * 24) : NULL;	// [40 + nPoints * 16 + 2 * 8] + [nPoints * 8 + 2 * 8] + [nPoints * 8]
+			break;
+
+		default:
+			break;
+		}
+
+		((CSG_Shape_Points *)pShape)->Add_Points(pPoint, nPoints, pZ, pM);
+
+		break;
+
+	//-----------------------------------------------------
+	case SHAPE_TYPE_Line:    //////////////////////////////
+	case SHAPE_TYPE_Polygon: //////////////////////////////
+
+		if( Length < 44
+		||  (nParts  = SG_Mem_Get_Int(Content + 36, false)) < 0
+		||  (nPoints = SG_Mem_Get_Int(Content + 40, false)) < 0 || 44 + nParts * 4 + nPoints * 16 > Length )
+		{
+			return( false );
+		}
+
+		Parts	= (int       *)(Content + 44);
+		pPoint	= (TSG_Point *)(Content + 44 + 4 * nParts);
+
+		switch( Vertex_Type )	// read Z + M
+		{
+		case SG_VERTEX_TYPE_XYZ:
+			pZ	= 60 + nParts * 4 + nPoints * 24 <= Length ? (double *)(Content + 60 + nParts * 4 + nPoints * 16) : NULL;	// [44 + nParts * 4 + nPoints * 16 + 2 * 8] + [nPoints * 8]
+			break;
+
+		case SG_VERTEX_TYPE_XYZM:
+			pZ	= 60 + nParts * 4 + nPoints * 24 <= Length ? (double *)(Content + 60 + nParts * 4 + nPoints * 16) : NULL;	// [44 + nParts * 4 + nPoints * 16 + 2 * 8] + [nPoints * 8]
+			pM	= 76 + nParts * 4 + nPoints * 32 <= Length ? (double *)(Content + 76 + nParts * 4 + nPoints * 24) : NULL;	// [44 + nParts * 4 + nPoints * 16 + 2 * 8] + [nPoints * 8 + 2 * 8] +  [nPoints * 8]
+			break;
+
+		default:
+			break;
+		}
+
+		//-------------------------------------------------
+		for(iPart=0, nParts=M_GET_MIN(nParts, nPoints); iPart<nParts; iPart++)	// each part is added with one allocation
+		{
+			int	iFirst	= Parts[iPart];
+			int	iLast	= iPart < nParts - 1 ? Parts[iPart + 1] : nPoints;
+
+			if( iFirst < 0 || iFirst > iLast || iLast > nPoints )
+			{
+				return( false );
+			}
+
+			if( iFirst < iLast )
+			{
+				((CSG_Shape_Points *)pShape)->Add_Points(pPoint + iFirst, iLast - iFirst,
+					pZ ? pZ + iFirst : NULL,
+					pM ? pM + iFirst : NULL, pShape->Get_Part_Count()
+				);
+			}
+		}
+
+		break;
+	}
+
+	return( true );
+}
+
 //---------------------------------------------------------
 bool CSG_Shapes::_Load_ESRI(const CSG_String &File_Name)
 {
-	int				Type, iField, iPart, nParts, *Parts, iPoint, nPoints, iOffset;
-	double			*pZ	= NULL, *pM	= NULL;
-	TSG_Point		*pPoint;
-	CSG_Buffer		File_Header(100), Record_Header(8), Content;
+	int				Type;
+	CSG_Buffer		File_Header(100);
 	CSG_File		fSHP;
 	CSG_Table_DBase	fDBF;
 
@@ -161,180 +278,142 @@ bool CSG_Shapes::_Load_ESRI(const CSG_String &File_Name)
 
 	//-----------------------------------------------------
 	// Load Shapes...
+	// The shape file is read in large blocks, record boundaries
+	// are found by scanning the record headers, geometries and
+	// attributes are then decoded in parallel.
 
-	for(int iShape=0; iShape<fDBF.Get_Record_Count() && SG_UI_Process_Set_Progress(iShape, fDBF.Get_Record_Count()); iShape++)
-	{
-		if( fSHP.Read(Record_Header.Get_Data(0), sizeof(int), 2) != 2 )		// read record header
-		{
-			SG_UI_Msg_Add_Error(_TL("corrupted record header"));
-
-			return( false );
-		}
+	bool		bError	= false, bEOF	= false;
+	size_t		nBuffer	= SHP_BLOCK_BYTES, nData = 0;
+	char		*Buffer	= (char *)SG_Malloc(nBuffer), *Records = NULL;
+	int			nRecords = 0, *Offset = NULL, *Length = NULL;
+	CSG_Shape	**pShapes	= NULL;
 
-		if( Record_Header.asInt(0, true) != iShape + 1 )					// record number
-		{
-			SG_UI_Msg_Add_Error(_TL("corrupted shapefile."));
-
-			return( false );
-		}
-
-		size_t	Length	= 2 * Record_Header.asInt(4, true);	// content length as 16-bit words !!!
-
-		if( !Content.Set_Size(Length, false) )
+	for(int iShape=0; !bError && Buffer && iShape<fDBF.Get_Record_Count() && SG_UI_Process_Set_Progress(iShape, fDBF.Get_Record_Count()); )
+	{
+		if( !bEOF )	// fill the buffer
 		{
-			SG_UI_Msg_Add_Error(_TL("memory allocation error."));
+			size_t	nRead	= fSHP.Read(Buffer + nData, sizeof(char), nBuffer - nData);
 
-			return( false );
+			bEOF	= nRead < nBuffer - nData;
+			nData	+= nRead;
 		}
 
-		if( fSHP.Read(Content.Get_Data(), sizeof(char), Length) != Length )
-		{
-			SG_UI_Msg_Add_Error(_TL("corrupted shapefile."));
-
-			return( false );
-		}
+		//-------------------------------------------------
+		int		n	= 0;
+		size_t	Position	= 0;
 
-		if( Content.asInt(0) != Type )
+		while( iShape + n < fDBF.Get_Record_Count() && Position + 8 <= nData )	// find complete records
 		{
-			if( Content.asInt(0) == 0 )
+			if( SG_Mem_Get_Int(Buffer + Position, true) != iShape + n + 1 )		// record number
 			{
-				// null shape is allowed !!!
+				bError	= true;	break;
 			}
-			else
-			{
-				SG_UI_Msg_Add_Error(_TL("corrupted shapefile."));
 
-				return( false );
-			}
-		}
-
-		//-------------------------------------------------
-		else
-		{
-			CSG_Shape	*pShape	= Add_Shape();
+			int	nBytes	= 2 * SG_Mem_Get_Int(Buffer + Position + 4, true);	// content length as 16-bit words !!!
 
-			switch( m_Type )
+			if( nBytes < 4 )
 			{
-			default:	break;
-
-			//---------------------------------------------
-			case SHAPE_TYPE_Point: ////////////////////////
-
-				pPoint	= (TSG_Point *)Content.Get_Data(4);
-
-				pShape->Add_Point(pPoint->x, pPoint->y);
+				bError	= true;	break;
+			}
 
-				switch( m_Vertex_Type )	// read Z + M
+			if( Position + 8 + nBytes > nData )
+			{
+				if( n == 0 && !bEOF && 8 + (size_t)nBytes > nBuffer )	// record exceeds buffer
 				{
-				case SG_VERTEX_TYPE_XYZM:	pShape->Set_M(Content.asDouble(28), 0);
-				case SG_VERTEX_TYPE_XYZ:	pShape->Set_Z(Content.asDouble(20), 0);
-				default:	break;
+					char	*p	= (char *)SG_Realloc(Buffer, nBuffer = 8 + nBytes);
+
+					if( !p )	{	bError	= true;	}	else	{	Buffer	= p;	}
 				}
 
 				break;
+			}
 
-			//---------------------------------------------
-			case SHAPE_TYPE_Points: ///////////////////////
-
-				nPoints	= Content.asInt(36);
-				pPoint	= (TSG_Point *)Content.Get_Data(40);
+			if( n >= nRecords )
+			{
+				nRecords	= 2 * nRecords + 1024;
 
-				switch( m_Vertex_Type )	// read Z + M
-				{
-				case SG_VERTEX_TYPE_XYZ:
-					pZ	= 56 + nPoints * 24 <= (int)Length ? (double *)Content.Get_Data(56 + nPoints * 16) : NULL;	// [40 + nPoints * 16 + 2 * 8] + [nPoints * 8]
-					break;
-
-				case SG_VERTEX_TYPE_XYZM:
-					pZ	= 56 + nPoints * 24 <= (int)Length ? (double *)Content.Get_Data(56 + nPoints * 16) : NULL;	// [40 + nPoints * 16 + 2 * 8] + [nPoints * 8]
-					pM	= 72 + nPoints * 32 <= (int)Length ? (double *)Content.Get_Data(72 + nPoints * 24) : NULL;	// [40 + nPoints * 16 + 2 * 8] + [nPoints * 8 + 2 * 8] + [nPoints * 8]
-					break;
-				default:	
-					break;
-				}
+				Offset	= (int        *)SG_Realloc(Offset , nRecords * sizeof(int));
+				Length	= (int        *)SG_Realloc(Length , nRecords * sizeof(int));
+				pShapes	= (CSG_Shape **)SG_Realloc(pShapes, nRecords * sizeof(CSG_Shape *));
+			}
 
-				//-----------------------------------------
-				for(iPoint=0; iPoint<nPoints; iPoint++, pPoint++)
-				{
-					pShape->Add_Point(pPoint->x, pPoint->y);
+			Offset[n]	= (int)Position + 8;
+			Length[n]	= nBytes;
 
-					if( pZ )	{	pShape->Set_Z(*(pZ++), iPoint);	}
-					if( pM )	{	pShape->Set_M(*(pM++), iPoint);	}
-				}
+			Position	+= 8 + nBytes;	n++;
+		}
 
-				break;
+		if( n == 0 )
+		{
+			if( bEOF )	// incomplete record
+			{
+				bError	= true;
+			}
 
-			//---------------------------------------------
-			case SHAPE_TYPE_Line:    //////////////////////
-			case SHAPE_TYPE_Polygon: //////////////////////
+			continue;
+		}
 
-				nParts	= Content.asInt(36);
-				nPoints	= Content.asInt(40);
-				Parts	= (int       *)Content.Get_Data(44);
-				pPoint	= (TSG_Point *)Content.Get_Data(44 + 4 * nParts);
+		//-------------------------------------------------
+		if( !(Records = (char *)SG_Realloc(Records, (size_t)n * fDBF.Get_Record_Bytes())) || !fDBF.Read_Records(iShape, n, Records) )
+		{
+			bError	= true;	break;
+		}
 
-				switch( m_Vertex_Type )	// read Z + M
-				{
-				case SG_VERTEX_TYPE_XYZ:
-					pZ	= 60 + nParts * 4 + nPoints * 24 <= (int)Length ? (double *)Content.Get_Data(60 + nParts * 4 + nPoints * 16) : NULL;	// [44 + nParts * 4 + nPoints * 16 + 2 * 8] + [nPoints * 8]
-					break;
-
-				case SG_VERTEX_TYPE_XYZM:
-					pZ	= 60 + nParts * 4 + nPoints * 24 <= (int)Length ? (double *)Content.Get_Data(60 + nParts * 4 + nPoints * 16) : NULL;	// [44 + nParts * 4 + nPoints * 16 + 2 * 8] + [nPoints * 8]
-					pM	= 76 + nParts * 4 + nPoints * 32 <= (int)Length ? (double *)Content.Get_Data(76 + nParts * 4 + nPoints * 24) : NULL;	// [44 + nParts * 4 + nPoints * 16 + 2 * 8] + [nPoints * 8 + 2 * 8] +  [nPoints * 8]
-					break;
-				default:
-					break;
-				}
+		for(int i=0; i<n; i++)
+		{
+			int	iType	= SG_Mem_Get_Int(Buffer + Offset[i], false);
 
+			if( iType == Type )
+			{
+				pShapes[i]	= Add_Shape();
+			}
+			else if( iType == 0 )	// null shape is allowed !!!
+			{
+				pShapes[i]	= NULL;
+			}
+			else
+			{
+				bError	= true;	break;
+			}
+		}
 
-				//-----------------------------------------
-				iOffset = 0;
+		if( bError )
+		{
+			break;
+		}
 
-				for(iPoint=0, iPart=0; iPoint<nPoints; iPoint++, pPoint++)
+		#pragma omp parallel for
+		for(int i=0; i<n; i++)
+		{
+			if( pShapes[i] )
+			{
+				if( !SG_Shape_Load_ESRI(pShapes[i], m_Type, m_Vertex_Type, Buffer + Offset[i], Length[i]) )
 				{
-					if( iPart < nParts - 1 && iPoint >= Parts[iPart + 1] )
-					{
-						iPart++;
-						iOffset = 0;
-					}
-
-					pShape->Add_Point(pPoint->x, pPoint->y, iPart);
-
-					if( pZ )	{	pShape->Set_Z(*(pZ++), iOffset, iPart);	}
-					if( pM )	{	pShape->Set_M(*(pM++), iOffset, iPart);	}
-
-					iOffset++;
+					bError	= true;
 				}
 
-				break;
+				fDBF.Get_Values(Records + (size_t)i * fDBF.Get_Record_Bytes(), pShapes[i]);
 			}
+		}
 
-			//---------------------------------------------
-			for(iField=0; iField<Get_Field_Count(); iField++)
-			{
-				switch( fDBF.Get_Field_Type(iField) )
-				{
-				default:
-					pShape->Set_Value(iField, fDBF.asString(iField));
-					break;
+		//-------------------------------------------------
+		memmove(Buffer, Buffer + Position, nData - Position);	// keep the incomplete tail
 
-				case DBF_FT_FLOAT:
-				case DBF_FT_NUMERIC:
-					{
-						double	Value;
+		nData	-= Position;
+		iShape	+= n;
+	}
 
-						if( fDBF.asDouble(iField, Value) )
-							pShape->Set_Value(iField, Value);
-						else
-							pShape->Set_NoData(iField);
-					}
-					break;
-				}
-			}
-		}
+	SG_FREE_SAFE(Buffer);
+	SG_FREE_SAFE(Records);
+	SG_FREE_SAFE(Offset);
+	SG_FREE_SAFE(Length);
+	SG_FREE_SAFE(pShapes);
+
+	if( bError )
+	{
+		SG_UI_Msg_Add_Error(_TL("corrupted shapefile."));
 
-		fDBF.Move_Next();
+		return( false );
 	}
 
 	//-----------------------------------------------------
@@ -353,19 +432,14 @@ bool CSG_Shapes::_Load_ESRI(const CSG_String &File_Name)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-#define Set_Content_Length(n)	Record_Header.Set_Value(4, (int)(n), true);\
-								fSHP.Write(Record_Header.Get_Data(), sizeof(int), 2);\
-								fSHX.Write_Int(fSHP_Size, true);\
-								fSHX.Write_Int((n)      , true);\
-								fSHP_Size	+= 4 + (n);\
-								fSHX_Size	+= 4;
+#define SHP_Write_Int(v)	{	SG_Mem_Set_Int   (pContent, (int)(v), false);	pContent	+= 4;	}
+#define SHP_Write_Double(v)	{	SG_Mem_Set_Double(pContent,      (v), false);	pContent	+= 8;	}
 
 //---------------------------------------------------------
 bool CSG_Shapes::_Save_ESRI(const CSG_String &File_Name)
 {
-	int				Type, fSHP_Size, fSHX_Size, iField, iPart, iPoint, nPoints;
-	TSG_Point		Point;
-	CSG_Buffer		File_Header(100), Record_Header(8), Content;
+	int				Type, fSHP_Size, fSHX_Size, iPart, iPoint, nPoints;
+	CSG_Buffer		File_Header(100);
 	CSG_File		fSHP, fSHX;
 	CSG_Table_DBase	fDBF;
 
@@ -449,6 +523,26 @@ bool CSG_Shapes::_Save_ESRI(const CSG_String &File_Name)
 
 	//-----------------------------------------------------
 	// Save Shapes...
+	// Records are collected in memory buffers and written
+	// blockwise, the index is written at once at the end.
+
+	size_t	nBuffer	= SHP_BLOCK_BYTES, nData = 0;
+	char	*Buffer	= (char *)SG_Malloc(nBuffer);
+	char	*Index	= (char *)SG_Malloc(8 * (size_t)M_GET_MAX(1, Get_Count()));
+
+	int		nRecords	= M_GET_MAX(1, SHP_BLOCK_BYTES / fDBF.Get_Record_Bytes()), iRecord = 0;
+	char	*Records	= (char *)SG_Malloc((size_t)nRecords * fDBF.Get_Record_Bytes());
+
+	if( !Buffer || !Index || !Records )
+	{
+		SG_FREE_SAFE(Buffer);
+		SG_FREE_SAFE(Index);
+		SG_FREE_SAFE(Records);
+
+		SG_UI_Msg_Add_Error(_TL("memory allocation error."));
+
+		return( false );
+	}
 
 	for(int iShape=0; iShape<Get_Count() && SG_UI_Process_Set_Progress(iShape, Get_Count()); iShape++)
 	{
@@ -457,48 +551,104 @@ bool CSG_Shapes::_Save_ESRI(const CSG_String &File_Name)
 		//-------------------------------------------------
 		// geometries...
 
-		Record_Header.Set_Value(0, iShape + 1, true);	// record number
-
 		for(iPart=0, nPoints=0; iPart<pShape->Get_Part_Count(); iPart++)
 		{
 			nPoints	+= pShape->Get_Point_Count(iPart);	// total number of points in shape
 		}
 
-		//-------------------------------------------------
-		switch( m_Type )			// write content header
+		int	Length	= 0;	// content length as 16-bit words
+
+		switch( m_Type )
 		{
 		default:	break;
 
-		//-------------------------------------------------
-		case SHAPE_TYPE_Point:		///////////////////////
-
+		case SHAPE_TYPE_Point:
 			switch( Vertex_Type )
 			{
-			case SG_VERTEX_TYPE_XY:		Set_Content_Length(10);	break;
-			case SG_VERTEX_TYPE_XYZ:	Set_Content_Length(14);	break;
-			case SG_VERTEX_TYPE_XYZM:	Set_Content_Length(18);	break;
+			case SG_VERTEX_TYPE_XY:		Length	= 10;	break;
+			case SG_VERTEX_TYPE_XYZ:	Length	= 14;	break;
+			case SG_VERTEX_TYPE_XYZM:	Length	= 18;	break;
 			}
+			break;
 
-			fSHP.Write_Int		(Type);
+		case SHAPE_TYPE_Points:
+			switch( Vertex_Type )
+			{
+			case SG_VERTEX_TYPE_XY:		Length	= 20 +  8 * nPoints;	break;
+			case SG_VERTEX_TYPE_XYZ:	Length	= 28 + 12 * nPoints;	break;
+			case SG_VERTEX_TYPE_XYZM:	Length	= 36 + 16 * nPoints;	break;
+			}
+			break;
 
+		case SHAPE_TYPE_Line:
+		case SHAPE_TYPE_Polygon:
+			switch( Vertex_Type )
+			{
+			case SG_VERTEX_TYPE_XY:		Length	= 22 + 2 * pShape->Get_Part_Count() +  8 * nPoints;	break;
+			case SG_VERTEX_TYPE_XYZ:	Length	= 30 + 2 * pShape->Get_Part_Count() + 12 * nPoints;	break;
+			case SG_VERTEX_TYPE_XYZM:	Length	= 38 + 2 * pShape->Get_Part_Count() + 16 * nPoints;	break;
+			}
 			break;
+		}
 
 		//-------------------------------------------------
-		case SHAPE_TYPE_Points:		///////////////////////
+		size_t	nBytes	= 8 + 2 * (size_t)Length;
 
-			switch( Vertex_Type )
+		if( nData + nBytes > nBuffer )
+		{
+			fSHP.Write(Buffer, sizeof(char), nData);	nData	= 0;
+
+			if( nBytes > nBuffer )
 			{
-			case SG_VERTEX_TYPE_XY:		Set_Content_Length(20 +  8 * nPoints);	break;
-			case SG_VERTEX_TYPE_XYZ:	Set_Content_Length(28 + 12 * nPoints);	break;
-			case SG_VERTEX_TYPE_XYZM:	Set_Content_Length(36 + 16 * nPoints);	break;
+				char	*p	= (char *)SG_Realloc(Buffer, nBuffer = nBytes);
+
+				if( !p )
+				{
+					SG_Free(Buffer);	SG_Free(Index);	SG_Free(Records);
+
+					SG_UI_Msg_Add_Error(_TL("memory allocation error."));
+
+					return( false );
+				}
+
+				Buffer	= p;
 			}
+		}
+
+		char	*pContent	= Buffer + nData;	nData	+= nBytes;
+
+		SG_Mem_Set_Int(pContent    , iShape + 1, true);	// record number
+		SG_Mem_Set_Int(pContent + 4, Length    , true);	// content length
+
+		SG_Mem_Set_Int(Index + 8 * iShape    , fSHP_Size, true);	// index: offset
+		SG_Mem_Set_Int(Index + 8 * iShape + 4, Length   , true);	// index: content length
+
+		fSHP_Size	+= 4 + Length;
+		fSHX_Size	+= 4;
 
-			fSHP.Write_Int		(Type);
-			fSHP.Write_Double	(pShape->Get_Extent().Get_XMin());
-			fSHP.Write_Double	(pShape->Get_Extent().Get_YMin());
-			fSHP.Write_Double	(pShape->Get_Extent().Get_XMax());
-			fSHP.Write_Double	(pShape->Get_Extent().Get_YMax());
-			fSHP.Write_Int		(nPoints);
+		pContent	+= 8;
+
+		//-------------------------------------------------
+		switch( m_Type )			// write content header
+		{
+		default:	break;
+
+		//-------------------------------------------------
+		case SHAPE_TYPE_Point:		///////////////////////
+
+			SHP_Write_Int		(Type);
+
+			break;
+
+		//-------------------------------------------------
+		case SHAPE_TYPE_Points:		///////////////////////
+
+			SHP_Write_Int		(Type);
+			SHP_Write_Double	(pShape->Get_Extent().Get_XMin());
+			SHP_Write_Double	(pShape->Get_Extent().Get_YMin());
+			SHP_Write_Double	(pShape->Get_Extent().Get_XMax());
+			SHP_Write_Double	(pShape->Get_Extent().Get_YMax());
+			SHP_Write_Int		(nPoints);
 
 			break;
 
@@ -506,24 +656,17 @@ bool CSG_Shapes::_Save_ESRI(const CSG_String &File_Name)
 		case SHAPE_TYPE_Line:		///////////////////////
 		case SHAPE_TYPE_Polygon:	///////////////////////
 
-			switch( Vertex_Type )
-			{
-			case SG_VERTEX_TYPE_XY:		Set_Content_Length(22 + 2 * pShape->Get_Part_Count() +  8 * nPoints);	break;
-			case SG_VERTEX_TYPE_XYZ:	Set_Content_Length(30 + 2 * pShape->Get_Part_Count() + 12 * nPoints);	break;
-			case SG_VERTEX_TYPE_XYZM:	Set_Content_Length(38 + 2 * pShape->Get_Part_Count() + 16 * nPoints);	break;
-			}
-
-			fSHP.Write_Int		(Type);
-			fSHP.Write_Double	(pShape->Get_Extent().Get_XMin());
-			fSHP.Write_Double	(pShape->Get_Extent().Get_YMin());
-			fSHP.Write_Double	(pShape->Get_Extent().Get_XMax());
-			fSHP.Write_Double	(pShape->Get_Extent().Get_YMax());
-			fSHP.Write_Int		(pShape->Get_Part_Count());
-			fSHP.Write_Int		(nPoints);
+			SHP_Write_Int		(Type);
+			SHP_Write_Double	(pShape->Get_Extent().Get_XMin());
+			SHP_Write_Double	(pShape->Get_Extent().Get_YMin());
+			SHP_Write_Double	(pShape->Get_Extent().Get_XMax());
+			SHP_Write_Double	(pShape->Get_Extent().Get_YMax());
+			SHP_Write_Int		(pShape->Get_Part_Count());
+			SHP_Write_Int		(nPoints);
 
 			for(iPart=0, iPoint=0; iPart<pShape->Get_Part_Count(); iPoint+=pShape->Get_Point_Count(iPart++))
 			{
-				fSHP.Write_Int(iPoint);
+				SHP_Write_Int(iPoint);
 			}
 
 			break;
@@ -537,16 +680,17 @@ bool CSG_Shapes::_Save_ESRI(const CSG_String &File_Name)
 		//-------------------------------------------------
 		case SHAPE_TYPE_Point:		///////////////////////
 
-			fSHP.Write(&(Point = pShape->Get_Point(0)), sizeof(TSG_Point));
+			SHP_Write_Double(pShape->Get_Point(0).x);
+			SHP_Write_Double(pShape->Get_Point(0).y);
 
 			//---------------------------------------------
 			if( Vertex_Type != SG_VERTEX_TYPE_XY )
 			{
-				fSHP.Write_Double(pShape->Get_Z(0));
+				SHP_Write_Double(pShape->Get_Z(0));
 
 				if( Vertex_Type == SG_VERTEX_TYPE_XYZM )
 				{
-					fSHP.Write_Double(pShape->Get_M(0));
+					SHP_Write_Double(pShape->Get_M(0));
 				}
 			}
 
@@ -561,34 +705,37 @@ bool CSG_Shapes::_Save_ESRI(const CSG_String &File_Name)
 			{
 				for(iPoint=0; iPoint<pShape->Get_Point_Count(iPart); iPoint++)
 				{
-					fSHP.Write(&(Point = pShape->Get_Point(iPoint, iPart)), sizeof(TSG_Point));
+					TSG_Point	Point	= pShape->Get_Point(iPoint, iPart);
+
+					SHP_Write_Double(Point.x);
+					SHP_Write_Double(Point.y);
 				}
 			}
 
 			//---------------------------------------------
 			if( Vertex_Type != SG_VERTEX_TYPE_XY )
 			{
-				fSHP.Write_Double(pShape->Get_ZMin());
-				fSHP.Write_Double(pShape->Get_ZMax());
+				SHP_Write_Double(pShape->Get_ZMin());
+				SHP_Write_Double(pShape->Get_ZMax());
 
 				for(iPart=0; iPart<pShape->Get_Part_Count(); iPart++)
 				{
 					for(iPoint=0; iPoint<pShape->Get_Point_Count(iPart); iPoint++)
 					{
-						fSHP.Write_Double(pShape->Get_Z(iPoint, iPart));
+						SHP_Write_Double(pShape->Get_Z(iPoint, iPart));
 					}
 				}
 
 				if( Vertex_Type == SG_VERTEX_TYPE_XYZM )
 				{
-					fSHP.Write_Double(pShape->Get_MMin());
-					fSHP.Write_Double(pShape->Get_MMax());
+					SHP_Write_Double(pShape->Get_MMin());
+					SHP_Write_Double(pShape->Get_MMax());
 
 					for(iPart=0; iPart<pShape->Get_Part_Count(); iPart++)
 					{
 						for(iPoint=0; iPoint<pShape->Get_Point_Count(iPart); iPoint++)
 						{
-							fSHP.Write_Double(pShape->Get_M(iPoint, iPart));
+							SHP_Write_Double(pShape->Get_M(iPoint, iPart));
 						}
 					}
 				}
@@ -598,30 +745,31 @@ bool CSG_Shapes::_Save_ESRI(const CSG_String &File_Name)
 		//-------------------------------------------------
 		// attributes...
 
-		fDBF.Add_Record();
+		fDBF.Set_Values(Records + (size_t)iRecord * fDBF.Get_Record_Bytes(), pShape);
 
-		for(iField=0; iField<Get_Field_Count(); iField++)
+		if( ++iRecord >= nRecords )
 		{
-			if( pShape->is_NoData(iField) )
-			{
-				fDBF.Set_NoData(iField);
-			}
-			else switch( fDBF.Get_Field_Type(iField) )
-			{
-			default:
-				fDBF.Set_Value(iField, CSG_String(pShape->asString(iField)));
-				break;
-
-			case DBF_FT_FLOAT:
-			case DBF_FT_NUMERIC:
-				fDBF.Set_Value(iField, pShape->asDouble(iField));
-				break;
-			}
+			fDBF.Write_Records(Records, iRecord);	iRecord	= 0;
 		}
+	}
 
-		fDBF.Flush_Record();
+	//-----------------------------------------------------
+	if( nData > 0 )
+	{
+		fSHP.Write(Buffer, sizeof(char), nData);
 	}
 
+	if( iRecord > 0 )
+	{
+		fDBF.Write_Records(Records, iRecord);
+	}
+
+	fSHX.Write(Index, sizeof(char), 8 * (size_t)Get_Count());
+
+	SG_FREE_SAFE(Buffer);
+	SG_FREE_SAFE(Index);
+	SG_FREE_SAFE(Records);
+
 	//-----------------------------------------------------
 	// File Sizes...
 
@@ -0,0 +1,543 @@
+/**********************************************************
+ * Version $Id$
+ *********************************************************/
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                   Library: SAGA_API                   //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                    shapes_overlay                     //
+//                                                       //
+//                 Copyright (C) 2014 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, version 2.1 of the License.      //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, write to the Free Software Foundation, Inc.,     //
+// 51 Franklin Street, 5th Floor, Boston, MA 02110-1301, //
+// USA.                                                  //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                Institute of Geography                 //
+//                University of Hamburg                  //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+
+#include "shapes.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//						R-Tree							 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Shapes_RTree::CSG_Shapes_RTree(void)
+{
+	m_nNodes	= 0;
+	m_Root		= -1;
+	m_First		= NULL;
+	m_Count		= NULL;
+	m_Extent	= NULL;
+	m_pShapes	= NULL;
+}
+
+//---------------------------------------------------------
+CSG_Shapes_RTree::CSG_Shapes_RTree(CSG_Shapes *pShapes, int Node_Size)
+{
+	m_nNodes	= 0;
+	m_Root		= -1;
+	m_First		= NULL;
+	m_Count		= NULL;
+	m_Extent	= NULL;
+	m_pShapes	= NULL;
+
+	Create(pShapes, Node_Size);
+}
+
+//---------------------------------------------------------
+CSG_Shapes_RTree::~CSG_Shapes_RTree(void)
+{
+	Destroy();
+}
+
+//---------------------------------------------------------
+bool CSG_Shapes_RTree::Destroy(void)
+{
+	SG_FREE_SAFE(m_First);
+	SG_FREE_SAFE(m_Count);
+	SG_FREE_SAFE(m_Extent);
+
+	m_nNodes	= 0;
+	m_Root		= -1;
+	m_pShapes	= NULL;
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// The nodes of all levels are stored in one array. The first
+// level holds one entry for each shape (m_First is the shape
+// index, m_Count is zero), each following level groups
+// Node_Size consecutive entries of the level below, after
+// these have been ordered by the STR algorithm.
+//---------------------------------------------------------
+bool CSG_Shapes_RTree::Create(CSG_Shapes *pShapes, int Node_Size)
+{
+	Destroy();
+
+	if( !pShapes || pShapes->Get_Count() < 1 || Node_Size < 2 )
+	{
+		return( false );
+	}
+
+	int	n	= pShapes->Get_Count(), nMax	= 2 * n + 1;	// n + n / (Node_Size - 1) + levels is always less
+
+	m_First		= (int      *)SG_Malloc(nMax * sizeof(int     ));
+	m_Count		= (int      *)SG_Malloc(nMax * sizeof(int     ));
+	m_Extent	= (TSG_Rect *)SG_Malloc(nMax * sizeof(TSG_Rect));
+
+	if( !m_First || !m_Count || !m_Extent )
+	{
+		Destroy();
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	for(int i=0; i<n; i++)
+	{
+		m_First [i]	= i;
+		m_Count [i]	= 0;
+		m_Extent[i]	= pShapes->Get_Shape(i)->Get_Extent().m_rect;
+	}
+
+	int	First	= 0;
+
+	m_nNodes	= n;
+
+	while( n > 1 )	// build the next level
+	{
+		_Sort(First, n, Node_Size);
+
+		for(int i=0; i<n; i+=Node_Size)
+		{
+			int	iNode	= m_nNodes++;
+
+			m_First [iNode]	= First + i;
+			m_Count [iNode]	= M_GET_MIN(Node_Size, n - i);
+			m_Extent[iNode]	= m_Extent[First + i];
+
+			for(int j=1; j<m_Count[iNode]; j++)
+			{
+				const TSG_Rect	&r	= m_Extent[First + i + j];
+
+				if( m_Extent[iNode].xMin > r.xMin )	m_Extent[iNode].xMin	= r.xMin;
+				if( m_Extent[iNode].yMin > r.yMin )	m_Extent[iNode].yMin	= r.yMin;
+				if( m_Extent[iNode].xMax < r.xMax )	m_Extent[iNode].xMax	= r.xMax;
+				if( m_Extent[iNode].yMax < r.yMax )	m_Extent[iNode].yMax	= r.yMax;
+			}
+		}
+
+		First	+= n;
+		n		 = m_nNodes - First;
+	}
+
+	m_Root		= m_nNodes - 1;
+	m_pShapes	= pShapes;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+// Sort-Tile-Recursive: order the entries by their centers'
+// x coordinate, cut them into vertical slices and order each
+// slice by the centers' y coordinate.
+//---------------------------------------------------------
+void CSG_Shapes_RTree::_Sort(int First, int nEntries, int Node_Size)
+{
+	if( nEntries <= Node_Size )
+	{
+		return;
+	}
+
+	int	nLeaves	= (nEntries + Node_Size - 1) / Node_Size;
+	int	nSlices	= (int)ceil(sqrt((double)nLeaves));
+	int	nSlice	= nSlices * Node_Size;	// entries per slice
+
+	CSG_Array	Order(sizeof(int), nEntries), Values(sizeof(double), nEntries);
+
+	int		*pOrder		= (int    *)Order .Get_Array();
+	double	*pValues	= (double *)Values.Get_Array();
+
+	//-----------------------------------------------------
+	for(int i=0; i<nEntries; i++)
+	{
+		pValues[i]	= m_Extent[First + i].xMin + m_Extent[First + i].xMax;
+	}
+
+	CSG_Index	Index(nEntries, pValues);
+
+	for(int i=0; i<nEntries; i++)
+	{
+		pOrder[i]	= Index[i];
+	}
+
+	//-----------------------------------------------------
+	for(int iSlice=0; iSlice<nEntries; iSlice+=nSlice)
+	{
+		int	n	= M_GET_MIN(nSlice, nEntries - iSlice);
+
+		for(int i=0; i<n; i++)
+		{
+			pValues[i]	= m_Extent[First + pOrder[iSlice + i]].yMin + m_Extent[First + pOrder[iSlice + i]].yMax;
+		}
+
+		Index.Create(n, pValues);
+
+		CSG_Array	Slice(sizeof(int), n);	int	*pSlice	= (int *)Slice.Get_Array();
+
+		for(int i=0; i<n; i++)
+		{
+			pSlice[i]	= pOrder[iSlice + Index[i]];
+		}
+
+		memcpy(pOrder + iSlice, pSlice, n * sizeof(int));
+	}
+
+	//-----------------------------------------------------
+	CSG_Array	First_Tmp(sizeof(int), nEntries), Count_Tmp(sizeof(int), nEntries), Extent_Tmp(sizeof(TSG_Rect), nEntries);
+
+	int			*pFirst		= (int      *)First_Tmp .Get_Array();
+	int			*pCount		= (int      *)Count_Tmp .Get_Array();
+	TSG_Rect	*pExtent	= (TSG_Rect *)Extent_Tmp.Get_Array();
+
+	for(int i=0; i<nEntries; i++)
+	{
+		pFirst [i]	= m_First [First + pOrder[i]];
+		pCount [i]	= m_Count [First + pOrder[i]];
+		pExtent[i]	= m_Extent[First + pOrder[i]];
+	}
+
+	memcpy(m_First  + First, pFirst , nEntries * sizeof(int     ));
+	memcpy(m_Count  + First, pCount , nEntries * sizeof(int     ));
+	memcpy(m_Extent + First, pExtent, nEntries * sizeof(TSG_Rect));
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+static int SG_RTree_Compare_Index(const void *a, const void *b)
+{
+	return( *((const int *)a) - *((const int *)b) );
+}
+
+//---------------------------------------------------------
+/**
+  * Collects the indices of all shapes, whose extent intersects
+  * with Extent, in ascending order. Returns their number.
+*/
+int CSG_Shapes_RTree::Get_Intersections(const TSG_Rect &Extent, CSG_Array &Indices) const
+{
+	if( Indices.Get_Value_Size() != sizeof(int) )
+	{
+		Indices.Create(sizeof(int), 0, SG_ARRAY_GROWTH_2);
+	}
+	else
+	{
+		Indices.Set_Array(0, false);
+	}
+
+	if( m_Root < 0 )
+	{
+		return( 0 );
+	}
+
+	//-----------------------------------------------------
+	CSG_Array	Stack(sizeof(int), 0, SG_ARRAY_GROWTH_1);
+
+	Stack.Inc_Array();	*((int *)Stack.Get_Entry(0))	= m_Root;
+
+	while( Stack.Get_Size() > 0 )
+	{
+		int	iNode	= *((int *)Stack.Get_Entry(Stack.Get_Size() - 1));	Stack.Dec_Array(false);
+
+		const TSG_Rect	&r	= m_Extent[iNode];
+
+		if( r.xMax < Extent.xMin || r.xMin > Extent.xMax
+		||  r.yMax < Extent.yMin || r.yMin > Extent.yMax )
+		{
+			continue;
+		}
+
+		if( m_Count[iNode] == 0 )	// shape
+		{
+			Indices.Inc_Array();	*((int *)Indices.Get_Entry(Indices.Get_Size() - 1))	= m_First[iNode];
+		}
+		else for(int i=0; i<m_Count[iNode]; i++)
+		{
+			Stack.Inc_Array();	*((int *)Stack.Get_Entry(Stack.Get_Size() - 1))	= m_First[iNode] + i;
+		}
+	}
+
+	//-----------------------------------------------------
+	if( Indices.Get_Size() > 1 )
+	{
+		qsort(Indices.Get_Array(), Indices.Get_Size(), sizeof(int), SG_RTree_Compare_Index);
+	}
+
+	return( (int)Indices.Get_Size() );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//					Polygon Overlay						 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define OVERLAY_CHUNK	16	// polygons of layer A processed by one thread at once
+
+//---------------------------------------------------------
+CSG_Polygon_Overlay::CSG_Polygon_Overlay(void)
+{}
+
+//---------------------------------------------------------
+CSG_Polygon_Overlay::~CSG_Polygon_Overlay(void)
+{}
+
+//---------------------------------------------------------
+// Extents, areas and lake flags are evaluated on demand, so
+// update them now to make the shapes safe for concurrent reads.
+//---------------------------------------------------------
+void CSG_Polygon_Overlay::_Prepare(CSG_Shapes *pShapes)
+{
+	pShapes->Get_Extent();
+
+	#pragma omp parallel for
+	for(int iShape=0; iShape<pShapes->Get_Count(); iShape++)
+	{
+		CSG_Shape_Polygon	*pShape	= (CSG_Shape_Polygon *)pShapes->Get_Shape(iShape);
+
+		pShape->Get_Extent();
+
+		for(int iPart=0; iPart<pShape->Get_Part_Count(); iPart++)
+		{
+			pShape->Get_Part(iPart)->Get_Extent();
+			pShape->is_Clockwise(iPart);
+			pShape->is_Lake     (iPart);
+		}
+	}
+}
+
+//---------------------------------------------------------
+bool CSG_Polygon_Overlay::Execute(TSG_Polygon_Overlay Type, CSG_Shapes *pA, CSG_Shapes *pB)
+{
+	if( !pA || pA->Get_Type() != SHAPE_TYPE_Polygon
+	||  !pB || pB->Get_Type() != SHAPE_TYPE_Polygon )
+	{
+		return( false );
+	}
+
+	_Prepare(pA);
+	_Prepare(pB);
+
+	CSG_Shapes_RTree	Tree(pB);
+
+	//-----------------------------------------------------
+	// each chunk of A collects its results in its own layer,
+	// the 'B' field keeps the index of the intersected polygon
+
+	int	nChunks	= 4 * SG_Get_Max_Num_Threads_Omp();
+	int	nBlock	= nChunks * OVERLAY_CHUNK;
+
+	CSG_Shapes	**pResults	= (CSG_Shapes **)SG_Malloc(nChunks * sizeof(CSG_Shapes *));
+
+	for(int iChunk=0; iChunk<nChunks; iChunk++)
+	{
+		pResults[iChunk]	= new CSG_Shapes(SHAPE_TYPE_Polygon);
+		pResults[iChunk]->Add_Field("B", SG_DATATYPE_Int);
+	}
+
+	int	*First	= (int *)SG_Malloc(nBlock * sizeof(int));
+	int	*Count	= (int *)SG_Malloc(nBlock * sizeof(int));
+
+	bool	bResult	= true;
+
+	//-----------------------------------------------------
+	for(int iBlock=0; bResult && iBlock<pA->Get_Count(); iBlock+=nBlock)
+	{
+		if( !SG_UI_Process_Set_Progress(iBlock, pA->Get_Count()) )
+		{
+			bResult	= false;
+
+			break;
+		}
+
+		#pragma omp parallel for schedule(dynamic)
+		for(int iChunk=0; iChunk<nChunks; iChunk++)
+		{
+			CSG_Shapes	*pResult	= pResults[iChunk];
+			CSG_Array	Candidates;
+
+			for(int i=iChunk*OVERLAY_CHUNK, iA=iBlock+i; i<(iChunk+1)*OVERLAY_CHUNK && iA<pA->Get_Count(); i++, iA++)
+			{
+				CSG_Shape	*pShape_A	= pA->Get_Shape(iA);
+
+				First[i]	= pResult->Get_Count();
+
+				//-----------------------------------------
+				int	nCandidates	= 0;
+
+				Tree.Get_Intersections(pShape_A->Get_Extent().m_rect, Candidates);
+
+				for(size_t j=0; j<Candidates.Get_Size(); j++)
+				{
+					int	iB	= *((int *)Candidates.Get_Entry(j));
+
+					if( pB->Get_Shape(iB)->Intersects(pShape_A->Get_Extent()) )	// same test as CSG_Shapes::Select(Extent)
+					{
+						*((int *)Candidates.Get_Entry(nCandidates++))	= iB;
+					}
+				}
+
+				//-----------------------------------------
+				if( Type == SG_POLYGON_OVERLAY_INTERSECTION )
+				{
+					for(int j=0; j<nCandidates; j++)
+					{
+						int			iB			= *((int *)Candidates.Get_Entry(j));
+						CSG_Shape	*pShape_AB	= pResult->Add_Shape();
+
+						if( SG_Polygon_Intersection(pShape_A, pB->Get_Shape(iB), pShape_AB) )
+						{
+							pShape_AB->Set_Value(0, iB);
+						}
+						else
+						{
+							pResult->Del_Shape(pResult->Get_Count() - 1);
+						}
+					}
+				}
+
+				//-----------------------------------------
+				else if( nCandidates < 1 )	// no overlap, A is taken as it is
+				{
+					First[i]	= -1;	Count[i]	= 0;
+
+					continue;
+				}
+				else
+				{
+					int			nIntersections	= 0;
+					CSG_Shape	*pShape_AB		= pResult->Add_Shape();
+
+					pShape_AB->Assign(pShape_A, false);
+
+					for(int j=0; j<nCandidates; j++)
+					{
+						if( SG_Polygon_Difference(pShape_AB, pB->Get_Shape(*((int *)Candidates.Get_Entry(j)))) )
+						{
+							nIntersections++;
+						}
+					}
+
+					if( nIntersections > 0 && pShape_AB->is_Valid() )
+					{
+						pShape_AB->Set_Value(0, -1);
+					}
+					else
+					{
+						pResult->Del_Shape(pResult->Get_Count() - 1);
+					}
+				}
+
+				Count[i]	= pResult->Get_Count() - First[i];
+			}
+		}
+
+		//-------------------------------------------------
+		// report results in the order of A and B
+
+		for(int i=0, iA=iBlock; bResult && i<nBlock && iA<pA->Get_Count(); i++, iA++)
+		{
+			if( First[i] < 0 )
+			{
+				bResult	= On_Result(pA->Get_Shape(iA), iA, -1);
+			}
+			else for(int j=0; bResult && j<Count[i]; j++)
+			{
+				CSG_Shape	*pShape_AB	= pResults[i / OVERLAY_CHUNK]->Get_Shape(First[i] + j);
+
+				bResult	= On_Result(pShape_AB, iA, pShape_AB->asInt(0));
+			}
+		}
+
+		for(int iChunk=0; iChunk<nChunks; iChunk++)
+		{
+			pResults[iChunk]->Del_Shapes();
+		}
+	}
+
+	//-----------------------------------------------------
+	for(int iChunk=0; iChunk<nChunks; iChunk++)
+	{
+		delete(pResults[iChunk]);
+	}
+
+	SG_Free(pResults);
+	SG_Free(First);
+	SG_Free(Count);
+
+	return( bResult );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
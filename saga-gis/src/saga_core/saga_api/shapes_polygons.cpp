@@ -172,12 +172,17 @@ bool CSG_Converter_WorldToInt::Convert(CSG_Shapes *pPolygons, ClipperLib::Paths
 			|| (((CSG_Shape_Polygon *)pPolygon)->is_Lake(iPart)
 			==  ((CSG_Shape_Polygon *)pPolygon)->is_Clockwise(iPart));
 
+			int	nPoints	= pPolygon->Get_Point_Count(iPart);
+
 			Polygons.resize(1 + jPolygon);
-			Polygons[jPolygon].resize(pPolygon->Get_Point_Count(iPart));
+			Polygons[jPolygon].resize(nPoints);
+
+			const TSG_Point	*pPoints	= pPolygon->Get_Type() == SHAPE_TYPE_Point ? NULL	// read parts' vertex arrays directly
+				: ((CSG_Shape_Points *)pPolygon)->Get_Part(iPart)->Get_Points();
 
-			for(int iPoint=0; iPoint<pPolygon->Get_Point_Count(iPart); iPoint++)
+			for(int iPoint=0; iPoint<nPoints; iPoint++)
 			{
-				TSG_Point	p	= pPolygon->Get_Point(iPoint, iPart, bAscending);
+				TSG_Point	p	= !pPoints ? pPolygon->Get_Point(iPoint, iPart, bAscending) : pPoints[bAscending ? iPoint : nPoints - 1 - iPoint];
 
 				Polygons[jPolygon][iPoint].X	= Get_X_asInt(p.x);
 				Polygons[jPolygon][iPoint].Y	= Get_Y_asInt(p.y);
@@ -216,11 +221,17 @@ bool CSG_Converter_WorldToInt::Convert(CSG_Shape *pPolygon, ClipperLib::Paths &P
 			|| (((CSG_Shape_Polygon *)pPolygon)->is_Lake(iPart)
 			==  ((CSG_Shape_Polygon *)pPolygon)->is_Clockwise(iPart));
 
+			int	nPoints	= pPolygon->Get_Point_Count(iPart);
+
 			Polygons.resize(1 + iPolygon);
+			Polygons[iPolygon].reserve(nPoints);
+
+			const TSG_Point	*pPoints	= pPolygon->Get_Type() == SHAPE_TYPE_Point ? NULL	// read parts' vertex arrays directly
+				: ((CSG_Shape_Points *)pPolygon)->Get_Part(iPart)->Get_Points();
 
-			for(int iPoint=0; iPoint<pPolygon->Get_Point_Count(iPart); iPoint++)
+			for(int iPoint=0; iPoint<nPoints; iPoint++)
 			{
-				TSG_Point	p	= pPolygon->Get_Point(iPoint, iPart, bAscending);
+				TSG_Point	p	= !pPoints ? pPolygon->Get_Point(iPoint, iPart, bAscending) : pPoints[bAscending ? iPoint : nPoints - 1 - iPoint];
 
 				ClipperLib::IntPoint	Point(Get_X_asInt(p.x), Get_Y_asInt(p.y));
 
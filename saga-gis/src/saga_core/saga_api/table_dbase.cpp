@@ -72,6 +72,16 @@
 #include "table.h"
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define DBF_BLOCK_BYTES	0x1000000	// records are read and written in blocks of 16 MB
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -187,37 +197,34 @@ bool CSG_Table_DBase::Open_Read(const SG_Char *FileName, CSG_Table *pTable, bool
 		}
 
 		//-------------------------------------------------
-		if( bRecords_Load && Get_Record_Count() > 0 && Move_First() )
+		if( bRecords_Load && Get_Record_Count() > 0 )
 		{
-			for(int iRecord=0; iRecord<Get_Record_Count() && SG_UI_Process_Set_Progress(iRecord, Get_Record_Count()); iRecord++)
+			int		nBlock	= M_GET_MAX(1, DBF_BLOCK_BYTES / m_nRecordBytes);
+			char	*Block	= (char *)SG_Malloc((size_t)nBlock * m_nRecordBytes);
+
+			for(int iRecord=0; Block && iRecord<Get_Record_Count() && SG_UI_Process_Set_Progress(iRecord, Get_Record_Count()); iRecord+=nBlock)
 			{
-				CSG_Table_Record	*pRecord	= pTable->Add_Record();
+				int	n	= M_GET_MIN(nBlock, Get_Record_Count() - iRecord);
 
-				for(iField=0; iField<Get_Field_Count(); iField++)
+				if( !Read_Records(iRecord, n, Block) )
 				{
-					switch( Get_Field_Type(iField) )
-					{
-					default:
-						pRecord->Set_Value(iField, asString(iField));
-						break;
-
-					case DBF_FT_FLOAT:
-					case DBF_FT_NUMERIC:
-						{
-							double	Value;
-
-							if( asDouble(iField, Value) )
-								pRecord->Set_Value(iField, Value);
-							else
-								pRecord->Set_NoData(iField);
-						}
-						break;
-					}
+					break;
 				}
 
-				Move_Next();
+				for(int i=0; i<n; i++)
+				{
+					pTable->Add_Record();
+				}
+
+				#pragma omp parallel for
+				for(int i=0; i<n; i++)
+				{
+					Get_Values(Block + (size_t)i * m_nRecordBytes, pTable->Get_Record(iRecord + i));
+				}
 			}
 
+			SG_FREE_SAFE(Block);
+
 			SG_UI_Process_Set_Ready();
 		}
 	}
@@ -386,36 +393,30 @@ bool CSG_Table_DBase::Open_Write(const SG_Char *FileName, CSG_Table *pTable, boo
 	m_nFileBytes	= m_nHeaderBytes;
 
 	//-----------------------------------------------------
-	if( bRecords_Save )
+	if( bRecords_Save && pTable->Get_Record_Count() > 0 )
 	{
-		for(int iRecord=0; iRecord<pTable->Get_Record_Count() && SG_UI_Process_Set_Progress(iRecord, pTable->Get_Record_Count()); iRecord++)
+		int		nBlock	= M_GET_MAX(1, DBF_BLOCK_BYTES / m_nRecordBytes);
+		char	*Block	= (char *)SG_Malloc((size_t)nBlock * m_nRecordBytes);
+
+		for(int iRecord=0; Block && iRecord<pTable->Get_Record_Count() && SG_UI_Process_Set_Progress(iRecord, pTable->Get_Record_Count()); iRecord+=nBlock)
 		{
-			CSG_Table_Record	*pRecord	= pTable->Get_Record(iRecord);
+			int	n	= M_GET_MIN(nBlock, pTable->Get_Record_Count() - iRecord);
 
-			Add_Record();
+			for(int i=0; i<n; i++)	// asString() of numeric fields is not thread safe, so encode serially
+			{
+				Set_Values(Block + (size_t)i * m_nRecordBytes, pTable->Get_Record(iRecord + i));
+			}
 
-			for(iField=0; iField<Get_Field_Count(); iField++)
+			if( !Write_Records(Block, n) )
 			{
-				if( pRecord->is_NoData(iField) )
-				{
-					Set_NoData(iField);
-				}
-				else switch( Get_Field_Type(iField) )
-				{
-				default:
-					Set_Value(iField, CSG_String(pRecord->asString(iField)));
-					break;
+				SG_UI_Msg_Add_Error(_TL("dbf write: could not write records"));
 
-				case DBF_FT_FLOAT:
-				case DBF_FT_NUMERIC:
-					Set_Value(iField, pRecord->asDouble(iField));
-					break;
-				}
+				break;
 			}
-
-			Flush_Record();
 		}
 
+		SG_FREE_SAFE(Block);
+
 		SG_UI_Process_Set_Ready();
 	}
 
@@ -654,30 +655,51 @@ bool CSG_Table_DBase::asInt(int iField, int &Value)
 //---------------------------------------------------------
 bool CSG_Table_DBase::asDouble(int iField, double &Value)
 {
-	if( m_hFile && iField >= 0 && iField < m_nFields )
+	return( m_hFile && _asDouble(m_Record, iField, Value) );
+}
+
+//---------------------------------------------------------
+bool CSG_Table_DBase::_asDouble(const char *Record, int iField, double &Value) const
+{
+	if( iField >= 0 && iField < m_nFields )
 	{
-		char		*c;
-		int			i;
-		CSG_String	s;
+		char		s[256];
+		const char	*c	= Record + m_Fields[iField].Offset;
+		int			n;
 
-		for(i=0, c=m_Record+m_Fields[iField].Offset; i<m_Fields[iField].Width && *c; i++, c++)
+		for(n=0; n<m_Fields[iField].Width && c[n]; n++)
 		{
-			s	+= *c;
+			s[n]	= c[n];
 		}
 
+		s[n]	= '\0';
+
 		if( m_Fields[iField].Type == DBF_FT_FLOAT
 		||  m_Fields[iField].Type == DBF_FT_NUMERIC )
 		{
-			s.Replace(",", ".");
+			for(int i=0; i<n; i++)
+			{
+				if( s[i] == ',' )
+				{
+					s[i]	= '.';
+				}
+			}
+
+			char	*end;
+
+			Value	= strtod(s, &end);
 
-			return( s.asDouble(Value) );
+			return( end > s );
 		}
 
-		if( m_Fields[iField].Type == DBF_FT_DATE && s.Length() >= 8 )
+		if( m_Fields[iField].Type == DBF_FT_DATE && n >= 8 )
 		{
-			int	d	= s.Mid(6, 2).asInt();	if( d < 1 )	d	= 1;	else if( d > 31 )	d	= 31;
-			int	m	= s.Mid(4, 2).asInt();	if( m < 1 )	m	= 1;	else if( m > 12 )	m	= 12;
-			int	y	= s.Mid(0, 4).asInt();
+			int	d	= 10 * (s[6] - '0') + (s[7] - '0');	if( d < 1 )	d	= 1;	else if( d > 31 )	d	= 31;
+			int	m	= 10 * (s[4] - '0') + (s[5] - '0');	if( m < 1 )	m	= 1;	else if( m > 12 )	m	= 12;
+
+			s[4]	= '\0';
+
+			int	y	= atoi(s);
 
 			Value	= 10000 * y + 100 * m + d;
 
@@ -690,19 +712,41 @@ bool CSG_Table_DBase::asDouble(int iField, double &Value)
 
 //---------------------------------------------------------
 CSG_String CSG_Table_DBase::asString(int iField)
+{
+	return( m_hFile ? _asString(m_Record, iField) : CSG_String() );
+}
+
+//---------------------------------------------------------
+CSG_String CSG_Table_DBase::_asString(const char *Record, int iField) const
 {
 	CSG_String	Value;
 
-	if( m_hFile && iField >= 0 && iField < m_nFields )
+	if( iField >= 0 && iField < m_nFields )
 	{
 		if( m_Fields[iField].Type != DBF_FT_DATE )
 		{
-			char	*c;
-			int		i;
+			char		s[256];
+			const char	*c	= Record + m_Fields[iField].Offset;
+			int			n;
+			bool		bASCII	= true;
+
+			for(n=0; n<m_Fields[iField].Width && c[n]; n++)
+			{
+				if( (s[n] = c[n]) & 0x80 )
+				{
+					bASCII	= false;
+				}
+			}
+
+			s[n]	= '\0';
 
-			for(i=0, c=m_Record+m_Fields[iField].Offset; i<m_Fields[iField].Width && *c; i++, c++)
+			if( bASCII )	// convert at once
 			{
-				Value	+= *c;
+				Value	= s;
+			}
+			else for(int i=0; i<n; i++)
+			{
+				Value	+= s[i];
 			}
 
 			Value.Trim(true);
@@ -710,7 +754,7 @@ CSG_String CSG_Table_DBase::asString(int iField)
 
 		else // if( m_Fields[iField].Type == DBF_FT_DATE )	// SAGA(DD.MM.YYYY) from DBASE(YYYYMMDD)
 		{
-			char	*s	= m_Record + m_Fields[iField].Offset;
+			const char	*s	= Record + m_Fields[iField].Offset;
 
 			Value	+= s[6];	// D1
 			Value	+= s[7];	// D2
@@ -738,9 +782,22 @@ CSG_String CSG_Table_DBase::asString(int iField)
 //---------------------------------------------------------
 bool CSG_Table_DBase::Set_Value(int iField, double Value)
 {
-	static char	s[256];
+	if( m_hFile && _Set_Value(m_Record, iField, Value) )
+	{
+		m_bModified	= true;
 
-	if( m_hFile && iField >= 0 && iField < m_nFields && m_Fields[iField].Width > 0 )
+		return( true );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+bool CSG_Table_DBase::_Set_Value(char *Record, int iField, double Value) const
+{
+	char	s[1024];
+
+	if( iField >= 0 && iField < m_nFields && m_Fields[iField].Width > 0 )
 	{
 		if( m_Fields[iField].Type == DBF_FT_FLOAT )
 		{	// Number stored as a string, right justified, and padded with blanks to the width of the field.
@@ -748,10 +805,8 @@ bool CSG_Table_DBase::Set_Value(int iField, double Value)
 
 			int	n	= (int)strlen(s);	if( n > m_Fields[iField].Width )	{	n	= m_Fields[iField].Width;	}
 
-			memset(m_Record + m_Fields[iField].Offset, ' ', m_Fields[iField].Width);
-			memcpy(m_Record + m_Fields[iField].Offset, s  , n);
-
-			m_bModified	= true;
+			memset(Record + m_Fields[iField].Offset, ' ', m_Fields[iField].Width);
+			memcpy(Record + m_Fields[iField].Offset, s  , n);
 
 			return( true );
 		}
@@ -769,10 +824,8 @@ bool CSG_Table_DBase::Set_Value(int iField, double Value)
 
 			int	n	= (int)strlen(s);	if( n > m_Fields[iField].Width )	{	n	= m_Fields[iField].Width;	}
 
-			memset(m_Record + m_Fields[iField].Offset, ' ', m_Fields[iField].Width);
-			memcpy(m_Record + m_Fields[iField].Offset, s  , n);
-
-			m_bModified	= true;
+			memset(Record + m_Fields[iField].Offset, ' ', m_Fields[iField].Width);
+			memcpy(Record + m_Fields[iField].Offset, s  , n);
 
 			return( true );
 		}
@@ -785,7 +838,7 @@ bool CSG_Table_DBase::Set_Value(int iField, double Value)
 
 			sprintf(s, "%04d%02d%02d", y, m, d);
 
-			return( Set_Value(iField, s) );
+			return( _Set_Value(Record, iField, s) );
 		}
 	}
 
@@ -795,7 +848,20 @@ bool CSG_Table_DBase::Set_Value(int iField, double Value)
 //---------------------------------------------------------
 bool CSG_Table_DBase::Set_Value(int iField, const char *Value)
 {
-	if( m_hFile && iField >= 0 && iField < m_nFields && m_Fields[iField].Width > 0 )
+	if( m_hFile && _Set_Value(m_Record, iField, Value) )
+	{
+		m_bModified	= true;
+
+		return( true );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+bool CSG_Table_DBase::_Set_Value(char *Record, int iField, const char *Value) const
+{
+	if( iField >= 0 && iField < m_nFields && m_Fields[iField].Width > 0 )
 	{
 		int		n	= Value && Value[0] ? (int)strlen(Value) : 0;
 
@@ -806,17 +872,15 @@ bool CSG_Table_DBase::Set_Value(int iField, const char *Value)
 				n	= m_Fields[iField].Width;
 			}
 
-			memset(m_Record + m_Fields[iField].Offset, ' ', m_Fields[iField].Width);
-			memcpy(m_Record + m_Fields[iField].Offset, Value, n);
-
-			m_bModified	= true;
+			memset(Record + m_Fields[iField].Offset, ' ', m_Fields[iField].Width);
+			memcpy(Record + m_Fields[iField].Offset, Value, n);
 
 			return( true );
 		}
 
 		if( m_Fields[iField].Type == DBF_FT_DATE && n == 10 )	// SAGA(DD.MM.YYYY) to DBASE(YYYYMMDD)
 		{	// 8 bytes - date stored as a string in the format YYYYMMDD
-			char	*s	= m_Record + m_Fields[iField].Offset;
+			char	*s	= Record + m_Fields[iField].Offset;
 
 			s[0]	= Value[6];	// Y1
 			s[1]	= Value[7];	// Y2
@@ -827,8 +891,6 @@ bool CSG_Table_DBase::Set_Value(int iField, const char *Value)
 			s[6]	= Value[0];	// D1
 			s[7]	= Value[1];	// D2
 
-			m_bModified	= true;
-
 			return( true );
 		}
 	}
@@ -852,6 +914,133 @@ bool CSG_Table_DBase::Set_NoData(int iField)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//					Block Access						 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * Reads nRecords raw records starting with iRecord with one
+  * file access. Records has to provide nRecords times
+  * Get_Record_Bytes() bytes. Does not change the current record.
+*/
+bool CSG_Table_DBase::Read_Records(int iRecord, int nRecords, char *Records)
+{
+	if( m_hFile && iRecord >= 0 && nRecords > 0 && iRecord + nRecords <= m_nRecords )
+	{
+		long	Position	= ftell(m_hFile);
+
+		fseek(m_hFile, m_nHeaderBytes + (long)iRecord * m_nRecordBytes, SEEK_SET);
+
+		bool	bResult	= fread(Records, m_nRecordBytes, nRecords, m_hFile) == (size_t)nRecords;
+
+		fseek(m_hFile, Position, SEEK_SET);
+
+		return( bResult );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+/**
+  * Decodes all fields of a raw record into pRecord. Does not
+  * touch the file, so that records can be decoded concurrently.
+*/
+bool CSG_Table_DBase::Get_Values(const char *Record, CSG_Table_Record *pRecord) const
+{
+	if( !Record || !pRecord )
+	{
+		return( false );
+	}
+
+	for(int iField=0; iField<m_nFields && iField<pRecord->Get_Table()->Get_Field_Count(); iField++)
+	{
+		switch( m_Fields[iField].Type )
+		{
+		default:
+			pRecord->Set_Value(iField, _asString(Record, iField));
+			break;
+
+		case DBF_FT_FLOAT:
+		case DBF_FT_NUMERIC:
+			{
+				double	Value;
+
+				if( _asDouble(Record, iField, Value) )
+					pRecord->Set_Value(iField, Value);
+				else
+					pRecord->Set_NoData(iField);
+			}
+			break;
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+  * Encodes the values of pRecord into a raw record, which can
+  * be written with Write_Records().
+*/
+bool CSG_Table_DBase::Set_Values(char *Record, CSG_Table_Record *pRecord) const
+{
+	if( !Record || !pRecord )
+	{
+		return( false );
+	}
+
+	memset(Record, ' ', m_nRecordBytes);	// not deleted, no-data fields are left blank
+
+	for(int iField=0; iField<m_nFields && iField<pRecord->Get_Table()->Get_Field_Count(); iField++)
+	{
+		if( !pRecord->is_NoData(iField) )
+		{
+			switch( m_Fields[iField].Type )
+			{
+			default:
+				_Set_Value(Record, iField, CSG_String(pRecord->asString(iField)));
+				break;
+
+			case DBF_FT_FLOAT:
+			case DBF_FT_NUMERIC:
+				_Set_Value(Record, iField, pRecord->asDouble(iField));
+				break;
+			}
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+  * Appends nRecords raw records with one file access.
+*/
+bool CSG_Table_DBase::Write_Records(const char *Records, int nRecords)
+{
+	if( m_hFile && !m_bReadOnly && nRecords > 0 )
+	{
+		Flush_Record();
+
+		fseek(m_hFile, m_nHeaderBytes + (long)m_nRecords * m_nRecordBytes, SEEK_SET);
+
+		if( fwrite(Records, m_nRecordBytes, nRecords, m_hFile) == (size_t)nRecords )
+		{
+			m_nRecords		+= nRecords;
+			m_nFileBytes	+= nRecords * m_nRecordBytes;
+
+			return( true );
+		}
+	}
+
+	return( false );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
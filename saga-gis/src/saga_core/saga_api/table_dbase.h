@@ -152,6 +152,15 @@ public:
 	bool						Set_Value			(int iField, const char *Value);
 	bool						Set_NoData			(int iField);
 
+	//-----------------------------------------------------
+	int							Get_Record_Bytes	(void)	{	return( m_nRecordBytes );	}
+
+	bool						Read_Records		(int iRecord, int nRecords, char *Records);
+	bool						Get_Values			(const char *Record, class CSG_Table_Record *pRecord)	const;
+
+	bool						Set_Values			(char *Record, class CSG_Table_Record *pRecord)	const;
+	bool						Write_Records		(const char *Records, int nRecords);
+
 
 private:
 	typedef struct
@@ -195,6 +204,12 @@ private:
 
 	void						Init_Record			(void);
 
+	bool						_asDouble			(const char *Record, int iField, double &Value)	const;
+	CSG_String					_asString			(const char *Record, int iField)				const;
+
+	bool						_Set_Value			(char *Record, int iField, double      Value)	const;
+	bool						_Set_Value			(char *Record, int iField, const char *Value)	const;
+
 };
 
 
@@ -164,12 +164,51 @@ int CSG_Table::Del_Selection(void)
 
 	int		i, n	= 0;
 
-	for(i=m_nRecords-1; i>=0; i--)
+	if( is_Indexed() )
 	{
-		if( m_Records[i]->is_Selected() && Del_Record(i) )
+		for(i=m_nRecords-1; i>=0; i--)
 		{
-			n++;
+			if( m_Records[i]->is_Selected() && Del_Record(i) )
+			{
+				n++;
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	else	// single pass, avoids moving the records once for each deletion
+	{
+		int		j;
+
+		for(i=0, j=0; i<m_nRecords; i++)
+		{
+			if( m_Records[i]->is_Selected() )
+			{
+				delete(m_Records[i]);
+			}
+			else
+			{
+				m_Records[j]			= m_Records[i];
+				m_Records[j]->m_Index	= j;
+
+				j++;
+			}
 		}
+
+		n	= m_nRecords - j;
+
+		for(i=0; i<n; i++)
+		{
+			m_nRecords--;
+
+			_Dec_Array();
+		}
+
+		Set_Modified();
+
+		Set_Update_Flag();
+
+		_Stats_Invalidate();
 	}
 
 	SG_FREE_SAFE(m_Selected);
@@ -231,6 +231,47 @@ bool CSG_TIN::Create(CSG_Shapes *pShapes)
 	return( false );
 }
 
+//---------------------------------------------------------
+bool CSG_TIN::Create(CSG_PointCloud *pPoints)
+{
+	Destroy();
+
+	if( pPoints && pPoints->is_Valid() )
+	{
+		SG_UI_Msg_Add(CSG_String::Format(SG_T("%s: %s..."), _TL("Create TIN from points"), pPoints->Get_Name()), true);
+
+		CSG_Table::Create(pPoints);
+
+		Set_Name(pPoints->Get_Name());
+
+		//-------------------------------------------------
+		// read the points directly, without the shape cursor
+
+		for(int iPoint=0; iPoint<pPoints->Get_Point_Count() && SG_UI_Process_Set_Progress(iPoint, pPoints->Get_Point_Count()); iPoint++)
+		{
+			CSG_TIN_Node	*pNode	= Add_Node(CSG_Point(pPoints->Get_X(iPoint), pPoints->Get_Y(iPoint)), NULL, false);
+
+			for(int iField=0; iField<pPoints->Get_Field_Count(); iField++)
+			{
+				pNode->Set_Value(iField, pPoints->Get_Value(iPoint, iField));
+			}
+		}
+
+		SG_UI_Process_Set_Ready();
+
+		if( Update() )
+		{
+			SG_UI_Msg_Add(_TL("okay"), false, SG_UI_MSG_STYLE_SUCCESS);
+
+			return( true );
+		}
+	}
+
+	SG_UI_Msg_Add(_TL("failed"), false, SG_UI_MSG_STYLE_FAILURE);
+
+	return( false );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -452,10 +493,17 @@ bool CSG_TIN::Del_Node(int iNode, bool bUpdateNow)
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+#define TIN_GROW_SIZE	1024	// edge and triangle arrays grow in blocks
+
 //---------------------------------------------------------
 inline bool CSG_TIN::_Add_Edge(CSG_TIN_Node *a, CSG_TIN_Node *b)
 {
-	m_Edges		= (CSG_TIN_Edge **)SG_Realloc(m_Edges, (m_nEdges + 1) * sizeof(CSG_TIN_Edge *));
+	if( (m_nEdges % TIN_GROW_SIZE) == 0 )
+	{
+		m_Edges		= (CSG_TIN_Edge **)SG_Realloc(m_Edges, (m_nEdges + TIN_GROW_SIZE) * sizeof(CSG_TIN_Edge *));
+	}
+
 	m_Edges[m_nEdges++]	= new CSG_TIN_Edge(a, b);
 
 	return( true );
@@ -466,7 +514,11 @@ bool CSG_TIN::_Add_Triangle(CSG_TIN_Node *a, CSG_TIN_Node *b, CSG_TIN_Node *c)
 {
 	CSG_TIN_Triangle	*pTriangle;
 
-	m_Triangles	= (CSG_TIN_Triangle **)SG_Realloc(m_Triangles, (m_nTriangles + 1) * sizeof(CSG_TIN_Triangle *));
+	if( (m_nTriangles % TIN_GROW_SIZE) == 0 )
+	{
+		m_Triangles	= (CSG_TIN_Triangle **)SG_Realloc(m_Triangles, (m_nTriangles + TIN_GROW_SIZE) * sizeof(CSG_TIN_Triangle *));
+	}
+
 	m_Triangles[m_nTriangles++]	= pTriangle = new CSG_TIN_Triangle(a, b, c);
 
 	if( a->_Add_Neighbor(b) )
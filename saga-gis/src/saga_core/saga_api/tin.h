@@ -74,7 +74,7 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-#include "shapes.h"
+#include "pointcloud.h"
 
 
 ///////////////////////////////////////////////////////////
@@ -224,6 +224,7 @@ public:
 
 									CSG_TIN		(CSG_Shapes *pShapes);
 	bool							Create		(CSG_Shapes *pShapes);
+	bool							Create		(CSG_PointCloud *pPoints);
 
 									CSG_TIN		(const CSG_String &File_Name);
 	bool							Create		(const CSG_String &File_Name);
@@ -298,7 +299,6 @@ protected:
 
 	bool							_Triangulate			(void);
 	bool							_Triangulate			(CSG_TIN_Node **Nodes, int nNodes, TTIN_Triangle *Triangles, int &nTriangles);
-	int								_CircumCircle			(double xp, double yp, double x1, double y1, double x2, double y2, double x3, double y3, double *xc, double *yc, double *r);
 
 };
 
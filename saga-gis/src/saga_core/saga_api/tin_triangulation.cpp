@@ -56,17 +56,20 @@
 //---------------------------------------------------------
 
 
-///////////////////////////////////////////////////////////
-//														 //
-//														 //
-//														 //
-///////////////////////////////////////////////////////////
-
 //---------------------------------------------------------
-// The Delaunay Triangulation algorithm used here is based
-// on Paul Bourke's C source codes, which can be found at:
+// The Delaunay triangulation is built by incremental point
+// insertion with Lawson's edge flipping. Points are inserted
+// along a Hilbert curve and located by walking from the last
+// created triangle, which makes the expected costs O(n log n).
+// Triangles are kept in compact index arrays (vertices and
+// neighbours) and only converted to TIN elements at the end.
+// The orientation and in-circle predicates use a floating
+// point filter and fall back to exact expansion arithmetic
+// (Shewchuk 1997) for nearly degenerate configurations.
 //
-//     http://astronomy.swin.edu.au/~pbourke/
+// Shewchuk, J.R. (1997): Adaptive Precision Floating-Point
+//     Arithmetic and Fast Robust Geometric Predicates.
+//     Discrete & Computational Geometry 18:305-363.
 //
 //---------------------------------------------------------
 
@@ -78,353 +81,651 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+#include <float.h>
+
 #include "tin.h"
 
 
 ///////////////////////////////////////////////////////////
 //														 //
-//														 //
+//					Exact Predicates					 //
 //														 //
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-int SG_TIN_Compare(const void *pp1, const void *pp2)
+#define EXACT_EPSILON			(DBL_EPSILON / 2.0)
+#define EXACT_SPLITTER			134217729.0	// 2^27 + 1
+#define EXACT_ORIENT_BOUND		((3.0 +  16.0 * EXACT_EPSILON) * EXACT_EPSILON)
+#define EXACT_INCIRCLE_BOUND	((10.0 + 96.0 * EXACT_EPSILON) * EXACT_EPSILON)
+
+//---------------------------------------------------------
+static inline void	SG_Exact_Fast_Two_Sum	(double a, double b, double &x, double &y)
 {
-	CSG_TIN_Node	*p1	= *((CSG_TIN_Node **)pp1),
-					*p2	= *((CSG_TIN_Node **)pp2);
+	x	= a + b;	double	bv	= x - a;	y	= b - bv;
+}
 
-	if( p1->Get_X() < p2->Get_X() )
+static inline void	SG_Exact_Two_Sum		(double a, double b, double &x, double &y)
+{
+	x	= a + b;	double	bv	= x - a,	av	= x - bv;	y	= (a - av) + (b - bv);
+}
+
+static inline void	SG_Exact_Two_Diff		(double a, double b, double &x, double &y)
+{
+	x	= a - b;	double	bv	= a - x,	av	= x + bv;	y	= (a - av) + (bv - b);
+}
+
+static inline void	SG_Exact_Split			(double a, double &hi, double &lo)
+{
+	double	c	= EXACT_SPLITTER * a;	hi	= c - (c - a);	lo	= a - hi;
+}
+
+static inline void	SG_Exact_Two_Product	(double a, double b, double bhi, double blo, double &x, double &y)
+{
+	double	ahi, alo;	SG_Exact_Split(a, ahi, alo);
+
+	x	= a * b;	y	= alo * blo - (((x - ahi * bhi) - alo * bhi) - ahi * blo);
+}
+
+//---------------------------------------------------------
+// h = e + f, expansions are ordered by increasing magnitude
+// and free of zero components, returns the length of h.
+static int		SG_Exact_Sum			(int ne, const double *e, int nf, const double *f, double *h)
+{
+	int		ie = 0, jf = 0, nh = 0;
+	double	Q, Qnew, hh, enow = e[0], fnow = f[0];
+
+	if( (fnow > enow) == (fnow > -enow) )	{	Q	= enow;	if( ++ie < ne )	enow	= e[ie];	}
+	else									{	Q	= fnow;	if( ++jf < nf )	fnow	= f[jf];	}
+
+	if( ie < ne && jf < nf )
 	{
-		return( -1 );
+		if( (fnow > enow) == (fnow > -enow) )	{	SG_Exact_Fast_Two_Sum(enow, Q, Qnew, hh);	if( ++ie < ne )	enow	= e[ie];	}
+		else									{	SG_Exact_Fast_Two_Sum(fnow, Q, Qnew, hh);	if( ++jf < nf )	fnow	= f[jf];	}
+
+		Q	= Qnew;	if( hh != 0.0 )	{	h[nh++]	= hh;	}
+
+		while( ie < ne && jf < nf )
+		{
+			if( (fnow > enow) == (fnow > -enow) )	{	SG_Exact_Two_Sum(Q, enow, Qnew, hh);	if( ++ie < ne )	enow	= e[ie];	}
+			else									{	SG_Exact_Two_Sum(Q, fnow, Qnew, hh);	if( ++jf < nf )	fnow	= f[jf];	}
+
+			Q	= Qnew;	if( hh != 0.0 )	{	h[nh++]	= hh;	}
+		}
 	}
 
-	if( p1->Get_X() > p2->Get_X() )
+	while( ie < ne )	{	SG_Exact_Two_Sum(Q, enow, Qnew, hh);	if( ++ie < ne )	enow	= e[ie];	Q	= Qnew;	if( hh != 0.0 )	{	h[nh++]	= hh;	}	}
+	while( jf < nf )	{	SG_Exact_Two_Sum(Q, fnow, Qnew, hh);	if( ++jf < nf )	fnow	= f[jf];	Q	= Qnew;	if( hh != 0.0 )	{	h[nh++]	= hh;	}	}
+
+	if( Q != 0.0 || nh == 0 )
 	{
-		return(  1 );
+		h[nh++]	= Q;
 	}
 
-	if( p1->Get_Y() < p2->Get_Y() )
+	return( nh );
+}
+
+//---------------------------------------------------------
+// h = e * b
+static int		SG_Exact_Scale			(int ne, const double *e, double b, double *h)
+{
+	int		nh	= 0;
+	double	bhi, blo, Q, hh, p1, p0, Sum;
+
+	SG_Exact_Split(b, bhi, blo);
+
+	SG_Exact_Two_Product(e[0], b, bhi, blo, Q, hh);	if( hh != 0.0 )	{	h[nh++]	= hh;	}
+
+	for(int i=1; i<ne; i++)
 	{
-		return( -1 );
+		SG_Exact_Two_Product(e[i], b, bhi, blo, p1, p0);
+
+		SG_Exact_Two_Sum     (Q , p0 , Sum, hh);	if( hh != 0.0 )	{	h[nh++]	= hh;	}
+		SG_Exact_Fast_Two_Sum(p1, Sum, Q  , hh);	if( hh != 0.0 )	{	h[nh++]	= hh;	}
 	}
 
-	if( p1->Get_Y() > p2->Get_Y() )
+	if( Q != 0.0 || nh == 0 )
 	{
-		return(  1 );
+		h[nh++]	= Q;
 	}
 
-	return( 0 );
+	return( nh );
 }
 
+//---------------------------------------------------------
+// h = e * f, h needs 2 * ne * nf elements
+static int		SG_Exact_Product		(int ne, const double *e, int nf, const double *f, double *h)
+{
+	double	t[2 * 16], s[2 * 2 * 16 * 16];	// ne <= 16
 
-///////////////////////////////////////////////////////////
-//														 //
-//														 //
-//														 //
-///////////////////////////////////////////////////////////
+	int	nh	= SG_Exact_Scale(ne, e, f[0], h);
+
+	for(int i=1; i<nf; i++)
+	{
+		int	nt	= SG_Exact_Scale(ne, e, f[i], t);
+
+		memcpy(s, h, nh * sizeof(double));
+
+		nh	= SG_Exact_Sum(nh, s, nt, t, h);
+	}
+
+	return( nh );
+}
 
 //---------------------------------------------------------
-bool CSG_TIN::_Triangulate(void)
+// h = a*d - b*c, each argument a two component expansion, h needs 16 elements
+static int		SG_Exact_Cross			(const double *a, const double *b, const double *c, const double *d, double *h)
 {
-	bool			bResult;
-	int				i, j, n, nTriangles;
-	CSG_TIN_Node	**Nodes;
-	TTIN_Triangle	*Triangles;
-
-	//-----------------------------------------------------
-	_Destroy_Edges();
-	_Destroy_Triangles();
+	double	ad[8], bc[8];
 
-	//-----------------------------------------------------
-	Nodes	= (CSG_TIN_Node **)SG_Malloc((Get_Node_Count() + 3) * sizeof(CSG_TIN_Node *));
+	int	nad	= SG_Exact_Product(2, a, 2, d, ad);
+	int	nbc	= SG_Exact_Product(2, b, 2, c, bc);
 
-	for(i=0; i<Get_Node_Count(); i++)
+	for(int i=0; i<nbc; i++)
 	{
-		Nodes[i]	= Get_Node(i);
-		Nodes[i]	->_Del_Relations();
+		bc[i]	= -bc[i];
 	}
 
-	//-----------------------------------------------------
-	qsort(Nodes, Get_Node_Count(), sizeof(CSG_TIN_Node *), SG_TIN_Compare);
+	return( SG_Exact_Sum(nad, ad, nbc, bc, h) );
+}
 
-	for(i=0, j=0, n=Get_Node_Count(); j<n; i++)	// remove duplicates
-	{
-		Nodes[i]	= Nodes[j++];
+//---------------------------------------------------------
+/**
+  * Positive if the points a, b and c are arranged counter-clockwise,
+  * negative if clockwise and zero if they are collinear.
+*/
+static double	SG_TIN_Orient			(const TSG_Point &a, const TSG_Point &b, const TSG_Point &c)
+{
+	double	l	= (a.x - c.x) * (b.y - c.y);
+	double	r	= (a.y - c.y) * (b.x - c.x);
+	double	d	= l - r;
 
-		while(	j < n
-			&&	Nodes[i]->Get_X() == Nodes[j]->Get_X()
-			&&	Nodes[i]->Get_Y() == Nodes[j]->Get_Y() )
-		{
-			Del_Node(Nodes[j++]->Get_Index(), false);
-		}
+	if( fabs(d) > EXACT_ORIENT_BOUND * (fabs(l) + fabs(r)) )
+	{
+		return( d );
 	}
 
 	//-----------------------------------------------------
-	for(i=Get_Node_Count(); i<Get_Node_Count()+3; i++)
+	double	acx[2], acy[2], bcx[2], bcy[2], h[16];
+
+	SG_Exact_Two_Diff(a.x, c.x, acx[1], acx[0]);
+	SG_Exact_Two_Diff(a.y, c.y, acy[1], acy[0]);
+	SG_Exact_Two_Diff(b.x, c.x, bcx[1], bcx[0]);
+	SG_Exact_Two_Diff(b.y, c.y, bcy[1], bcy[0]);
+
+	int	n	= SG_Exact_Cross(acx, acy, bcx, bcy, h);
+
+	return( h[n - 1] );
+}
+
+//---------------------------------------------------------
+/**
+  * Positive if d lies inside the circle through the counter-clockwise
+  * arranged points a, b and c, negative if outside, zero if on the circle.
+*/
+static double	SG_TIN_InCircle			(const TSG_Point &a, const TSG_Point &b, const TSG_Point &c, const TSG_Point &d)
+{
+	double	adx	= a.x - d.x, ady = a.y - d.y;
+	double	bdx	= b.x - d.x, bdy = b.y - d.y;
+	double	cdx	= c.x - d.x, cdy = c.y - d.y;
+
+	double	bc	= bdx * cdy, cb	= cdx * bdy, al	= adx * adx + ady * ady;
+	double	ca	= cdx * ady, ac	= adx * cdy, bl	= bdx * bdx + bdy * bdy;
+	double	ab	= adx * bdy, ba	= bdx * ady, cl	= cdx * cdx + cdy * cdy;
+
+	double	det	= al * (bc - cb) + bl * (ca - ac) + cl * (ab - ba);
+
+	double	sum	= al * (fabs(bc) + fabs(cb)) + bl * (fabs(ca) + fabs(ac)) + cl * (fabs(ab) + fabs(ba));
+
+	if( fabs(det) > EXACT_INCIRCLE_BOUND * sum )
 	{
-		Nodes[i]	= new CSG_TIN_Node(this, 0);
+		return( det );
 	}
 
 	//-----------------------------------------------------
-	Triangles	= (TTIN_Triangle *)SG_Malloc(3 * Get_Node_Count() * sizeof(TTIN_Triangle));
+	double	ax[2], ay[2], bx[2], by[2], cx[2], cy[2];
 
-	if( (bResult = _Triangulate(Nodes, Get_Node_Count(), Triangles, nTriangles)) == true )
-	{
-		for(i=0; i<nTriangles && SG_UI_Process_Set_Progress(i, nTriangles); i++)
-		{
-			_Add_Triangle(Nodes[Triangles[i].p1], Nodes[Triangles[i].p2], Nodes[Triangles[i].p3]);
-		}
-	}
+	SG_Exact_Two_Diff(a.x, d.x, ax[1], ax[0]);	SG_Exact_Two_Diff(a.y, d.y, ay[1], ay[0]);
+	SG_Exact_Two_Diff(b.x, d.x, bx[1], bx[0]);	SG_Exact_Two_Diff(b.y, d.y, by[1], by[0]);
+	SG_Exact_Two_Diff(c.x, d.x, cx[1], cx[0]);	SG_Exact_Two_Diff(c.y, d.y, cy[1], cy[0]);
 
-	SG_Free(Triangles);
+	double	s[3][512], t[1024], h[1536], xx[8], yy[8], lift[16], cross[16];
+	int		ns[3], nt, nh;
 
-	//-----------------------------------------------------
-	for(i=Get_Node_Count(); i<Get_Node_Count()+3; i++)
+	const double	*P[3][2]	= { { ax, ay }, { bx, by }, { cx, cy } };
+
+	for(int i=0; i<3; i++)
 	{
-		delete(Nodes[i]);
-	}
+		const double	*px	= P[ i         ][0], *py	= P[ i         ][1];
+		const double	*qx	= P[(i + 1) % 3][0], *qy	= P[(i + 1) % 3][1];
+		const double	*rx	= P[(i + 2) % 3][0], *ry	= P[(i + 2) % 3][1];
 
-	SG_Free(Nodes);
+		int	nxx		= SG_Exact_Product(2, px, 2, px, xx);
+		int	nyy		= SG_Exact_Product(2, py, 2, py, yy);
+		int	nlift	= SG_Exact_Sum(nxx, xx, nyy, yy, lift);
+		int	ncross	= SG_Exact_Cross(qx, qy, rx, ry, cross);
 
-	SG_UI_Process_Set_Ready();
+		ns[i]	= SG_Exact_Product(nlift, lift, ncross, cross, s[i]);
+	}
 
-	return( bResult );
+	nt	= SG_Exact_Sum(ns[0], s[0], ns[1], s[1], t);
+	nh	= SG_Exact_Sum(nt   , t   , ns[2], s[2], h);
+
+	return( h[nh - 1] );
 }
 
 
 ///////////////////////////////////////////////////////////
 //														 //
-//														 //
+//					Triangle Mesh						 //
 //														 //
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CSG_TIN::_Triangulate(CSG_TIN_Node **Points, int nPoints, TTIN_Triangle *Triangles, int &nTriangles)
+// Triangles are stored as vertex and neighbour index triplets,
+// vertices are ordered counter-clockwise and the neighbour at
+// position i shares the edge opposite to vertex i.
+//---------------------------------------------------------
+class CSG_TIN_Mesh
 {
-	int			i, j, k, inside, trimax,
-				nedge		= 0,
-				emax		= 200,
-				status		= 0,
-				*complete	= NULL;
+public:
+
+	CSG_TIN_Mesh(TSG_Point *Points, int nPoints)
+	{
+		m_Points	= Points;
+		m_nMax		= 2 * nPoints + 4;
+		m_nTriangles= 0;
+		m_V			= (int *)SG_Malloc(3 * m_nMax * sizeof(int));
+		m_N			= (int *)SG_Malloc(3 * m_nMax * sizeof(int));
+		m_Stack		= NULL;
+		m_nStack	= m_nStack_Max	= 0;
+	}
+
+	~CSG_TIN_Mesh(void)
+	{
+		SG_Free(m_V);
+		SG_Free(m_N);
+		SG_FREE_SAFE(m_Stack);
+	}
 
-	double		dmax, xp, yp, x1, y1, x2, y2, x3, y3, xc, yc, r;
+	bool			is_Okay			(void)	const	{	return( m_V && m_N );	}
 
-	TTIN_Edge	*edges		= NULL;
+	int				Get_Count		(void)	const	{	return( m_nTriangles );	}
+	const int *		Get_Vertices	(int t)	const	{	return( m_V + 3 * t );	}
 
 	//-----------------------------------------------------
-	// Update extent...
-	if( nPoints >= 3 )
+	int				Add				(int a, int b, int c)
 	{
-		TSG_Rect	r;
+		_Set(m_nTriangles, a, b, c, -1, -1, -1);
 
-		m_Extent.Assign(
-			Points[0]->Get_X(), Points[0]->Get_Y(),
-			Points[0]->Get_X(), Points[0]->Get_Y()
-		);
+		return( m_nTriangles++ );
+	}
+
+	//-----------------------------------------------------
+	bool			Insert			(int p)
+	{
+		int	t, Edge;
 
-		for(i=1; i<nPoints; i++)
+		if( (t = _Locate(m_Points[p], Edge)) < 0 )
 		{
-			r.xMin	= r.xMax	= Points[i]->Get_X();
-			r.yMin	= r.yMax	= Points[i]->Get_Y();
+			return( false );
+		}
 
-			m_Extent.Union(r);
+		if( Edge < 0 )
+		{
+			_Split_Triangle(t, p);
 		}
+		else
+		{
+			_Split_Edge(t, Edge, p);
+		}
+
+		_Legalize(p);
+
+		return( true );
 	}
-	else
+
+
+private:
+
+	int				m_nTriangles, m_nMax, m_Last, *m_V, *m_N, *m_Stack, m_nStack, m_nStack_Max;
+
+	TSG_Point		*m_Points;
+
+
+	//-----------------------------------------------------
+	void			_Set			(int t, int a, int b, int c, int na, int nb, int nc)
 	{
-		return( false );
+		int	*V	= m_V + 3 * t;	V[0]	= a;	V[1]	= b;	V[2]	= c;
+		int	*N	= m_N + 3 * t;	N[0]	= na;	N[1]	= nb;	N[2]	= nc;
+
+		m_Last	= t;
+	}
+
+	void			_Replace		(int t, int Old, int New)
+	{
+		if( t >= 0 )
+		{
+			int	*N	= m_N + 3 * t;
+
+			if( N[0] == Old )	N[0]	= New;	else
+			if( N[1] == Old )	N[1]	= New;	else
+			if( N[2] == Old )	N[2]	= New;
+		}
+	}
+
+	void			_Push			(int t)
+	{
+		if( m_nStack >= m_nStack_Max )
+		{
+			m_Stack	= (int *)SG_Realloc(m_Stack, (m_nStack_Max += 256) * sizeof(int));
+		}
+
+		m_Stack[m_nStack++]	= t;
 	}
 
 	//-----------------------------------------------------
-	// Allocate memory for the completeness list, flag for each triangle
-	trimax	= 4 * nPoints;
-	if( (complete	= (int       *)SG_Malloc(trimax * sizeof(int))) == NULL )
+	// visibility walk, returns the triangle containing p and
+	// the edge p is located on (-1 if p is inside)
+	int				_Locate			(const TSG_Point &p, int &Edge)
 	{
-		status	= 1;
-		goto skip;
+		for(int t=m_Last, nSteps=0; t>=0 && nSteps<=m_nTriangles; nSteps++)
+		{
+			int	*V	= m_V + 3 * t, Next = -1;
+
+			Edge	= -1;
+
+			for(int k=0, i=nSteps%3; k<3 && Next<0; k++, i=(i+1)%3)
+			{
+				double	d	= SG_TIN_Orient(m_Points[V[(i + 1) % 3]], m_Points[V[(i + 2) % 3]], p);
+
+				if( d < 0.0 )
+				{
+					Next	= m_N[3 * t + i];
+				}
+				else if( d == 0.0 )
+				{
+					Edge	= Edge < 0 ? i : 3;	// on two edges means on a vertex
+				}
+			}
+
+			if( Next < 0 )
+			{
+				return( Edge < 3 ? t : -1 );
+			}
+
+			t	= Next;
+		}
+
+		//-------------------------------------------------
+		for(int t=0; t<m_nTriangles; t++)	// should not be needed, just to be safe
+		{
+			int	*V	= m_V + 3 * t, nZero = 0;
+
+			double	d0	= SG_TIN_Orient(m_Points[V[1]], m_Points[V[2]], p);
+			double	d1	= SG_TIN_Orient(m_Points[V[2]], m_Points[V[0]], p);
+			double	d2	= SG_TIN_Orient(m_Points[V[0]], m_Points[V[1]], p);
+
+			if( d0 >= 0.0 && d1 >= 0.0 && d2 >= 0.0 )
+			{
+				Edge	= -1;
+
+				if( d0 == 0.0 )	{	Edge	= 0;	nZero++;	}
+				if( d1 == 0.0 )	{	Edge	= 1;	nZero++;	}
+				if( d2 == 0.0 )	{	Edge	= 2;	nZero++;	}
+
+				return( nZero < 2 ? t : -1 );
+			}
+		}
+
+		return( -1 );
 	}
 
 	//-----------------------------------------------------
-	// Allocate memory for the edge list
-	if( (edges		= (TTIN_Edge *)SG_Malloc(emax   * sizeof(TTIN_Edge))) == NULL )
+	void			_Split_Triangle	(int t, int p)
 	{
-		status	= 2;
-		goto skip;
+		int	*V	= m_V + 3 * t, a = V[0], b = V[1], c = V[2];
+		int	*N	= m_N + 3 * t, na = N[0], nb = N[1], nc = N[2];
+
+		int	t1	= m_nTriangles++;
+		int	t2	= m_nTriangles++;
+
+		_Set(t , a, b, p, t1, t2, nc);
+		_Set(t1, b, c, p, t2, t , na);
+		_Set(t2, c, a, p, t , t1, nb);
+
+		_Replace(na, t, t1);
+		_Replace(nb, t, t2);
+
+		_Push(t); _Push(t1); _Push(t2);
 	}
 
 	//-----------------------------------------------------
-	//	Find the maximum and minimum vertex bounds.
-	//	This is to allow calculation of the bounding triangle
-	//	Set up the supertriangle
-	//	This is a triangle which encompasses all the sample points.
-	//	The supertriangle coordinates are added to the end of the
-	//	vertex list. The supertriangle is the first triangle in
-	//	the triangle list.
+	void			_Split_Edge		(int t, int i, int p)
+	{
+		int	*V	= m_V + 3 * t, a = V[i], b = V[(i + 1) % 3], c = V[(i + 2) % 3];
+		int	*N	= m_N + 3 * t, u = N[i], nb = N[(i + 1) % 3], nc = N[(i + 2) % 3];
+
+		int	t1	= m_nTriangles++;
+
+		if( u < 0 )	// edge on the outer boundary
+		{
+			_Set(t , a, b, p, -1, t1, nc);
+			_Set(t1, a, p, c, -1, nb, t );
+
+			_Replace(nb, t, t1);
 
-	dmax	= m_Extent.Get_XRange() > m_Extent.Get_YRange() ? m_Extent.Get_XRange() : m_Extent.Get_YRange();
+			_Push(t); _Push(t1);
 
-	Points[nPoints + 0]->m_Point.x	= m_Extent.Get_XCenter() - 20 * dmax;
-	Points[nPoints + 1]->m_Point.x	= m_Extent.Get_XCenter();
-	Points[nPoints + 2]->m_Point.x	= m_Extent.Get_XCenter() + 20 * dmax;
+			return;
+		}
+
+		int	k	= m_N[3 * u] == t ? 0 : m_N[3 * u + 1] == t ? 1 : 2;
+		int	d	= m_V[3 * u + k], xb = m_N[3 * u + (k + 2) % 3], xc = m_N[3 * u + (k + 1) % 3];	// u = (d, c, b)
 
-	Points[nPoints + 0]->m_Point.y	= m_Extent.Get_YCenter() -      dmax;
-	Points[nPoints + 1]->m_Point.y	= m_Extent.Get_YCenter() + 20 * dmax;
-	Points[nPoints + 2]->m_Point.y	= m_Extent.Get_YCenter() -      dmax;
+		int	u1	= m_nTriangles++;
 
-	Triangles[0].p1	= nPoints;
-	Triangles[0].p2	= nPoints + 1;
-	Triangles[0].p3	= nPoints + 2;
+		_Set(t , a, b, p, u1, t1, nc);
+		_Set(t1, a, p, c, u , nb, t );
+		_Set(u , d, c, p, t1, u1, xb);
+		_Set(u1, d, p, b, t , xc, u );
 
-	complete [0]	= false;
+		_Replace(nb, t, t1);
+		_Replace(xc, u, u1);
 
-	nTriangles		= 1;
+		_Push(t); _Push(t1); _Push(u); _Push(u1);
+	}
 
 	//-----------------------------------------------------
-	//	Include each point one at a time into the existing mesh
-	for(i=0; i<nPoints && SG_UI_Process_Set_Progress(i, nPoints); i++)
+	// restores the Delaunay criterion for the edges opposite to p
+	void			_Legalize		(int p)
 	{
-		xp		= Points[i]->Get_X();
-		yp		= Points[i]->Get_Y();
-		nedge	= 0;
-
-		//-------------------------------------------------
-		//	Set up the edge buffer.
-		//	If the point (xp,yp) lies inside the circumcircle then the
-		//	three edges of that triangle are added to the edge buffer
-		//	and that triangle is removed.
-		for(j=0; j<nTriangles; j++)
+		while( m_nStack > 0 )
 		{
-			if( complete[j] )
+			int	t	= m_Stack[--m_nStack], *V = m_V + 3 * t, *N = m_N + 3 * t;
+
+			int	j	= V[0] == p ? 0 : V[1] == p ? 1 : 2;
+			int	u	= N[j];
+
+			if( u < 0 )
 			{
 				continue;
 			}
 
-			x1		= Points[Triangles[j].p1]->Get_X();
-			y1		= Points[Triangles[j].p1]->Get_Y();
-			x2		= Points[Triangles[j].p2]->Get_X();
-			y2		= Points[Triangles[j].p2]->Get_Y();
-			x3		= Points[Triangles[j].p3]->Get_X();
-			y3		= Points[Triangles[j].p3]->Get_Y();
-
-			inside	= _CircumCircle(xp, yp, x1, y1, x2, y2, x3, y3, &xc, &yc, &r);
+			int	b	= V[(j + 1) % 3], c = V[(j + 2) % 3], tb = N[(j + 1) % 3], tc = N[(j + 2) % 3];
+			int	k	= m_N[3 * u] == t ? 0 : m_N[3 * u + 1] == t ? 1 : 2;
+			int	d	= m_V[3 * u + k], ub = m_N[3 * u + (k + 2) % 3], uc = m_N[3 * u + (k + 1) % 3];	// u = (d, c, b)
 
-			if( xc + r < xp )
+			if( SG_TIN_InCircle(m_Points[p], m_Points[b], m_Points[c], m_Points[d]) > 0.0 )
 			{
-				complete[j]	= true;
+				_Set(t, p, b, d, uc, u, tc);
+				_Set(u, p, d, c, ub, tb, t);
+
+				_Replace(uc, u, t);
+				_Replace(tb, t, u);
+
+				_Push(t); _Push(u);
 			}
+		}
+	}
+};
 
-			if( inside )
-			{
-				// Check that we haven't exceeded the edge list size
-				if( nedge + 3 >= emax )
-				{
-					emax	+= 100;
 
-					if( (edges = (TTIN_Edge *)SG_Realloc(edges, emax * sizeof(TTIN_Edge))) == NULL )
-					{
-						status	= 3;
-						goto skip;
-					}
-				}
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
 
-				edges[nedge + 0].p1	= Triangles[j].p1;
-				edges[nedge + 0].p2	= Triangles[j].p2;
-				edges[nedge + 1].p1	= Triangles[j].p2;
-				edges[nedge + 1].p2	= Triangles[j].p3;
-				edges[nedge + 2].p1	= Triangles[j].p3;
-				edges[nedge + 2].p2	= Triangles[j].p1;
+//---------------------------------------------------------
+int SG_TIN_Compare(const void *pp1, const void *pp2)
+{
+	CSG_TIN_Node	*p1	= *((CSG_TIN_Node **)pp1),
+					*p2	= *((CSG_TIN_Node **)pp2);
 
-				nedge	+= 3;
+	if( p1->Get_X() < p2->Get_X() )
+	{
+		return( -1 );
+	}
 
-				Triangles[j]	= Triangles[nTriangles - 1];
-				complete [j]	= complete [nTriangles - 1];
+	if( p1->Get_X() > p2->Get_X() )
+	{
+		return(  1 );
+	}
 
-				nTriangles--;
-				j--;
-			}
-		}
+	if( p1->Get_Y() < p2->Get_Y() )
+	{
+		return( -1 );
+	}
 
-		//-------------------------------------------------
-		//	Tag multiple edges
-		//	Note: if all triangles are specified anticlockwise then all
-		//	      interior edges are opposite pointing in direction.
-		for(j=0; j<nedge-1; j++)
+	if( p1->Get_Y() > p2->Get_Y() )
+	{
+		return(  1 );
+	}
+
+	return( 0 );
+}
+
+//---------------------------------------------------------
+typedef struct
+{
+	unsigned int	Key;
+
+	int				Index;
+}
+TSG_TIN_Hilbert;
+
+//---------------------------------------------------------
+int SG_TIN_Compare_Hilbert(const void *pp1, const void *pp2)
+{
+	const TSG_TIN_Hilbert	*p1	= (const TSG_TIN_Hilbert *)pp1,
+							*p2	= (const TSG_TIN_Hilbert *)pp2;
+
+	return( p1->Key < p2->Key ? -1 : p1->Key > p2->Key ? 1 : p1->Index - p2->Index );
+}
+
+//---------------------------------------------------------
+// distance of the cell (x, y) along a Hilbert curve covering 2^16 x 2^16 cells
+static unsigned int SG_TIN_Get_Hilbert(unsigned int x, unsigned int y)
+{
+	unsigned int	d	= 0;
+
+	for(unsigned int s=1u<<15; s>0; s>>=1)
+	{
+		unsigned int	rx	= (x & s) > 0;
+		unsigned int	ry	= (y & s) > 0;
+
+		d	+= s * s * ((3 * rx) ^ ry);
+
+		if( ry == 0 )
 		{
-			for(k=j+1; k<nedge; k++)
+			if( rx == 1 )
 			{
-				if( (edges[j].p1 == edges[k].p2) && (edges[j].p2 == edges[k].p1) )
-				{
-					edges[j].p1 = -1;
-					edges[j].p2 = -1;
-					edges[k].p1 = -1;
-					edges[k].p2 = -1;
-				}
-
-				// Shouldn't need the following, see note above
-				if( (edges[j].p1 == edges[k].p1) && (edges[j].p2 == edges[k].p2) )
-				{
-					edges[j].p1 = -1;
-					edges[j].p2 = -1;
-					edges[k].p1 = -1;
-					edges[k].p2 = -1;
-				}
+				x	= s - 1 - x;
+				y	= s - 1 - y;
 			}
+
+			unsigned int	t	= x;	x	= y;	y	= t;
 		}
+	}
 
-		//-------------------------------------------------
-		//	Form new triangles for the current point
-		//	Skipping over any tagged edges.
-		//	All edges are arranged in clockwise order.
-		for(j=0; j<nedge; j++)
+	return( d );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_TIN::_Triangulate(void)
+{
+	bool			bResult;
+	int				i, j, n, nTriangles;
+	CSG_TIN_Node	**Nodes;
+	TTIN_Triangle	*Triangles;
+
+	//-----------------------------------------------------
+	_Destroy_Edges();
+	_Destroy_Triangles();
+
+	//-----------------------------------------------------
+	Nodes	= (CSG_TIN_Node **)SG_Malloc(Get_Node_Count() * sizeof(CSG_TIN_Node *));
+
+	for(i=0; i<Get_Node_Count(); i++)
+	{
+		Nodes[i]	= Get_Node(i);
+		Nodes[i]	->_Del_Relations();
+	}
+
+	//-----------------------------------------------------
+	qsort(Nodes, Get_Node_Count(), sizeof(CSG_TIN_Node *), SG_TIN_Compare);
+
+	bool	bDuplicates	= false;
+
+	for(i=0, j=0, n=Get_Node_Count(); j<n; i++)	// remove duplicates
+	{
+		Nodes[i]	= Nodes[j++];
+
+		while(	j < n
+			&&	Nodes[i]->Get_X() == Nodes[j]->Get_X()
+			&&	Nodes[i]->Get_Y() == Nodes[j]->Get_Y() )
 		{
-			if( edges[j].p1 < 0 || edges[j].p2 < 0 )
+			if( !bDuplicates )
 			{
-				continue;
-			}
+				bDuplicates	= true;
 
-			if( nTriangles >= trimax )
-			{
-				status	= 4;
-				goto skip;
+				Select();	// clear a previous selection
 			}
 
-			Triangles[nTriangles].p1	= edges[j].p1;
-			Triangles[nTriangles].p2	= edges[j].p2;
-			Triangles[nTriangles].p3	= i;
-			complete [nTriangles]		= false;
-			nTriangles++;
+			Select(Nodes[j++], true);
 		}
 	}
 
-	//-----------------------------------------------------
-	//	Remove triangles with supertriangle vertices
-	//	These are triangles which have a vertex number greater than nPoints
-	for(i=0; i<nTriangles; i++)
+	if( bDuplicates )	// delete all at once, one by one would be quadratic
 	{
-		if(	Triangles[i].p1 >= nPoints
-		||	Triangles[i].p2 >= nPoints
-		||	Triangles[i].p3 >= nPoints )
-		{
-			Triangles[i] = Triangles[nTriangles - 1];
-			nTriangles--;
-			i--;
-		}
+		Del_Selection();
 	}
 
 	//-----------------------------------------------------
-	skip:
+	Triangles	= (TTIN_Triangle *)SG_Malloc(2 * (Get_Node_Count() + 2) * sizeof(TTIN_Triangle));
 
-	if( edges )
+	if( (bResult = _Triangulate(Nodes, Get_Node_Count(), Triangles, nTriangles)) == true )
 	{
-		SG_Free(edges);
+		for(i=0; i<nTriangles && SG_UI_Process_Set_Progress(i, nTriangles); i++)
+		{
+			_Add_Triangle(Nodes[Triangles[i].p1], Nodes[Triangles[i].p2], Nodes[Triangles[i].p3]);
+		}
 	}
 
-	if( complete )
-	{
-		SG_Free(complete);
-	}
+	SG_Free(Triangles);
 
-	return( status == 0 );
+	SG_Free(Nodes);
+
+	SG_UI_Process_Set_Ready();
+
+	return( bResult );
 }
 
 
@@ -435,71 +736,110 @@ bool CSG_TIN::_Triangulate(CSG_TIN_Node **Points, int nPoints, TTIN_Triangle *Tr
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-//	Return true if a point (xp,yp) is inside the circumcircle made up
-//	of the points (x1,y1), (x2,y2), (x3,y3)
-//	The circumcircle centre is returned in (xc,yc) and the radius r
-//	NOTE: A point on the edge is inside the circumcircle
-//
-
-//---------------------------------------------------------
-#define IS_IDENTICAL(a, b)	(a == b)
-//#define IS_IDENTICAL(a, b)	(fabs(a - b) < 0.0001)
-
-//---------------------------------------------------------
-int CSG_TIN::_CircumCircle(double xp, double yp, double x1, double y1, double x2, double y2, double x3, double y3, double *xc, double *yc, double *r)
+bool CSG_TIN::_Triangulate(CSG_TIN_Node **Nodes, int nNodes, TTIN_Triangle *Triangles, int &nTriangles)
 {
-	double	m1, m2, mx1, mx2, my1, my2,
-			dx, dy, rsqr, drsqr;
+	int		i;
+
+	nTriangles	= 0;
 
-	// Check for coincident points
-	if( IS_IDENTICAL(y1, y2) && IS_IDENTICAL(y2, y3) )
+	if( nNodes < 3 )
 	{
 		return( false );
 	}
 
 	//-----------------------------------------------------
-	if( IS_IDENTICAL(y2, y1) )
+	// Update extent...
+	m_Extent.Assign(Nodes[0]->Get_X(), Nodes[0]->Get_Y(), Nodes[0]->Get_X(), Nodes[0]->Get_Y());
+
+	for(i=1; i<nNodes; i++)
 	{
-		m2	= -(x3 - x2) / (y3 - y2);
-		mx2	=  (x2 + x3) / 2.0;
-		my2	=  (y2 + y3) / 2.0;
-		*xc	=  (x2 + x1) / 2.0;
+		m_Extent.Union(Nodes[i]->Get_Point());
+	}
 
-		*yc	= m2 * (*xc - mx2) + my2;
+	//-----------------------------------------------------
+	// Points with a surrounding super triangle appended,
+	// which is far enough away not to affect the hull.
+
+	TSG_Point	*Points	= (TSG_Point *)SG_Malloc((nNodes + 3) * sizeof(TSG_Point));
+
+	for(i=0; i<nNodes; i++)
+	{
+		Points[i]	= Nodes[i]->Get_Point();
 	}
-	else if( IS_IDENTICAL(y3, y2) )
+
+	double	dMax	= m_Extent.Get_XRange() > m_Extent.Get_YRange() ? m_Extent.Get_XRange() : m_Extent.Get_YRange();
+
+	if( dMax <= 0.0 )
 	{
-		m1	= -(x2 - x1) / (y2 - y1);
-		mx1	=  (x1 + x2) / 2.0;
-		my1	=  (y1 + y2) / 2.0;
-		*xc	=  (x3 + x2) / 2.0;
+		SG_Free(Points);
 
-		*yc	= m1 * (*xc - mx1) + my1;
+		return( false );
 	}
-	else
-	{
-		m1	= -(x2 - x1) / (y2 - y1);
-		m2	= -(x3 - x2) / (y3 - y2);
-		mx1	=  (x1 + x2) / 2.0;
-		mx2	=  (x2 + x3) / 2.0;
-		my1	=  (y1 + y2) / 2.0;
-		my2	=  (y2 + y3) / 2.0;
 
-		*xc	= (m1 * mx1 - m2 * mx2 + my2 - my1) / (m1 - m2);
-		*yc	= m1 * (*xc - mx1) + my1;
+	dMax	*= 1000.0;
+
+	Points[nNodes + 0].x	= m_Extent.Get_XCenter() - 2 * dMax;	Points[nNodes + 0].y	= m_Extent.Get_YCenter() -     dMax;
+	Points[nNodes + 1].x	= m_Extent.Get_XCenter() + 2 * dMax;	Points[nNodes + 1].y	= m_Extent.Get_YCenter() -     dMax;
+	Points[nNodes + 2].x	= m_Extent.Get_XCenter()           ;	Points[nNodes + 2].y	= m_Extent.Get_YCenter() + 2 * dMax;
+
+	//-----------------------------------------------------
+	// Insertion order along a Hilbert curve keeps the walks short.
+
+	TSG_TIN_Hilbert	*Order	= (TSG_TIN_Hilbert *)SG_Malloc(nNodes * sizeof(TSG_TIN_Hilbert));
+
+	double	dx	= m_Extent.Get_XRange() > 0.0 ? 65535.0 / m_Extent.Get_XRange() : 0.0;
+	double	dy	= m_Extent.Get_YRange() > 0.0 ? 65535.0 / m_Extent.Get_YRange() : 0.0;
+
+	#pragma omp parallel for
+	for(i=0; i<nNodes; i++)
+	{
+		Order[i].Index	= i;
+		Order[i].Key	= SG_TIN_Get_Hilbert(
+			(unsigned int)(dx * (Points[i].x - m_Extent.Get_XMin())),
+			(unsigned int)(dy * (Points[i].y - m_Extent.Get_YMin()))
+		);
 	}
 
+	qsort(Order, nNodes, sizeof(TSG_TIN_Hilbert), SG_TIN_Compare_Hilbert);
+
 	//-----------------------------------------------------
-	dx		= x2 - *xc;
-	dy		= y2 - *yc;
-	rsqr	= dx*dx + dy*dy;
-	*r		= sqrt(rsqr);
+	CSG_TIN_Mesh	Mesh(Points, nNodes + 3);
+
+	bool	bResult	= Mesh.is_Okay();
 
-	dx		= xp - *xc;
-	dy		= yp - *yc;
-	drsqr	= dx*dx + dy*dy;
+	if( bResult )
+	{
+		Mesh.Add(nNodes + 0, nNodes + 1, nNodes + 2);
+
+		for(i=0; i<nNodes && SG_UI_Process_Set_Progress(i, nNodes); i++)
+		{
+			Mesh.Insert(Order[i].Index);	// fails only for duplicates, which have been removed before
+		}
+
+		//-------------------------------------------------
+		// Remove triangles with super triangle vertices
 
-	return( drsqr <= rsqr ? 1 : 0 );
+		for(i=0; i<Mesh.Get_Count(); i++)
+		{
+			const int	*V	= Mesh.Get_Vertices(i);
+
+			if( V[0] < nNodes && V[1] < nNodes && V[2] < nNodes )
+			{
+				Triangles[nTriangles].p1	= V[0];
+				Triangles[nTriangles].p2	= V[1];
+				Triangles[nTriangles].p3	= V[2];
+
+				nTriangles++;
+			}
+		}
+
+		bResult	= nTriangles > 0;
+	}
+
+	SG_Free(Order );
+	SG_Free(Points);
+
+	return( bResult );
 }
 
 
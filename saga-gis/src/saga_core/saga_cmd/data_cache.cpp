@@ -0,0 +1,432 @@
+/**********************************************************
+ * Version $Id$
+ *********************************************************/
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                Command Line Interface                 //
+//                                                       //
+//                   Program: SAGA_CMD                   //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                    data_cache.cpp                     //
+//                                                       //
+//                 Copyright (C) 2014 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation; version 2 of the License.   //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not,       //
+// write to the Free Software Foundation, Inc.,          //
+// 51 Franklin Street, 5th Floor, Boston, MA 02110-1301, //
+// USA.                                                  //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                Institute of Geography                 //
+//                University of Hamburg                  //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include <wx/filefn.h>
+
+#include "data_cache.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CCMD_Data_Cache &	CMD_Get_Data_Cache	(void)
+{
+	static CCMD_Data_Cache	Cache;
+
+	return( Cache );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CCMD_Data_Cache::CCMD_Data_Cache(void)
+{
+	m_Entries.Create(sizeof(TCMD_Cache_Entry));
+}
+
+//---------------------------------------------------------
+CCMD_Data_Cache::~CCMD_Data_Cache(void)
+{
+	for(int i=0; i<_Get_Count(); i++)
+	{
+		delete(_Get_Entry(i)->pFile);	// data objects are owned by the data manager
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CCMD_Data_Cache::is_Memory(const CSG_String &File)
+{
+	return( File.Length() > SG_STR_LEN(CMD_MEMORY_PREFIX) && !File.Left(SG_STR_LEN(CMD_MEMORY_PREFIX)).CmpNoCase(CMD_MEMORY_PREFIX) );
+}
+
+//---------------------------------------------------------
+long CCMD_Data_Cache::_Get_File_Time(const CSG_String &File)
+{
+	return( (long)wxFileModificationTime(File.c_str()) );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+int CCMD_Data_Cache::_Find(const CSG_String &File) const
+{
+	for(int i=0; i<_Get_Count(); i++)
+	{
+		if( !_Get_Entry(i)->pFile->Cmp(File) )
+		{
+			return( i );
+		}
+	}
+
+	return( -1 );
+}
+
+//---------------------------------------------------------
+int CCMD_Data_Cache::_Find(CSG_Data_Object *pObject) const
+{
+	for(int i=0; i<_Get_Count(); i++)
+	{
+		if( _Get_Entry(i)->pObject == pObject )
+		{
+			return( i );
+		}
+	}
+
+	return( -1 );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * Returns the data object associated with File. Memory objects
+  * are looked up by name. File based objects are only returned,
+  * if the file has not been modified since it has been loaded or
+  * saved, otherwise the outdated object is dropped, so that the
+  * caller will load the file again.
+*/
+//---------------------------------------------------------
+CSG_Data_Object * CCMD_Data_Cache::Get(const CSG_String &File)
+{
+	int	i	= _Find(File);
+
+	if( i >= 0 )
+	{
+		TCMD_Cache_Entry	*pEntry	= _Get_Entry(i);
+
+		if( !SG_Get_Data_Manager().Exists(pEntry->pObject) )	// has been removed by someone else
+		{
+			_Del(i, false);
+
+			return( NULL );
+		}
+
+		if( is_Memory(File) || pEntry->Time == _Get_File_Time(File) )
+		{
+			return( pEntry->pObject );
+		}
+
+		_Del(i, true);	// file has been changed since we did read it
+
+		return( NULL );
+	}
+
+	//-----------------------------------------------------
+	CSG_Data_Object	*pObject	= is_Memory(File) ? NULL : SG_Get_Data_Manager().Find(File, false);
+
+	if( pObject )	// loaded without cache registration, e.g. by a tool
+	{
+		_Add(File, pObject, _Get_File_Time(File));
+	}
+
+	return( pObject );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CCMD_Data_Cache::_Add(const CSG_String &File, CSG_Data_Object *pObject, long Time)
+{
+	int	i	= _Find(File);
+
+	if( i >= 0 )
+	{
+		if( _Get_Entry(i)->pObject != pObject )	// name is reused for another object
+		{
+			CSG_Data_Object	*pPrevious	= _Get_Entry(i)->pObject;
+
+			_Del(i, false);	// previous object might still be in use by the current tool...
+
+			if( _Find(pPrevious) < 0 )
+			{
+				pPrevious->Set_File_Name(SG_T(""));	// ...so let Del_Unused() remove it later on
+			}
+		}
+		else
+		{
+			_Get_Entry(i)->Time	= Time;
+
+			return( true );
+		}
+	}
+
+	if( !m_Entries.Inc_Array() )
+	{
+		return( false );
+	}
+
+	TCMD_Cache_Entry	*pEntry	= _Get_Entry(_Get_Count() - 1);
+
+	pEntry->pFile	= new CSG_String(File);
+	pEntry->pObject	= pObject;
+	pEntry->Time	= Time;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CCMD_Data_Cache::Add_File(const CSG_String &File, CSG_Data_Object *pObject)
+{
+	if( !pObject || is_Memory(File) || !SG_File_Exists(File) )
+	{
+		return( false );
+	}
+
+	return( _Add(File, pObject, _Get_File_Time(File)) );
+}
+
+//---------------------------------------------------------
+bool CCMD_Data_Cache::Add_Memory(const CSG_String &Name, CSG_Data_Object *pObject)
+{
+	if( !pObject || !is_Memory(Name) )
+	{
+		return( false );
+	}
+
+	pObject->Set_Name(Name.Right(Name.Length() - SG_STR_LEN(CMD_MEMORY_PREFIX)));
+
+	return( _Add(Name, pObject, 0) );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CCMD_Data_Cache::_Del(int i, bool bDelete)
+{
+	TCMD_Cache_Entry	*pEntry	= _Get_Entry(i);
+
+	if( !pEntry )
+	{
+		return( false );
+	}
+
+	CSG_Data_Object	*pObject	= pEntry->pObject;
+
+	delete(pEntry->pFile);
+
+	TCMD_Cache_Entry	*pEntries	= (TCMD_Cache_Entry *)m_Entries.Get_Array();
+
+	for(int j=i+1; j<_Get_Count(); j++)
+	{
+		pEntries[j - 1]	= pEntries[j];
+	}
+
+	m_Entries.Dec_Array();
+
+	//-----------------------------------------------------
+	if( bDelete && _Find(pObject) < 0 )	// not referenced by another name
+	{
+		SG_Get_Data_Manager().Delete(pObject);
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CCMD_Data_Cache::Del(const CSG_String &File)
+{
+	return( _Del(_Find(File), true) );
+}
+
+//---------------------------------------------------------
+bool CCMD_Data_Cache::Del_All(void)
+{
+	while( _Get_Count() > 0 )
+	{
+		_Del(_Get_Count() - 1, false);
+	}
+
+	return( SG_Get_Data_Manager().Delete_All() );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * Replacement for CSG_Data_Manager::Delete_Unsaved(), which
+  * keeps data objects that are referenced as memory objects.
+*/
+//---------------------------------------------------------
+bool CCMD_Data_Cache::Del_Unused(void)
+{
+	CSG_Data_Manager	&Manager	= SG_Get_Data_Manager();
+
+	_Del_Unused(Manager.Get_Table      ());
+	_Del_Unused(Manager.Get_TIN        ());
+	_Del_Unused(Manager.Get_Point_Cloud());
+	_Del_Unused(Manager.Get_Shapes     ());
+
+	for(size_t i=Manager.Grid_System_Count(); i>0; i--)
+	{
+		_Del_Unused(Manager.Get_Grid_System(i - 1));
+	}
+
+	//-----------------------------------------------------
+	for(int i=_Get_Count()-1; i>=0; i--)	// drop entries of objects that no more exist
+	{
+		if( !Manager.Exists(_Get_Entry(i)->pObject) )
+		{
+			_Del(i, false);
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CCMD_Data_Cache::_Del_Unused(CSG_Data_Collection *pCollection)
+{
+	CSG_Data_Object	**pObjects	= (CSG_Data_Object **)SG_Malloc(pCollection->Count() * sizeof(CSG_Data_Object *));
+
+	size_t	i, n;
+
+	for(i=0, n=0; i<pCollection->Count(); i++)
+	{
+		CSG_Data_Object	*pObject	= pCollection->Get(i);
+
+		if( !SG_File_Exists(pObject->Get_File_Name()) && _Find(pObject) < 0 )
+		{
+			pObjects[n++]	= pObject;
+		}
+	}
+
+	for(i=0; i<n; i++)	// collection might be deleted with its last grid
+	{
+		SG_Get_Data_Manager().Delete(pObjects[i]);
+	}
+
+	SG_Free(pObjects);
+
+	return( n > 0 );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_String CCMD_Data_Cache::Get_Summary(void) const
+{
+	CSG_String	s;
+
+	for(int i=0; i<_Get_Count(); i++)
+	{
+		CSG_Data_Object	*pObject	= _Get_Entry(i)->pObject;
+
+		s	+= CSG_String::Format(SG_T("%s\t[%s]\n"), _Get_Entry(i)->pFile->c_str(), SG_Get_DataObject_Name(pObject->Get_ObjectType()).c_str());
+	}
+
+	return( s );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
@@ -0,0 +1,162 @@
+/**********************************************************
+ * Version $Id$
+ *********************************************************/
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                Command Line Interface                 //
+//                                                       //
+//                   Program: SAGA_CMD                   //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                     data_cache.h                      //
+//                                                       //
+//                 Copyright (C) 2014 by                 //
+//              SAGA User Group Association              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation; version 2 of the License.   //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not,       //
+// write to the Free Software Foundation, Inc.,          //
+// 51 Franklin Street, 5th Floor, Boston, MA 02110-1301, //
+// USA.                                                  //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    SAGA User Group Association            //
+//                Institute of Geography                 //
+//                University of Hamburg                  //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#ifndef _HEADER_INCLUDED__SAGA_CMD__Data_Cache_H
+#define _HEADER_INCLUDED__SAGA_CMD__Data_Cache_H
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include <saga_api/saga_api.h>
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Data objects referenced with this prefix (e.g. -SLOPE=mem:slope)
+// are kept in memory and never written to disk. They survive
+// the execution of a tool and can be used as input by any
+// following tool call of the same script or server session.
+
+#define CMD_MEMORY_PREFIX		SG_T("mem:")
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+class CCMD_Data_Cache
+{
+public:
+	CCMD_Data_Cache(void);
+	virtual ~CCMD_Data_Cache(void);
+
+	static bool					is_Memory				(const CSG_String &File);
+
+	CSG_Data_Object *			Get						(const CSG_String &File);
+
+	bool						Add_File				(const CSG_String &File, CSG_Data_Object *pObject);
+	bool						Add_Memory				(const CSG_String &Name, CSG_Data_Object *pObject);
+
+	bool						Del						(const CSG_String &File);
+	bool						Del_All					(void);
+
+	bool						Del_Unused				(void);
+
+	CSG_String					Get_Summary				(void)	const;
+
+
+private:
+
+	typedef struct
+	{
+		CSG_String				*pFile;
+
+		CSG_Data_Object			*pObject;
+
+		long					Time;
+	}
+	TCMD_Cache_Entry;
+
+
+	CSG_Array					m_Entries;
+
+
+	int							_Get_Count				(void)	const	{	return( (int)m_Entries.Get_Size() );	}
+	TCMD_Cache_Entry *			_Get_Entry				(int i)	const	{	return( (TCMD_Cache_Entry *)m_Entries.Get_Entry(i) );	}
+
+	int							_Find					(const CSG_String &File)	const;
+	int							_Find					(CSG_Data_Object *pObject)	const;
+
+	bool						_Add					(const CSG_String &File, CSG_Data_Object *pObject, long Time);
+	bool						_Del					(int i, bool bDelete);
+
+	bool						_Del_Unused				(CSG_Data_Collection *pCollection);
+
+	static long					_Get_File_Time			(const CSG_String &File);
+
+};
+
+//---------------------------------------------------------
+CCMD_Data_Cache &				CMD_Get_Data_Cache		(void);
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#endif // #ifndef _HEADER_INCLUDED__SAGA_CMD__Data_Cache_H
@@ -64,6 +64,7 @@
 #include "callback.h"
 
 #include "module_library.h"
+#include "data_cache.h"
 
 
 ///////////////////////////////////////////////////////////
@@ -230,7 +231,7 @@ bool CCMD_Module::Execute(int argc, char *argv[])
 			_Save_Output(m_pModule->Get_Parameters(i));
 		}
 
-		SG_Get_Data_Manager().Delete_Unsaved();	// remove temporary data to save memory resources
+		CMD_Get_Data_Cache().Del_Unused();	// remove temporary data to save memory resources, keep memory objects
 	}
 	else
 	{
@@ -611,6 +612,22 @@ bool CCMD_Module::_Get_Parameters(CSG_Parameters *pParameters, bool bInitialize)
 //                                                       //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+CSG_Data_Object * CCMD_Module::_Get_Input(const CSG_String &File)
+{
+	CSG_Data_Object	*pObject	= CMD_Get_Data_Cache().Get(File);
+
+	if( !pObject && !CCMD_Data_Cache::is_Memory(File) && SG_Get_Data_Manager().Add(File) )
+	{
+		if( (pObject = SG_Get_Data_Manager().Find(File, false)) != NULL )
+		{
+			CMD_Get_Data_Cache().Add_File(File, pObject);
+		}
+	}
+
+	return( pObject );
+}
+
 //---------------------------------------------------------
 bool CCMD_Module::_Load_Input(CSG_Parameter *pParameter)
 {
@@ -628,20 +645,24 @@ bool CCMD_Module::_Load_Input(CSG_Parameter *pParameter)
 
 	if( pParameter->is_DataObject() )
 	{
-		if( !SG_Get_Data_Manager().Find(&FileName) && !SG_Get_Data_Manager().Add(&FileName) && !pParameter->is_Optional() )
+		CSG_Data_Object	*pObject	= _Get_Input(&FileName);
+
+		if( !pObject && !pParameter->is_Optional() )
 		{
 			CMD_Print_Error(_TL("input file"), &FileName);
 
 			return( false );
 		}
 
-		return( pParameter->Set_Value(SG_Get_Data_Manager().Find(&FileName, false)) );
+		return( pParameter->Set_Value(pObject) );
 	}
 
 	else if( pParameter->is_DataObject_List() )
 	{
 		pParameter->asList()->Del_Items();
 
+		CSG_Strings	Files, Load;
+
 		wxString	FileNames(FileName);
 
 		do
@@ -649,14 +670,24 @@ bool CCMD_Module::_Load_Input(CSG_Parameter *pParameter)
 			FileName	= FileNames.BeforeFirst(';').Trim(false);
 			FileNames	= FileNames.AfterFirst (';');
 
-			if( !SG_Get_Data_Manager().Find(&FileName) )
+			Files	+= &FileName;
+
+			if( !CMD_Get_Data_Cache().Get(&FileName) && !CCMD_Data_Cache::is_Memory(&FileName) )
 			{
-				SG_Get_Data_Manager().Add(&FileName);
+				Load	+= &FileName;
 			}
-
-			pParameter->asList()->Add_Item(SG_Get_Data_Manager().Find(&FileName, false));
 		}
 		while( FileNames.Length() > 0 );
+
+		if( Load.Get_Count() > 1 )	// load all files at once, native formats will be read concurrently
+		{
+			SG_Get_Data_Manager().Add(Load);
+		}
+
+		for(int i=0; i<Files.Get_Count(); i++)
+		{
+			pParameter->asList()->Add_Item(_Get_Input(Files[i]));
+		}
 	}
 
 	return( true );
@@ -669,6 +700,78 @@ bool CCMD_Module::_Load_Input(CSG_Parameter *pParameter)
 //                                                       //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+bool CCMD_Module::_Save_Output(CSG_Data_Object *pObject, const CSG_String &File)
+{
+	if( CCMD_Data_Cache::is_Memory(File) )
+	{
+		return( CMD_Get_Data_Cache().Add_Memory(File, pObject) );
+	}
+
+	if( pObject->Save(File) )
+	{
+		CMD_Get_Data_Cache().Add_File(pObject->Get_File_Name(), pObject);
+
+		return( true );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+/**
+  * Saves the items of a data object list to the given files.
+  * Files are written concurrently, memory objects are registered
+  * afterwards.
+*/
+//---------------------------------------------------------
+bool CCMD_Module::_Save_Output(CSG_Parameter_List *pList, const CSG_Strings &Files)
+{
+	int		i, n	= pList->Get_Count() < Files.Get_Count() ? pList->Get_Count() : Files.Get_Count();
+
+	CSG_Array	Saved(sizeof(char), n);
+
+	char	*bSaved	= (char *)Saved.Get_Array();
+
+	//-----------------------------------------------------
+	SG_UI_Progress_Lock(true);
+	SG_UI_Msg_Lock     (true);
+
+	#pragma omp parallel for schedule(dynamic) num_threads(SG_Get_Max_Num_Threads_IO())
+	for(i=0; i<n; i++)
+	{
+		bSaved[i]	= !CCMD_Data_Cache::is_Memory(Files[i]) && pList->asDataObject(i)->Save(Files[i]);
+	}
+
+	SG_UI_Msg_Lock     (false);
+	SG_UI_Progress_Lock(false);
+
+	//-----------------------------------------------------
+	bool	bResult	= true;
+
+	for(i=0; i<n; i++)
+	{
+		if( CCMD_Data_Cache::is_Memory(Files[i]) )
+		{
+			CMD_Get_Data_Cache().Add_Memory(Files[i], pList->asDataObject(i));
+		}
+		else if( bSaved[i] )
+		{
+			CMD_Print(CSG_String::Format(SG_T("%s: %s"), _TL("Save"), Files[i].c_str()));
+
+			CMD_Get_Data_Cache().Add_File(pList->asDataObject(i)->Get_File_Name(), pList->asDataObject(i));
+		}
+		else
+		{
+			CMD_Print_Error(_TL("output file"), Files[i]);
+
+			bResult	= false;
+		}
+	}
+
+	return( bResult );
+}
+
 //---------------------------------------------------------
 bool CCMD_Module::_Save_Output(CSG_Parameters *pParameters)
 {
@@ -687,7 +790,7 @@ bool CCMD_Module::_Save_Output(CSG_Parameters *pParameters)
 
 				if( pObject && pObject->is_Modified() && SG_File_Exists(pObject->Get_File_Name()) )
 				{
-					pObject->Save(pObject->Get_File_Name());
+					_Save_Output(pObject, pObject->Get_File_Name());
 				}
 			}
 
@@ -699,7 +802,7 @@ bool CCMD_Module::_Save_Output(CSG_Parameters *pParameters)
 
 					if( pObject->is_Modified() && SG_File_Exists(pObject->Get_File_Name()) )
 					{
-						pObject->Save(pObject->Get_File_Name());
+						_Save_Output(pObject, pObject->Get_File_Name());
 					}
 				}
 			}
@@ -712,7 +815,7 @@ bool CCMD_Module::_Save_Output(CSG_Parameters *pParameters)
 			{
 				if( pParameter->asDataObject() )
 				{
-					pParameter->asDataObject()->Save(&FileName);
+					_Save_Output(pParameter->asDataObject(), &FileName);
 				}
 			}
 
@@ -736,21 +839,25 @@ bool CCMD_Module::_Save_Output(CSG_Parameters *pParameters)
 				{
 					int	nFileNames	= pParameter->asList()->Get_Count() <= FileNames.Get_Count() ? FileNames.Get_Count() : FileNames.Get_Count() - 1;
 
+					CSG_Strings	Files;
+
 					for(int i=0; i<pParameter->asList()->Get_Count(); i++)
 					{
 						if( i < nFileNames )
 						{
-							pParameter->asList()->asDataObject(i)->Save(FileNames[i]);
+							Files	+= FileNames[i];
 						}
 						else
 						{
-							pParameter->asList()->asDataObject(i)->Save(CSG_String::Format(SG_T("%s_%0*d"),
+							Files	+= CSG_String::Format(SG_T("%s_%0*d"),
 								FileNames[nFileNames].c_str(),
 								SG_Get_Digit_Count(pParameter->asList()->Get_Count()),
 								1 + i - nFileNames
-							));
+							);
 						}
 					}
+
+					_Save_Output(pParameter->asList(), Files);
 				}
 			}
 		}
@@ -115,7 +115,10 @@ private:
 	bool						_Set_Parameters			(CSG_Parameters *pParameters, bool bOptional);
 	bool						_Get_Parameters			(CSG_Parameters *pParameters, bool bInitialize);
 
+	CSG_Data_Object *			_Get_Input				(const CSG_String &File);
 	bool						_Load_Input				(CSG_Parameter  *pParameter);
+	bool						_Save_Output			(CSG_Data_Object *pObject, const CSG_String &File);
+	bool						_Save_Output			(CSG_Parameter_List *pList, const CSG_Strings &Files);
 	bool						_Save_Output			(CSG_Parameters *pParameters);
 
 };
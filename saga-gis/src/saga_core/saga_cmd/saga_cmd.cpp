@@ -63,12 +63,20 @@
 //---------------------------------------------------------
 #include <locale.h>
 
+#if defined(_SAGA_LINUX)
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
 #include <wx/app.h>
 #include <wx/utils.h>
 
 #include "callback.h"
 
 #include "module_library.h"
+#include "data_cache.h"
 
 
 ///////////////////////////////////////////////////////////
@@ -82,6 +90,9 @@ bool		Run				(int argc, char *argv[]);
 
 bool		Execute			(int argc, char *argv[]);
 bool		Execute_Script	(const CSG_String &Script);
+bool		Execute_Server	(const CSG_String &Socket);
+
+bool		Check_Server	(const CSG_String &Argument, CSG_String &Socket);
 
 bool		Load_Libraries	(void);
 
@@ -190,6 +201,14 @@ bool		Run(int argc, char *argv[])
 		return( false );
 	}
 
+	//-----------------------------------------------------
+	CSG_String	Socket;
+
+	if( argc == 2 && Check_Server(argv[1], Socket) )
+	{
+		return( Execute_Server(Socket) );
+	}
+
 	//-----------------------------------------------------
 	if( argc <= 1 )
 	{
@@ -378,7 +397,198 @@ bool		Execute_Script(const CSG_String &Script)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool		Load_Libraries(const CSG_String &Directory)
+#define SERVER_REPLY_OKAY	"#SAGA_OKAY"
+#define SERVER_REPLY_ERROR	"#SAGA_ERROR"
+#define SERVER_REPLY_EXIT	"#SAGA_EXIT"
+
+//---------------------------------------------------------
+bool		Server_Read_Line(FILE *Stream, CSG_String &Line)
+{
+	CSG_Array	Buffer(sizeof(char), 0, SG_ARRAY_GROWTH_2);
+
+	int		c;
+
+	while( (c = fgetc(Stream)) != EOF && c != '\n' )
+	{
+		if( c != '\r' && Buffer.Inc_Array() )
+		{
+			((char *)Buffer.Get_Array())[Buffer.Get_Size() - 1]	= (char)c;
+		}
+	}
+
+	if( c == EOF && Buffer.Get_Size() == 0 )
+	{
+		return( false );
+	}
+
+	if( Buffer.Inc_Array() )
+	{
+		((char *)Buffer.Get_Array())[Buffer.Get_Size() - 1]	= '\0';
+	}
+
+	Line	= (const char *)Buffer.Get_Array();
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool		Server_Execute	(const CSG_String &Command, FILE *Reply, bool &bExit)
+{
+	CSG_String	Key(Command.BeforeFirst(' ')), Value(Command.AfterFirst(' '));
+
+	Value.Trim(false);	Value.Trim(true);
+
+	if( !Key.CmpNoCase("EXIT") || !Key.CmpNoCase("QUIT") )
+	{
+		bExit	= true;
+
+		return( true );
+	}
+
+	if( !Key.CmpNoCase("FREE") )	// remove a data object from cache
+	{
+		return( CMD_Get_Data_Cache().Del(Value) );
+	}
+
+	if( !Key.CmpNoCase("CLEAR") )	// remove all data objects
+	{
+		return( CMD_Get_Data_Cache().Del_All() );
+	}
+
+	if( !Key.CmpNoCase("LIST") )	// list cached data objects
+	{
+		fprintf(Reply, "%s", CMD_Get_Data_Cache().Get_Summary().b_str());
+
+		return( true );
+	}
+
+	CSG_String	s(Command);
+
+	Set_Environment(s);
+
+	return( Execute(s) );
+}
+
+//---------------------------------------------------------
+bool		Server_Session	(FILE *Input, FILE *Reply)
+{
+	bool		bExit	= false;
+	CSG_String	Command;
+
+	while( !bExit && Server_Read_Line(Input, Command) )
+	{
+		bool	bResult	= Server_Execute(Command, Reply, bExit);
+
+		fflush(stdout);
+		fflush(stderr);
+
+		fprintf(Reply, "%s\n", bExit ? SERVER_REPLY_EXIT : bResult ? SERVER_REPLY_OKAY : SERVER_REPLY_ERROR);
+		fflush(Reply);
+	}
+
+	return( bExit );
+}
+
+//---------------------------------------------------------
+/**
+  * Keeps tool libraries and data objects loaded and executes
+  * one command per line, read either from standard input or,
+  * if a socket path has been specified (Linux only), from the
+  * clients connecting to this local (unix domain) socket. Each
+  * command is answered with a single status line.
+*/
+//---------------------------------------------------------
+bool		Execute_Server	(const CSG_String &Socket)
+{
+	if( CMD_Get_Show_Messages() )
+	{
+		CMD_Print(CSG_String::Format(SG_T("%s: %s"), _TL("Running Server"), Socket.is_Empty() ? SG_T("stdin") : Socket.c_str()));
+	}
+
+	//-----------------------------------------------------
+	if( Socket.is_Empty() )
+	{
+		Server_Session(stdin, stdout);
+
+		return( true );
+	}
+
+	//-----------------------------------------------------
+#if defined(_SAGA_LINUX)
+	struct sockaddr_un	Address;
+
+	if( Socket.Length() >= sizeof(Address.sun_path) )
+	{
+		CMD_Print_Error(_TL("socket path is too long"), Socket);
+
+		return( false );
+	}
+
+	memset(&Address, 0, sizeof(Address));
+	Address.sun_family	= AF_UNIX;
+	strcpy(Address.sun_path, Socket.b_str());
+
+	int	Server	= socket(AF_UNIX, SOCK_STREAM, 0);
+
+	unlink(Address.sun_path);
+
+	if( Server < 0 || bind(Server, (struct sockaddr *)&Address, sizeof(Address)) < 0 || listen(Server, 8) < 0 )
+	{
+		CMD_Print_Error(_TL("could not create socket"), Socket);
+
+		if( Server >= 0 )
+		{
+			close(Server);
+		}
+
+		return( false );
+	}
+
+	signal(SIGPIPE, SIG_IGN);	// a client might disconnect before receiving its reply
+
+	bool	bExit	= false;
+
+	while( !bExit )
+	{
+		int	Client	= accept(Server, NULL, NULL);
+
+		if( Client >= 0 )
+		{
+			FILE	*Input	= fdopen(Client, "r");
+			FILE	*Reply	= fdopen(dup(Client), "w");
+
+			if( Input && Reply )
+			{
+				bExit	= Server_Session(Input, Reply);
+			}
+
+			if( Input ) fclose(Input); else close(Client);
+			if( Reply ) fclose(Reply);
+		}
+	}
+
+	close(Server);
+
+	unlink(Address.sun_path);
+
+	return( true );
+
+#else
+	CMD_Print_Error(_TL("socket connections are not supported on this platform"), Socket);
+
+	return( false );
+#endif
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+int			Load_Libraries(const CSG_String &Directory)
 {
 	bool	bShow	= CMD_Get_Show_Messages();
 
@@ -386,7 +596,28 @@ bool		Load_Libraries(const CSG_String &Directory)
 	int	n	= SG_Get_Module_Library_Manager().Add_Directory(Directory, false);
 	CMD_Set_Show_Messages(bShow);
 
-	return( n > 0 );
+	return( n );
+}
+
+//---------------------------------------------------------
+// Tool libraries are only inspected, if they are not listed
+// in the tool catalogue or have changed since, and are loaded
+// on demand, i.e. usually only the library of the requested
+// tool needs to be loaded. Set the environment variable
+// SAGA_CATALOGUE to 'none' to load all libraries at start-up.
+//---------------------------------------------------------
+CSG_String	Get_Catalogue	(void)
+{
+	wxString	File;
+
+	if( wxGetEnv("SAGA_CATALOGUE", &File) )
+	{
+		return( File.CmpNoCase("none") ? CSG_String(&File) : CSG_String("") );
+	}
+
+	File	= wxGetHomeDir();
+
+	return( SG_File_Make_Path(CSG_String(&File), SG_T(".saga_cmd_tools"), SG_T("cat")) );
 }
 
 //---------------------------------------------------------
@@ -394,8 +625,17 @@ bool		Load_Libraries(void)
 {
 	wxString	Path, CMD_Path	= SG_File_Get_Path(SG_UI_Get_Application_Path()).c_str();
 
+	int		nLibraries	= 0;
+
+	CSG_String	Catalogue	= Get_Catalogue();
+
+	if( !Catalogue.is_Empty() )
+	{
+		SG_Get_Module_Library_Manager().Set_Catalogue(Catalogue);
+	}
+
     #if defined(_SAGA_LINUX)
-		Load_Libraries(wxT(MODULE_LIBRARY_PATH));
+		nLibraries	+= Load_Libraries(wxT(MODULE_LIBRARY_PATH));
 	#else
 		wxString	DLL_Path	= SG_File_Make_Path(CMD_Path, SG_T("dll")).c_str();
 
@@ -410,20 +650,22 @@ bool		Load_Libraries(void)
 
 		wxSetEnv("GDAL_DRIVER_PATH", DLL_Path);
 
-		Load_Libraries(SG_File_Make_Path(CMD_Path, SG_T("modules")));
+		nLibraries	+= Load_Libraries(SG_File_Make_Path(CMD_Path, SG_T("modules")));
     #endif
 
 	if( wxGetEnv(SG_T("SAGA_MLB"), &Path) )
 	{
 		while( Path.Length() > 0 )
 		{
-			Load_Libraries(CSG_String(&Path).BeforeFirst(';'));
+			nLibraries	+= Load_Libraries(CSG_String(&Path).BeforeFirst(';'));
 
 			Path	= Path.AfterFirst(';');
 		}
 	}
 
-	if( SG_Get_Module_Library_Manager().Get_Count() <= 0 )
+	SG_Get_Module_Library_Manager().Save_Catalogue();
+
+	if( nLibraries <= 0 )
 	{
 		CMD_Print_Error(SG_T("could not load any tool library"));
 
@@ -474,6 +716,19 @@ bool		Check_First		(const CSG_String &Argument)
 	return( false );
 }
 
+//---------------------------------------------------------
+bool		Check_Server	(const CSG_String &Argument, CSG_String &Socket)
+{
+	if( !Argument.BeforeFirst('=').CmpNoCase("--server") )
+	{
+		Socket	= Argument.AfterFirst('=');
+
+		return( true );
+	}
+
+	return( false );
+}
+
 //---------------------------------------------------------
 bool		Check_Flags		(const CSG_String &Argument)
 {
@@ -488,6 +743,8 @@ bool		Check_Flags		(const CSG_String &Argument)
 		CMD_Set_Interactive  (s.Find('i') >= 0                  );	// i: allow user interaction
 		CMD_Set_XML          (s.Find('x') >= 0                  );	// x: message output as xml
 
+		SG_Grid_Cache_Set_Virtual(s.Find('v') >= 0);	// v: read grid files on demand
+
 		if( s.Find('l') >= 0 )	// l: load translation dictionary
 		{
 			SG_Get_Translator() .Create(SG_File_Make_Path(SG_File_Get_Path(SG_UI_Get_Application_Path()),
@@ -557,6 +814,8 @@ void		Print_Libraries	(void)
 {
 	CMD_Print_Error(_TL("select a library"));
 
+	SG_Get_Module_Library_Manager().Load_Catalogue();
+
 	if( CMD_Get_Show_Messages() )
 	{
 		if( CMD_Get_XML() )
@@ -686,11 +945,13 @@ void		Print_Help		(void)
 		"saga_cmd [-b, --batch]\n"
 		"saga_cmd [-d, --docs]\n"
 #ifdef _OPENMP
-		"saga_cmd [-f, --flags][=qrsilpxo][-s, --story][=#][-c, --cores][=#] <LIBRARY> <MODULE> <OPTIONS>\n"
-		"saga_cmd [-f, --flags][=qrsilpxo][-s, --story][=#][-c, --cores][=#] <SCRIPT>\n"
+		"saga_cmd [-f, --flags][=qrsilpxov][-s, --story][=#][-c, --cores][=#] <LIBRARY> <MODULE> <OPTIONS>\n"
+		"saga_cmd [-f, --flags][=qrsilpxov][-s, --story][=#][-c, --cores][=#] <SCRIPT>\n"
+		"saga_cmd [-f, --flags][=qrsilpxov][-s, --story][=#][-c, --cores][=#] --server[=<SOCKET>]\n"
 #else
-		"saga_cmd [-f, --flags][=qrsilpxo][-s, --story][=#] <LIBRARY> <MODULE> <module specific options...>\n"
-		"saga_cmd [-f, --flags][=qrsilpxo][-s, --story][=#] <SCRIPT>\n"
+		"saga_cmd [-f, --flags][=qrsilpxov][-s, --story][=#] <LIBRARY> <MODULE> <module specific options...>\n"
+		"saga_cmd [-f, --flags][=qrsilpxov][-s, --story][=#] <SCRIPT>\n"
+		"saga_cmd [-f, --flags][=qrsilpxov][-s, --story][=#] --server[=<SOCKET>]\n"
 #endif
 		"\n"
 		"[-h], [--help]   : help on usage\n"
@@ -701,7 +962,7 @@ void		Print_Help		(void)
 #ifdef _OPENMP
 		"[-c], [--cores]  : number of physical processors to use for computation\n"
 #endif
-		"[-f], [--flags]  : various flags for general usage [qrsilpxo]\n"
+		"[-f], [--flags]  : various flags for general usage [qrsilpxov]\n"
 		"  q              : no progress report\n"
 		"  r              : no messages report\n"
 		"  s              : silent mode (no progress and no messages report)\n"
@@ -710,11 +971,15 @@ void		Print_Help		(void)
 		"  p              : load projections dictionary\n"
 		"  x              : use XML markups for synopses and messages\n"
 		"  o              : load old style naming\n"
+		"  v              : read input grids on demand from their files (virtual grids)\n"
 		"\n"
 		"<LIBRARY>        : name of the library\n"
 		"<MODULE>         : either name or index of the tool\n"
 		"<OPTIONS>        : tool specific options\n"
 		"<SCRIPT>         : saga cmd script file with one or more tool calls\n"
+		"--server         : keep running and execute one tool call per line read\n"
+		"                   from standard input or from clients of a local socket\n"
+		"<SOCKET>         : file path of a unix domain socket (linux only)\n"
 		"\n"
 		"____________________________\n"
 		"Example:\n"
@@ -726,12 +991,25 @@ void		Print_Help		(void)
 		"will be loaded automatically. Additional directories can be specified\n"
 		"by adding the environment variable \'SAGA_MLB\' and let it point to one\n"
 		"or more directories, just the way it is done with the DOS \'PATH\' variable.\n"
+		"Libraries are listed in a tool catalogue and only the library of the\n"
+		"requested tool is loaded. The catalogue is stored in the home directory\n"
+		"unless the environment variable \'SAGA_CATALOGUE\' specifies another file\n"
+		"path (or \'none\' to load all libraries at start-up).\n"
 		"\n"
 		"The SAGA command line interpreter is particularly useful for the processing\n"
 		"of complex work flows by defining a series of subsequent tool calls in a\n"
 		"script file. Calling saga_cmd with the option \'-b\' or \'--batch\' will\n"
 		"create an example of a DOS batch script file, which might be a good starting\n"
 		"point for the implementation of your own specific work flows.\n"
+		"\n"
+		"Within scripts and server sessions data sets, which have been loaded or\n"
+		"saved once, are kept in memory and are only loaded again, if the file\n"
+		"has been changed. Output targets named with the prefix 'mem:' (e.g.\n"
+		"-SLOPE=mem:slope) are not written to disk at all, but can be used as\n"
+		"input by following tool calls. A server replies to each call with one of\n"
+		"the status lines '" SERVER_REPLY_OKAY "', '" SERVER_REPLY_ERROR "' or '" SERVER_REPLY_EXIT "'. Beside\n"
+		"tool calls it understands the commands 'FREE <file or mem:name>', 'CLEAR',\n"
+		"'LIST' and 'EXIT'.\n"
 		"____________________________\n"
 	);
 }
@@ -856,6 +1134,8 @@ void		Create_Docs		(void)
 
 		CMD_Set_Show_Messages(false);
 
+		SG_Get_Module_Library_Manager().Load_Catalogue();
+
 		SG_Get_Module_Library_Manager().Get_Summary(SG_Dir_Get_Current());
 
 		CMD_Print(_TL("okay"));
@@ -95,6 +95,8 @@
 CWKSP_Grid::CWKSP_Grid(CSG_Grid *pGrid)
 	: CWKSP_Layer(pGrid)
 {
+	m_Renderer.Set_Grid(pGrid);
+
 	On_Create_Parameters();
 
 	DataObject_Changed();
@@ -497,6 +499,8 @@ void CWKSP_Grid::On_Create_Parameters(void)
 //---------------------------------------------------------
 void CWKSP_Grid::On_DataObject_Changed(void)
 {
+	m_Renderer.Invalidate();	// values might have changed, pyramid needs to be rebuilt
+
 	CWKSP_Layer::On_DataObject_Changed();
 
 	//-----------------------------------------------------
@@ -1004,6 +1008,8 @@ bool CWKSP_Grid::Edit_Set_Attributes(void)
 			}
 		}
 
+		m_Renderer.Invalidate();
+
 		Update_Views();
 
 		return( true );
@@ -1051,6 +1057,8 @@ bool CWKSP_Grid::_Edit_Del_Selection(void)
 			}
 		}
 
+		m_Renderer.Invalidate();
+
 		g_pACTIVE->Get_Attributes()->Set_Attributes();
 
 		Update_Views();
@@ -1422,6 +1430,26 @@ void CWKSP_Grid::_Draw_Grid_Points(CWKSP_Map_DC &dc_Map, int Interpolation)
 		break;
 	}
 
+	//-----------------------------------------------------
+	CSG_Grid	*pGrids[3];	// when zoomed out, values are taken from a pyramid level matching the display resolution
+
+	bool	bPyramid	= m_pClassify->Get_Mode() != CLASSIFY_LUT && m_pClassify->Get_Mode() != CLASSIFY_RGB;
+
+	pGrids[0]	= bPyramid ? m_Renderer.Get_Level(dc_Map.m_DC2World) : Get_Grid();
+	pGrids[1]	= Mode >= 0 && pOverlay[0] ? pOverlay[0]->m_Renderer.Get_Level(dc_Map.m_DC2World) : NULL;
+	pGrids[2]	= Mode >= 0 && pOverlay[1] ? pOverlay[1]->m_Renderer.Get_Level(dc_Map.m_DC2World) : NULL;
+
+	bool	bParallel	= true;
+
+	for(int i=0; i<3; i++)
+	{
+		if( pGrids[i] && (pGrids[i]->is_Cached() || pGrids[i]->is_Compressed()) )
+		{
+			bParallel	= false;
+		}
+	}
+
+	//-----------------------------------------------------
 	CSG_Rect	rMap(dc_Map.m_rWorld);	rMap.Intersect(Get_Grid()->Get_Extent(true));
 
 	int	axDC	= (int)dc_Map.xWorld2DC(rMap.Get_XMin());	if( axDC < 0 )	axDC	= 0;
@@ -1430,11 +1458,11 @@ void CWKSP_Grid::_Draw_Grid_Points(CWKSP_Map_DC &dc_Map, int Interpolation)
 	int	byDC	= (int)dc_Map.yWorld2DC(rMap.Get_YMax());	if( byDC < 0 )	byDC	= 0;
 	int	nyDC	= abs(ayDC - byDC);
 
-	if( Get_Grid()->is_Cached() || Get_Grid()->is_Compressed() )
+	if( !bParallel )
 	{
 		for(int iyDC=0; iyDC<=nyDC; iyDC++)
 		{
-			_Draw_Grid_Line(dc_Map, Interpolation, Mode, pOverlay, ayDC - iyDC, axDC, bxDC);
+			_Draw_Grid_Line(dc_Map, Interpolation, Mode, pGrids, pOverlay, ayDC - iyDC, axDC, bxDC);
 		}
 	}
 	else
@@ -1442,13 +1470,13 @@ void CWKSP_Grid::_Draw_Grid_Points(CWKSP_Map_DC &dc_Map, int Interpolation)
 		#pragma omp parallel for
 		for(int iyDC=0; iyDC<=nyDC; iyDC++)
 		{
-			_Draw_Grid_Line(dc_Map, Interpolation, Mode, pOverlay, ayDC - iyDC, axDC, bxDC);
+			_Draw_Grid_Line(dc_Map, Interpolation, Mode, pGrids, pOverlay, ayDC - iyDC, axDC, bxDC);
 		}
 	}
 }
 
 //---------------------------------------------------------
-void CWKSP_Grid::_Draw_Grid_Line(CWKSP_Map_DC &dc_Map, int Interpolation, int Mode, CWKSP_Grid *pOverlay[2], int yDC, int axDC, int bxDC)
+void CWKSP_Grid::_Draw_Grid_Line(CWKSP_Map_DC &dc_Map, int Interpolation, int Mode, CSG_Grid *pGrids[3], CWKSP_Grid *pOverlay[2], int yDC, int axDC, int bxDC)
 {
 	double	xMap	= dc_Map.xDC2World(axDC);
 	double	yMap	= dc_Map.yDC2World( yDC);
@@ -1457,7 +1485,7 @@ void CWKSP_Grid::_Draw_Grid_Line(CWKSP_Map_DC &dc_Map, int Interpolation, int Mo
 	{
 		double	Value;
 
-		if( Get_Grid()->Get_Value(xMap, yMap, Value, Interpolation, Mode == -2, true) )
+		if( pGrids[0]->Get_Value(xMap, yMap, Value, Interpolation, Mode == -2, true) )
 		{
 			if( Mode < 0 )
 			{
@@ -1474,10 +1502,10 @@ void CWKSP_Grid::_Draw_Grid_Line(CWKSP_Map_DC &dc_Map, int Interpolation, int Mo
 
 				c[0]	= (int)(255.0 * m_pClassify->Get_MetricToRelative(Value));
 
-				c[1]	= pOverlay[0] && pOverlay[0]->Get_Grid()->Get_Value(xMap, yMap, Value, Interpolation, false, true)
+				c[1]	= pGrids[1] && pGrids[1]->Get_Value(xMap, yMap, Value, Interpolation, false, true)
 						? (int)(255.0 * pOverlay[0]->m_pClassify->Get_MetricToRelative(Value)) : 255;
 
-				c[2]	= pOverlay[1] && pOverlay[1]->Get_Grid()->Get_Value(xMap, yMap, Value, Interpolation, false, true)
+				c[2]	= pGrids[2] && pGrids[2]->Get_Value(xMap, yMap, Value, Interpolation, false, true)
 						? (int)(255.0 * pOverlay[1]->m_pClassify->Get_MetricToRelative(Value)) : 255;
 
 				if( c[0] < 0 ) c[0] = 0; else if( c[0] > 255 ) c[0] = 255;
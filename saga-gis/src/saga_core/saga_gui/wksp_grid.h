@@ -132,6 +132,8 @@ private:
 
 	int							m_xSel, m_ySel;
 
+	CSG_Grid_Renderer			m_Renderer;
+
 
 	void						_LUT_Create				(void);
 
@@ -141,7 +143,7 @@ private:
 	void						_Save_Image				(void);
 
 	void						_Draw_Grid_Points		(CWKSP_Map_DC &dc_Map, int Interpolation);
-	void						_Draw_Grid_Line			(CWKSP_Map_DC &dc_Map, int Interpolation, int Mode, CWKSP_Grid *pOverlay[2], int yDC, int axDC, int bxDC);
+	void						_Draw_Grid_Line			(CWKSP_Map_DC &dc_Map, int Interpolation, int Mode, CSG_Grid *pGrids[3], CWKSP_Grid *pOverlay[2], int yDC, int axDC, int bxDC);
 	void						_Draw_Grid_Cells		(CWKSP_Map_DC &dc_Map);
 
 	void						_Draw_Values			(CWKSP_Map_DC &dc_Map);